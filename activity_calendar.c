@@ -0,0 +1,736 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the activity calendar. Days are kept in one
+ *          array from the first day with activity to the last, both in
+ *          memory and in activity_calendar.dat after a small header, so a
+ *          change to one day is written in place. A day's census is only
+ *          stored when it changed that day; other days carry the last one
+ *          forward.
+ *
+ *          The header records how many archive records the discharge counts
+ *          cover. Discharges archived while the calendar was not updated are
+ *          added from the archive tail on load. If the file is missing or
+ *          unreadable, or the archive is shorter than it claims, the calendar
+ *          is rebuilt: every archived stay adds an admission and a discharge,
+ *          every admitted patient an admission, and each day's census is the
+ *          running total of admissions less discharges.
+ *
+ *          Every load, including the one after a restore, reconciles the
+ *          calendar with the census just read from patients.dat: the count
+ *          of admitted patients by day is recounted from the admitted list,
+ *          no day may count fewer admissions than patients still admitted
+ *          from it, and today's census is the length of the list.
+ */
+
+#include "activity_calendar.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "report_format.h"
+#include "report_sink.h"
+#include "utils.h"
+
+// Private constants
+#define ARCHIVE_CHUNK 256
+#define MAX_CONSOLE_REPORT_ROWS 500
+
+static const char  CALENDAR_MAGIC[4]    = { 'C', 'A', 'L', 'N' };
+static const int   CALENDAR_VERSION     = 1;
+static const int   NO_SNAPSHOT          = -1;
+static const int   DEFAULT_REPORT_DAYS  = 7;
+static const char *CALENDAR_FILE        = "activity_calendar.dat";
+static const char *CALENDAR_TEMP        = "activity_calendar.tmp";
+static const char *ACTIVITY_REPORT_FILE = "activity_reports.txt";
+static const char *SEPARATOR_LINE       = "---------------------------------------\n";
+
+/*
+ * The counts of one day. census is NO_SNAPSHOT when it did not change.
+ */
+typedef struct
+{
+    int admissions;
+    int discharges;
+    int census;
+} DayActivity;
+
+/*
+ * Header of activity_calendar.dat, followed by dayCount days from firstDay.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    int       firstDay;
+    int       dayCount;
+    long long coveredRecords;
+} CalendarHeader;
+
+static DayActivity *days           = NULL;
+static int          firstDay       = 0;
+static int          dayCount       = 0;
+static long long    coveredRecords = 0;
+static int          calendarLoaded = 0;
+
+// The layout last written to activity_calendar.dat
+static int savedFirstDay = 0;
+static int savedDayCount = 0;
+
+// Admitted patients by admission day, rebuilt with the census
+static int *admittedByDay    = NULL;
+static int  admittedFirstDay = 0;
+static int  admittedDayCount = 0;
+
+// Function prototypes for internal helper functions
+static int          readCalendarFile(void);
+static void         rebuildCalendar(void);
+static int          addArchivedDischarges(long long fromRecord, int countAdmissions);
+static void         reconcileWithCensus(void);
+static void         recordCensus(int census);
+static DayActivity *dayAt(int day);
+static int         *admittedAt(int day);
+static int          saveCalendar(void);
+static void         saveDays(int fromDay, int toDay);
+static void         resetDays(void);
+static int          censusOn(int day);
+
+/*
+ * Loads the calendar, catching up on newly archived discharges, or rebuilds
+ * it when the file cannot be trusted, then reconciles it with the census.
+ */
+void loadActivityCalendar(void)
+{
+    calendarLoaded = 1;
+
+    if(!readCalendarFile())
+    {
+        rebuildCalendar();
+    }
+    else
+    {
+        long long covered = coveredRecords;
+        int       result  = addArchivedDischarges(covered, 0);
+
+        if(result < 0)
+        {
+            rebuildCalendar();
+        }
+        else if(result > 0)
+        {
+            saveCalendar();
+        }
+    }
+
+    reconcileWithCensus();
+}
+
+/*
+ * Counts the admission and the new census, then writes the days changed.
+ */
+void activityRecordAdmission(time_t admittedAt, int census)
+{
+    if(!calendarLoaded)
+    {
+        loadActivityCalendar();
+    }
+
+    int day   = toDayNumber(admittedAt);
+    int today = toDayNumber(time(NULL));
+
+    // Both days are added before either is used, as growing the array moves it
+    if(dayAt(day) == NULL || dayAt(today) == NULL)
+    {
+        puts("Error: Not enough memory for the activity calendar.");
+        return;
+    }
+
+    dayAt(day)->admissions++;
+    dayAt(today)->census = census;
+    saveDays(day < today ? day : today, day > today ? day : today);
+}
+
+/*
+ * Counts the discharges on their days, reading them from the archive if
+ * earlier records were missed, then writes the days changed.
+ */
+void activityRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count, int census)
+{
+    int today = toDayNumber(time(NULL));
+    int from  = today;
+    int to    = today;
+
+    if(!calendarLoaded)
+    {
+        loadActivityCalendar();
+    }
+    else if(firstArchiveRecord != coveredRecords)
+    {
+        loadActivityCalendar();
+    }
+    else
+    {
+        for(int i = 0; i < count; i++)
+        {
+            int          day   = toDayNumber(records[i].dischargeDate);
+            DayActivity *entry = dayAt(day);
+
+            if(entry == NULL)
+            {
+                puts("Error: Not enough memory for the activity calendar.");
+                return;
+            }
+
+            entry->discharges++;
+            from = day < from ? day : from;
+            to   = day > to ? day : to;
+        }
+        coveredRecords += count;
+    }
+
+    DayActivity *now = dayAt(today);
+    if(now != NULL)
+    {
+        now->census = census;
+        saveDays(from, to);
+    }
+}
+
+/*
+ * Recounts the admitted patients by day from the admitted list, raises any
+ * day counting fewer admissions than patients still admitted from it, and
+ * stores the list's length as today's census.
+ */
+static void reconcileWithCensus(void)
+{
+    int census = 0;
+    int from   = 0;
+    int to     = 0;
+    int raised = 0;
+
+    activityClearAdmitted();
+
+    for(const PatientNode *node = admittedPatients(); node != NULL; node = node->nextNode)
+    {
+        activityTrackAdmitted(node->data.admissionDate, 1);
+        census++;
+    }
+
+    for(int day = admittedFirstDay; day < admittedFirstDay + admittedDayCount; day++)
+    {
+        int stillAdmitted = admittedByDay[day - admittedFirstDay];
+        if(stillAdmitted == 0)
+        {
+            continue;
+        }
+
+        DayActivity *entry = dayAt(day);
+        if(entry == NULL)
+        {
+            puts("Error: Not enough memory for the activity calendar.");
+            return;
+        }
+
+        if(entry->admissions < stillAdmitted)
+        {
+            entry->admissions = stillAdmitted;
+            from              = raised == 0 ? day : from;
+            to                = day;
+            raised++;
+        }
+    }
+
+    if(raised > 0)
+    {
+        printf("Activity calendar: added admissions from patients.dat missing on %d days.\n", raised);
+        saveDays(from, to);
+    }
+
+    recordCensus(census);
+}
+
+/*
+ * Stores today's census if it differs from the one carried forward.
+ */
+static void recordCensus(int census)
+{
+    int today = toDayNumber(time(NULL));
+    if(censusOn(today) == census)
+    {
+        return;
+    }
+
+    DayActivity *now = dayAt(today);
+    if(now != NULL)
+    {
+        now->census = census;
+        saveDays(today, today);
+    }
+}
+
+/*
+ * Adjusts the admission day's count of admitted patients.
+ */
+void activityTrackAdmitted(time_t admittedAtTime, int change)
+{
+    int *count = admittedAt(toDayNumber(admittedAtTime));
+
+    if(count == NULL)
+    {
+        puts("Warning: Unable to count the patient in the activity calendar.");
+        return;
+    }
+    *count += change;
+}
+
+/*
+ * Frees the count of admitted patients by day.
+ */
+void activityClearAdmitted(void)
+{
+    free(admittedByDay);
+    admittedByDay    = NULL;
+    admittedFirstDay = 0;
+    admittedDayCount = 0;
+}
+
+/*
+ * Sums a counter over the part of the range the calendar holds.
+ */
+int activityTotal(int counter, int fromDay, int toDay)
+{
+    if(counter != ACTIVITY_STILL_ADMITTED && !calendarLoaded)
+    {
+        loadActivityCalendar();
+    }
+
+    int start = counter == ACTIVITY_STILL_ADMITTED ? admittedFirstDay : firstDay;
+    int count = counter == ACTIVITY_STILL_ADMITTED ? admittedDayCount : dayCount;
+    int total = 0;
+
+    for(int day = fromDay < start ? start : fromDay; day <= toDay && day < start + count; day++)
+    {
+        switch(counter)
+        {
+            case ACTIVITY_ADMISSIONS:
+                total += days[day - start].admissions;
+                break;
+            case ACTIVITY_DISCHARGES:
+                total += days[day - start].discharges;
+                break;
+            default:
+                total += admittedByDay[day - start];
+                break;
+        }
+    }
+    return total;
+}
+
+/*
+ * Prompts for a range and prints one row per day and the range's totals.
+ */
+void showActivityReport(void)
+{
+    int    today   = toDayNumber(time(NULL));
+    time_t from    = promptDateTime("From (YYYY-MM-DD, Enter for 7 days ago):\n",
+                                    dayNumberToTime(today - DEFAULT_REPORT_DAYS + 1));
+    time_t to      = promptDateTime("To, inclusive (YYYY-MM-DD, Enter for today):\n", dayNumberToTime(today));
+    int    fromDay = toDayNumber(from);
+    int    toDay   = toDayNumber(to);
+
+    if(toDay < fromDay)
+    {
+        puts("The range ends before it starts.");
+        return;
+    }
+
+    FILE *file = fopen(ACTIVITY_REPORT_FILE, "a");
+    if(file == NULL)
+    {
+        printf("Error opening file for writing!\n");
+        return;
+    }
+
+    fprintf(file, "\n");
+
+    // A report too long to read on screen only goes to the file
+    int         echoToConsole = toDay - fromDay + 1 <= MAX_CONSOLE_REPORT_ROWS;
+    ReportSink *sink          = openReportSink(file, echoToConsole);
+    DateCache   dates;
+
+    initDateCache(&dates);
+
+    if(sink != NULL)
+    {
+        int admissions = activityTotal(ACTIVITY_ADMISSIONS, fromDay, toDay);
+        int discharges = activityTotal(ACTIVITY_DISCHARGES, fromDay, toDay);
+
+        sinkPrintf(sink, "   Daily Activity Report - %s", cachedDateText(&dates, dayNumberToTime(fromDay)));
+        sinkPrintf(sink, " to %s\n", cachedDateText(&dates, dayNumberToTime(toDay)));
+        sinkPrintf(sink, "=======================================\n");
+        sinkPrintf(sink, "%-11s| %-9s| %-10s| %s\n", "Date", "Admitted", "Discharged", "Census");
+        sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+        for(int day = fromDay; day <= toDay; day++)
+        {
+            sinkPrintf(sink, "%-11s| %-9d| %-10d| %d\n", cachedDateText(&dates, dayNumberToTime(day)),
+                       activityTotal(ACTIVITY_ADMISSIONS, day, day), activityTotal(ACTIVITY_DISCHARGES, day, day),
+                       censusOn(day));
+        }
+
+        sinkPrintf(sink, "%s", SEPARATOR_LINE);
+        sinkPrintf(sink, "%-11s| %-9d| %-10d| %+d\n", "Total", admissions, discharges, admissions - discharges);
+    }
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing %s\n", ACTIVITY_REPORT_FILE);
+        return;
+    }
+
+    if(!echoToConsole)
+    {
+        printf("The report lists %d days, so it is only written to the file.\n", toDay - fromDay + 1);
+    }
+    printf("\nReport successfully written to %s\n", ACTIVITY_REPORT_FILE);
+}
+
+/*
+ * Reads activity_calendar.dat into memory. Returns 0 if it is missing or
+ * unreadable.
+ */
+static int readCalendarFile(void)
+{
+    resetDays();
+
+    FILE *file = fopen(CALENDAR_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    CalendarHeader header;
+    int            valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, CALENDAR_MAGIC, sizeof(CALENDAR_MAGIC)) == 0 &&
+                header.version == CALENDAR_VERSION && header.dayCount >= 0 && header.coveredRecords >= 0;
+
+    if(valid && header.dayCount > 0)
+    {
+        days  = malloc(header.dayCount * sizeof(DayActivity));
+        valid = days != NULL && fread(days, sizeof(DayActivity), header.dayCount, file) == (size_t) header.dayCount;
+    }
+
+    fclose(file);
+
+    if(!valid)
+    {
+        puts("Error reading activity_calendar.dat. The activity calendar will be rebuilt.");
+        resetDays();
+        return 0;
+    }
+
+    firstDay       = header.firstDay;
+    dayCount       = header.dayCount;
+    coveredRecords = header.coveredRecords;
+    savedFirstDay  = firstDay;
+    savedDayCount  = dayCount;
+    return 1;
+}
+
+/*
+ * Recounts every day from the archive and the census and saves the result.
+ */
+static void rebuildCalendar(void)
+{
+    resetDays();
+
+    if(addArchivedDischarges(0, 1) < 0)
+    {
+        puts("Error: Not enough memory for the activity calendar.");
+        resetDays();
+        return;
+    }
+
+    for(const PatientNode *node = admittedPatients(); node != NULL; node = node->nextNode)
+    {
+        DayActivity *entry = dayAt(toDayNumber(node->data.admissionDate));
+        if(entry == NULL)
+        {
+            puts("Error: Not enough memory for the activity calendar.");
+            resetDays();
+            return;
+        }
+        entry->admissions++;
+    }
+
+    if(dayAt(toDayNumber(time(NULL))) == NULL)
+    {
+        resetDays();
+        return;
+    }
+
+    int census = 0;
+    for(int i = 0; i < dayCount; i++)
+    {
+        census += days[i].admissions - days[i].discharges;
+        days[i].census = census;
+    }
+
+    saveCalendar();
+}
+
+/*
+ * Counts the discharges of the archive records from fromRecord on, and
+ * their admissions too when rebuilding. Returns the number of records
+ * added, or -1 if the archive is shorter than fromRecord or memory ran out.
+ */
+static int addArchivedDischarges(long long fromRecord, int countAdmissions)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return fromRecord == 0 ? 0 : -1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long long recordCount = ftell(file) / (long long) sizeof(DischargedPatient);
+
+    if(recordCount < fromRecord || fseek(file, (long) (fromRecord * sizeof(DischargedPatient)), SEEK_SET) != 0)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    DischargedPatient *chunk = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    int                added = 0;
+    int                ok    = chunk != NULL;
+    size_t             read;
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            DayActivity *discharged = dayAt(toDayNumber(chunk[i].dischargeDate));
+            ok                      = discharged != NULL;
+
+            if(ok)
+            {
+                discharged->discharges++;
+            }
+            if(ok && countAdmissions)
+            {
+                DayActivity *admitted = dayAt(toDayNumber(chunk[i].patient.admissionDate));
+                ok                    = admitted != NULL;
+
+                if(ok)
+                {
+                    admitted->admissions++;
+                }
+            }
+        }
+        added += ok ? (int) read : 0;
+    }
+
+    free(chunk);
+    fclose(file);
+
+    if(!ok)
+    {
+        return -1;
+    }
+    coveredRecords = fromRecord + added;
+    return added;
+}
+
+/*
+ * Returns a day's counts, growing the array at either end to include it.
+ * Returns NULL if memory ran out.
+ */
+static DayActivity *dayAt(int day)
+{
+    if(dayCount == 0)
+    {
+        firstDay = day;
+    }
+
+    if(day >= firstDay && day < firstDay + dayCount)
+    {
+        return &days[day - firstDay];
+    }
+
+    int          newFirst = day < firstDay ? day : firstDay;
+    int          newCount = (day >= firstDay + dayCount ? day + 1 : firstDay + dayCount) - newFirst;
+    int          shift    = firstDay - newFirst;
+    DayActivity *grown    = realloc(days, newCount * sizeof(DayActivity));
+
+    if(grown == NULL)
+    {
+        return NULL;
+    }
+
+    memmove(&grown[shift], grown, dayCount * sizeof(DayActivity));
+    for(int i = 0; i < newCount; i++)
+    {
+        if(i < shift || i >= shift + dayCount)
+        {
+            grown[i] = (DayActivity) { 0, 0, NO_SNAPSHOT };
+        }
+    }
+
+    days     = grown;
+    firstDay = newFirst;
+    dayCount = newCount;
+    return &days[day - firstDay];
+}
+
+/*
+ * Returns a day's count of admitted patients, growing the array at either
+ * end to include it. Returns NULL if memory ran out.
+ */
+static int *admittedAt(int day)
+{
+    if(admittedDayCount == 0)
+    {
+        admittedFirstDay = day;
+    }
+
+    if(day >= admittedFirstDay && day < admittedFirstDay + admittedDayCount)
+    {
+        return &admittedByDay[day - admittedFirstDay];
+    }
+
+    int  newFirst = day < admittedFirstDay ? day : admittedFirstDay;
+    int  newCount = (day >= admittedFirstDay + admittedDayCount ? day + 1 : admittedFirstDay + admittedDayCount) -
+                   newFirst;
+    int  shift    = admittedFirstDay - newFirst;
+    int *grown    = realloc(admittedByDay, newCount * sizeof(int));
+
+    if(grown == NULL)
+    {
+        return NULL;
+    }
+
+    memmove(&grown[shift], grown, admittedDayCount * sizeof(int));
+    memset(grown, 0, shift * sizeof(int));
+    memset(&grown[shift + admittedDayCount], 0, (newCount - shift - admittedDayCount) * sizeof(int));
+
+    admittedByDay    = grown;
+    admittedFirstDay = newFirst;
+    admittedDayCount = newCount;
+    return &admittedByDay[day - admittedFirstDay];
+}
+
+/*
+ * Writes the whole calendar to activity_calendar.tmp and renames it over
+ * activity_calendar.dat.
+ */
+static int saveCalendar(void)
+{
+    FILE *file = fopen(CALENDAR_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating activity_calendar.tmp");
+        return 0;
+    }
+
+    CalendarHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CALENDAR_MAGIC, sizeof(CALENDAR_MAGIC));
+    header.version        = CALENDAR_VERSION;
+    header.firstDay       = firstDay;
+    header.dayCount       = dayCount;
+    header.coveredRecords = coveredRecords;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  (dayCount == 0 || fwrite(days, sizeof(DayActivity), dayCount, file) == (size_t) dayCount) &&
+                  flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing activity_calendar.tmp");
+        remove(CALENDAR_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(CALENDAR_TEMP, CALENDAR_FILE))
+    {
+        perror("Error renaming activity_calendar.tmp to activity_calendar.dat");
+        remove(CALENDAR_TEMP);
+        return 0;
+    }
+
+    savedFirstDay = firstDay;
+    savedDayCount = dayCount;
+    return 1;
+}
+
+/*
+ * Writes the days from fromDay to toDay, and any days added since the last
+ * write, in place with the header. Days added before the first one move
+ * every day, so the whole file is written instead.
+ */
+static void saveDays(int fromDay, int toDay)
+{
+    FILE *file = savedDayCount > 0 && firstDay == savedFirstDay ? fopen(CALENDAR_FILE, "r+b") : NULL;
+    if(file == NULL)
+    {
+        saveCalendar();
+        return;
+    }
+
+    if(dayCount > savedDayCount)
+    {
+        fromDay = fromDay < firstDay + savedDayCount ? fromDay : firstDay + savedDayCount;
+        toDay   = firstDay + dayCount - 1;
+    }
+
+    CalendarHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CALENDAR_MAGIC, sizeof(CALENDAR_MAGIC));
+    header.version        = CALENDAR_VERSION;
+    header.firstDay       = firstDay;
+    header.dayCount       = dayCount;
+    header.coveredRecords = coveredRecords;
+
+    int first   = fromDay - firstDay;
+    int count   = toDay - fromDay + 1;
+    int written = fseek(file, (long) (sizeof(header) + first * sizeof(DayActivity)), SEEK_SET) == 0 &&
+                  fwrite(&days[first], sizeof(DayActivity), count, file) == (size_t) count &&
+                  fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing activity_calendar.dat");
+        return;
+    }
+    savedDayCount = dayCount;
+}
+
+/*
+ * Frees the days so they can be read or rebuilt.
+ */
+static void resetDays(void)
+{
+    free(days);
+    days           = NULL;
+    firstDay       = 0;
+    dayCount       = 0;
+    coveredRecords = 0;
+    savedFirstDay  = 0;
+    savedDayCount  = 0;
+}
+
+/*
+ * Returns the census at the end of a day: the last one stored on or before
+ * it.
+ */
+static int censusOn(int day)
+{
+    for(int i = (day < firstDay + dayCount ? day : firstDay + dayCount - 1) - firstDay; i >= 0; i--)
+    {
+        if(days[i].census != NO_SNAPSHOT)
+        {
+            return days[i].census;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the activity calendar: per-day counts of
+ *          admissions and discharges and the census at the end of each day,
+ *          kept in activity_calendar.dat. Admissions and discharges update
+ *          their day as they happen, so totals over a day, week, month or
+ *          any range are sums of that many day counters rather than scans
+ *          of the census and the archive. The calendar also counts the
+ *          admitted patients by admission day, which is rebuilt in memory
+ *          whenever the census is loaded.
+ */
+
+#ifndef ACTIVITY_CALENDAR_H
+#define ACTIVITY_CALENDAR_H
+
+#include <time.h>
+#include "patient_management.h"
+
+// Counters accepted by activityTotal
+#define ACTIVITY_ADMISSIONS 1
+#define ACTIVITY_DISCHARGES 2
+#define ACTIVITY_STILL_ADMITTED 3
+
+/*
+ * Function: loadActivityCalendar
+ * ------------------------------
+ * Reads activity_calendar.dat and adds any discharges archived since it was
+ * saved, or rebuilds it from the archive and the census if it is missing,
+ * unreadable or ahead of the archive. It is then reconciled with the census:
+ * the count of admitted patients by day is recounted from the admitted
+ * list, any patient's admission the calendar lacks is added, and today's
+ * census is saved. Must run after the census is loaded or restored.
+ */
+void loadActivityCalendar(void);
+
+/*
+ * Function: activityRecordAdmission
+ * ---------------------------------
+ * Counts an admission on its day and saves the day.
+ *
+ * admittedAt: The admission time
+ * census: Number of admitted patients after the admission
+ */
+void activityRecordAdmission(time_t admittedAt, int census);
+
+/*
+ * Function: activityRecordDischarges
+ * ----------------------------------
+ * Counts newly archived discharges on their days and saves those days.
+ *
+ * records: The discharge records, in the order they were archived
+ * firstArchiveRecord: Position of records[0] in discharged_patients.dat
+ * count: Number of records
+ * census: Number of admitted patients after the discharges
+ */
+void activityRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count, int census);
+
+/*
+ * Function: activityTrackAdmitted
+ * -------------------------------
+ * Adds a patient to or removes one from the count of admitted patients by
+ * admission day.
+ *
+ * admittedAt: The patient's admission time
+ * change: 1 when the patient joins the census, -1 when they leave it
+ */
+void activityTrackAdmitted(time_t admittedAt, int change);
+
+/*
+ * Function: activityClearAdmitted
+ * -------------------------------
+ * Empties the count of admitted patients before the census is reloaded.
+ */
+void activityClearAdmitted(void);
+
+/*
+ * Function: activityTotal
+ * -----------------------
+ * Sums one counter over a range of days.
+ *
+ * counter: ACTIVITY_ADMISSIONS, ACTIVITY_DISCHARGES or ACTIVITY_STILL_ADMITTED
+ * firstDay: First day number of the range (see toDayNumber)
+ * lastDay: Last day number of the range, inclusive
+ *
+ * Returns: The total
+ */
+int activityTotal(int counter, int firstDay, int lastDay);
+
+/*
+ * Function: showActivityReport
+ * ----------------------------
+ * Prompts for a date range and lists each day's admissions, discharges and
+ * end-of-day census with the range's totals, appending the report to
+ * activity_reports.txt.
+ */
+void showActivityReport(void);
+
+#endif // ACTIVITY_CALENDAR_H
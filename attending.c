@@ -0,0 +1,1140 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the attending-doctor links.
+ *          An open-addressing table maps each linked patient to their doctor
+ *          and to their position in that doctor's caseload list, so a patient
+ *          is added, moved or removed in constant time (removal swaps the last
+ *          patient of the list into the gap).
+ *
+ *          attending.dat holds every link as of the last compaction and
+ *          attending.log the changes appended since, one record per change.
+ *          The log is folded into attending.dat on start-up once it grows
+ *          large or when stale links were dropped.
+ *
+ *          attending_history.dat gains one record per discharged patient
+ *          who had a doctor, keyed by the stay's record number in the
+ *          discharge archive (patient IDs are reused after a restart, so they
+ *          cannot tell two stays apart). It is loaded into an array indexed
+ *          by record number the first time a past doctor is looked up.
+ *          Histories from before the header was added were keyed by patient
+ *          ID; both files are in discharge order, so they are converted by
+ *          walking them side by side.
+ */
+
+#include "attending.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "doctor_data.h"
+#include "oncall.h"
+#include "patient_data.h"
+#include "patient_management.h"
+#include "schedule_index.h"
+#include "schedule_store.h"
+#include "utils.h"
+
+// Private constants
+#define MIN_LINK_CAPACITY 64
+#define INITIAL_CASELOAD_CAPACITY 8
+#define MAX_ON_DUTY 24
+#define INPUT_LENGTH 32
+#define ARCHIVE_CHUNK 256
+
+static const char   ATTENDING_MAGIC[4]  = { 'A', 'T', 'N', 'D' };
+static const int    ATTENDING_VERSION   = 1;
+static const int    COMPACT_THRESHOLD   = 1024;
+static const int    EMPTY_LINK          = 0;
+static const char  *ATTENDING_FILE      = "attending.dat";
+static const char  *ATTENDING_TEMP      = "attending.tmp";
+static const char  *ATTENDING_LOG       = "attending.log";
+static const char  *HISTORY_FILE        = "attending_history.dat";
+static const char  *HISTORY_TEMP        = "attending_history.tmp";
+static const char   HISTORY_MAGIC[4]    = { 'A', 'T', 'H', 'S' };
+static const int    HISTORY_VERSION     = 1;
+
+/*
+ * One change of attending doctor. A doctorId of NO_ATTENDING_DOCTOR clears the link.
+ */
+typedef struct
+{
+    int patientId;
+    int doctorId;
+} AttendingRecord;
+
+/*
+ * The doctor attending a stay at discharge, by archive record number.
+ */
+typedef struct
+{
+    int archiveRecord;
+    int doctorId;
+} PastAttendingRecord;
+
+/*
+ * Header of attending_history.dat, followed by PastAttendingRecords.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+} HistoryHeader;
+
+/*
+ * Header of attending.dat, followed by count records.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+    int  count;
+} AttendingHeader;
+
+/*
+ * A slot of the link table. position is the patient's index in the
+ * doctor's caseload. A patientId of EMPTY_LINK marks a free slot.
+ */
+typedef struct
+{
+    int patientId;
+    int doctorId;
+    int position;
+} PatientLink;
+
+/*
+ * The current patients of one doctor, in no particular order.
+ */
+typedef struct
+{
+    int  doctorId;
+    int *patientIds;
+    int  count;
+    int  capacity;
+} Caseload;
+
+static PatientLink *links         = NULL;
+static int          linkCapacity  = 0;
+static int          linkCount     = 0;
+static Caseload    *caseloads     = NULL;
+static int          caseloadCount = 0;
+static int          loggedChanges = 0;
+
+// Past doctors by archive record number; NO_ATTENDING_DOCTOR where unknown
+static int *pastDoctors        = NULL;
+static int  pastDoctorCapacity = 0;
+static int  pastLinksLoaded    = 0;
+
+// Function prototypes for internal helper functions
+static int          applyChange(int patientId, int doctorId);
+static int          logChanges(const AttendingRecord records[], int count);
+static int          loadAttendingFile(void);
+static void         loadAttendingLog(void);
+static int          dropStaleLinks(void);
+static int          compactAttending(void);
+static PatientLink *findLink(int patientId);
+static int          insertLink(int patientId, int doctorId, int position);
+static void         deleteLink(int patientId);
+static int          growLinkTable(void);
+static Caseload    *findCaseload(int doctorId, int create);
+static int          caseloadSize(int doctorId);
+static int          compareCaseloads(const void *a, const void *b);
+static int          promptPatientId(void);
+static void         loadPastLinks(void);
+static int          convertLegacyHistory(FILE *file);
+static int          writeHistoryFile(void);
+static int          insertPastLink(long archiveRecord, int doctorId);
+static int          restoreLinksFromHistory(void);
+
+/*
+ * Loads the links, drops any that no longer apply and folds a large log
+ * back into attending.dat.
+ */
+void initializeAttending(void)
+{
+    int hasBase = loadAttendingFile();
+    loadAttendingLog();
+
+    int dropped = dropStaleLinks();
+    if(dropped > 0)
+    {
+        printf("Dropped %d attending-doctor links to discharged patients or removed doctors.\n", dropped);
+    }
+
+    if(dropped > 0 || loggedChanges >= COMPACT_THRESHOLD || (!hasBase && loggedChanges > 0))
+    {
+        compactAttending();
+    }
+}
+
+/*
+ * Suggests the least-loaded doctor working a shift right now, or failing
+ * that the least-loaded doctor on call.
+ */
+int suggestAttendingDoctor(void)
+{
+    ScheduleSlot onDuty[MAX_ON_DUTY];
+    time_t       now       = time(NULL);
+    int          count     = findOnDutySlots(now, onDuty, MAX_ON_DUTY);
+    int          suggested = NO_ATTENDING_DOCTOR;
+
+    for(int i = 0; i < count; i++)
+    {
+        int doctorId = scheduleDoctorAt(onDuty[i].dayNumber, onDuty[i].shiftIndex);
+
+        if(getDoctorWithId(doctorId) != NULL &&
+           (suggested == NO_ATTENDING_DOCTOR || caseloadSize(doctorId) < caseloadSize(suggested)))
+        {
+            suggested = doctorId;
+        }
+    }
+
+    for(int position = 0; suggested == NO_ATTENDING_DOCTOR && position < getDoctorCount(); position++)
+    {
+        int doctorId = getDoctorAt(position)->id;
+
+        if(isDoctorOnCall(doctorId, now, now + 1) &&
+           (suggested == NO_ATTENDING_DOCTOR || caseloadSize(doctorId) < caseloadSize(suggested)))
+        {
+            suggested = doctorId;
+        }
+    }
+
+    return suggested;
+}
+
+/*
+ * Reads a doctor ID, taking Enter as the suggested doctor.
+ */
+int promptAttendingDoctor(void)
+{
+    char input[INPUT_LENGTH];
+    int  suggested = suggestAttendingDoctor();
+
+    while(1)
+    {
+        if(suggested != NO_ATTENDING_DOCTOR)
+        {
+            printf("Enter the attending doctor's ID (Enter for Dr.%s, on duty now; 0 for none):\n",
+                   getDoctorWithId(suggested)->name);
+        }
+        else
+        {
+            printf("Enter the attending doctor's ID (nobody is on duty now; Enter or 0 for none):\n");
+        }
+
+        if(fgets(input, sizeof(input), stdin) == NULL)
+        {
+            return NO_ATTENDING_DOCTOR;
+        }
+
+        int doctorId;
+        if(input[strspn(input, " \t\r\n")] == '\0')
+        {
+            return suggested;
+        }
+        if(sscanf(input, "%d", &doctorId) != SUCCESSFUL_READ)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            continue;
+        }
+        if(doctorId == NO_ATTENDING_DOCTOR || getDoctorWithId(doctorId) != NULL)
+        {
+            return doctorId;
+        }
+        printf("No doctor has ID %d.\n", doctorId);
+    }
+}
+
+/*
+ * Moves a patient to a doctor's caseload and logs the change.
+ */
+int assignAttendingDoctor(int patientId, int doctorId)
+{
+    if(attendingDoctorOf(patientId) == doctorId)
+    {
+        return 1;
+    }
+
+    AttendingRecord record = { patientId, doctorId };
+    return applyChange(patientId, doctorId) && logChanges(&record, 1);
+}
+
+/*
+ * Drops links the restored census no longer has and gives restored
+ * patients back the doctor they had at discharge.
+ */
+void resyncAttendingDoctors(void)
+{
+    int dropped  = dropStaleLinks();
+    int restored = restoreLinksFromHistory();
+
+    if(dropped > 0 || restored > 0)
+    {
+        printf("Attending doctors updated for the restored patients: %d links dropped, %d restored.\n", dropped,
+               restored);
+        compactAttending();
+    }
+}
+
+/*
+ * Appends the discharged patients' links to the history under their
+ * archive record numbers, then clears them with one log write.
+ */
+void releaseAttendingDoctors(const int patientIds[], long firstArchiveRecord, int count)
+{
+    AttendingRecord *records = malloc(count * sizeof(AttendingRecord));
+    if(records == NULL)
+    {
+        puts("Warning: Not enough memory to record the discharged patients' attending doctors.");
+        for(int i = 0; i < count; i++)
+        {
+            assignAttendingDoctor(patientIds[i], NO_ATTENDING_DOCTOR);
+        }
+        return;
+    }
+
+    PastAttendingRecord *history = malloc(count * sizeof(PastAttendingRecord));
+    int                  linked  = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        int doctorId = attendingDoctorOf(patientIds[i]);
+
+        if(doctorId != NO_ATTENDING_DOCTOR)
+        {
+            if(history != NULL)
+            {
+                history[linked] = (PastAttendingRecord) { (int) (firstArchiveRecord + i), doctorId };
+            }
+            records[linked++] = (AttendingRecord) { patientIds[i], doctorId };
+        }
+    }
+
+    if(linked > 0)
+    {
+        // A legacy history is converted first so the new records are not appended to it
+        if(!pastLinksLoaded)
+        {
+            loadPastLinks();
+        }
+
+        FILE *file = fopen(HISTORY_FILE, "ab");
+        int   saved = file != NULL && history != NULL;
+
+        if(saved && ftell(file) == 0)
+        {
+            HistoryHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+            header.version = HISTORY_VERSION;
+            saved          = fwrite(&header, sizeof(header), 1, file) == 1;
+        }
+        saved = saved && fwrite(history, sizeof(PastAttendingRecord), linked, file) == (size_t) linked;
+
+        if(file == NULL || fclose(file) != 0 || !saved)
+        {
+            perror("Error writing attending_history.dat");
+        }
+
+        for(int i = 0; i < linked; i++)
+        {
+            if(history != NULL && !insertPastLink(history[i].archiveRecord, history[i].doctorId))
+            {
+                puts("Warning: Not enough memory to remember a past attending doctor.");
+            }
+
+            applyChange(records[i].patientId, NO_ATTENDING_DOCTOR);
+            records[i].doctorId = NO_ATTENDING_DOCTOR;
+        }
+
+        logChanges(records, linked);
+    }
+
+    free(history);
+    free(records);
+}
+
+/*
+ * Clears every link to a doctor with one log write.
+ */
+int releaseDoctorCaseload(int doctorId)
+{
+    Caseload *caseload = findCaseload(doctorId, 0);
+    if(caseload == NULL || caseload->count == 0)
+    {
+        return 0;
+    }
+
+    int              count   = caseload->count;
+    AttendingRecord *records = malloc(count * sizeof(AttendingRecord));
+
+    for(int i = 0; i < count; i++)
+    {
+        int patientId = caseload->patientIds[i];
+
+        deleteLink(patientId);
+        if(records != NULL)
+        {
+            records[i] = (AttendingRecord) { patientId, NO_ATTENDING_DOCTOR };
+        }
+    }
+    caseload->count = 0;
+
+    if(records == NULL || !logChanges(records, count))
+    {
+        puts("Warning: Unable to save the attending-doctor changes.");
+    }
+
+    free(records);
+    return count;
+}
+
+/*
+ * Looks up a patient's attending doctor in the link table.
+ */
+int attendingDoctorOf(int patientId)
+{
+    const PatientLink *link = findLink(patientId);
+    return link == NULL ? NO_ATTENDING_DOCTOR : link->doctorId;
+}
+
+/*
+ * Looks up a stay in the history array, loading it first if needed.
+ */
+int pastAttendingDoctorOf(long archiveRecord)
+{
+    if(!pastLinksLoaded)
+    {
+        loadPastLinks();
+    }
+
+    if(archiveRecord < 0 || archiveRecord >= pastDoctorCapacity)
+    {
+        return NO_ATTENDING_DOCTOR;
+    }
+    return pastDoctors[archiveRecord];
+}
+
+/*
+ * Lists a doctor's current patients straight from their caseload.
+ */
+void showDoctorCaseload(void)
+{
+    int             doctorId = chooseDoctor();
+    const Caseload *caseload = findCaseload(doctorId, 0);
+    int             count    = caseload == NULL ? 0 : caseload->count;
+
+    printf("Dr.%s has %d current patients.\n", getDoctorWithId(doctorId)->name, count);
+    if(count == 0)
+    {
+        return;
+    }
+
+    printf("%-6s| %-40s| %-6s| %s\n", "ID", "Name", "Room", "Diagnosis");
+    for(int i = 0; i < count; i++)
+    {
+        const Patient *patient = findAdmittedPatient(caseload->patientIds[i]);
+
+        if(patient != NULL)
+        {
+            printf("%-6d| %-40s| %-6d| %s\n", patient->patientId, patient->name, patient->roomNumber,
+                   patient->diagnosis);
+        }
+    }
+}
+
+/*
+ * Prompts for a patient and moves them to another doctor.
+ */
+void changeAttendingDoctor(void)
+{
+    int patientId = promptPatientId();
+    if(patientId == EMPTY_LINK)
+    {
+        return;
+    }
+
+    const Patient *patient = findAdmittedPatient(patientId);
+    int            current = attendingDoctorOf(patientId);
+
+    if(current == NO_ATTENDING_DOCTOR)
+    {
+        printf("%s has no attending doctor.\n", patient->name);
+    }
+    else
+    {
+        printf("%s's attending doctor is Dr.%s.\n", patient->name, getDoctorWithId(current)->name);
+    }
+
+    int doctorId = promptAttendingDoctor();
+    if(!assignAttendingDoctor(patientId, doctorId))
+    {
+        puts("Error saving the attending doctor.");
+    }
+    else if(doctorId == NO_ATTENDING_DOCTOR)
+    {
+        printf("%s no longer has an attending doctor.\n", patient->name);
+    }
+    else
+    {
+        printf("Dr.%s is now attending %s.\n", getDoctorWithId(doctorId)->name, patient->name);
+    }
+}
+
+/*
+ * Sorts the doctors by caseload and prints each against the average.
+ */
+void printCaseloadReport(void)
+{
+    int doctorCount = getDoctorCount();
+    if(doctorCount == 0)
+    {
+        puts("No doctors in the registry.");
+        return;
+    }
+
+    Caseload *sorted = malloc(doctorCount * sizeof(Caseload));
+    if(sorted == NULL)
+    {
+        puts("Error: Not enough memory for the caseload report.");
+        return;
+    }
+
+    for(int position = 0; position < doctorCount; position++)
+    {
+        int doctorId = getDoctorAt(position)->id;
+
+        sorted[position] = (Caseload) { doctorId, NULL, caseloadSize(doctorId), 0 };
+    }
+    qsort(sorted, doctorCount, sizeof(Caseload), compareCaseloads);
+
+    double average = (double) linkCount / doctorCount;
+
+    printf("Caseload Balance (%d patients with an attending doctor, average %.1f per doctor)\n", linkCount, average);
+    printf("%-6s| %-40s| %-9s| %s\n", "ID", "Name", "Patients", "vs Average");
+    for(int i = 0; i < doctorCount; i++)
+    {
+        printf("%-6d| %-40s| %-9d| %+.1f\n", sorted[i].doctorId, getDoctorWithId(sorted[i].doctorId)->name,
+               sorted[i].count, sorted[i].count - average);
+    }
+
+    printf("Spread between the largest and smallest caseload: %d\n",
+           sorted[0].count - sorted[doctorCount - 1].count);
+    free(sorted);
+}
+
+/*
+ * Updates the link table and caseloads for one change, in memory only.
+ */
+static int applyChange(int patientId, int doctorId)
+{
+    PatientLink *link = findLink(patientId);
+
+    if(link != NULL)
+    {
+        Caseload *previous = findCaseload(link->doctorId, 0);
+        int       position = link->position;
+        int       last     = previous->patientIds[--previous->count];
+
+        // Move the last patient of the list into the gap
+        if(last != patientId)
+        {
+            previous->patientIds[position] = last;
+            findLink(last)->position       = position;
+        }
+        deleteLink(patientId);
+    }
+
+    if(doctorId == NO_ATTENDING_DOCTOR)
+    {
+        return 1;
+    }
+
+    Caseload *caseload = findCaseload(doctorId, 1);
+    if(caseload == NULL)
+    {
+        puts("Error: Not enough memory for the doctor's caseload.");
+        return 0;
+    }
+
+    if(caseload->count == caseload->capacity)
+    {
+        int  newCapacity = caseload->capacity == 0 ? INITIAL_CASELOAD_CAPACITY : caseload->capacity * 2;
+        int *grown       = realloc(caseload->patientIds, newCapacity * sizeof(int));
+
+        if(grown == NULL)
+        {
+            puts("Error: Not enough memory for the doctor's caseload.");
+            return 0;
+        }
+
+        caseload->patientIds = grown;
+        caseload->capacity   = newCapacity;
+    }
+
+    if(!insertLink(patientId, doctorId, caseload->count))
+    {
+        puts("Error: Not enough memory for the attending-doctor links.");
+        return 0;
+    }
+
+    caseload->patientIds[caseload->count++] = patientId;
+    return 1;
+}
+
+/*
+ * Appends changes to attending.log in one write.
+ */
+static int logChanges(const AttendingRecord records[], int count)
+{
+    FILE *file  = fopen(ATTENDING_LOG, "ab");
+    int   saved = file != NULL && fwrite(records, sizeof(AttendingRecord), count, file) == (size_t) count;
+
+    if(file == NULL || fclose(file) != 0 || !saved)
+    {
+        perror("Error writing attending.log");
+        return 0;
+    }
+
+    loggedChanges += count;
+    return 1;
+}
+
+/*
+ * Reads attending.dat. Returns 0 if there is no valid file.
+ */
+static int loadAttendingFile(void)
+{
+    FILE *file = fopen(ATTENDING_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    AttendingHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, ATTENDING_MAGIC, sizeof(ATTENDING_MAGIC)) != 0 || header.version != ATTENDING_VERSION)
+    {
+        puts("Error reading attending.dat. Attending doctors will be rebuilt from attending.log.");
+        fclose(file);
+        return 0;
+    }
+
+    AttendingRecord record;
+    for(int i = 0; i < header.count && fread(&record, sizeof(record), 1, file) == 1; i++)
+    {
+        applyChange(record.patientId, record.doctorId);
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/*
+ * Applies the changes appended to attending.log since the last compaction.
+ */
+static void loadAttendingLog(void)
+{
+    FILE *file = fopen(ATTENDING_LOG, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    AttendingRecord record;
+    while(fread(&record, sizeof(AttendingRecord), 1, file) == 1)
+    {
+        applyChange(record.patientId, record.doctorId);
+        loggedChanges++;
+    }
+
+    fclose(file);
+}
+
+/*
+ * Clears links whose patient is no longer admitted or whose doctor has
+ * left the registry. Returns the number cleared.
+ */
+static int dropStaleLinks(void)
+{
+    int dropped = 0;
+
+    for(int i = 0; i < caseloadCount; i++)
+    {
+        Caseload *caseload  = &caseloads[i];
+        int       hasDoctor = getDoctorWithId(caseload->doctorId) != NULL;
+
+        // Walk backwards so the swap-with-last removal never skips a patient
+        for(int position = caseload->count - 1; position >= 0; position--)
+        {
+            int patientId = caseload->patientIds[position];
+
+            if(!hasDoctor || findAdmittedPatient(patientId) == NULL)
+            {
+                applyChange(patientId, NO_ATTENDING_DOCTOR);
+                dropped++;
+            }
+        }
+    }
+
+    return dropped;
+}
+
+/*
+ * Rewrites attending.dat with every current link and empties the log.
+ */
+static int compactAttending(void)
+{
+    FILE *file = fopen(ATTENDING_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating attending.tmp");
+        return 0;
+    }
+
+    AttendingHeader header;
+    memcpy(header.magic, ATTENDING_MAGIC, sizeof(ATTENDING_MAGIC));
+    header.version = ATTENDING_VERSION;
+    header.count   = linkCount;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int i = 0; written && i < caseloadCount; i++)
+    {
+        for(int position = 0; written && position < caseloads[i].count; position++)
+        {
+            AttendingRecord record = { caseloads[i].patientIds[position], caseloads[i].doctorId };
+            written                = fwrite(&record, sizeof(record), 1, file) == 1;
+        }
+    }
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing attending.tmp");
+        remove(ATTENDING_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(ATTENDING_TEMP, ATTENDING_FILE))
+    {
+        perror("Error renaming attending.tmp to attending.dat");
+        return 0;
+    }
+
+    // Every logged change is now in attending.dat
+    remove(ATTENDING_LOG);
+    loggedChanges = 0;
+    return 1;
+}
+
+/*
+ * Returns a patient's slot in the link table, or NULL.
+ */
+static PatientLink *findLink(int patientId)
+{
+    if(links == NULL)
+    {
+        return NULL;
+    }
+
+    int mask = linkCapacity - 1;
+    int slot = (unsigned int) patientId & mask;
+
+    while(links[slot].patientId != EMPTY_LINK)
+    {
+        if(links[slot].patientId == patientId)
+        {
+            return &links[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+/*
+ * Adds a patient to the link table, growing it to stay at most half full.
+ */
+static int insertLink(int patientId, int doctorId, int position)
+{
+    if((linkCount + 1) * 2 > linkCapacity && !growLinkTable())
+    {
+        return 0;
+    }
+
+    int mask = linkCapacity - 1;
+    int slot = (unsigned int) patientId & mask;
+
+    while(links[slot].patientId != EMPTY_LINK)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    links[slot] = (PatientLink) { patientId, doctorId, position };
+    linkCount++;
+    return 1;
+}
+
+/*
+ * Removes a patient from the link table. Entries after the freed slot are
+ * shifted back so probe chains stay unbroken.
+ */
+static void deleteLink(int patientId)
+{
+    PatientLink *link = findLink(patientId);
+    if(link == NULL)
+    {
+        return;
+    }
+
+    int mask = linkCapacity - 1;
+    int slot = (int) (link - links);
+
+    links[slot].patientId = EMPTY_LINK;
+    linkCount--;
+
+    int next = (slot + 1) & mask;
+    while(links[next].patientId != EMPTY_LINK)
+    {
+        int home = (unsigned int) links[next].patientId & mask;
+
+        // Move the entry back if the freed slot lies on its probe path
+        if(((next - home) & mask) >= ((next - slot) & mask))
+        {
+            links[slot]           = links[next];
+            links[next].patientId = EMPTY_LINK;
+            slot                  = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+/*
+ * Doubles the link table and reinserts every link.
+ */
+static int growLinkTable(void)
+{
+    int          newCapacity = linkCapacity == 0 ? MIN_LINK_CAPACITY : linkCapacity * 2;
+    PatientLink *newLinks    = calloc(newCapacity, sizeof(PatientLink));
+
+    if(newLinks == NULL)
+    {
+        return 0;
+    }
+
+    PatientLink *oldLinks    = links;
+    int          oldCapacity = linkCapacity;
+
+    links        = newLinks;
+    linkCapacity = newCapacity;
+    linkCount    = 0;
+
+    for(int slot = 0; slot < oldCapacity; slot++)
+    {
+        if(oldLinks[slot].patientId != EMPTY_LINK)
+        {
+            insertLink(oldLinks[slot].patientId, oldLinks[slot].doctorId, oldLinks[slot].position);
+        }
+    }
+
+    free(oldLinks);
+    return 1;
+}
+
+/*
+ * Returns a doctor's caseload, adding an empty one when create is set.
+ */
+static Caseload *findCaseload(int doctorId, int create)
+{
+    for(int i = 0; i < caseloadCount; i++)
+    {
+        if(caseloads[i].doctorId == doctorId)
+        {
+            return &caseloads[i];
+        }
+    }
+
+    if(!create)
+    {
+        return NULL;
+    }
+
+    Caseload *grown = realloc(caseloads, (caseloadCount + 1) * sizeof(Caseload));
+    if(grown == NULL)
+    {
+        return NULL;
+    }
+
+    caseloads                = grown;
+    caseloads[caseloadCount] = (Caseload) { doctorId, NULL, 0, 0 };
+    return &caseloads[caseloadCount++];
+}
+
+/*
+ * Returns the number of current patients of a doctor.
+ */
+static int caseloadSize(int doctorId)
+{
+    const Caseload *caseload = findCaseload(doctorId, 0);
+    return caseload == NULL ? 0 : caseload->count;
+}
+
+/*
+ * qsort comparison: largest caseload first, then by doctor ID.
+ */
+static int compareCaseloads(const void *a, const void *b)
+{
+    const Caseload *left  = a;
+    const Caseload *right = b;
+
+    if(left->count != right->count)
+    {
+        return right->count - left->count;
+    }
+    return (left->doctorId > right->doctorId) - (left->doctorId < right->doctorId);
+}
+
+/*
+ * Prompts for the ID of an admitted patient. Returns EMPTY_LINK if the
+ * patient is not found.
+ */
+static int promptPatientId(void)
+{
+    int patientId;
+
+    printf("Enter patient ID:\n");
+    if(scanf("%d", &patientId) != SUCCESSFUL_READ)
+    {
+        clearInputBuffer();
+        puts("Invalid input.");
+        return EMPTY_LINK;
+    }
+    clearInputBuffer();
+
+    if(patientId == EMPTY_LINK || findAdmittedPatient(patientId) == NULL)
+    {
+        puts("Patient not found!");
+        return EMPTY_LINK;
+    }
+
+    return patientId;
+}
+
+/*
+ * Reads attending_history.dat into the history array, converting a legacy
+ * file first.
+ */
+static void loadPastLinks(void)
+{
+    pastLinksLoaded = 1;
+
+    FILE *file = fopen(HISTORY_FILE, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    HistoryHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0 || header.version != HISTORY_VERSION)
+    {
+        rewind(file);
+        if(convertLegacyHistory(file))
+        {
+            puts("Converted attending_history.dat to archive record numbers.");
+        }
+        fclose(file);
+        return;
+    }
+
+    PastAttendingRecord record;
+    while(fread(&record, sizeof(PastAttendingRecord), 1, file) == 1)
+    {
+        if(!insertPastLink(record.archiveRecord, record.doctorId))
+        {
+            puts("Warning: Not enough memory to load every past attending doctor.");
+            break;
+        }
+    }
+
+    fclose(file);
+}
+
+/*
+ * Matches a history keyed by patient ID against the archive. Both are in
+ * discharge order and the history only skips patients without a doctor,
+ * so each history record belongs to the next archive record with its
+ * patient ID. Rewrites the file in the new format.
+ */
+static int convertLegacyHistory(FILE *file)
+{
+    FILE *archive = fopen("discharged_patients.dat", "rb");
+    if(archive == NULL)
+    {
+        // With no archive there is no stay to match, so the history starts over
+        return writeHistoryFile();
+    }
+
+    DischargedPatient *chunk       = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    long               recordCount = 0;
+    int                ok          = chunk != NULL;
+    AttendingRecord    legacy;
+    int                pending     = fread(&legacy, sizeof(AttendingRecord), 1, file) == 1;
+    size_t             read;
+
+    while(ok && pending && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, archive)) > 0)
+    {
+        for(size_t i = 0; ok && pending && i < read; i++)
+        {
+            if(chunk[i].patient.patientId == legacy.patientId)
+            {
+                ok      = insertPastLink(recordCount + (long) i, legacy.doctorId);
+                pending = fread(&legacy, sizeof(AttendingRecord), 1, file) == 1;
+            }
+        }
+        recordCount += (long) read;
+    }
+
+    free(chunk);
+    fclose(archive);
+
+    if(!ok)
+    {
+        puts("Warning: Not enough memory to convert attending_history.dat.");
+        return 0;
+    }
+    return writeHistoryFile();
+}
+
+/*
+ * Writes every known past doctor to attending_history.tmp and renames it
+ * over attending_history.dat.
+ */
+static int writeHistoryFile(void)
+{
+    FILE *file = fopen(HISTORY_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating attending_history.tmp");
+        return 0;
+    }
+
+    HistoryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+    header.version = HISTORY_VERSION;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(int record = 0; written && record < pastDoctorCapacity; record++)
+    {
+        if(pastDoctors[record] != NO_ATTENDING_DOCTOR)
+        {
+            PastAttendingRecord entry = { record, pastDoctors[record] };
+            written                   = fwrite(&entry, sizeof(entry), 1, file) == 1;
+        }
+    }
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing attending_history.tmp");
+        remove(HISTORY_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(HISTORY_TEMP, HISTORY_FILE))
+    {
+        perror("Error renaming attending_history.tmp to attending_history.dat");
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Records a stay's past doctor, doubling the history array as needed.
+ */
+static int insertPastLink(long archiveRecord, int doctorId)
+{
+    if(archiveRecord < 0)
+    {
+        return 1;
+    }
+
+    if(archiveRecord >= pastDoctorCapacity)
+    {
+        long newCapacity = pastDoctorCapacity == 0 ? MIN_LINK_CAPACITY : pastDoctorCapacity;
+        while(newCapacity <= archiveRecord)
+        {
+            newCapacity *= 2;
+        }
+
+        int *grown = realloc(pastDoctors, newCapacity * sizeof(int));
+        if(grown == NULL)
+        {
+            return 0;
+        }
+
+        for(long record = pastDoctorCapacity; record < newCapacity; record++)
+        {
+            grown[record] = NO_ATTENDING_DOCTOR;
+        }
+        pastDoctors        = grown;
+        pastDoctorCapacity = (int) newCapacity;
+    }
+
+    pastDoctors[archiveRecord] = doctorId;
+    return 1;
+}
+
+/*
+ * Links each admitted patient who has no doctor to the one they had when
+ * the same stay (same ID and admission time) was discharged, as happens
+ * when a backup from before the discharge is restored. Returns the number
+ * of links restored.
+ */
+static int restoreLinksFromHistory(void)
+{
+    int unlinked = 0;
+    for(const PatientNode *node = admittedPatients(); node != NULL; node = node->nextNode)
+    {
+        unlinked += attendingDoctorOf(node->data.patientId) == NO_ATTENDING_DOCTOR;
+    }
+
+    FILE *archive = unlinked > 0 ? fopen("discharged_patients.dat", "rb") : NULL;
+    if(archive == NULL)
+    {
+        return 0;
+    }
+
+    if(!pastLinksLoaded)
+    {
+        loadPastLinks();
+    }
+
+    DischargedPatient *chunk       = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    long               recordCount = 0;
+    int                restored    = 0;
+    size_t             read;
+
+    while(chunk != NULL && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, archive)) > 0)
+    {
+        for(size_t i = 0; i < read; i++)
+        {
+            const Patient *patient  = findAdmittedPatient(chunk[i].patient.patientId);
+            int            doctorId = pastAttendingDoctorOf(recordCount + (long) i);
+
+            if(patient != NULL && doctorId != NO_ATTENDING_DOCTOR &&
+               patient->admissionDate == chunk[i].patient.admissionDate &&
+               attendingDoctorOf(patient->patientId) == NO_ATTENDING_DOCTOR && getDoctorWithId(doctorId) != NULL &&
+               applyChange(patient->patientId, doctorId))
+            {
+                restored++;
+            }
+        }
+        recordCount += (long) read;
+    }
+
+    free(chunk);
+    fclose(archive);
+    return restored;
+}
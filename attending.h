@@ -0,0 +1,137 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the attending-doctor links between admitted
+ *          patients and the doctor registry. Each doctor's caseload is kept
+ *          as a list that is updated on every admission, discharge and
+ *          reassignment, so a doctor's patients and the caseload report cost
+ *          time in proportion to their output. The links are kept in
+ *          attending.dat beside patients.dat, whose format is unchanged, and
+ *          the doctor of each discharged patient in attending_history.dat.
+ */
+
+#ifndef ATTENDING_H
+#define ATTENDING_H
+
+// Returned when a patient has no attending doctor
+#define NO_ATTENDING_DOCTOR 0
+
+/*
+ * Function: initializeAttending
+ * -----------------------------
+ * Loads the attending-doctor links. Links to patients who are no longer
+ * admitted or doctors no longer in the registry are dropped. Call after the
+ * patient system and the doctor registry are loaded.
+ */
+void initializeAttending(void);
+
+/*
+ * Function: suggestAttendingDoctor
+ * --------------------------------
+ * Picks the doctor to suggest for a new admission: of the doctors on duty
+ * right now, the one with the fewest current patients.
+ *
+ * Returns: The doctor's ID, or NO_ATTENDING_DOCTOR if nobody is on duty
+ */
+int suggestAttendingDoctor(void);
+
+/*
+ * Function: promptAttendingDoctor
+ * -------------------------------
+ * Asks for the attending doctor of a new admission, offering the suggested
+ * doctor as the default.
+ *
+ * Returns: The chosen doctor's ID, or NO_ATTENDING_DOCTOR for none
+ */
+int promptAttendingDoctor(void);
+
+/*
+ * Function: assignAttendingDoctor
+ * -------------------------------
+ * Makes a doctor the attending doctor of an admitted patient, moving the
+ * patient out of any previous doctor's caseload.
+ *
+ * patientId: The admitted patient
+ * doctorId: The doctor, or NO_ATTENDING_DOCTOR to clear the link
+ *
+ * Returns: 1 if the link was saved, 0 otherwise
+ */
+int assignAttendingDoctor(int patientId, int doctorId);
+
+/*
+ * Function: releaseAttendingDoctors
+ * ---------------------------------
+ * Removes discharged patients from their doctors' caseloads, recording each
+ * patient's last attending doctor in attending_history.dat.
+ *
+ * patientIds: The discharged patients, in the order they were archived
+ * firstArchiveRecord: Position of the first patient's record in discharged_patients.dat
+ * count: Number of patients
+ */
+void releaseAttendingDoctors(const int patientIds[], long firstArchiveRecord, int count);
+
+/*
+ * Function: resyncAttendingDoctors
+ * --------------------------------
+ * Brings the links in line with a census restored from backup: links to
+ * patients no longer admitted are dropped, and restored patients who were
+ * discharged since the backup get back the doctor they had then.
+ */
+void resyncAttendingDoctors(void);
+
+/*
+ * Function: releaseDoctorCaseload
+ * -------------------------------
+ * Clears the attending doctor of every patient of a doctor (used when the
+ * doctor is removed).
+ *
+ * doctorId: The doctor whose caseload is cleared
+ *
+ * Returns: The number of patients left without an attending doctor
+ */
+int releaseDoctorCaseload(int doctorId);
+
+/*
+ * Function: attendingDoctorOf
+ * ---------------------------
+ * patientId: An admitted patient
+ *
+ * Returns: The patient's attending doctor, or NO_ATTENDING_DOCTOR
+ */
+int attendingDoctorOf(int patientId);
+
+/*
+ * Function: pastAttendingDoctorOf
+ * -------------------------------
+ * Looks up the doctor who was attending a stay at discharge. The history
+ * is read from attending_history.dat on the first call.
+ *
+ * archiveRecord: The stay's record number in discharged_patients.dat
+ *
+ * Returns: The doctor's ID, or NO_ATTENDING_DOCTOR
+ */
+int pastAttendingDoctorOf(long archiveRecord);
+
+/*
+ * Function: showDoctorCaseload
+ * ----------------------------
+ * Prompts for a doctor and lists their current patients.
+ */
+void showDoctorCaseload(void);
+
+/*
+ * Function: changeAttendingDoctor
+ * -------------------------------
+ * Prompts for an admitted patient and a new attending doctor.
+ */
+void changeAttendingDoctor(void);
+
+/*
+ * Function: printCaseloadReport
+ * -----------------------------
+ * Lists every doctor's caseload from largest to smallest with each
+ * doctor's difference from the average.
+ */
+void printCaseloadReport(void);
+
+#endif // ATTENDING_H
@@ -0,0 +1,770 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the diagnosis inverted index. Terms live in an
+ *          open-addressing hash table; each term owns a posting list of keys
+ *          kept in increasing order and stored as variable-length byte deltas,
+ *          which usually takes one byte per key.
+ *
+ *          A removed key is not cut out of the encoded bytes straight away;
+ *          it goes into the list's small sorted array of removed keys, which
+ *          decoding skips. The list is only re-encoded without them once they
+ *          make up a quarter of it, so each removal costs a binary search
+ *          rather than a pass over the whole list.
+ */
+
+#include "diagnosis_index.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+// Private constants
+#define MAX_TERM_LENGTH 64
+#define INITIAL_TABLE_CAPACITY 256
+#define INITIAL_LIST_CAPACITY 16
+#define VARINT_MAX_BYTES 5
+#define MIN_REMOVED_CAPACITY 4
+#define COMPACT_RATIO 4
+
+static const int   NO_KEY        = -1;
+static const char *OR_KEYWORD    = "or";
+static const char *AND_KEYWORD   = "and";
+
+/*
+ * Posting list of one term: the sorted keys of every record mentioning it,
+ * encoded as the first key followed by the gaps between consecutive keys.
+ * count includes the keys listed in removed, which are still encoded.
+ */
+typedef struct
+{
+    char          *term;
+    unsigned char *bytes;
+    int            length;
+    int            capacity;
+    int            count;
+    int            lastKey;
+    int           *removed;
+    int            removedCount;
+    int            removedCapacity;
+} PostingList;
+
+struct DiagnosisIndex
+{
+    PostingList *slots;
+    int          capacity;
+    int          used;
+};
+
+/*
+ * Callback invoked once per term found by tokenizeDiagnosis.
+ */
+typedef int (*TermHandler)(const char *term, void *context);
+
+/*
+ * State shared with the add/remove term handlers.
+ */
+typedef struct
+{
+    DiagnosisIndex *index;
+    int             key;
+} TermUpdate;
+
+/*
+ * Terms of a parsed query, collected by the query term handler.
+ */
+typedef struct
+{
+    char terms[MAX_DIAGNOSIS_QUERY_TERMS][MAX_TERM_LENGTH];
+    int  termCount;
+} QueryTerms;
+
+// Function prototypes for internal helper functions
+static int          tokenizeDiagnosis(const char *text, TermHandler handler, void *context);
+static PostingList *findList(const DiagnosisIndex *index, const char *term);
+static PostingList *findOrAddList(DiagnosisIndex *index, const char *term);
+static int          growTable(DiagnosisIndex *index);
+static int          appendVarint(PostingList *list, unsigned int value);
+static int          decodeList(const PostingList *list, int keys[]);
+static int          encodeList(PostingList *list, const int keys[], int count);
+static int          findRemoved(const PostingList *list, int key, int *position);
+static int          compactList(PostingList *list);
+static int          addTermHandler(const char *term, void *context);
+static int          removeTermHandler(const char *term, void *context);
+static int          queryTermHandler(const char *term, void *context);
+static int          evaluateGroup(const DiagnosisIndex *index, char terms[][MAX_TERM_LENGTH], int termCount, int **keys);
+static int          mergeUnion(int **result, int resultCount, int *group, int groupCount);
+
+/*
+ * Allocates an empty diagnosis index.
+ */
+DiagnosisIndex *createDiagnosisIndex(void)
+{
+    DiagnosisIndex *index = malloc(sizeof(DiagnosisIndex));
+    if(index == NULL)
+    {
+        return NULL;
+    }
+
+    index->slots = calloc(INITIAL_TABLE_CAPACITY, sizeof(PostingList));
+    if(index->slots == NULL)
+    {
+        free(index);
+        return NULL;
+    }
+
+    index->capacity = INITIAL_TABLE_CAPACITY;
+    index->used     = 0;
+    return index;
+}
+
+/*
+ * Frees the index and every posting list it owns.
+ */
+void destroyDiagnosisIndex(DiagnosisIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    clearDiagnosisIndex(index);
+    free(index->slots);
+    free(index);
+}
+
+/*
+ * Removes every term while keeping the index usable.
+ */
+void clearDiagnosisIndex(DiagnosisIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    for(int i = 0; i < index->capacity; i++)
+    {
+        free(index->slots[i].term);
+        free(index->slots[i].bytes);
+        free(index->slots[i].removed);
+    }
+
+    memset(index->slots, 0, index->capacity * sizeof(PostingList));
+    index->used = 0;
+}
+
+/*
+ * Tokenizes a diagnosis and adds the key to the posting list of every term.
+ */
+int diagnosisIndexAdd(DiagnosisIndex *index, const char *diagnosis, int key)
+{
+    TermUpdate update = { index, key };
+    return tokenizeDiagnosis(diagnosis, addTermHandler, &update);
+}
+
+/*
+ * Removes the key from the posting list of every term of a diagnosis.
+ */
+void diagnosisIndexRemove(DiagnosisIndex *index, const char *diagnosis, int key)
+{
+    TermUpdate update = { index, key };
+    tokenizeDiagnosis(diagnosis, removeTermHandler, &update);
+}
+
+/*
+ * Evaluates a keyword query as an OR of AND-groups and returns the matching
+ * keys in increasing order.
+ */
+int diagnosisIndexSearch(const DiagnosisIndex *index, const char *query, int **keys)
+{
+    QueryTerms parsed;
+    int       *result      = NULL;
+    int        resultCount = 0;
+    int        groupStart  = 0;
+
+    parsed.termCount = 0;
+    if(!tokenizeDiagnosis(query, queryTermHandler, &parsed))
+    {
+        *keys = NULL;
+        return DIAGNOSIS_QUERY_TOO_LONG;
+    }
+
+    for(int i = 0; i <= parsed.termCount; i++)
+    {
+        if(i < parsed.termCount && strcmp(parsed.terms[i], OR_KEYWORD) != 0)
+        {
+            continue;
+        }
+
+        // terms[groupStart .. i) form one AND-group
+        if(i > groupStart)
+        {
+            int *group      = NULL;
+            int  groupCount = evaluateGroup(index, &parsed.terms[groupStart], i - groupStart, &group);
+
+            if(groupCount < 0)
+            {
+                free(result);
+                return DIAGNOSIS_QUERY_OUT_OF_MEMORY;
+            }
+
+            resultCount = mergeUnion(&result, resultCount, group, groupCount);
+            if(resultCount < 0)
+            {
+                return DIAGNOSIS_QUERY_OUT_OF_MEMORY;
+            }
+        }
+
+        groupStart = i + 1;
+    }
+
+    *keys = result;
+    return resultCount;
+}
+
+/*
+ * Splits text into lowercase alphabetic terms and passes each to the handler.
+ * Stops early and returns 0 if the handler fails.
+ */
+static int tokenizeDiagnosis(const char *text, TermHandler handler, void *context)
+{
+    char term[MAX_TERM_LENGTH];
+    int  length = 0;
+
+    for(int i = 0;; i++)
+    {
+        unsigned char character = (unsigned char) text[i];
+
+        if(isalpha(character))
+        {
+            if(length < MAX_TERM_LENGTH - 1)
+            {
+                term[length++] = (char) tolower(character);
+            }
+            continue;
+        }
+
+        if(length > 0)
+        {
+            term[length] = '\0';
+            length       = 0;
+
+            if(!handler(term, context))
+            {
+                return 0;
+            }
+        }
+
+        if(character == '\0')
+        {
+            return 1;
+        }
+    }
+}
+
+/*
+ * Returns the posting list of a term, or NULL if the term was never indexed.
+ */
+static PostingList *findList(const DiagnosisIndex *index, const char *term)
+{
+    unsigned int mask = index->capacity - 1;
+    unsigned int slot = hashString(FNV_OFFSET_BASIS, term) & mask;
+
+    while(index->slots[slot].term != NULL)
+    {
+        if(strcmp(index->slots[slot].term, term) == 0)
+        {
+            return &index->slots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns the posting list of a term, creating an empty one if needed.
+ */
+static PostingList *findOrAddList(DiagnosisIndex *index, const char *term)
+{
+    PostingList *list = findList(index, term);
+    if(list != NULL)
+    {
+        return list;
+    }
+
+    if((index->used + 1) * 10 > index->capacity * 7 && !growTable(index))
+    {
+        return NULL;
+    }
+
+    unsigned int mask = index->capacity - 1;
+    unsigned int slot = hashString(FNV_OFFSET_BASIS, term) & mask;
+
+    while(index->slots[slot].term != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    list       = &index->slots[slot];
+    list->term = malloc(strlen(term) + 1);
+    if(list->term == NULL)
+    {
+        return NULL;
+    }
+
+    strcpy(list->term, term);
+    list->bytes           = NULL;
+    list->length          = 0;
+    list->capacity        = 0;
+    list->count           = 0;
+    list->lastKey         = NO_KEY;
+    list->removed         = NULL;
+    list->removedCount    = 0;
+    list->removedCapacity = 0;
+    index->used++;
+    return list;
+}
+
+/*
+ * Doubles the term table, moving every posting list to its new slot.
+ */
+static int growTable(DiagnosisIndex *index)
+{
+    int          newCapacity = index->capacity * 2;
+    PostingList *newSlots    = calloc(newCapacity, sizeof(PostingList));
+
+    if(newSlots == NULL)
+    {
+        return 0;
+    }
+
+    for(int i = 0; i < index->capacity; i++)
+    {
+        if(index->slots[i].term == NULL)
+        {
+            continue;
+        }
+
+        unsigned int slot = hashString(FNV_OFFSET_BASIS, index->slots[i].term) & (newCapacity - 1);
+        while(newSlots[slot].term != NULL)
+        {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newSlots[slot] = index->slots[i];
+    }
+
+    free(index->slots);
+    index->slots    = newSlots;
+    index->capacity = newCapacity;
+    return 1;
+}
+
+/*
+ * Appends a value to a posting list using 7 bits per byte, with the high bit
+ * marking that more bytes follow.
+ */
+static int appendVarint(PostingList *list, unsigned int value)
+{
+    if(list->length + VARINT_MAX_BYTES > list->capacity)
+    {
+        int            newCapacity = list->capacity == 0 ? INITIAL_LIST_CAPACITY : list->capacity * 2;
+        unsigned char *newBytes    = realloc(list->bytes, newCapacity);
+
+        if(newBytes == NULL)
+        {
+            return 0;
+        }
+
+        list->bytes    = newBytes;
+        list->capacity = newCapacity;
+    }
+
+    while(value >= 0x80)
+    {
+        list->bytes[list->length++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    list->bytes[list->length++] = (unsigned char) value;
+    return 1;
+}
+
+/*
+ * Decodes the live keys of a posting list into keys[], which must hold
+ * list->count entries, skipping removed keys. Returns the number decoded.
+ */
+static int decodeList(const PostingList *list, int keys[])
+{
+    int position = 0;
+    int key      = 0;
+    int removed  = 0;
+    int live     = 0;
+
+    for(int i = 0; i < list->count; i++)
+    {
+        unsigned int value = 0;
+        int          shift = 0;
+        unsigned char byte;
+
+        do
+        {
+            byte = list->bytes[position++];
+            value |= (unsigned int) (byte & 0x7F) << shift;
+            shift += 7;
+        }
+        while(byte & 0x80);
+
+        key = (i == 0) ? (int) value : key + (int) value;
+
+        // Both are sorted, so the removed keys are passed in step
+        while(removed < list->removedCount && list->removed[removed] < key)
+        {
+            removed++;
+        }
+        if(removed < list->removedCount && list->removed[removed] == key)
+        {
+            continue;
+        }
+        keys[live++] = key;
+    }
+
+    return live;
+}
+
+/*
+ * Replaces the contents of a posting list with the given sorted keys,
+ * which drops every removed key.
+ */
+static int encodeList(PostingList *list, const int keys[], int count)
+{
+    list->length       = 0;
+    list->count        = 0;
+    list->lastKey      = NO_KEY;
+    list->removedCount = 0;
+
+    for(int i = 0; i < count; i++)
+    {
+        unsigned int gap = (i == 0) ? (unsigned int) keys[i] : (unsigned int) (keys[i] - keys[i - 1]);
+
+        if(!appendVarint(list, gap))
+        {
+            return 0;
+        }
+
+        list->count++;
+        list->lastKey = keys[i];
+    }
+
+    return 1;
+}
+
+/*
+ * Binary search of a list's removed keys. Returns 1 if the key is there;
+ * position receives its index or the index it would be inserted at.
+ */
+static int findRemoved(const PostingList *list, int key, int *position)
+{
+    int low  = 0;
+    int high = list->removedCount;
+
+    while(low < high)
+    {
+        int middle = low + (high - low) / 2;
+
+        if(list->removed[middle] < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *position = low;
+    return low < list->removedCount && list->removed[low] == key;
+}
+
+/*
+ * Re-encodes a posting list without its removed keys.
+ */
+static int compactList(PostingList *list)
+{
+    int *keys = malloc(list->count * sizeof(int));
+    if(keys == NULL)
+    {
+        return 0;
+    }
+
+    int count  = decodeList(list, keys);
+    int result = encodeList(list, keys, count);
+
+    free(keys);
+    return result;
+}
+
+/*
+ * Adds the update's key to one term's posting list. A key removed but not
+ * yet compacted away is simply revived; increasing keys are appended
+ * directly; an out-of-order key re-encodes the list.
+ */
+static int addTermHandler(const char *term, void *context)
+{
+    TermUpdate  *update = context;
+    PostingList *list   = findOrAddList(update->index, term);
+    int          position;
+
+    if(list == NULL)
+    {
+        return 0;
+    }
+
+    if(list->removedCount > 0 && findRemoved(list, update->key, &position))
+    {
+        memmove(&list->removed[position], &list->removed[position + 1],
+                (list->removedCount - position - 1) * sizeof(int));
+        list->removedCount--;
+        return 1;
+    }
+
+    if(update->key == list->lastKey)
+    {
+        return 1; // Term repeated within the same diagnosis
+    }
+
+    if(update->key > list->lastKey)
+    {
+        unsigned int gap = (list->count == 0) ? (unsigned int) update->key
+                                              : (unsigned int) (update->key - list->lastKey);
+        if(!appendVarint(list, gap))
+        {
+            return 0;
+        }
+
+        list->count++;
+        list->lastKey = update->key;
+        return 1;
+    }
+
+    int *keys = malloc((list->count + 1) * sizeof(int));
+    if(keys == NULL)
+    {
+        return 0;
+    }
+
+    int count = decodeList(list, keys);
+    position  = count;
+
+    while(position > 0 && keys[position - 1] > update->key)
+    {
+        position--;
+    }
+
+    if(position > 0 && keys[position - 1] == update->key)
+    {
+        free(keys);
+        return 1;
+    }
+
+    memmove(&keys[position + 1], &keys[position], (count - position) * sizeof(int));
+    keys[position] = update->key;
+
+    int result = encodeList(list, keys, count + 1);
+    free(keys);
+    return result;
+}
+
+/*
+ * Marks the update's key removed from one term's posting list, compacting
+ * the list once a quarter of its keys are removed. Keys above the last one
+ * were never added, so they are ignored.
+ */
+static int removeTermHandler(const char *term, void *context)
+{
+    TermUpdate  *update = context;
+    PostingList *list   = findList(update->index, term);
+    int          position;
+
+    if(list == NULL || list->count == 0 || update->key > list->lastKey || findRemoved(list, update->key, &position))
+    {
+        return 1; // Absent, or a term repeated within the same diagnosis
+    }
+
+    if(list->removedCount == list->removedCapacity)
+    {
+        int  newCapacity = list->removedCapacity == 0 ? MIN_REMOVED_CAPACITY : list->removedCapacity * 2;
+        int *grown       = realloc(list->removed, newCapacity * sizeof(int));
+
+        if(grown == NULL)
+        {
+            return 0;
+        }
+
+        list->removed         = grown;
+        list->removedCapacity = newCapacity;
+    }
+
+    memmove(&list->removed[position + 1], &list->removed[position], (list->removedCount - position) * sizeof(int));
+    list->removed[position] = update->key;
+    list->removedCount++;
+
+    if(list->removedCount * COMPACT_RATIO >= list->count)
+    {
+        return compactList(list);
+    }
+    return 1;
+}
+
+/*
+ * Collects one query term, skipping the optional "and" keyword.
+ */
+static int queryTermHandler(const char *term, void *context)
+{
+    QueryTerms *parsed = context;
+
+    if(strcmp(term, AND_KEYWORD) == 0)
+    {
+        return 1;
+    }
+
+    if(parsed->termCount == MAX_DIAGNOSIS_QUERY_TERMS)
+    {
+        return 0; // Rejected rather than silently dropping terms
+    }
+
+    strcpy(parsed->terms[parsed->termCount++], term);
+    return 1;
+}
+
+/*
+ * Intersects the posting lists of an AND-group, starting from the shortest
+ * list so the working set only ever shrinks.
+ */
+static int evaluateGroup(const DiagnosisIndex *index, char terms[][MAX_TERM_LENGTH], int termCount, int **keys)
+{
+    const PostingList *lists[MAX_DIAGNOSIS_QUERY_TERMS];
+    int                shortest = 0;
+
+    *keys = NULL;
+
+    for(int i = 0; i < termCount; i++)
+    {
+        lists[i] = findList(index, terms[i]);
+
+        if(lists[i] == NULL || lists[i]->count == 0)
+        {
+            return 0;
+        }
+
+        if(lists[i]->count < lists[shortest]->count)
+        {
+            shortest = i;
+        }
+    }
+
+    int *result = malloc(lists[shortest]->count * sizeof(int));
+    int *other  = NULL;
+
+    if(result == NULL)
+    {
+        return -1;
+    }
+
+    int count = decodeList(lists[shortest], result);
+
+    for(int i = 0; i < termCount && count > 0; i++)
+    {
+        if(i == shortest || lists[i] == lists[shortest])
+        {
+            continue;
+        }
+
+        int *grown = realloc(other, lists[i]->count * sizeof(int));
+        if(grown == NULL)
+        {
+            free(other);
+            free(result);
+            return -1;
+        }
+        other = grown;
+
+        int otherCount = decodeList(lists[i], other);
+        int kept       = 0;
+        int j          = 0;
+
+        for(int k = 0; k < count; k++)
+        {
+            while(j < otherCount && other[j] < result[k])
+            {
+                j++;
+            }
+
+            if(j < otherCount && other[j] == result[k])
+            {
+                result[kept++] = result[k];
+            }
+        }
+
+        count = kept;
+    }
+
+    free(other);
+    *keys = result;
+    return count;
+}
+
+/*
+ * Merges a sorted group of keys into the sorted running result, dropping
+ * duplicates. Frees the group and returns the new result size.
+ */
+static int mergeUnion(int **result, int resultCount, int *group, int groupCount)
+{
+    if(groupCount == 0)
+    {
+        free(group);
+        return resultCount;
+    }
+
+    if(resultCount == 0)
+    {
+        free(*result);
+        *result = group;
+        return groupCount;
+    }
+
+    int *merged = malloc((resultCount + groupCount) * sizeof(int));
+    if(merged == NULL)
+    {
+        free(group);
+        free(*result);
+        *result = NULL;
+        return -1;
+    }
+
+    int i     = 0;
+    int j     = 0;
+    int count = 0;
+
+    while(i < resultCount || j < groupCount)
+    {
+        if(j == groupCount || (i < resultCount && (*result)[i] < group[j]))
+        {
+            merged[count++] = (*result)[i++];
+        }
+        else if(i == resultCount || group[j] < (*result)[i])
+        {
+            merged[count++] = group[j++];
+        }
+        else
+        {
+            merged[count++] = (*result)[i++];
+            j++;
+        }
+    }
+
+    free(group);
+    free(*result);
+    *result = merged;
+    return count;
+}
@@ -0,0 +1,99 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines an inverted index from diagnosis keywords to the
+ *          records whose diagnosis mentions them. Posting lists are stored
+ *          sorted and delta-encoded, so keyword queries never have to scan the
+ *          diagnosis text of every record.
+ */
+
+#ifndef DIAGNOSIS_INDEX_H
+#define DIAGNOSIS_INDEX_H
+
+/*
+ * Opaque handle to a diagnosis index. Each record is identified by an integer
+ * key chosen by the owner (a patient ID or an archive record number).
+ */
+typedef struct DiagnosisIndex DiagnosisIndex;
+
+// Longest query accepted by diagnosisIndexSearch, counted in words
+#define MAX_DIAGNOSIS_QUERY_TERMS 32
+
+// Error results of diagnosisIndexSearch
+#define DIAGNOSIS_QUERY_OUT_OF_MEMORY -1
+#define DIAGNOSIS_QUERY_TOO_LONG      -2
+
+/*
+ * Function: createDiagnosisIndex
+ * ------------------------------
+ * Allocates an empty diagnosis index.
+ *
+ * Returns: The new index, or NULL if memory could not be allocated
+ */
+DiagnosisIndex *createDiagnosisIndex(void);
+
+/*
+ * Function: destroyDiagnosisIndex
+ * -------------------------------
+ * Frees the index and every posting list it owns.
+ *
+ * index: The index to free (may be NULL)
+ */
+void destroyDiagnosisIndex(DiagnosisIndex *index);
+
+/*
+ * Function: clearDiagnosisIndex
+ * -----------------------------
+ * Removes every term while keeping the index usable.
+ *
+ * index: The index to empty
+ */
+void clearDiagnosisIndex(DiagnosisIndex *index);
+
+/*
+ * Function: diagnosisIndexAdd
+ * ---------------------------
+ * Tokenizes a diagnosis and adds the key to the posting list of every term.
+ * Keys added in increasing order are appended in constant time.
+ *
+ * index: The index to update
+ * diagnosis: The diagnosis text
+ * key: The owner's key for the record
+ *
+ * Returns: 1 on success, 0 if memory could not be allocated
+ */
+int diagnosisIndexAdd(DiagnosisIndex *index, const char *diagnosis, int key);
+
+/*
+ * Function: diagnosisIndexRemove
+ * ------------------------------
+ * Removes the key from the posting list of every term of a diagnosis. The
+ * key is only marked removed; a list is compacted once enough of its keys
+ * are, so a removal does not re-encode the whole list.
+ *
+ * index: The index to update
+ * diagnosis: The diagnosis text the key was added with (it must have been
+ *            added, since a later add of the same key revives the mark)
+ * key: The owner's key for the record
+ */
+void diagnosisIndexRemove(DiagnosisIndex *index, const char *diagnosis, int key);
+
+/*
+ * Function: diagnosisIndexSearch
+ * ------------------------------
+ * Evaluates a keyword query. Words are ANDed together; the word "or" separates
+ * alternatives, so "fracture and wrist or pneumonia" matches records
+ * mentioning both fracture and wrist, or mentioning pneumonia.
+ *
+ * index: The index to search
+ * query: The keyword query
+ * keys: Receives a malloc'd array of matching keys in increasing order
+ *       (NULL when there are no matches); the caller frees it
+ *
+ * Returns: The number of matching keys, DIAGNOSIS_QUERY_TOO_LONG if the query
+ *          has more than MAX_DIAGNOSIS_QUERY_TERMS words (nothing is searched),
+ *          or DIAGNOSIS_QUERY_OUT_OF_MEMORY if memory ran out
+ */
+int diagnosisIndexSearch(const DiagnosisIndex *index, const char *query, int **keys);
+
+#endif // DIAGNOSIS_INDEX_H
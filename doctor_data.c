@@ -2,52 +2,100 @@
  * Author: Arsh M, Nathan O
  * Date: Feb 12, 2025
  * Purpose: This file contains the implementation of the doctor management system.
+ *          doctors.dat holds a small header followed by one Doctor record per
+ *          doctor. In memory the doctors sit in a growable array; an open
+ *          addressing table maps IDs to array positions and a name index
+ *          maps names to IDs.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include "attending.h"
 #include "doctor_data.h"
+#include "doctor_schedule.h"
+#include "name_index.h"
+#include "oncall.h"
 #include "utils.h"
 
-// Doctor ages
+// Ages of the seeded doctors
 #define RAYMOND_AGE 44
 #define GEORGE_AGE 67
 #define SOFIA_AGE 33
 
-#define DOCTOR_COUNT 3
+#define SEED_DOCTOR_COUNT 3
+#define RESULTS_PER_PAGE 10
 
 // Private constants
-static const int INVALID_INPUT = -1;
-static const int MIN_INDEX     = 0;
-
-/* Pre-defined array of available doctors in the system */
-static Doctor doctors[DOCTOR_COUNT];
+static const int   INVALID_INPUT      = -1;
+static const int   SEARCH_BY_NAME     = 0;
+static const int   EMPTY_SLOT         = -1;
+static const int   MIN_TABLE_CAPACITY = 16;
+static const int   MIN_DOCTOR_AGE     = 18;
+static const int   MAX_DOCTOR_AGE     = 120;
+static const char  DOCTORS_MAGIC[4]   = { 'D', 'O', 'C', 'S' };
+static const int   DOCTORS_VERSION    = 1;
+static const char *DOCTORS_FILE       = "doctors.dat";
+static const char *DOCTORS_TEMP       = "doctors.tmp";
 
 /*
- * Initializes the doctor database with predefined doctors.
+ * Header at the start of doctors.dat, followed by count Doctor records.
  */
-void initializeDoctors(void)
+typedef struct
 {
-    doctors[0] = (Doctor) { RAYMOND_ID, "Raymond Redington", RAYMOND_AGE };
-    doctors[1] = (Doctor) { GEORGE_ID, "George Washington", GEORGE_AGE };
-    doctors[2] = (Doctor) { SOFIA_ID, "Sofia Gomez", SOFIA_AGE };
-}
+    char magic[4];
+    int  version;
+    int  count;
+    int  nextId;
+} DoctorFileHeader;
+
+/* Registry of doctors, in no particular order */
+static Doctor    *doctors        = NULL;
+static int        doctorCount    = 0;
+static int        doctorCapacity = 0;
+static int        nextDoctorId   = 1;
+
+/* ID -> position in doctors[], open addressing with linear probing */
+static int       *idTable         = NULL;
+static int        idTableCapacity = 0;
+
+/* Name -> ID */
+static NameIndex *doctorNameIndex = NULL;
+
+// Function prototypes for internal helper functions
+static void seedDoctors(void);
+static int  loadDoctorsFile(void);
+static int  saveDoctorsFile(void);
+static int  appendDoctor(Doctor doctor);
+static int  findDoctorPosition(int doctorId);
+static int  findIdSlot(int doctorId);
+static int  rebuildIdTable(int capacity);
+static void removeIdSlot(int slot);
+static int  hashDoctorId(int doctorId);
+static int  doctorExists(int doctorId);
+static int  promptDoctorName(char name[]);
+static int  promptDoctorAge(void);
+static int  pickDoctorByName(void);
+static void printDoctorRow(const Doctor *doctor);
 
 /*
- * Validates if a given doctor ID exists in the system.
- * Returns the ID if valid, INVALID_INPUT otherwise.
+ * Loads the registry from doctors.dat, seeding it the first time.
  */
-static int doctorExists(const int doctorId)
+void initializeDoctors(void)
 {
-    for(int i = 0; i < DOCTOR_COUNT; i++)
+    doctorNameIndex = createNameIndex();
+    if(doctorNameIndex == NULL || !rebuildIdTable(MIN_TABLE_CAPACITY))
     {
-        if(doctors[i].id == doctorId)
-        {
-            return doctorId;
-        }
+        puts("Error: Not enough memory for the doctor registry.");
+        return;
     }
 
-    return INVALID_INPUT;
+    if(!loadDoctorsFile())
+    {
+        seedDoctors();
+        saveDoctorsFile();
+    }
 }
 
 /*
@@ -56,14 +104,24 @@ static int doctorExists(const int doctorId)
  */
 const Doctor *getDoctorWithId(const int doctorId)
 {
-    for(int i = 0; i < DOCTOR_COUNT; i++)
-    {
-        if(doctors[i].id == doctorId)
-        {
-            return &doctors[i];
-        }
-    }
-    return NULL;
+    int position = findDoctorPosition(doctorId);
+    return position == EMPTY_SLOT ? NULL : &doctors[position];
+}
+
+/*
+ * Returns the number of doctors in the registry.
+ */
+int getDoctorCount(void)
+{
+    return doctorCount;
+}
+
+/*
+ * Returns the doctor at a registry position, or NULL.
+ */
+const Doctor *getDoctorAt(int position)
+{
+    return (position >= 0 && position < doctorCount) ? &doctors[position] : NULL;
 }
 
 /*
@@ -76,7 +134,7 @@ int chooseDoctor(void)
 
     do
     {
-        printf("Enter Doctor Id: ");
+        printf("Enter Doctor Id (0 to search by name): ");
 
         if(scanf("%d", &doctorId) != SUCCESSFUL_READ)
         {
@@ -84,8 +142,18 @@ int chooseDoctor(void)
             clearInputBuffer();
             doctorId = INVALID_INPUT;
         }
+        else if(doctorId == SEARCH_BY_NAME)
+        {
+            clearInputBuffer();
+            doctorId = pickDoctorByName();
+            if(doctorId != INVALID_INPUT)
+            {
+                printf("Selected Dr.%s.\n", getDoctorWithId(doctorId)->name);
+            }
+        }
         else
         {
+            clearInputBuffer();
             doctorId = doctorExists(doctorId);
         }
     }
@@ -93,3 +161,528 @@ int chooseDoctor(void)
 
     return doctorId;
 }
+
+/*
+ * Prompts for a new doctor's details and adds them to the registry.
+ */
+void addDoctor(void)
+{
+    Doctor doctor;
+
+    if(!promptDoctorName(doctor.name))
+    {
+        return;
+    }
+    doctor.age = promptDoctorAge();
+    doctor.id  = nextDoctorId;
+
+    if(!appendDoctor(doctor))
+    {
+        puts("Error: Not enough memory to add the doctor.");
+        return;
+    }
+
+    nextDoctorId++;
+    saveDoctorsFile();
+    printf("Dr.%s added with ID %d.\n", doctor.name, doctor.id);
+}
+
+/*
+ * Prompts for a doctor and replaces their name and age.
+ */
+void updateDoctor(void)
+{
+    if(doctorCount == 0)
+    {
+        puts("There are no doctors in the registry.");
+        return;
+    }
+
+    int    doctorId = chooseDoctor();
+    Doctor updated  = *getDoctorWithId(doctorId);
+
+    if(!promptDoctorName(updated.name))
+    {
+        return;
+    }
+    updated.age = promptDoctorAge();
+
+    Doctor *doctor = &doctors[findDoctorPosition(doctorId)];
+
+    nameIndexRemove(doctorNameIndex, doctor->name, doctorId);
+    *doctor = updated;
+    if(!nameIndexInsert(doctorNameIndex, doctor->name, doctorId))
+    {
+        puts("Warning: Unable to add doctor to the name index.");
+    }
+
+    saveDoctorsFile();
+    printf("Doctor %d updated.\n", doctorId);
+}
+
+/*
+ * Removes a doctor. The last doctor in the array moves into the freed
+ * position so the array stays packed.
+ */
+void removeDoctor(void)
+{
+    if(doctorCount == 0)
+    {
+        puts("There are no doctors in the registry.");
+        return;
+    }
+
+    int  doctorId = chooseDoctor();
+    char confirm;
+
+    printf("Remove Dr.%s? Their shifts will become unassigned. (y/n)\n", getDoctorWithId(doctorId)->name);
+    scanf(" %c", &confirm);
+    clearInputBuffer();
+
+    if(confirm != YES)
+    {
+        puts("Doctor not removed.");
+        return;
+    }
+
+    int  slot     = findIdSlot(doctorId);
+    int  position = idTable[slot];
+    int  last     = doctorCount - 1;
+    char name[NAME_LENGTH];
+
+    strcpy(name, doctors[position].name);
+    nameIndexRemove(doctorNameIndex, name, doctorId);
+    removeIdSlot(slot);
+
+    if(position != last)
+    {
+        doctors[position]                         = doctors[last];
+        idTable[findIdSlot(doctors[position].id)] = position;
+    }
+    doctorCount--;
+
+    saveDoctorsFile();
+
+    int unassigned = unassignDoctorShifts(doctorId);
+    printf("Dr.%s removed. %d shifts are now unassigned.\n", name, unassigned);
+
+    int onCallBlocks = removeDoctorOnCall(doctorId);
+    if(onCallBlocks > 0)
+    {
+        printf("%d on-call blocks were removed.\n", onCallBlocks);
+    }
+
+    int patients = releaseDoctorCaseload(doctorId);
+    if(patients > 0)
+    {
+        printf("%d patients no longer have an attending doctor.\n", patients);
+    }
+}
+
+/*
+ * Lists every doctor in name order, one page at a time.
+ */
+void listDoctors(void)
+{
+    int keys[RESULTS_PER_PAGE];
+    int total  = 0;
+    int offset = 0;
+
+    if(doctorCount == 0)
+    {
+        puts("There are no doctors in the registry.");
+        return;
+    }
+
+    printf("%-6s | %-40s | %s\n", "ID", "Name", "Age");
+    printf("-------|------------------------------------------|-----\n");
+
+    do
+    {
+        int count = nameIndexSearch(doctorNameIndex, "", NAME_MATCH_PREFIX, offset, RESULTS_PER_PAGE, keys, &total);
+
+        for(int i = 0; i < count; i++)
+        {
+            printDoctorRow(getDoctorWithId(keys[i]));
+        }
+        offset += count;
+
+        if(offset >= total || count == 0)
+        {
+            break;
+        }
+
+        printf("Enter n for the next page, or anything else to stop:\n");
+        char next = getchar();
+        if(next != '\n')
+        {
+            clearInputBuffer();
+        }
+        if(next != 'n' && next != 'N')
+        {
+            break;
+        }
+    }
+    while(1);
+
+    printf("Doctors in registry: %d\n", doctorCount);
+}
+
+/*
+ * Prompts for a name prefix and lists the matching doctors.
+ */
+void searchDoctorsByName(void)
+{
+    pickDoctorByName();
+}
+
+/*
+ * Adds the three doctors the system originally shipped with.
+ */
+static void seedDoctors(void)
+{
+    const Doctor seeds[SEED_DOCTOR_COUNT] = {
+        { RAYMOND_ID, "Raymond Redington", RAYMOND_AGE },
+        { GEORGE_ID, "George Washington", GEORGE_AGE },
+        { SOFIA_ID, "Sofia Gomez", SOFIA_AGE },
+    };
+
+    for(int i = 0; i < SEED_DOCTOR_COUNT; i++)
+    {
+        appendDoctor(seeds[i]);
+        if(seeds[i].id >= nextDoctorId)
+        {
+            nextDoctorId = seeds[i].id + 1;
+        }
+    }
+}
+
+/*
+ * Reads doctors.dat into the registry. Returns 0 if the file is missing or invalid.
+ */
+static int loadDoctorsFile(void)
+{
+    FILE *file = fopen(DOCTORS_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    DoctorFileHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, DOCTORS_MAGIC, sizeof(DOCTORS_MAGIC)) != 0 || header.version != DOCTORS_VERSION ||
+       header.count < 0)
+    {
+        puts("Error reading doctors.dat. Using the default doctors.");
+        fclose(file);
+        return 0;
+    }
+
+    Doctor doctor;
+    nextDoctorId = header.nextId;
+
+    for(int i = 0; i < header.count && fread(&doctor, sizeof(doctor), 1, file) == 1; i++)
+    {
+        doctor.name[NAME_LENGTH - 1] = '\0';
+
+        if(findDoctorPosition(doctor.id) != EMPTY_SLOT)
+        {
+            printf("Warning: Skipping duplicate doctor ID %d in doctors.dat.\n", doctor.id);
+            continue;
+        }
+        if(!appendDoctor(doctor))
+        {
+            puts("Error: Not enough memory to load every doctor.");
+            break;
+        }
+        if(doctor.id >= nextDoctorId)
+        {
+            nextDoctorId = doctor.id + 1;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/*
+ * Writes the registry to a temporary file and renames it over doctors.dat.
+ */
+static int saveDoctorsFile(void)
+{
+    FILE *file = fopen(DOCTORS_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating doctors.tmp");
+        return 0;
+    }
+
+    DoctorFileHeader header;
+    memcpy(header.magic, DOCTORS_MAGIC, sizeof(DOCTORS_MAGIC));
+    header.version = DOCTORS_VERSION;
+    header.count   = doctorCount;
+    header.nextId  = nextDoctorId;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(doctors, sizeof(Doctor), doctorCount, file) == (size_t) doctorCount;
+
+    written = written && flushToDisk(file);
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing doctors.tmp");
+        remove(DOCTORS_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(DOCTORS_TEMP, DOCTORS_FILE))
+    {
+        perror("Error renaming doctors.tmp to doctors.dat");
+        remove(DOCTORS_TEMP);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Adds a doctor to the array, the ID table and the name index.
+ */
+static int appendDoctor(Doctor doctor)
+{
+    if(doctorCount == doctorCapacity)
+    {
+        int     newCapacity = doctorCapacity == 0 ? MIN_TABLE_CAPACITY : doctorCapacity * 2;
+        Doctor *grown       = realloc(doctors, newCapacity * sizeof(Doctor));
+
+        if(grown == NULL)
+        {
+            return 0;
+        }
+
+        doctors        = grown;
+        doctorCapacity = newCapacity;
+    }
+
+    // Keep the ID table at most half full
+    if(2 * (doctorCount + 1) > idTableCapacity && !rebuildIdTable(idTableCapacity * 2))
+    {
+        return 0;
+    }
+
+    doctors[doctorCount]           = doctor;
+    idTable[findIdSlot(doctor.id)] = doctorCount;
+    doctorCount++;
+
+    if(!nameIndexInsert(doctorNameIndex, doctor.name, doctor.id))
+    {
+        puts("Warning: Unable to add doctor to the name index.");
+    }
+
+    return 1;
+}
+
+/*
+ * Returns the array position of a doctor, or EMPTY_SLOT.
+ */
+static int findDoctorPosition(int doctorId)
+{
+    if(idTable == NULL)
+    {
+        return EMPTY_SLOT;
+    }
+    return idTable[findIdSlot(doctorId)];
+}
+
+/*
+ * Returns the table slot holding the ID, or the empty slot where it would go.
+ */
+static int findIdSlot(int doctorId)
+{
+    int mask = idTableCapacity - 1;
+    int slot = hashDoctorId(doctorId) & mask;
+
+    while(idTable[slot] != EMPTY_SLOT && doctors[idTable[slot]].id != doctorId)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/*
+ * Reallocates the ID table at the given capacity and reinserts every doctor.
+ */
+static int rebuildIdTable(int capacity)
+{
+    int *table = malloc(capacity * sizeof(int));
+    if(table == NULL)
+    {
+        return 0;
+    }
+
+    free(idTable);
+    idTable         = table;
+    idTableCapacity = capacity;
+
+    for(int slot = 0; slot < capacity; slot++)
+    {
+        idTable[slot] = EMPTY_SLOT;
+    }
+
+    for(int position = 0; position < doctorCount; position++)
+    {
+        idTable[findIdSlot(doctors[position].id)] = position;
+    }
+
+    return 1;
+}
+
+/*
+ * Empties a table slot, shifting later entries back so probe chains stay unbroken.
+ */
+static void removeIdSlot(int slot)
+{
+    int mask = idTableCapacity - 1;
+
+    idTable[slot] = EMPTY_SLOT;
+
+    int next = (slot + 1) & mask;
+    while(idTable[next] != EMPTY_SLOT)
+    {
+        int home = hashDoctorId(doctors[idTable[next]].id) & mask;
+
+        // Move the entry back if the hole lies between its home slot and its current slot
+        if(((next - home) & mask) >= ((next - slot) & mask))
+        {
+            idTable[slot] = idTable[next];
+            idTable[next] = EMPTY_SLOT;
+            slot          = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+/*
+ * Spreads doctor IDs (often multiples of 10) across the table.
+ */
+static int hashDoctorId(int doctorId)
+{
+    return (int) (((unsigned int) doctorId * 2654435761u) >> 8);
+}
+
+/*
+ * Validates if a given doctor ID exists in the system.
+ * Returns the ID if valid, INVALID_INPUT otherwise.
+ */
+static int doctorExists(const int doctorId)
+{
+    if(findDoctorPosition(doctorId) != EMPTY_SLOT)
+    {
+        return doctorId;
+    }
+
+    printf("No doctor with ID %d.\n", doctorId);
+    return INVALID_INPUT;
+}
+
+/*
+ * Reads a doctor's name. Returns 0 if it is empty or has no letters.
+ */
+static int promptDoctorName(char name[])
+{
+    printf("Enter Doctor Name:\n");
+    if(fgets(name, NAME_LENGTH, stdin) == NULL)
+    {
+        return 0;
+    }
+
+    if(strchr(name, '\n') == NULL)
+    {
+        clearInputBuffer();
+    }
+    name[strcspn(name, "\n")] = '\0';
+
+    for(const char *c = name; *c != '\0'; c++)
+    {
+        if(isalpha((unsigned char) *c))
+        {
+            return 1;
+        }
+    }
+
+    puts("Invalid doctor name.");
+    return 0;
+}
+
+/*
+ * Reads a doctor's age, asking again until it is in range.
+ */
+static int promptDoctorAge(void)
+{
+    int age;
+
+    while(1)
+    {
+        printf("Enter Doctor Age:\n");
+        if(scanf("%d", &age) != SUCCESSFUL_READ)
+        {
+            printf("Invalid Input.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+
+        if(age >= MIN_DOCTOR_AGE && age <= MAX_DOCTOR_AGE)
+        {
+            return age;
+        }
+        printf("Age must be between %d and %d.\n", MIN_DOCTOR_AGE, MAX_DOCTOR_AGE);
+    }
+}
+
+/*
+ * Lists the doctors whose names start with the entered text. If exactly
+ * one matches, returns their ID; otherwise returns INVALID_INPUT.
+ */
+static int pickDoctorByName(void)
+{
+    char query[NAME_LENGTH];
+    int  keys[RESULTS_PER_PAGE];
+    int  total = 0;
+
+    printf("Enter Doctor Name (or the start of it):\n");
+    if(fgets(query, sizeof(query), stdin) == NULL)
+    {
+        return INVALID_INPUT;
+    }
+    query[strcspn(query, "\n")] = '\0';
+
+    int count = nameIndexSearch(doctorNameIndex, query, NAME_MATCH_PREFIX, 0, RESULTS_PER_PAGE, keys, &total);
+
+    if(total == 0)
+    {
+        puts("No doctors match that name.");
+        return INVALID_INPUT;
+    }
+
+    printf("%-6s | %-40s | %s\n", "ID", "Name", "Age");
+    printf("-------|------------------------------------------|-----\n");
+    for(int i = 0; i < count; i++)
+    {
+        printDoctorRow(getDoctorWithId(keys[i]));
+    }
+    if(total > count)
+    {
+        printf("... and %d more. Enter more of the name to narrow the search.\n", total - count);
+    }
+
+    return total == 1 ? keys[0] : INVALID_INPUT;
+}
+
+/*
+ * Prints one doctor as a table row.
+ */
+static void printDoctorRow(const Doctor *doctor)
+{
+    printf("%-6d | %-40s | %d\n", doctor->id, doctor->name, doctor->age);
+}
@@ -3,6 +3,9 @@
  * Date: Feb 12, 2025
  * Purpose: This file contains the definition of the doctor management system.
  *          It provides functionality for managing doctor information.
+ *          Doctors are kept in doctors.dat and looked up through an ID hash
+ *          table and a name index, so the registry can hold any number of
+ *          physicians.
  */
 
 #ifndef DOCTOR_MANAGEMENT_H
@@ -10,7 +13,7 @@
 
 #define NAME_LENGTH 100
 
-// Doctor IDs
+// IDs of the doctors the registry is seeded with
 #define RAYMOND_ID 10
 #define GEORGE_ID 20
 #define SOFIA_ID 30
@@ -31,13 +34,31 @@ typedef struct
  * ----------------------------
  * Retrieves a pointer to a doctor with the specified ID.
  * Returns NULL if no matching doctor is found.
+ * The pointer is only valid until the registry is next changed.
  */
 const Doctor *getDoctorWithId(int doctorId);
 
+/*
+ * Function: getDoctorCount
+ * ----------------------------
+ * Returns: The number of doctors in the registry
+ */
+int getDoctorCount(void);
+
+/*
+ * Function: getDoctorAt
+ * ----------------------------
+ * Retrieves the doctor at a position in the registry, for iterating over
+ * every doctor (positions 0 to getDoctorCount() - 1, in no particular order).
+ * Returns NULL if the position is out of range.
+ */
+const Doctor *getDoctorAt(int position);
+
 /*
  * Function: chooseDoctor
  * ----------------------------
  * Prompts for and validates a doctor ID selection.
+ * Entering 0 searches the registry by name first.
  * Returns the selected doctor ID.
  */
 int chooseDoctor(void);
@@ -45,8 +66,45 @@ int chooseDoctor(void);
 /*
  * Function: initializeDoctors
  * ----------------------------
- * Initializes the doctor database with predefined doctors.
+ * Loads the doctor registry from doctors.dat. If the file does not exist,
+ * the registry is seeded with the original three doctors.
  */
 void initializeDoctors(void);
 
+/*
+ * Function: addDoctor
+ * ----------------------------
+ * Prompts for a name and age and adds a new doctor with the next free ID.
+ */
+void addDoctor(void);
+
+/*
+ * Function: updateDoctor
+ * ----------------------------
+ * Prompts for a doctor and changes their name and age.
+ */
+void updateDoctor(void);
+
+/*
+ * Function: removeDoctor
+ * ----------------------------
+ * Prompts for a doctor, removes them from the registry and unassigns
+ * their scheduled shifts.
+ */
+void removeDoctor(void);
+
+/*
+ * Function: listDoctors
+ * ----------------------------
+ * Displays every doctor in the registry in name order.
+ */
+void listDoctors(void);
+
+/*
+ * Function: searchDoctorsByName
+ * ----------------------------
+ * Prompts for a name or the start of one and lists matching doctors.
+ */
+void searchDoctorsByName(void);
+
 #endif // DOCTOR_MANAGEMENT_H
@@ -7,130 +7,105 @@
 #include "doctor_schedule.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "doctor_data.h"
+#include "oncall.h"
+#include "report_sink.h"
+#include "schedule_index.h"
+#include "schedule_store.h"
 #include "utils.h"
 
 #define DAYS_IN_WEEK 7
-#define TIMES_OF_DAY 3
-
-#define NO_DOCTOR 0
+#define MAX_ON_DUTY 24
+#define MAX_LISTED_GAPS 500
 
 // Private constants
-static const int INVALID_INPUT = -1;
-static const int UNASSIGNED_ID = 0;
-static const int MIN_INDEX     = 0;
-
-/* Weekly schedule matrix organized by day and time slot */
-static Doctor weeklyDoctorSchedule[DAYS_IN_WEEK][TIMES_OF_DAY];
+static const int INVALID_INPUT      = -1;
+static const int MIN_INDEX          = 0;
+static const int MINUTES_PER_HOUR   = 60;
+static const int SECONDS_PER_MINUTE = 60;
+static const int DAYS_IN_QUARTER    = 91;
 
-/* Array of day names for display purposes */
+/* Array of day names for display purposes, starting on Monday */
 static const char *daysOfWeek[] = { "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday" };
 
-/* Array of time slot names for display purposes */
-static const char *timesOfDay[] = { "Morning", "Afternoon", "Evening" };
-
 /* Function prototypes for internal helper functions */
-static int chooseDay(void);
-static int chooseTime(void);
-static int dayExists(int);
-static int timeExists(int);
-static void writeScheduleToFile(void);
-static void updateScheduleFile(void);
+static int  chooseDay(void);
+static int  chooseTime(void);
+static int  timeExists(int);
+static int  chooseWeek(const char *prompt);
+static void formatDay(int dayNumber, char dateStr[], size_t size);
+static void printSlot(const ScheduleSlot *slot);
+static void shiftPeriod(int dayNumber, int shiftIndex, time_t *start, time_t *end);
+static int  checkWeekOnCall(int fromWeek, int toWeek);
 
 /*
- * Initializes the weekly schedule from file or with default values
+ * Opens the calendar schedule, converting or creating schedule.dat as needed.
  */
 void initializeSchedule(void)
 {
-    FILE *pSchedule = fopen("schedule.dat", "rb");
-
-    if(pSchedule != NULL)
+    if(openScheduleStore())
     {
-        size_t read = fread(weeklyDoctorSchedule, sizeof(Doctor), 
-                           DAYS_IN_WEEK * TIMES_OF_DAY, pSchedule);
-
-        if(read != DAYS_IN_WEEK * TIMES_OF_DAY)
-        {
-            fclose(pSchedule);
-            puts("\nError reading from schedule.dat. Initializing with default settings.");
-            initializeScheduleDefault();
-            return;
-        }
-
-        fclose(pSchedule);
         puts("\nSchedule successfully loaded from file.");
     }
     else
     {
         puts("\nUnable to read schedule.dat. Schedule initialized with default settings.");
-        initializeScheduleDefault();
     }
 }
 
 /*
- * Initializes the schedule with empty slots
+ * Replaces the schedule with an empty one.
  */
 void initializeScheduleDefault(void)
 {
-    for(int day = 0; day < DAYS_IN_WEEK; day++)
-    {
-        for(int time = 0; time < TIMES_OF_DAY; time++)
-        {
-            weeklyDoctorSchedule[day][time] = (Doctor) { UNASSIGNED_ID, "", 0 };
-        }
-    }
-    
-    // Create initial schedule file
-    writeScheduleToFile();
-}
-
-/*
- * Updates the schedule file with current assignments
- */
-static void writeScheduleToFile(void)
-{
-    FILE *pSchedule = fopen("schedule.dat", "wb");
-    
-    if(pSchedule == NULL)
-    {
-        puts("\nUnable to create schedule.dat.");
-        return;
-    }
-
-    size_t written = fwrite(weeklyDoctorSchedule, sizeof(Doctor), 
-                           DAYS_IN_WEEK * TIMES_OF_DAY, pSchedule);
-    
-    if(written == DAYS_IN_WEEK * TIMES_OF_DAY)
-    {
-        puts("\nSchedule successfully saved to file.");
-    }
-    else
-    {
-        puts("\nError saving schedule to file.");
-    }
-    
-    fclose(pSchedule);
+    closeScheduleStore();
+    remove("schedule.dat");
+    openScheduleStore();
 }
 
 /*
- * Handles the process of assigning a doctor to a specific time slot.
- * Prompts for doctor, day, and time selection. Handles conflicts with
+ * Handles the process of assigning a doctor to a specific date and shift.
+ * Prompts for doctor, date, and shift selection. Handles conflicts with
  * existing assignments by asking for confirmation before overwriting.
  */
 void assignDoctor(void)
 {
     char proceed = YES;
+    char dateStr[20];
+
+    const int     doctorId   = chooseDoctor();
+    const int     dayNumber  = chooseDay();
+    const int     shiftIndex = chooseTime();
+    const Doctor *doctor     = getDoctorWithId(doctorId);
+
+    formatDay(dayNumber, dateStr, sizeof(dateStr));
+    printf("Assigning Dr.%s for %s %s %s.\n", doctor->name, daysOfWeek[dayOfWeek(dayNumber)], dateStr,
+           scheduleShift(shiftIndex)->name);
+
+    time_t shiftStart, shiftEnd;
+    shiftPeriod(dayNumber, shiftIndex, &shiftStart, &shiftEnd);
 
-    const int     doctorId  = chooseDoctor();
-    const int     dayIndex  = chooseDay();
-    const int     timeIndex = chooseTime();
-    const Doctor *doctor    = getDoctorWithId(doctorId);
+    const int onCall    = isDoctorOnCall(doctorId, shiftStart, shiftEnd);
+    const int shortRest = !onCall && isDoctorOnCallNear(doctorId, shiftStart, shiftEnd);
 
-    printf("Assigning Dr.%s for %s %s.\n", doctor->name, daysOfWeek[dayIndex], timesOfDay[timeIndex]);
+    if(onCall)
+    {
+        printf("Dr.%s is on call during this shift.\n", doctor->name);
+    }
+    else if(shortRest)
+    {
+        printf("Dr.%s would have less than %d hours of rest next to an on-call block.\n", doctor->name,
+               ONCALL_MIN_REST_HOURS);
+    }
 
-    if(weeklyDoctorSchedule[dayIndex][timeIndex].id != UNASSIGNED_ID)
+    if(scheduleDoctorAt(dayNumber, shiftIndex) != NO_DOCTOR_ASSIGNED || onCall || shortRest)
     {
-        printf("Another Doctor Already Assigned. Would You Like To Proceed? (y / n)\n");
+        if(scheduleDoctorAt(dayNumber, shiftIndex) != NO_DOCTOR_ASSIGNED)
+        {
+            printf("Another Doctor Already Assigned. ");
+        }
+        printf("Would You Like To Proceed? (y / n)\n");
 
         do
         {
@@ -142,90 +117,219 @@ void assignDoctor(void)
 
     if(proceed == YES)
     {
-        weeklyDoctorSchedule[dayIndex][timeIndex] = *doctor;
-        writeScheduleToFile();  // Update file after assignment
+        if(scheduleAssign(dayNumber, shiftIndex, doctorId))
+        {
+            puts("\nSchedule successfully saved to file.");
+        }
+        else
+        {
+            puts("\nError saving schedule to file.");
+        }
     }
 }
 
 /*
- * Displays the complete weekly schedule showing all assignments.
- * Lists each day and time slot with either the assigned doctor's name
+ * Displays the schedule for one calendar week (Monday to Sunday).
+ * Lists each day and shift with either the assigned doctor's name
  * or indicates if the slot is unassigned.
  */
 void printFullSchedule(void)
 {
+    int weekStart = chooseWeek("Enter a date in the week to show (YYYY-MM-DD, Enter for this week):\n");
+
     for(int dayIndex = 0; dayIndex < DAYS_IN_WEEK; dayIndex++)
     {
-        printf("---%s---\n", daysOfWeek[dayIndex]);
+        char dateStr[20];
+
+        formatDay(weekStart + dayIndex, dateStr, sizeof(dateStr));
+        printf("---%s %s---\n", daysOfWeek[dayIndex], dateStr);
         printf("%-20sAssigned Doctor\n", "Time Of Day");
 
-        for(int timeIndex = 0; timeIndex < TIMES_OF_DAY; timeIndex++)
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
         {
-            printf("%-20s", timesOfDay[timeIndex]);
-            if(strlen(weeklyDoctorSchedule[dayIndex][timeIndex].name) == NO_DOCTOR)
+            // Names come from the registry so renamed doctors show their current name
+            const Doctor *doctor = getDoctorWithId(scheduleDoctorAt(weekStart + dayIndex, shiftIndex));
+
+            printf("%-20s", scheduleShift(shiftIndex)->name);
+            if(doctor == NULL)
             {
                 printf("Unassigned!\n");
             }
             else
             {
-                printf("%s\n", weeklyDoctorSchedule[dayIndex][timeIndex].name);
+                printf("%s\n", doctor->name);
             }
         }
     }
 }
 
 /*
- * Prompts for and validates a day selection.
- * Displays numbered options and continues until valid input is received.
+ * Copies one week's assignments onto another. Unassigned slots in the source
+ * week clear the matching target slots, so the target ends up identical.
+ * The copy is refused if it would put a doctor on a shift overlapping one of
+ * their on-call blocks, and needs confirmation if it leaves a short rest.
  */
-static int chooseDay(void)
+void copyScheduleWeek(void)
 {
-    int dayIndex;
+    char fromStr[20];
+    char toStr[20];
 
-    do
+    const int fromWeek = chooseWeek("Enter a date in the week to copy (YYYY-MM-DD, Enter for this week):\n");
+    const int toWeek   = chooseWeek("Enter a date in the week to fill (YYYY-MM-DD, Enter for this week):\n");
+
+    if(fromWeek == toWeek)
     {
-        printf("Choose A Day:\n"
-               "0: Monday\n"
-               "1: Tuesday\n"
-               "2: Wednesday\n"
-               "3: Thursday\n"
-               "4: Friday\n"
-               "5: Saturday\n"
-               "6: Sunday\n");
-
-        if(scanf(" %d", &dayIndex) != SUCCESSFUL_READ)
-        {
-            printf("Invalid Input.\n");
-            clearInputBuffer();
-            dayIndex = INVALID_INPUT;
-        }
-        else
+        puts("The source and target weeks are the same.");
+        return;
+    }
+
+    if(!checkWeekOnCall(fromWeek, toWeek))
+    {
+        puts("Week not copied.");
+        return;
+    }
+
+    scheduleBeginBatch();
+    for(int dayIndex = 0; dayIndex < DAYS_IN_WEEK; dayIndex++)
+    {
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
         {
-            dayIndex = dayExists(dayIndex);
+            int doctorId = scheduleDoctorAt(fromWeek + dayIndex, shiftIndex);
+
+            if(getDoctorWithId(doctorId) == NULL)
+            {
+                doctorId = NO_DOCTOR_ASSIGNED;
+            }
+
+            if(!scheduleBatchAssign(toWeek + dayIndex, shiftIndex, doctorId))
+            {
+                scheduleCancelBatch();
+                puts("\nError saving schedule to file.");
+                return;
+            }
         }
     }
-    while(dayIndex == INVALID_INPUT);
 
-    return dayIndex;
+    formatDay(fromWeek, fromStr, sizeof(fromStr));
+    formatDay(toWeek, toStr, sizeof(toStr));
+
+    if(scheduleCommitBatch() == DAYS_IN_WEEK * scheduleShiftCount())
+    {
+        printf("\nCopied the week of %s to the week of %s.\n", fromStr, toStr);
+    }
+    else
+    {
+        puts("\nError saving schedule to file.");
+    }
 }
 
 /*
- * Validates if a given day index is within valid range.
- * Returns the index if valid, INVALID_INPUT otherwise.
+ * Lists the shifts running at a chosen moment and the doctor on each.
  */
-static int dayExists(const int dayIndex)
+void showDoctorsOnDuty(void)
 {
-    if(MIN_INDEX <= dayIndex && dayIndex < DAYS_IN_WEEK)
+    ScheduleSlot onDuty[MAX_ON_DUTY];
+
+    time_t when  = promptDateTime("Enter a date and time (YYYY-MM-DD HH:MM, Enter for now):\n", time(NULL));
+    int    count = findOnDutySlots(when, onDuty, MAX_ON_DUTY);
+
+    if(count == 0)
     {
-        return dayIndex;
+        puts("No shift is running at that time.");
+        return;
     }
 
-    printf("Invalid Day.\n");
-    return INVALID_INPUT;
+    for(int i = 0; i < count; i++)
+    {
+        const Doctor *doctor = getDoctorWithId(scheduleDoctorAt(onDuty[i].dayNumber, onDuty[i].shiftIndex));
+
+        printSlot(&onDuty[i]);
+        printf("%s\n", doctor == NULL ? "Unassigned!" : doctor->name);
+    }
 }
 
 /*
- * Prompts for and validates a time slot selection.
+ * Lists the unassigned shifts in the quarter (91 days) starting at a chosen date.
+ */
+void showUncoveredShifts(void)
+{
+    static ScheduleSlot gaps[MAX_LISTED_GAPS];
+
+    int first = chooseDay();
+    int last  = first + DAYS_IN_QUARTER - 1;
+    int count = findUncoveredSlots(first, last, gaps, MAX_LISTED_GAPS);
+
+    if(count == 0)
+    {
+        puts("Every shift in the next quarter is covered.");
+        return;
+    }
+
+    for(int i = 0; i < count && i < MAX_LISTED_GAPS; i++)
+    {
+        printSlot(&gaps[i]);
+        printf("\n");
+    }
+
+    printf("%d of %d shifts are unassigned.\n", count, DAYS_IN_QUARTER * scheduleShiftCount());
+}
+
+/*
+ * Tells whether a doctor could take a shift and who holds it now.
+ */
+void checkDoctorAvailability(void)
+{
+    const int     doctorId   = chooseDoctor();
+    const int     dayNumber  = chooseDay();
+    const int     shiftIndex = chooseTime();
+    const Doctor *doctor     = getDoctorWithId(doctorId);
+    const Doctor *current    = getDoctorWithId(scheduleDoctorAt(dayNumber, shiftIndex));
+    ScheduleSlot  slot       = { dayNumber, shiftIndex };
+
+    printSlot(&slot);
+    if(isDoctorFree(doctorId, dayNumber, shiftIndex))
+    {
+        printf("Dr.%s is free.", doctor->name);
+    }
+    else
+    {
+        printf("Dr.%s is already working at that time.", doctor->name);
+    }
+
+    if(current != NULL && current->id != doctorId)
+    {
+        printf(" (currently Dr.%s)", current->name);
+    }
+    printf("\n");
+}
+
+/*
+ * Clears every slot assigned to the doctor and saves the schedule.
+ */
+int unassignDoctorShifts(int doctorId)
+{
+    return scheduleClearDoctor(doctorId);
+}
+
+/*
+ * Prompts for a calendar date and returns its day number.
+ */
+static int chooseDay(void)
+{
+    return toDayNumber(promptDateTime("Choose A Date (YYYY-MM-DD, Enter for today):\n", time(NULL)));
+}
+
+/*
+ * Prompts for a date and returns the day number of the Monday of its week.
+ */
+static int chooseWeek(const char *prompt)
+{
+    int dayNumber = toDayNumber(promptDateTime(prompt, time(NULL)));
+    return dayNumber - dayOfWeek(dayNumber);
+}
+
+/*
+ * Prompts for and validates a shift selection.
  * Displays numbered options and continues until valid input is received.
  */
 static int chooseTime(void)
@@ -234,10 +338,14 @@ static int chooseTime(void)
 
     do
     {
-        printf("Choose A Time Of Day:\n"
-               "0: Morning\n"
-               "1: Afternoon\n"
-               "2: Evening\n");
+        printf("Choose A Shift:\n");
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
+        {
+            const ShiftDefinition *shift = scheduleShift(shiftIndex);
+
+            printf("%d: %s (%02d:%02d, %d hours)\n", shiftIndex, shift->name, shift->startMinute / MINUTES_PER_HOUR,
+                   shift->startMinute % MINUTES_PER_HOUR, shift->lengthMinutes / MINUTES_PER_HOUR);
+        }
 
         if(scanf("%d", &timeIndex) != SUCCESSFUL_READ)
         {
@@ -247,6 +355,7 @@ static int chooseTime(void)
         }
         else
         {
+            clearInputBuffer();
             timeIndex = timeExists(timeIndex);
         }
     }
@@ -256,12 +365,12 @@ static int chooseTime(void)
 }
 
 /*
- * Validates if a given time slot index is within valid range.
+ * Validates if a given shift index is within valid range.
  * Returns the index if valid, INVALID_INPUT otherwise.
  */
 static int timeExists(const int timeIndex)
 {
-    if(MIN_INDEX <= timeIndex && timeIndex < TIMES_OF_DAY)
+    if(MIN_INDEX <= timeIndex && timeIndex < scheduleShiftCount())
     {
         return timeIndex;
     }
@@ -270,56 +379,162 @@ static int timeExists(const int timeIndex)
     return INVALID_INPUT;
 }
 
-// Helper function to count shifts for a specific doctor
-static int countDoctorShifts(int doctorId) {
-    int shiftCount = 0;
+/*
+ * Prints a slot as "Day YYYY-MM-DD Shift" padded to a column.
+ */
+static void printSlot(const ScheduleSlot *slot)
+{
+    char dateStr[20];
+
+    formatDay(slot->dayNumber, dateStr, sizeof(dateStr));
+    printf("%-10s %s %-12s", daysOfWeek[dayOfWeek(slot->dayNumber)], dateStr,
+           scheduleShift(slot->shiftIndex)->name);
+}
+
+/*
+ * Computes the start and end time of one shift on one day.
+ */
+static void shiftPeriod(int dayNumber, int shiftIndex, time_t *start, time_t *end)
+{
+    const ShiftDefinition *shift = scheduleShift(shiftIndex);
+
+    *start = dayNumberToTime(dayNumber) + (time_t) shift->startMinute * SECONDS_PER_MINUTE;
+    *end   = *start + (time_t) shift->lengthMinutes * SECONDS_PER_MINUTE;
+}
+
+/*
+ * Lists every shift of a week copy that overlaps the doctor's on-call blocks
+ * or leaves less than the minimum rest next to one. Returns 0 if any shift
+ * overlaps or the user declines the short rests, 1 if the copy may go ahead.
+ */
+static int checkWeekOnCall(int fromWeek, int toWeek)
+{
+    int  overlaps   = 0;
+    int  shortRests = 0;
+    char proceed    = YES;
+
+    for(int dayIndex = 0; dayIndex < DAYS_IN_WEEK; dayIndex++)
+    {
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
+        {
+            const Doctor *doctor = getDoctorWithId(scheduleDoctorAt(fromWeek + dayIndex, shiftIndex));
+            ScheduleSlot  slot   = { toWeek + dayIndex, shiftIndex };
+            time_t        shiftStart, shiftEnd;
+
+            if(doctor == NULL)
+            {
+                continue;
+            }
 
-    for (int dayIndex = 0; dayIndex < DAYS_IN_WEEK; dayIndex++) {
-        for (int timeIndex = 0; timeIndex < TIMES_OF_DAY; timeIndex++) {
-            if (weeklyDoctorSchedule[dayIndex][timeIndex].id == doctorId) {
-                shiftCount++;
+            shiftPeriod(slot.dayNumber, slot.shiftIndex, &shiftStart, &shiftEnd);
+            if(isDoctorOnCall(doctor->id, shiftStart, shiftEnd))
+            {
+                printSlot(&slot);
+                printf("Dr.%s is on call during this shift.\n", doctor->name);
+                overlaps++;
+            }
+            else if(isDoctorOnCallNear(doctor->id, shiftStart, shiftEnd))
+            {
+                printSlot(&slot);
+                printf("Dr.%s would have less than %d hours of rest next to an on-call block.\n", doctor->name,
+                       ONCALL_MIN_REST_HOURS);
+                shortRests++;
             }
         }
     }
 
-    return shiftCount;
+    if(overlaps > 0)
+    {
+        printf("%d shifts overlap an on-call block of their doctor.\n", overlaps);
+        return 0;
+    }
+
+    if(shortRests > 0)
+    {
+        printf("Would You Like To Proceed? (y / n)\n");
+        do
+        {
+            scanf(" %c", &proceed);
+            clearInputBuffer();
+        }
+        while(proceed != YES && proceed != NO);
+    }
+
+    return proceed == YES;
+}
+
+/*
+ * Formats a day number as YYYY-MM-DD.
+ */
+static void formatDay(int dayNumber, char dateStr[], size_t size)
+{
+    time_t midnight = dayNumberToTime(dayNumber);
+    strftime(dateStr, size, "%Y-%m-%d", localtime(&midnight));
 }
 
 /*
- * Prints out a doctor utilization report and overwrites to
- * doctor_utilization_report.txt showcasing number of shifts
- * covered by doctors
+ * Prints out a doctor utilization report for a range of dates and overwrites
+ * doctor_utilization_report.txt showcasing number of shifts covered by
+ * doctors. Each count is two prefix-sum lookups in the schedule index, so
+ * the report does not scan the schedule.
  */
 void printDoctorUtilizationReport() {
+    int firstStored = scheduleFirstDay();
+    int lastStored = scheduleFirstDay() + scheduleDayCount() - 1;
+    char fromStr[20];
+    char toStr[20];
+
+    if (scheduleDayCount() == 0) {
+        printf("The schedule is empty.\n");
+        return;
+    }
+
+    int fromDay = toDayNumber(promptDateTime("Report from (YYYY-MM-DD, Enter for the first scheduled day):\n",
+                                             dayNumberToTime(firstStored)));
+    int toDay = toDayNumber(promptDateTime("Report to (YYYY-MM-DD, Enter for the last scheduled day):\n",
+                                           dayNumberToTime(lastStored)));
+
+    if (toDay < fromDay) {
+        printf("The end date is before the start date.\n");
+        return;
+    }
+
     FILE *reportFile = fopen("doctor_utilization_report.txt", "w");
     if (reportFile == NULL) {
         printf("Error opening file to write the report.\n");
         return;
     }
 
-    // Print header to console and file
-    printf("Doctor Utilization Report\n");
-    printf("==========================\n");
-    fprintf(reportFile, "Doctor Utilization Report\n");
-    fprintf(reportFile, "==========================\n");
+    int periodShifts = (toDay - fromDay + 1) * scheduleShiftCount();
 
-    // Iterate over all doctors and count their shifts
-    const Doctor doctors[] = {
-        {RAYMOND_ID, "Raymond", 40},
-        {GEORGE_ID, "George", 45},
-        {SOFIA_ID, "Sofia", 35}
-    };
+    formatDay(fromDay, fromStr, sizeof(fromStr));
+    formatDay(toDay, toStr, sizeof(toStr));
 
-    for (int i = 0; i < 3; i++) {
-        int shiftCount = countDoctorShifts(doctors[i].id);
+    ReportSink *sink = openReportSink(reportFile, 1);
+    if (sink == NULL) {
+        fclose(reportFile);
+        return;
+    }
+
+    // Print header to console and file
+    sinkPrintf(sink, "Doctor Utilization Report\n"
+                     "==========================\n"
+                     "%s to %s (%d shifts)\n", fromStr, toStr, periodShifts);
+
+    // Iterate over every doctor in the registry and count their shifts in the period
+    for (int i = 0; i < getDoctorCount(); i++) {
+        const Doctor *doctor = getDoctorAt(i);
+        int shiftCount = countDoctorSlots(doctor->id, fromDay, toDay);
+        double share = 100.0 * shiftCount / periodShifts;
 
         // Print doctor details and shift count
-        printf("Dr.%s - Shifts Covered: %d\n", doctors[i].name, shiftCount);
-        fprintf(reportFile, "Dr.%s - Shifts Covered: %d\n", doctors[i].name, shiftCount);
+        sinkPrintf(sink, "Dr.%s - Shifts Covered: %d (%.1f%%)\n", doctor->name, shiftCount, share);
     }
 
-    // Close the report file
-    fclose(reportFile);
+    // Write out the report and close the file
+    if (!closeReportSink(sink) || fclose(reportFile) != 0) {
+        printf("Error writing doctor_utilization_report.txt\n");
+        return;
+    }
     printf("\nReport successfully written to doctor_utilization_report.txt\n");
 }
-
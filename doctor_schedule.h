@@ -2,8 +2,8 @@
  * Author: Arsh M, Nathan O
  * Date: 2/13/2025
  * Purpose: This file contains the definition of the doctor scheduling system.
- *          It provides functionality for assigning doctors to specific time slots
- *          and displaying the complete weekly schedule.
+ *          It provides functionality for assigning doctors to shifts on
+ *          calendar dates and displaying the schedule one week at a time.
  */
 
 #ifndef SCHEDULE_H
@@ -12,35 +12,82 @@
 /*
  * Function: initializeSchedule
  * ----------------------------
- * Initializes the weekly schedule from file or with empty slots if file doesn't exist
+ * Opens the calendar schedule from file (converting the old one-week file),
+ * or creates an empty schedule if the file doesn't exist
  */
 void initializeSchedule(void);
 
 /*
  * Function: initializeScheduleDefault
  * ----------------------------------
- * Initializes the weekly schedule with empty slots (used when file reading fails)
+ * Replaces the schedule with an empty one
  */
 void initializeScheduleDefault(void);
 
 /*
  * Function: assignDoctor
  * ---------------------
- * Assigns a doctor to work at a time during the week and updates the schedule file
+ * Assigns a doctor to a shift on a calendar date and updates the schedule file
  */
 void assignDoctor(void);
 
 /*
  * Function: printFullSchedule
  * --------------------------
- * Displays the full doctor schedule with days, times, and assigned doctors
+ * Prompts for a week and displays its days, shifts, and assigned doctors
  */
 void printFullSchedule(void);
 
+/*
+ * Function: copyScheduleWeek
+ * --------------------------
+ * Prompts for a source and a target week and copies every assignment of the
+ * source week onto the target week, saving all of the changes as one batch.
+ * A copy that puts a doctor on a shift overlapping one of their on-call
+ * blocks is refused; one leaving a short rest next to a block must be
+ * confirmed.
+ */
+void copyScheduleWeek(void);
+
+/*
+ * Function: showDoctorsOnDuty
+ * ---------------------------
+ * Prompts for a moment (now by default) and lists the shifts running then
+ * with the doctor assigned to each
+ */
+void showDoctorsOnDuty(void);
+
+/*
+ * Function: showUncoveredShifts
+ * -----------------------------
+ * Prompts for a start date and lists every unassigned shift in the
+ * following quarter (91 days)
+ */
+void showUncoveredShifts(void);
+
+/*
+ * Function: checkDoctorAvailability
+ * ---------------------------------
+ * Prompts for a doctor, date and shift and reports whether the doctor is
+ * free to work it
+ */
+void checkDoctorAvailability(void);
+
+/*
+ * Function: unassignDoctorShifts
+ * ------------------------------
+ * Clears every slot assigned to a doctor (used when the doctor is removed)
+ * and updates the schedule file.
+ *
+ * Returns: The number of slots cleared
+ */
+int unassignDoctorShifts(int doctorId);
+
 /*
  * Function: printDoctorUtilizationReport
  * --------------------------------------
- * Calculates and prints a report detailing the number of shifts covered by each doctor.
+ * Prompts for a date range (the whole stored schedule by default) and reports
+ * the number of shifts covered by each doctor in it.
  * Displays the report on the console and writes it to the "doctor_utilization_report.txt" file.
  */
 void printDoctorUtilizationReport();
@@ -0,0 +1,773 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the data exports.
+ *          Every data set is a fixed list of typed columns and a function
+ *          that feeds its rows one at a time to an export writer. CSV and
+ *          JSON Lines rows are formatted straight into a file-only report
+ *          sink. Columnar rows are collected into row groups of at most
+ *          ROW_GROUP_SIZE rows and written column by column when a group
+ *          fills, so memory is bounded by one group. The discharge archive
+ *          is read in fixed-size chunks rather than loaded whole.
+ */
+
+#include "export.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "attending.h"
+#include "doctor_data.h"
+#include "facility.h"
+#include "patient_data.h"
+#include "patient_management.h"
+#include "report_format.h"
+#include "report_sink.h"
+#include "room_usage.h"
+#include "schedule_index.h"
+#include "schedule_store.h"
+#include "utils.h"
+
+// Private constants
+#define ROW_GROUP_SIZE 4096
+#define DISCHARGE_CHUNK 256
+#define FILE_NAME_LENGTH 256
+#define NUMBER_TEXT_LENGTH 32
+#define UNICODE_ESCAPE_LENGTH 7
+
+#define COLUMN_INT 1
+#define COLUMN_TEXT 2
+#define COLUMN_TIME 3
+#define COLUMN_REAL 4
+
+#define FORMAT_CSV 1
+#define FORMAT_JSONL 2
+#define FORMAT_COLUMNAR 3
+
+static const char   COLUMNAR_MAGIC[4]      = { 'H', 'C', 'O', 'L' };
+static const int    COLUMNAR_VERSION       = 1;
+static const int    END_OF_ROW_GROUPS      = 0;
+static const double SECONDS_PER_HOUR       = 60.0 * 60.0;
+static const double PERCENT                = 100.0;
+static const char  *formatNames[]          = { "", "csv", "jsonl", "col" };
+static const char  *formatTitles[]         = { "", "CSV", "JSON Lines", "Columnar binary" };
+
+/*
+ * A column of an export: its name in the header and its type.
+ */
+typedef struct
+{
+    const char *name;
+    int         type;
+} ExportColumn;
+
+/*
+ * One cell of a row. Int and time columns use integer, real columns use
+ * real and text columns use text.
+ */
+typedef struct
+{
+    long long   integer;
+    double      real;
+    const char *text;
+} ExportValue;
+
+/*
+ * The text of one column in the current row group. offsets[i] is where
+ * row i starts in bytes.
+ */
+typedef struct
+{
+    char  *bytes;
+    int   *offsets;
+    size_t length;
+    size_t capacity;
+} TextColumn;
+
+/*
+ * An export in progress. The row group arrays are only allocated for
+ * columnar files.
+ */
+typedef struct
+{
+    int                 format;
+    const ExportColumn *columns;
+    int                 columnCount;
+    ReportSink         *sink;
+    DateCache           dates;
+    long                rows;
+    int                 failed;
+    int                 groupRows;
+    long long          *integers;
+    double             *reals;
+    TextColumn         *texts;
+} ExportWriter;
+
+/*
+ * A data set that can be exported.
+ */
+typedef struct
+{
+    const char         *name;
+    const char         *title;
+    const ExportColumn *columns;
+    int                 columnCount;
+    void (*writeRows)(ExportWriter *writer);
+} ExportDataset;
+
+// Function prototypes for internal helper functions
+static void writeAdmissions(ExportWriter *writer);
+static void writeDischarges(ExportWriter *writer);
+static void writeRooms(ExportWriter *writer);
+static void writeUtilization(ExportWriter *writer);
+static int  openExportWriter(ExportWriter *writer, int format, FILE *file, const ExportDataset *dataset);
+static void writeExportRow(ExportWriter *writer, const ExportValue values[]);
+static int  closeExportWriter(ExportWriter *writer);
+static void writeCsvRow(ExportWriter *writer, const ExportValue values[]);
+static void writeJsonRow(ExportWriter *writer, const ExportValue values[]);
+static void writeScalar(ExportWriter *writer, int type, const ExportValue *value);
+static void writeCsvText(ReportSink *sink, const char *text);
+static void writeJsonText(ReportSink *sink, const char *text);
+static void bufferColumnarRow(ExportWriter *writer, const ExportValue values[]);
+static void flushRowGroup(ExportWriter *writer);
+static void freeRowGroup(ExportWriter *writer);
+static const ExportDataset *findDataset(const char *name);
+static int  findFormat(const char *name);
+
+static const ExportColumn admissionColumns[] = {
+    { "patient_id", COLUMN_INT },   { "name", COLUMN_TEXT },   { "age", COLUMN_INT },
+    { "diagnosis", COLUMN_TEXT },   { "room", COLUMN_INT },    { "ward", COLUMN_TEXT },
+    { "admitted", COLUMN_TIME },    { "attending_doctor_id", COLUMN_INT },
+};
+
+static const ExportColumn dischargeColumns[] = {
+    { "patient_id", COLUMN_INT },   { "name", COLUMN_TEXT },   { "age", COLUMN_INT },
+    { "diagnosis", COLUMN_TEXT },   { "room", COLUMN_INT },    { "admitted", COLUMN_TIME },
+    { "discharged", COLUMN_TIME },  { "stay_hours", COLUMN_REAL },
+};
+
+static const ExportColumn roomColumns[] = {
+    { "room", COLUMN_INT },  { "ward", COLUMN_TEXT }, { "beds", COLUMN_INT },
+    { "occupied", COLUMN_INT }, { "uses", COLUMN_INT },
+};
+
+static const ExportColumn utilizationColumns[] = {
+    { "doctor_id", COLUMN_INT },  { "name", COLUMN_TEXT },  { "first_day", COLUMN_TEXT },
+    { "last_day", COLUMN_TEXT },  { "shifts", COLUMN_INT }, { "share_percent", COLUMN_REAL },
+};
+
+#define COLUMNS(list) list, (int) (sizeof(list) / sizeof(list[0]))
+
+static const ExportDataset datasets[] = {
+    { "admissions", "Admitted Patients", COLUMNS(admissionColumns), writeAdmissions },
+    { "discharges", "Discharged Patients", COLUMNS(dischargeColumns), writeDischarges },
+    { "rooms", "Rooms", COLUMNS(roomColumns), writeRooms },
+    { "utilization", "Doctor Utilization", COLUMNS(utilizationColumns), writeUtilization },
+};
+
+static const int DATASET_COUNT = (int) (sizeof(datasets) / sizeof(datasets[0]));
+
+/*
+ * Asks which data set and format to export and where to, then exports it.
+ */
+void exportData(void)
+{
+    char fileName[FILE_NAME_LENGTH];
+    char defaultName[FILE_NAME_LENGTH];
+
+    printf("Export which data?\n");
+    for(int i = 0; i < DATASET_COUNT; i++)
+    {
+        printf("%d: %s\n", i + 1, datasets[i].title);
+    }
+    const ExportDataset *dataset = &datasets[promptNumber("Enter choice: ", 1, DATASET_COUNT) - 1];
+
+    printf("Export format?\n");
+    for(int format = FORMAT_CSV; format <= FORMAT_COLUMNAR; format++)
+    {
+        printf("%d: %s (.%s)\n", format, formatTitles[format], formatNames[format]);
+    }
+    int format = promptNumber("Enter choice: ", FORMAT_CSV, FORMAT_COLUMNAR);
+
+    snprintf(defaultName, sizeof(defaultName), "%s.%s", dataset->name, formatNames[format]);
+    printf("File to write (Enter for %s):\n", defaultName);
+    if(fgets(fileName, sizeof(fileName), stdin) == NULL)
+    {
+        return;
+    }
+    fileName[strcspn(fileName, "\r\n")] = '\0';
+
+    runExport(dataset->name, formatNames[format], fileName[0] == '\0' ? defaultName : fileName);
+}
+
+/*
+ * Streams one data set to a file in the chosen format.
+ */
+long runExport(const char *dataset, const char *format, const char *fileName)
+{
+    const ExportDataset *found       = findDataset(dataset);
+    int                  formatIndex = findFormat(format);
+    char                 defaultName[FILE_NAME_LENGTH];
+
+    if(found == NULL || formatIndex == 0)
+    {
+        printf("Unknown %s '%s'. Data sets: admissions, discharges, rooms, utilization. Formats: csv, jsonl, col.\n",
+               found == NULL ? "data set" : "format", found == NULL ? dataset : format);
+        return EXPORT_FAILED;
+    }
+
+    if(fileName == NULL)
+    {
+        snprintf(defaultName, sizeof(defaultName), "%s.%s", found->name, formatNames[formatIndex]);
+        fileName = defaultName;
+    }
+
+    FILE *file = fopen(fileName, formatIndex == FORMAT_COLUMNAR ? "wb" : "w");
+    if(file == NULL)
+    {
+        perror("Error creating the export file");
+        return EXPORT_FAILED;
+    }
+
+    ExportWriter writer;
+    if(!openExportWriter(&writer, formatIndex, file, found))
+    {
+        fclose(file);
+        remove(fileName);
+        return EXPORT_FAILED;
+    }
+
+    found->writeRows(&writer);
+
+    long rows    = writer.rows;
+    int  written = closeExportWriter(&writer);
+    if(fclose(file) != 0 || !written)
+    {
+        printf("Error writing %s\n", fileName);
+        return EXPORT_FAILED;
+    }
+
+    printf("Exported %ld rows to %s\n", rows, fileName);
+    return rows;
+}
+
+/*
+ * Feeds every admitted patient to the writer.
+ */
+static void writeAdmissions(ExportWriter *writer)
+{
+    for(const PatientNode *node = admittedPatients(); node != NULL; node = node->nextNode)
+    {
+        const Patient *patient = &node->data;
+        int            ward    = facilityRoomWard(patient->roomNumber);
+
+        ExportValue values[] = {
+            { .integer = patient->patientId },
+            { .text = patient->name },
+            { .integer = patient->ageInYears },
+            { .text = patient->diagnosis },
+            { .integer = patient->roomNumber },
+            { .text = ward == NO_WARD ? "" : facilityWardName(ward) },
+            { .integer = patient->admissionDate },
+            { .integer = attendingDoctorOf(patient->patientId) },
+        };
+        writeExportRow(writer, values);
+    }
+}
+
+/*
+ * Reads the discharge archive a chunk at a time and feeds every record
+ * to the writer.
+ */
+static void writeDischarges(ExportWriter *writer)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    DischargedPatient *chunk = malloc(DISCHARGE_CHUNK * sizeof(DischargedPatient));
+    if(chunk == NULL)
+    {
+        puts("Error: Not enough memory to export the discharge archive.");
+        writer->failed = 1;
+        fclose(file);
+        return;
+    }
+
+    size_t count;
+    while((count = fread(chunk, sizeof(DischargedPatient), DISCHARGE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            const Patient *patient = &chunk[i].patient;
+
+            ExportValue values[] = {
+                { .integer = patient->patientId },
+                { .text = patient->name },
+                { .integer = patient->ageInYears },
+                { .text = patient->diagnosis },
+                { .integer = patient->roomNumber },
+                { .integer = patient->admissionDate },
+                { .integer = chunk[i].dischargeDate },
+                { .real = difftime(chunk[i].dischargeDate, patient->admissionDate) / SECONDS_PER_HOUR },
+            };
+            writeExportRow(writer, values);
+        }
+    }
+
+    free(chunk);
+    fclose(file);
+}
+
+/*
+ * Feeds every room of the facility layout to the writer.
+ */
+static void writeRooms(ExportWriter *writer)
+{
+    for(int room = MIN_ROOM_NUMBER; room <= facilityMaxRoomNumber(); room++)
+    {
+        if(!facilityHasRoom(room))
+        {
+            continue;
+        }
+
+        int beds = facilityRoomCapacity(room);
+
+        ExportValue values[] = {
+            { .integer = room },
+            { .text = facilityWardName(facilityRoomWard(room)) },
+            { .integer = beds },
+            { .integer = beds - facilityFreeBeds(room) },
+            { .integer = roomUsageCount(room) },
+        };
+        writeExportRow(writer, values);
+    }
+}
+
+/*
+ * Feeds every doctor's shift count over the stored schedule to the writer.
+ */
+static void writeUtilization(ExportWriter *writer)
+{
+    int  firstDay = scheduleFirstDay();
+    int  lastDay  = firstDay + scheduleDayCount() - 1;
+    char firstText[DATETIME_TEXT_LENGTH];
+    char lastText[DATETIME_TEXT_LENGTH];
+
+    if(scheduleDayCount() == 0)
+    {
+        return;
+    }
+
+    strcpy(firstText, cachedDateText(&writer->dates, dayNumberToTime(firstDay)));
+    strcpy(lastText, cachedDateText(&writer->dates, dayNumberToTime(lastDay)));
+
+    int periodShifts = scheduleDayCount() * scheduleShiftCount();
+
+    for(int position = 0; position < getDoctorCount(); position++)
+    {
+        const Doctor *doctor = getDoctorAt(position);
+        int           shifts = countDoctorSlots(doctor->id, firstDay, lastDay);
+
+        ExportValue values[] = {
+            { .integer = doctor->id },
+            { .text = doctor->name },
+            { .text = firstText },
+            { .text = lastText },
+            { .integer = shifts },
+            { .real = PERCENT * shifts / periodShifts },
+        };
+        writeExportRow(writer, values);
+    }
+}
+
+/*
+ * Sets up a writer and writes the file's header: the column names for CSV,
+ * nothing for JSON Lines and the column list for columnar files.
+ */
+static int openExportWriter(ExportWriter *writer, int format, FILE *file, const ExportDataset *dataset)
+{
+    memset(writer, 0, sizeof(ExportWriter));
+    writer->format      = format;
+    writer->columns     = dataset->columns;
+    writer->columnCount = dataset->columnCount;
+    writer->sink        = openReportSink(file, 0);
+    initDateCache(&writer->dates);
+
+    if(writer->sink == NULL)
+    {
+        return 0;
+    }
+
+    if(format == FORMAT_CSV)
+    {
+        for(int column = 0; column < writer->columnCount; column++)
+        {
+            sinkPrintf(writer->sink, column == 0 ? "%s" : ",%s", writer->columns[column].name);
+        }
+        sinkWrite(writer->sink, "\n", 1);
+    }
+    else if(format == FORMAT_COLUMNAR)
+    {
+        writer->integers = malloc((size_t) writer->columnCount * ROW_GROUP_SIZE * sizeof(long long));
+        writer->reals    = malloc((size_t) writer->columnCount * ROW_GROUP_SIZE * sizeof(double));
+        writer->texts    = calloc(writer->columnCount, sizeof(TextColumn));
+
+        for(int column = 0; writer->texts != NULL && column < writer->columnCount; column++)
+        {
+            writer->texts[column].offsets = malloc((ROW_GROUP_SIZE + 1) * sizeof(int));
+            if(writer->texts[column].offsets == NULL)
+            {
+                writer->failed = 1;
+            }
+        }
+
+        if(writer->integers == NULL || writer->reals == NULL || writer->texts == NULL || writer->failed)
+        {
+            puts("Error: Not enough memory for the export.");
+            freeRowGroup(writer);
+            closeReportSink(writer->sink);
+            return 0;
+        }
+
+        sinkWrite(writer->sink, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+        sinkWrite(writer->sink, (const char *) &COLUMNAR_VERSION, sizeof(int));
+        sinkWrite(writer->sink, (const char *) &writer->columnCount, sizeof(int));
+
+        for(int column = 0; column < writer->columnCount; column++)
+        {
+            unsigned char type       = (unsigned char) writer->columns[column].type;
+            unsigned char nameLength = (unsigned char) strlen(writer->columns[column].name);
+
+            sinkWrite(writer->sink, (const char *) &type, 1);
+            sinkWrite(writer->sink, (const char *) &nameLength, 1);
+            sinkWrite(writer->sink, writer->columns[column].name, nameLength);
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Adds one row in the writer's format.
+ */
+static void writeExportRow(ExportWriter *writer, const ExportValue values[])
+{
+    switch(writer->format)
+    {
+        case FORMAT_CSV:
+            writeCsvRow(writer, values);
+            break;
+        case FORMAT_JSONL:
+            writeJsonRow(writer, values);
+            break;
+        case FORMAT_COLUMNAR:
+            bufferColumnarRow(writer, values);
+            break;
+    }
+    writer->rows++;
+}
+
+/*
+ * Writes any partial row group and the end marker, then releases the writer.
+ * Returns 1 if everything was written.
+ */
+static int closeExportWriter(ExportWriter *writer)
+{
+    if(writer->format == FORMAT_COLUMNAR)
+    {
+        flushRowGroup(writer);
+        sinkWrite(writer->sink, (const char *) &END_OF_ROW_GROUPS, sizeof(int));
+        freeRowGroup(writer);
+    }
+
+    int written = closeReportSink(writer->sink);
+    return written && !writer->failed;
+}
+
+/*
+ * Writes a row as comma-separated values.
+ */
+static void writeCsvRow(ExportWriter *writer, const ExportValue values[])
+{
+    for(int column = 0; column < writer->columnCount; column++)
+    {
+        if(column > 0)
+        {
+            sinkWrite(writer->sink, ",", 1);
+        }
+
+        if(writer->columns[column].type == COLUMN_TEXT)
+        {
+            writeCsvText(writer->sink, values[column].text);
+        }
+        else
+        {
+            writeScalar(writer, writer->columns[column].type, &values[column]);
+        }
+    }
+    sinkWrite(writer->sink, "\n", 1);
+}
+
+/*
+ * Writes a row as one JSON object on its own line.
+ */
+static void writeJsonRow(ExportWriter *writer, const ExportValue values[])
+{
+    for(int column = 0; column < writer->columnCount; column++)
+    {
+        sinkPrintf(writer->sink, column == 0 ? "{\"%s\":" : ",\"%s\":", writer->columns[column].name);
+
+        int type = writer->columns[column].type;
+        if(type == COLUMN_INT || type == COLUMN_REAL)
+        {
+            writeScalar(writer, type, &values[column]);
+        }
+        else
+        {
+            sinkWrite(writer->sink, "\"", 1);
+            if(type == COLUMN_TEXT)
+            {
+                writeJsonText(writer->sink, values[column].text);
+            }
+            else
+            {
+                writeScalar(writer, type, &values[column]);
+            }
+            sinkWrite(writer->sink, "\"", 1);
+        }
+    }
+    sinkWrite(writer->sink, "}\n", 2);
+}
+
+/*
+ * Writes an int, a real with two decimals or a time as
+ * "YYYY-MM-DD HH:MM:SS". None of these need quoting or escaping.
+ */
+static void writeScalar(ExportWriter *writer, int type, const ExportValue *value)
+{
+    char text[NUMBER_TEXT_LENGTH];
+    int  length;
+
+    if(type == COLUMN_TIME)
+    {
+        formatDateTime(&writer->dates, (time_t) value->integer, text);
+        length = (int) strlen(text);
+    }
+    else if(type == COLUMN_REAL)
+    {
+        length = snprintf(text, sizeof(text), "%.2f", value->real);
+    }
+    else
+    {
+        length = snprintf(text, sizeof(text), "%lld", value->integer);
+    }
+
+    sinkWrite(writer->sink, text, (size_t) length);
+}
+
+/*
+ * Writes a CSV field, quoted with doubled quotes if it holds a comma,
+ * quote or line break.
+ */
+static void writeCsvText(ReportSink *sink, const char *text)
+{
+    size_t length = strlen(text);
+
+    if(strpbrk(text, ",\"\r\n") == NULL)
+    {
+        sinkWrite(sink, text, length);
+        return;
+    }
+
+    sinkWrite(sink, "\"", 1);
+    for(const char *quote; (quote = strchr(text, '"')) != NULL; text = quote + 1)
+    {
+        sinkWrite(sink, text, (size_t) (quote - text) + 1);
+        sinkWrite(sink, "\"", 1);
+    }
+    sinkWrite(sink, text, strlen(text));
+    sinkWrite(sink, "\"", 1);
+}
+
+/*
+ * Writes the inside of a JSON string, escaping quotes, backslashes and
+ * control characters.
+ */
+static void writeJsonText(ReportSink *sink, const char *text)
+{
+    const char *run = text;
+
+    for(; *text != '\0'; text++)
+    {
+        unsigned char c = (unsigned char) *text;
+
+        if(c != '"' && c != '\\' && c >= ' ')
+        {
+            continue;
+        }
+
+        sinkWrite(sink, run, (size_t) (text - run));
+        run = text + 1;
+
+        if(c == '"' || c == '\\')
+        {
+            char escaped[2] = { '\\', (char) c };
+            sinkWrite(sink, escaped, sizeof(escaped));
+        }
+        else
+        {
+            char escaped[UNICODE_ESCAPE_LENGTH];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            sinkWrite(sink, escaped, UNICODE_ESCAPE_LENGTH - 1);
+        }
+    }
+
+    sinkWrite(sink, run, (size_t) (text - run));
+}
+
+/*
+ * Copies a row into the row group, writing the group out when it is full.
+ */
+static void bufferColumnarRow(ExportWriter *writer, const ExportValue values[])
+{
+    int row = writer->groupRows;
+
+    for(int column = 0; column < writer->columnCount; column++)
+    {
+        size_t cell = (size_t) column * ROW_GROUP_SIZE + row;
+
+        if(writer->columns[column].type == COLUMN_REAL)
+        {
+            writer->reals[cell] = values[column].real;
+        }
+        else if(writer->columns[column].type != COLUMN_TEXT)
+        {
+            writer->integers[cell] = values[column].integer;
+        }
+        else
+        {
+            TextColumn *text   = &writer->texts[column];
+            size_t      length = strlen(values[column].text);
+
+            if(text->length + length > text->capacity)
+            {
+                size_t newCapacity = text->capacity == 0 ? ROW_GROUP_SIZE : text->capacity;
+                while(newCapacity < text->length + length)
+                {
+                    newCapacity *= 2;
+                }
+
+                char *grown = realloc(text->bytes, newCapacity);
+                if(grown == NULL)
+                {
+                    puts("Error: Not enough memory for the export.");
+                    writer->failed = 1;
+                    length         = 0;
+                }
+                else
+                {
+                    text->bytes    = grown;
+                    text->capacity = newCapacity;
+                }
+            }
+
+            text->offsets[row] = (int) text->length;
+            memcpy(text->bytes + text->length, values[column].text, length);
+            text->length += length;
+        }
+    }
+
+    if(++writer->groupRows == ROW_GROUP_SIZE)
+    {
+        flushRowGroup(writer);
+    }
+}
+
+/*
+ * Writes the buffered rows as one row group, column by column.
+ */
+static void flushRowGroup(ExportWriter *writer)
+{
+    int rows = writer->groupRows;
+    if(rows == 0)
+    {
+        return;
+    }
+
+    sinkWrite(writer->sink, (const char *) &rows, sizeof(int));
+
+    for(int column = 0; column < writer->columnCount; column++)
+    {
+        size_t first = (size_t) column * ROW_GROUP_SIZE;
+
+        switch(writer->columns[column].type)
+        {
+            case COLUMN_REAL:
+                sinkWrite(writer->sink, (const char *) &writer->reals[first], rows * sizeof(double));
+                break;
+            case COLUMN_TEXT:
+                writer->texts[column].offsets[rows] = (int) writer->texts[column].length;
+                sinkWrite(writer->sink, (const char *) writer->texts[column].offsets, (rows + 1) * sizeof(int));
+                sinkWrite(writer->sink, writer->texts[column].bytes, writer->texts[column].length);
+                writer->texts[column].length = 0;
+                break;
+            default:
+                sinkWrite(writer->sink, (const char *) &writer->integers[first], rows * sizeof(long long));
+                break;
+        }
+    }
+
+    writer->groupRows = 0;
+}
+
+/*
+ * Frees the row group arrays.
+ */
+static void freeRowGroup(ExportWriter *writer)
+{
+    for(int column = 0; writer->texts != NULL && column < writer->columnCount; column++)
+    {
+        free(writer->texts[column].bytes);
+        free(writer->texts[column].offsets);
+    }
+
+    free(writer->texts);
+    free(writer->reals);
+    free(writer->integers);
+    writer->texts    = NULL;
+    writer->reals    = NULL;
+    writer->integers = NULL;
+}
+
+/*
+ * Returns the data set with a name, or NULL.
+ */
+static const ExportDataset *findDataset(const char *name)
+{
+    for(int i = 0; i < DATASET_COUNT; i++)
+    {
+        if(strcmp(datasets[i].name, name) == 0)
+        {
+            return &datasets[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns the format with a name, or 0.
+ */
+static int findFormat(const char *name)
+{
+    for(int format = FORMAT_CSV; format <= FORMAT_COLUMNAR; format++)
+    {
+        if(strcmp(formatNames[format], name) == 0)
+        {
+            return format;
+        }
+    }
+    return 0;
+}
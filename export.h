@@ -0,0 +1,46 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the data exports. The admitted patients, the
+ *          discharge archive, the rooms and doctor utilization can each be
+ *          written as CSV, JSON Lines or a columnar binary file, streamed in
+ *          one pass with memory that does not grow with the data.
+ *
+ *          Columnar files (.col) hold, in host byte order:
+ *            "HCOL", int32 version, int32 column count,
+ *            per column: uint8 type (1 int, 2 text, 3 time, 4 real),
+ *                        uint8 name length, name bytes,
+ *            then row groups, each an int32 row count followed by every
+ *            column in order: int64 values for int and time (seconds since
+ *            the epoch), float64 values for real, and for text
+ *            (rows + 1) int32 offsets followed by the text bytes,
+ *            and finally a row count of 0.
+ */
+
+#ifndef EXPORT_H
+#define EXPORT_H
+
+// Returned by runExport when nothing could be exported
+#define EXPORT_FAILED (-1)
+
+/*
+ * Function: exportData
+ * --------------------
+ * Prompts for a data set, a format and a file name, then writes the export.
+ */
+void exportData(void);
+
+/*
+ * Function: runExport
+ * -------------------
+ * Writes one export without prompting (used by the command line).
+ *
+ * dataset: "admissions", "discharges", "rooms" or "utilization"
+ * format: "csv", "jsonl" or "col"
+ * fileName: The file to create, or NULL for <dataset>.<format>
+ *
+ * Returns: The number of rows written, or EXPORT_FAILED
+ */
+long runExport(const char *dataset, const char *format, const char *fileName);
+
+#endif // EXPORT_H
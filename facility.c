@@ -0,0 +1,678 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the facility model.
+ *          Each ward numbers its beds 0..bedCount-1, room by room in the order
+ *          rooms appear in facility.cfg. A ward keeps one bit per bed (set when
+ *          the bed is free) and a summary with one bit per 64-bed word (set when
+ *          that word has any free bed), so the first free bed is found by
+ *          skipping whole groups of 4096 full beds at a time.
+ *
+ *          facility.cfg holds one line per block of rooms:
+ *              ward name, floor, first room, last room, beds per room
+ */
+
+#include "facility.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "patient_data.h"
+#include "utils.h"
+
+// Private constants
+#define BITS_PER_WORD 64
+#define CONFIG_LINE_LENGTH 256
+#define CONFIG_FIELDS 5
+
+static const int   MAX_BEDS_PER_ROOM   = 64;
+static const int   MAX_CONFIG_ROOM     = 1000000;
+static const int   DEFAULT_LAST_ROOM   = 50;
+static const int   DEFAULT_FLOOR       = 1;
+static const int   DEFAULT_BEDS        = 1;
+static const char *DEFAULT_WARD        = "General";
+static const char *FACILITY_FILE       = "facility.cfg";
+
+/*
+ * A ward and its bed bitmaps. freeBits has one bit per bed, set while the
+ * bed is free; summary has one bit per freeBits word, set while that word
+ * has any free bed. bedRoom maps each ward bed to its room number.
+ */
+typedef struct
+{
+    char      name[MAX_WARD_NAME_LENGTH];
+    uint64_t *freeBits;
+    uint64_t *summary;
+    int      *bedRoom;
+    int       bedCount;
+    int       wordCount;
+    int       summaryCount;
+    int       occupied;
+} Ward;
+
+/*
+ * Placement and occupancy of one room. Its beds are ward beds
+ * firstBed .. firstBed + capacity - 1.
+ */
+typedef struct
+{
+    int ward;
+    int floor;
+    int capacity;
+    int firstBed;
+    int occupied;
+} RoomInfo;
+
+/*
+ * Bed totals of one floor.
+ */
+typedef struct
+{
+    int number;
+    int beds;
+    int occupied;
+} FloorInfo;
+
+/*
+ * One parsed line of facility.cfg.
+ */
+typedef struct
+{
+    char name[MAX_WARD_NAME_LENGTH];
+    int  floor;
+    int  firstRoom;
+    int  lastRoom;
+    int  beds;
+} RoomBlock;
+
+static Ward      *wards         = NULL;
+static int        wardCount     = 0;
+static RoomInfo  *roomTable     = NULL;
+static int        maxRoomNumber = 0;
+static FloorInfo *floors        = NULL;
+static int        floorCount    = 0;
+
+// Function prototypes for internal helper functions
+static int       readConfig(RoomBlock **blocks);
+static int       parseConfigLine(const char *line, RoomBlock *block);
+static void      buildFacility(const RoomBlock blocks[], int blockCount);
+static int       findOrAddWard(const char *name);
+static int       findOrAddFloor(int number);
+static int       allocateBitmaps(Ward *ward);
+static void      markAllFree(Ward *ward);
+static void      freeFacility(void);
+static RoomInfo *getRoomInfo(int roomNumber);
+static int       lowestSetBit(uint64_t word);
+
+/*
+ * Loads the room layout from facility.cfg, or the default layout.
+ */
+void initializeFacility(void)
+{
+    RoomBlock *blocks     = NULL;
+    int        blockCount = readConfig(&blocks);
+
+    freeFacility();
+
+    if(blockCount <= 0)
+    {
+        RoomBlock defaultBlock;
+        strcpy(defaultBlock.name, DEFAULT_WARD);
+        defaultBlock.floor     = DEFAULT_FLOOR;
+        defaultBlock.firstRoom = MIN_ROOM_NUMBER;
+        defaultBlock.lastRoom  = DEFAULT_LAST_ROOM;
+        defaultBlock.beds      = DEFAULT_BEDS;
+
+        puts("Using the default facility layout (rooms 1-50, one bed each).");
+        buildFacility(&defaultBlock, 1);
+    }
+    else
+    {
+        buildFacility(blocks, blockCount);
+        printf("Facility loaded: %d wards, %d floors, rooms up to %d.\n", wardCount, floorCount, maxRoomNumber);
+    }
+
+    free(blocks);
+}
+
+/*
+ * Returns 1 if the room is part of the configured facility.
+ */
+int facilityHasRoom(int roomNumber)
+{
+    return getRoomInfo(roomNumber) != NULL;
+}
+
+/*
+ * Returns the highest configured room number.
+ */
+int facilityMaxRoomNumber(void)
+{
+    return maxRoomNumber;
+}
+
+/*
+ * Returns the number of beds in a room.
+ */
+int facilityRoomCapacity(int roomNumber)
+{
+    RoomInfo *room = getRoomInfo(roomNumber);
+    return room == NULL ? 0 : room->capacity;
+}
+
+/*
+ * Returns the number of free beds in a room.
+ */
+int facilityFreeBeds(int roomNumber)
+{
+    RoomInfo *room = getRoomInfo(roomNumber);
+    return room == NULL ? 0 : room->capacity - room->occupied;
+}
+
+/*
+ * Returns the ward a room belongs to.
+ */
+int facilityRoomWard(int roomNumber)
+{
+    RoomInfo *room = getRoomInfo(roomNumber);
+    return room == NULL ? NO_WARD : room->ward;
+}
+
+/*
+ * Occupies the first free bed of a room.
+ */
+int facilityOccupyBed(int roomNumber)
+{
+    RoomInfo *room = getRoomInfo(roomNumber);
+    if(room == NULL || room->occupied == room->capacity)
+    {
+        return 0;
+    }
+
+    Ward *ward = &wards[room->ward];
+
+    for(int bed = room->firstBed; bed < room->firstBed + room->capacity; bed++)
+    {
+        int      word = bed / BITS_PER_WORD;
+        uint64_t bit  = (uint64_t) 1 << (bed % BITS_PER_WORD);
+
+        if(ward->freeBits[word] & bit)
+        {
+            ward->freeBits[word] &= ~bit;
+            if(ward->freeBits[word] == 0)
+            {
+                ward->summary[word / BITS_PER_WORD] &= ~((uint64_t) 1 << (word % BITS_PER_WORD));
+            }
+
+            room->occupied++;
+            ward->occupied++;
+            floors[room->floor].occupied++;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Frees one occupied bed of a room.
+ */
+void facilityReleaseBed(int roomNumber)
+{
+    RoomInfo *room = getRoomInfo(roomNumber);
+    if(room == NULL || room->occupied == 0)
+    {
+        return;
+    }
+
+    Ward *ward = &wards[room->ward];
+
+    for(int bed = room->firstBed; bed < room->firstBed + room->capacity; bed++)
+    {
+        int      word = bed / BITS_PER_WORD;
+        uint64_t bit  = (uint64_t) 1 << (bed % BITS_PER_WORD);
+
+        if(!(ward->freeBits[word] & bit))
+        {
+            ward->freeBits[word] |= bit;
+            ward->summary[word / BITS_PER_WORD] |= (uint64_t) 1 << (word % BITS_PER_WORD);
+
+            room->occupied--;
+            ward->occupied--;
+            floors[room->floor].occupied--;
+            return;
+        }
+    }
+}
+
+/*
+ * Marks every bed in the facility free.
+ */
+void facilityResetOccupancy(void)
+{
+    for(int i = 0; i < wardCount; i++)
+    {
+        markAllFree(&wards[i]);
+    }
+
+    for(int room = 0; room <= maxRoomNumber && roomTable != NULL; room++)
+    {
+        roomTable[room].occupied = 0;
+    }
+
+    for(int i = 0; i < floorCount; i++)
+    {
+        floors[i].occupied = 0;
+    }
+}
+
+/*
+ * Returns the number of configured wards.
+ */
+int facilityWardCount(void)
+{
+    return wardCount;
+}
+
+/*
+ * Returns the name of a ward.
+ */
+const char *facilityWardName(int wardIndex)
+{
+    return (wardIndex >= 0 && wardIndex < wardCount) ? wards[wardIndex].name : "";
+}
+
+/*
+ * Looks up a ward by name, ignoring case.
+ */
+int facilityFindWard(const char *wardName)
+{
+    for(int i = 0; i < wardCount; i++)
+    {
+        const char *a = wards[i].name;
+        const char *b = wardName;
+
+        while(*a != '\0' && tolower((unsigned char) *a) == tolower((unsigned char) *b))
+        {
+            a++;
+            b++;
+        }
+
+        if(*a == '\0' && *b == '\0')
+        {
+            return i;
+        }
+    }
+
+    return NO_WARD;
+}
+
+/*
+ * Finds the room holding the lowest-numbered free bed of a ward: the
+ * summary gives the first word with a free bed, and that word gives the bed.
+ */
+int facilityFirstFreeRoomInWard(int wardIndex)
+{
+    if(wardIndex == NO_WARD)
+    {
+        for(int i = 0; i < wardCount; i++)
+        {
+            int room = facilityFirstFreeRoomInWard(i);
+            if(room != NO_FREE_ROOM)
+            {
+                return room;
+            }
+        }
+
+        return NO_FREE_ROOM;
+    }
+
+    if(wardIndex < 0 || wardIndex >= wardCount)
+    {
+        return NO_FREE_ROOM;
+    }
+
+    const Ward *ward = &wards[wardIndex];
+
+    for(int i = 0; i < ward->summaryCount; i++)
+    {
+        if(ward->summary[i] != 0)
+        {
+            int word = i * BITS_PER_WORD + lowestSetBit(ward->summary[i]);
+            int bed  = word * BITS_PER_WORD + lowestSetBit(ward->freeBits[word]);
+            return ward->bedRoom[bed];
+        }
+    }
+
+    return NO_FREE_ROOM;
+}
+
+/*
+ * Prints occupied and total beds for every ward and every floor.
+ */
+void displayWardOccupancyReport(void)
+{
+    int totalBeds     = 0;
+    int totalOccupied = 0;
+
+    printf("\n--- Ward Occupancy Report ---\n");
+    printf("%-20s | Occupied | Beds  | %% Full\n", "Ward");
+    printf("---------------------|----------|-------|-------\n");
+
+    for(int i = 0; i < wardCount; i++)
+    {
+        const Ward *ward = &wards[i];
+
+        printf("%-20s | %-8d | %-5d | %6.2f\n", ward->name, ward->occupied, ward->bedCount,
+               ward->bedCount == 0 ? 0.0 : 100.0 * ward->occupied / ward->bedCount);
+        totalBeds += ward->bedCount;
+        totalOccupied += ward->occupied;
+    }
+
+    printf("\n%-20s | Occupied | Beds  | %% Full\n", "Floor");
+    printf("---------------------|----------|-------|-------\n");
+
+    for(int i = 0; i < floorCount; i++)
+    {
+        printf("%-20d | %-8d | %-5d | %6.2f\n", floors[i].number, floors[i].occupied, floors[i].beds,
+               floors[i].beds == 0 ? 0.0 : 100.0 * floors[i].occupied / floors[i].beds);
+    }
+
+    printf("-------------------------\n");
+    printf("Total beds occupied: %d of %d\n", totalOccupied, totalBeds);
+    printf("-------------------------\n");
+}
+
+/*
+ * Reads every valid line of facility.cfg into a malloc'd array.
+ * Returns the number of blocks read, or 0 if the file is missing or empty.
+ */
+static int readConfig(RoomBlock **blocks)
+{
+    FILE *file = fopen(FACILITY_FILE, "r");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    char line[CONFIG_LINE_LENGTH];
+    int  count      = 0;
+    int  capacity   = 0;
+    int  lineNumber = 0;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        RoomBlock block;
+        lineNumber++;
+
+        const char *text = line + strspn(line, " \t");
+        if(*text == '#' || *text == '\n' || *text == '\0')
+        {
+            continue;
+        }
+
+        if(!parseConfigLine(text, &block))
+        {
+            printf("Warning: Ignoring invalid line %d in facility.cfg.\n", lineNumber);
+            continue;
+        }
+
+        if(count == capacity)
+        {
+            int        newCapacity = capacity == 0 ? 16 : capacity * 2;
+            RoomBlock *grown       = realloc(*blocks, newCapacity * sizeof(RoomBlock));
+
+            if(grown == NULL)
+            {
+                puts("Error: Not enough memory to read facility.cfg.");
+                break;
+            }
+
+            *blocks  = grown;
+            capacity = newCapacity;
+        }
+
+        (*blocks)[count++] = block;
+    }
+
+    fclose(file);
+    return count;
+}
+
+/*
+ * Parses "ward name, floor, first room, last room, beds per room".
+ */
+static int parseConfigLine(const char *line, RoomBlock *block)
+{
+    int fields = sscanf(line, " %63[^,],%d,%d,%d,%d", block->name, &block->floor, &block->firstRoom,
+                        &block->lastRoom, &block->beds);
+
+    if(fields != CONFIG_FIELDS)
+    {
+        return 0;
+    }
+
+    // Drop trailing spaces from the ward name
+    size_t length = strlen(block->name);
+    while(length > 0 && isspace((unsigned char) block->name[length - 1]))
+    {
+        block->name[--length] = '\0';
+    }
+
+    return length > 0 && block->firstRoom >= MIN_ROOM_NUMBER && block->lastRoom >= block->firstRoom &&
+           block->lastRoom <= MAX_CONFIG_ROOM && block->beds >= 1 && block->beds <= MAX_BEDS_PER_ROOM;
+}
+
+/*
+ * Creates the room table, wards, floors and bed bitmaps for the given blocks.
+ */
+static void buildFacility(const RoomBlock blocks[], int blockCount)
+{
+    for(int i = 0; i < blockCount; i++)
+    {
+        if(blocks[i].lastRoom > maxRoomNumber)
+        {
+            maxRoomNumber = blocks[i].lastRoom;
+        }
+    }
+
+    roomTable = malloc((maxRoomNumber + 1) * sizeof(RoomInfo));
+    if(roomTable == NULL)
+    {
+        puts("Error: Not enough memory for the facility layout.");
+        maxRoomNumber = 0;
+        return;
+    }
+
+    for(int room = 0; room <= maxRoomNumber; room++)
+    {
+        roomTable[room] = (RoomInfo) { NO_WARD, 0, 0, 0, 0 };
+    }
+
+    for(int i = 0; i < blockCount; i++)
+    {
+        int wardIndex  = findOrAddWard(blocks[i].name);
+        int floorIndex = findOrAddFloor(blocks[i].floor);
+
+        if(wardIndex == NO_WARD || floorIndex < 0)
+        {
+            puts("Error: Not enough memory for the facility layout.");
+            return;
+        }
+
+        for(int room = blocks[i].firstRoom; room <= blocks[i].lastRoom; room++)
+        {
+            if(roomTable[room].ward != NO_WARD)
+            {
+                printf("Warning: Room %d is listed more than once in facility.cfg.\n", room);
+                continue;
+            }
+
+            roomTable[room] = (RoomInfo) { wardIndex, floorIndex, blocks[i].beds, wards[wardIndex].bedCount, 0 };
+            wards[wardIndex].bedCount += blocks[i].beds;
+            floors[floorIndex].beds += blocks[i].beds;
+        }
+    }
+
+    for(int i = 0; i < wardCount; i++)
+    {
+        if(!allocateBitmaps(&wards[i]))
+        {
+            puts("Error: Not enough memory for the ward bed maps.");
+            return;
+        }
+    }
+
+    // Fill in which room each ward bed belongs to
+    for(int room = 0; room <= maxRoomNumber; room++)
+    {
+        const RoomInfo *info = &roomTable[room];
+
+        for(int bed = 0; info->ward != NO_WARD && bed < info->capacity; bed++)
+        {
+            wards[info->ward].bedRoom[info->firstBed + bed] = room;
+        }
+    }
+}
+
+/*
+ * Returns the index of the ward with this name, adding it if needed.
+ */
+static int findOrAddWard(const char *name)
+{
+    int existing = facilityFindWard(name);
+    if(existing != NO_WARD)
+    {
+        return existing;
+    }
+
+    Ward *grown = realloc(wards, (wardCount + 1) * sizeof(Ward));
+    if(grown == NULL)
+    {
+        return NO_WARD;
+    }
+
+    wards = grown;
+    memset(&wards[wardCount], 0, sizeof(Ward));
+    strcpy(wards[wardCount].name, name);
+    return wardCount++;
+}
+
+/*
+ * Returns the index of the floor with this number, adding it if needed.
+ */
+static int findOrAddFloor(int number)
+{
+    for(int i = 0; i < floorCount; i++)
+    {
+        if(floors[i].number == number)
+        {
+            return i;
+        }
+    }
+
+    FloorInfo *grown = realloc(floors, (floorCount + 1) * sizeof(FloorInfo));
+    if(grown == NULL)
+    {
+        return -1;
+    }
+
+    floors             = grown;
+    floors[floorCount] = (FloorInfo) { number, 0, 0 };
+    return floorCount++;
+}
+
+/*
+ * Allocates a ward's bed bitmaps and bed-to-room map, with every bed free.
+ */
+static int allocateBitmaps(Ward *ward)
+{
+    ward->wordCount    = (ward->bedCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    ward->summaryCount = (ward->wordCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    ward->freeBits     = calloc(ward->wordCount + 1, sizeof(uint64_t));
+    ward->summary      = calloc(ward->summaryCount + 1, sizeof(uint64_t));
+    ward->bedRoom      = malloc((ward->bedCount + 1) * sizeof(int));
+
+    if(ward->freeBits == NULL || ward->summary == NULL || ward->bedRoom == NULL)
+    {
+        return 0;
+    }
+
+    markAllFree(ward);
+    return 1;
+}
+
+/*
+ * Sets every bed of a ward free and rebuilds its summary.
+ */
+static void markAllFree(Ward *ward)
+{
+    memset(ward->summary, 0, ward->summaryCount * sizeof(uint64_t));
+
+    for(int word = 0; word < ward->wordCount; word++)
+    {
+        int bedsInWord = ward->bedCount - word * BITS_PER_WORD;
+
+        ward->freeBits[word] = bedsInWord >= BITS_PER_WORD ? ~(uint64_t) 0 : (((uint64_t) 1 << bedsInWord) - 1);
+        ward->summary[word / BITS_PER_WORD] |= (uint64_t) 1 << (word % BITS_PER_WORD);
+    }
+
+    ward->occupied = 0;
+}
+
+/*
+ * Frees the current layout so a new one can be loaded.
+ */
+static void freeFacility(void)
+{
+    for(int i = 0; i < wardCount; i++)
+    {
+        free(wards[i].freeBits);
+        free(wards[i].summary);
+        free(wards[i].bedRoom);
+    }
+
+    free(wards);
+    free(roomTable);
+    free(floors);
+
+    wards         = NULL;
+    wardCount     = 0;
+    roomTable     = NULL;
+    maxRoomNumber = 0;
+    floors        = NULL;
+    floorCount    = 0;
+}
+
+/*
+ * Returns a configured room, or NULL for unknown room numbers.
+ */
+static RoomInfo *getRoomInfo(int roomNumber)
+{
+    if(roomTable == NULL || roomNumber < MIN_ROOM_NUMBER || roomNumber > maxRoomNumber ||
+       roomTable[roomNumber].ward == NO_WARD)
+    {
+        return NULL;
+    }
+
+    return &roomTable[roomNumber];
+}
+
+/*
+ * Returns the position of the lowest set bit of a non-zero word.
+ */
+static int lowestSetBit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int position = 0;
+    while(!(word & 1))
+    {
+        word >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
@@ -0,0 +1,125 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the facility model: which rooms exist, which
+ *          ward and floor each belongs to, and how many beds it has. The
+ *          layout is read from facility.cfg. Bed occupancy is tracked per
+ *          ward in two-level bitmaps, so finding a free bed or counting a
+ *          ward's occupancy never scans every bed.
+ */
+
+#ifndef FACILITY_H
+#define FACILITY_H
+
+#define MAX_WARD_NAME_LENGTH 64
+#define NO_WARD (-1)
+#define NO_FREE_ROOM (-1)
+
+/*
+ * Function: initializeFacility
+ * ----------------------------
+ * Loads the room layout from facility.cfg. If the file is missing, a single
+ * "General" ward with rooms 1-50 of one bed each is used.
+ */
+void initializeFacility(void);
+
+/*
+ * Function: facilityHasRoom
+ * -------------------------
+ * Returns: 1 if the room number is part of the configured facility, 0 otherwise
+ */
+int facilityHasRoom(int roomNumber);
+
+/*
+ * Function: facilityMaxRoomNumber
+ * -------------------------------
+ * Returns: The highest configured room number
+ */
+int facilityMaxRoomNumber(void);
+
+/*
+ * Function: facilityRoomCapacity
+ * ------------------------------
+ * Returns: The number of beds in a room (0 for unknown rooms)
+ */
+int facilityRoomCapacity(int roomNumber);
+
+/*
+ * Function: facilityFreeBeds
+ * --------------------------
+ * Returns: The number of unoccupied beds in a room (0 for unknown rooms)
+ */
+int facilityFreeBeds(int roomNumber);
+
+/*
+ * Function: facilityRoomWard
+ * --------------------------
+ * Returns: The index of the ward a room belongs to, or NO_WARD
+ */
+int facilityRoomWard(int roomNumber);
+
+/*
+ * Function: facilityOccupyBed
+ * ---------------------------
+ * Marks one free bed in the room as occupied.
+ *
+ * Returns: 1 on success, 0 if the room is unknown or full
+ */
+int facilityOccupyBed(int roomNumber);
+
+/*
+ * Function: facilityReleaseBed
+ * ----------------------------
+ * Marks one occupied bed in the room as free again.
+ */
+void facilityReleaseBed(int roomNumber);
+
+/*
+ * Function: facilityResetOccupancy
+ * --------------------------------
+ * Marks every bed free (used before the census is reloaded).
+ */
+void facilityResetOccupancy(void);
+
+/*
+ * Function: facilityWardCount
+ * ---------------------------
+ * Returns: The number of configured wards
+ */
+int facilityWardCount(void);
+
+/*
+ * Function: facilityWardName
+ * --------------------------
+ * Returns: The name of a ward, given its index
+ */
+const char *facilityWardName(int wardIndex);
+
+/*
+ * Function: facilityFindWard
+ * --------------------------
+ * Looks up a ward by name, ignoring case.
+ *
+ * Returns: The ward index, or NO_WARD if there is no such ward
+ */
+int facilityFindWard(const char *wardName);
+
+/*
+ * Function: facilityFirstFreeRoomInWard
+ * -------------------------------------
+ * Finds the lowest-numbered bed that is free in a ward.
+ *
+ * wardIndex: The ward to search, or NO_WARD to search every ward
+ *
+ * Returns: The room holding that bed, or NO_FREE_ROOM if the ward is full
+ */
+int facilityFirstFreeRoomInWard(int wardIndex);
+
+/*
+ * Function: displayWardOccupancyReport
+ * ------------------------------------
+ * Prints occupied and total beds for every ward and every floor.
+ */
+void displayWardOccupancyReport(void);
+
+#endif // FACILITY_H
@@ -0,0 +1,924 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the top diagnosis and room turnover reports.
+ *          A Space-Saving summary has SUMMARY_CAPACITY counters. A new item
+ *          takes a free counter or replaces the smallest one, inheriting its
+ *          count as the item's error, so each counter's true count lies
+ *          between count - error and count, and an item without a counter
+ *          occurred at most as often as the smallest counter.
+ *
+ *          Summaries of several months are merged by adding each item's
+ *          counts; a month without the item adds its smallest counter to the
+ *          item's upper bound. Rooms are kept as their number in text so
+ *          both kinds share one summary type.
+ *
+ *          heavy_hitters.dat records how many archive records the summaries
+ *          cover. Discharges are added as they are archived; records archived
+ *          without them (before the file existed, or when it could not be
+ *          written) are read from the archive the next time it is loaded.
+ */
+
+#include "heavy_hitters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "report_format.h"
+#include "report_sink.h"
+#include "utils.h"
+
+// Private constants
+#define SUMMARY_CAPACITY 64
+#define ITEM_LENGTH (MAX_DIAGNOSIS_LENGTH + 1)
+#define MIN_TABLE_CAPACITY 256
+#define ARCHIVE_CHUNK 256
+#define PROMPT_LENGTH 64
+#define COUNT_INPUT_LENGTH 16
+
+#define KIND_DIAGNOSIS 1
+#define KIND_ROOM 2
+
+#define PERIOD_MONTH 1
+#define PERIOD_YEAR 2
+#define PERIOD_RANGE 3
+
+#define MODE_APPROXIMATE 1
+#define MODE_EXACT 2
+
+static const char  SUMMARY_MAGIC[4] = { 'H', 'I', 'T', 'S' };
+static const int   SUMMARY_VERSION  = 1;
+static const int   EMPTY_SLOT       = -1;
+static const int   MONTHS_PER_YEAR  = 12;
+static const int   DEFAULT_TOP      = 10;
+static const int   MAX_TOP          = 25;
+static const char *SUMMARY_FILE     = "heavy_hitters.dat";
+static const char *SUMMARY_TEMP     = "heavy_hitters.tmp";
+static const char *TOP_REPORT_FILE  = "top_reports.txt";
+static const char *SEPARATOR_LINE   = "---------------------------------------\n";
+
+/*
+ * One Space-Saving counter: the item's count is at most count and at
+ * least count - error.
+ */
+typedef struct
+{
+    char      item[ITEM_LENGTH];
+    long long count;
+    long long error;
+} HitterCounter;
+
+/*
+ * The diagnosis or room counters of one month's discharges.
+ */
+typedef struct
+{
+    int           month;
+    int           kind;
+    long long     total;
+    int           counterCount;
+    HitterCounter counters[SUMMARY_CAPACITY];
+} HitterSummary;
+
+/*
+ * Header of heavy_hitters.dat, followed by summaryCount summaries.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    long long coveredRecords;
+    int       summaryCount;
+} SummaryFileHeader;
+
+/*
+ * Header of one stored summary, followed by its counters.
+ */
+typedef struct
+{
+    int       month;
+    int       kind;
+    long long total;
+    int       counterCount;
+} StoredSummary;
+
+/*
+ * One stored counter, followed by the item text.
+ */
+typedef struct
+{
+    long long count;
+    long long error;
+    int       itemLength;
+} StoredCounter;
+
+/*
+ * An item's merged or exact count: between count - error and count.
+ * presentBound sums the smallest counter of the months that had the item.
+ */
+typedef struct
+{
+    char      item[ITEM_LENGTH];
+    long long count;
+    long long error;
+    long long presentBound;
+} ItemTotal;
+
+/*
+ * Open-addressing table of item totals, keyed by item text.
+ */
+typedef struct
+{
+    ItemTotal *items;
+    int        count;
+    int        capacity;
+    int       *slots;
+    int        slotCapacity;
+} ItemTable;
+
+static HitterSummary *summaries        = NULL;
+static int            summaryCount     = 0;
+static int            summaryCapacity  = 0;
+static long long      coveredRecords   = 0;
+static int            summariesLoaded  = 0;
+
+// Function prototypes for internal helper functions
+static void           loadSummaries(void);
+static int            updateSummaries(void);
+static int            saveSummaries(void);
+static void           resetSummaries(void);
+static int            addDischarge(DateCache *dates, const DischargedPatient *record);
+static HitterSummary *findSummary(int month, int kind, int create);
+static void           countItem(HitterSummary *summary, const char *item);
+static long long      smallestCount(const HitterSummary *summary);
+static void           itemText(const Patient *patient, int kind, char item[]);
+static int            mergeSummaries(ItemTable *table, int kind, int fromMonth, int toMonth, long long *total,
+                                     long long *missingBound);
+static int            countArchive(ItemTable *table, int kind, int fromMonth, int toMonth, long long *total);
+static ItemTotal     *findItem(ItemTable *table, const char *item);
+static int            growItemSlots(ItemTable *table);
+static void           freeItemTable(ItemTable *table);
+static int            compareTotals(const void *a, const void *b);
+static int            promptChoice(const char *menu, int maxChoice);
+static int            promptTopCount(void);
+static void           printTopReport(ReportSink *sink, int kind, int mode, int fromMonth, int toMonth, int top);
+
+/*
+ * Adds the records to the summaries in memory, or reads them from the
+ * archive if earlier records are missing, then saves the summaries.
+ */
+int heavyHittersRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count)
+{
+    if(!summariesLoaded)
+    {
+        loadSummaries();
+    }
+
+    if(firstArchiveRecord != coveredRecords)
+    {
+        return updateSummaries();
+    }
+
+    DateCache dates;
+    initDateCache(&dates);
+
+    for(int i = 0; i < count; i++)
+    {
+        if(!addDischarge(&dates, &records[i]))
+        {
+            puts("Error: Not enough memory for the top diagnosis summaries.");
+            resetSummaries();
+            return 0;
+        }
+    }
+
+    coveredRecords += count;
+    return saveSummaries();
+}
+
+/*
+ * Prompts for the report and prints it to the console and top_reports.txt.
+ */
+void heavyHittersMenu(void)
+{
+    if(!summariesLoaded)
+    {
+        loadSummaries();
+    }
+
+    int kind = promptChoice("Report on:\n1: Most common diagnoses\n2: Room turnover (discharges per room)\n",
+                            KIND_ROOM);
+    int period = promptChoice("Period:\n1: This month\n2: This year\n3: A range of months\n", PERIOD_RANGE);
+
+    DateCache dates;
+    initDateCache(&dates);
+
+    int thisMonth = cachedMonthNumber(&dates, time(NULL));
+    int fromMonth = period == PERIOD_MONTH ? thisMonth : thisMonth - thisMonth % MONTHS_PER_YEAR;
+    int toMonth   = thisMonth;
+
+    if(period == PERIOD_RANGE)
+    {
+        char monthText[MONTH_TEXT_LENGTH];
+        char prompt[PROMPT_LENGTH];
+
+        formatMonthNumber(fromMonth, monthText);
+        snprintf(prompt, sizeof(prompt), "From month (YYYY-MM, Enter for %s):\n", monthText);
+        fromMonth = promptMonth(prompt, fromMonth);
+
+        formatMonthNumber(toMonth, monthText);
+        snprintf(prompt, sizeof(prompt), "To month, inclusive (YYYY-MM, Enter for %s):\n", monthText);
+        toMonth = promptMonth(prompt, toMonth);
+
+        if(toMonth < fromMonth)
+        {
+            puts("The range ends before it starts.");
+            return;
+        }
+    }
+
+    int mode = promptChoice("Counting:\n1: Approximate (from the monthly summaries)\n"
+                            "2: Exact (reads the whole discharge archive)\n",
+                            MODE_EXACT);
+    int top  = promptTopCount();
+
+    if(mode == MODE_APPROXIMATE && !updateSummaries())
+    {
+        return;
+    }
+
+    FILE *file = fopen(TOP_REPORT_FILE, "a");
+    if(file == NULL)
+    {
+        printf("Error opening file for writing!\n");
+        return;
+    }
+
+    fprintf(file, "\n");
+
+    ReportSink *sink = openReportSink(file, 1);
+    if(sink != NULL)
+    {
+        printTopReport(sink, kind, mode, fromMonth, toMonth, top);
+    }
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing %s\n", TOP_REPORT_FILE);
+        return;
+    }
+    printf("\nReport successfully written to %s\n", TOP_REPORT_FILE);
+}
+
+/*
+ * Reads heavy_hitters.dat. A missing or unreadable file leaves no
+ * summaries, so they are rebuilt from the whole archive.
+ */
+static void loadSummaries(void)
+{
+    summariesLoaded = 1;
+
+    FILE *file = fopen(SUMMARY_FILE, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    SummaryFileHeader header;
+    int               valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, SUMMARY_MAGIC, sizeof(SUMMARY_MAGIC)) == 0 &&
+                header.version == SUMMARY_VERSION;
+
+    for(int i = 0; valid && i < header.summaryCount; i++)
+    {
+        StoredSummary stored;
+
+        valid = fread(&stored, sizeof(stored), 1, file) == 1 && stored.counterCount >= 0 &&
+                stored.counterCount <= SUMMARY_CAPACITY;
+
+        HitterSummary *summary = valid ? findSummary(stored.month, stored.kind, 1) : NULL;
+        valid                  = summary != NULL;
+
+        for(int c = 0; valid && c < stored.counterCount; c++)
+        {
+            StoredCounter  counter;
+            HitterCounter *target = &summary->counters[c];
+
+            valid = fread(&counter, sizeof(counter), 1, file) == 1 && counter.itemLength >= 0 &&
+                    counter.itemLength < ITEM_LENGTH &&
+                    fread(target->item, 1, counter.itemLength, file) == (size_t) counter.itemLength;
+
+            if(valid)
+            {
+                target->item[counter.itemLength] = '\0';
+                target->count                    = counter.count;
+                target->error                    = counter.error;
+            }
+        }
+
+        if(valid)
+        {
+            summary->total        = stored.total;
+            summary->counterCount = stored.counterCount;
+        }
+    }
+
+    fclose(file);
+
+    if(!valid)
+    {
+        puts("Error reading heavy_hitters.dat. The top diagnosis summaries will be rebuilt.");
+        resetSummaries();
+        return;
+    }
+    coveredRecords = header.coveredRecords;
+}
+
+/*
+ * Adds the discharges archived since the summaries were saved and saves
+ * them again if any were added. Returns 0 if the summaries could not be
+ * updated.
+ */
+static int updateSummaries(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        resetSummaries();
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long long recordCount = ftell(file) / (long long) sizeof(DischargedPatient);
+
+    if(recordCount < coveredRecords)
+    {
+        resetSummaries();
+    }
+    if(recordCount == coveredRecords)
+    {
+        fclose(file);
+        return 1;
+    }
+
+    DischargedPatient *chunk = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    DateCache          dates;
+    int                ok = chunk != NULL && fseek(file, (long) (coveredRecords * sizeof(DischargedPatient)), SEEK_SET) == 0;
+    size_t             read;
+
+    initDateCache(&dates);
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            ok = addDischarge(&dates, &chunk[i]);
+        }
+        coveredRecords += ok ? (long long) read : 0;
+    }
+
+    free(chunk);
+    fclose(file);
+
+    if(!ok)
+    {
+        puts("Error: Not enough memory for the top diagnosis summaries.");
+        resetSummaries();
+        return 0;
+    }
+
+    return saveSummaries();
+}
+
+/*
+ * Writes every summary to heavy_hitters.tmp and renames it over
+ * heavy_hitters.dat.
+ */
+static int saveSummaries(void)
+{
+    FILE *file = fopen(SUMMARY_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating heavy_hitters.tmp");
+        return 0;
+    }
+
+    SummaryFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SUMMARY_MAGIC, sizeof(SUMMARY_MAGIC));
+    header.version        = SUMMARY_VERSION;
+    header.coveredRecords = coveredRecords;
+    header.summaryCount   = summaryCount;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int i = 0; written && i < summaryCount; i++)
+    {
+        const HitterSummary *summary = &summaries[i];
+        StoredSummary        stored;
+
+        memset(&stored, 0, sizeof(stored));
+        stored.month        = summary->month;
+        stored.kind         = summary->kind;
+        stored.total        = summary->total;
+        stored.counterCount = summary->counterCount;
+
+        written = fwrite(&stored, sizeof(stored), 1, file) == 1;
+
+        for(int c = 0; written && c < summary->counterCount; c++)
+        {
+            StoredCounter counter;
+
+            memset(&counter, 0, sizeof(counter));
+            counter.count      = summary->counters[c].count;
+            counter.error      = summary->counters[c].error;
+            counter.itemLength = (int) strlen(summary->counters[c].item);
+
+            written = fwrite(&counter, sizeof(counter), 1, file) == 1 &&
+                      fwrite(summary->counters[c].item, 1, counter.itemLength, file) == (size_t) counter.itemLength;
+        }
+    }
+
+    written = written && flushToDisk(file);
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing heavy_hitters.tmp");
+        remove(SUMMARY_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(SUMMARY_TEMP, SUMMARY_FILE))
+    {
+        perror("Error renaming heavy_hitters.tmp to heavy_hitters.dat");
+        remove(SUMMARY_TEMP);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Drops every summary so they are rebuilt from the first archive record.
+ */
+static void resetSummaries(void)
+{
+    free(summaries);
+    summaries       = NULL;
+    summaryCount    = 0;
+    summaryCapacity = 0;
+    coveredRecords  = 0;
+}
+
+/*
+ * Counts one discharge's diagnosis and room in its month's summaries.
+ */
+static int addDischarge(DateCache *dates, const DischargedPatient *record)
+{
+    int  month = cachedMonthNumber(dates, record->dischargeDate);
+    char item[ITEM_LENGTH];
+
+    HitterSummary *byDiagnosis = findSummary(month, KIND_DIAGNOSIS, 1);
+    if(byDiagnosis == NULL)
+    {
+        return 0;
+    }
+    itemText(&record->patient, KIND_DIAGNOSIS, item);
+    countItem(byDiagnosis, item);
+
+    HitterSummary *byRoom = findSummary(month, KIND_ROOM, 1);
+    if(byRoom == NULL)
+    {
+        return 0;
+    }
+    itemText(&record->patient, KIND_ROOM, item);
+    countItem(byRoom, item);
+    return 1;
+}
+
+/*
+ * Returns the summary of a month and kind, adding an empty one when create
+ * is set. Discharges arrive in time order, so the search starts from the
+ * newest summary.
+ */
+static HitterSummary *findSummary(int month, int kind, int create)
+{
+    for(int i = summaryCount - 1; i >= 0; i--)
+    {
+        if(summaries[i].month == month && summaries[i].kind == kind)
+        {
+            return &summaries[i];
+        }
+    }
+
+    if(!create)
+    {
+        return NULL;
+    }
+
+    if(summaryCount == summaryCapacity)
+    {
+        int            newCapacity = summaryCapacity == 0 ? MONTHS_PER_YEAR * 2 : summaryCapacity * 2;
+        HitterSummary *grown       = realloc(summaries, newCapacity * sizeof(HitterSummary));
+
+        if(grown == NULL)
+        {
+            return NULL;
+        }
+        summaries       = grown;
+        summaryCapacity = newCapacity;
+    }
+
+    HitterSummary *summary = &summaries[summaryCount++];
+    memset(summary, 0, sizeof(HitterSummary));
+    summary->month = month;
+    summary->kind  = kind;
+    return summary;
+}
+
+/*
+ * The Space-Saving update: count the item's counter, or give it a free
+ * counter, or let it take over the smallest one.
+ */
+static void countItem(HitterSummary *summary, const char *item)
+{
+    int smallest = 0;
+
+    summary->total++;
+
+    for(int c = 0; c < summary->counterCount; c++)
+    {
+        if(strcmp(summary->counters[c].item, item) == 0)
+        {
+            summary->counters[c].count++;
+            return;
+        }
+        if(summary->counters[c].count < summary->counters[smallest].count)
+        {
+            smallest = c;
+        }
+    }
+
+    HitterCounter *counter = &summary->counters[smallest];
+
+    if(summary->counterCount < SUMMARY_CAPACITY)
+    {
+        counter        = &summary->counters[summary->counterCount++];
+        counter->count = 0;
+    }
+
+    counter->error = counter->count;
+    counter->count++;
+    snprintf(counter->item, sizeof(counter->item), "%s", item);
+}
+
+/*
+ * Returns the most an item without a counter can have occurred: the
+ * smallest counter once every counter is in use, otherwise 0.
+ */
+static long long smallestCount(const HitterSummary *summary)
+{
+    if(summary->counterCount < SUMMARY_CAPACITY)
+    {
+        return 0;
+    }
+
+    long long smallest = summary->counters[0].count;
+    for(int c = 1; c < summary->counterCount; c++)
+    {
+        if(summary->counters[c].count < smallest)
+        {
+            smallest = summary->counters[c].count;
+        }
+    }
+    return smallest;
+}
+
+/*
+ * Gives the item a discharge is counted under: its normalised diagnosis or
+ * its room number.
+ */
+static void itemText(const Patient *patient, int kind, char item[])
+{
+    if(kind == KIND_ROOM)
+    {
+        snprintf(item, ITEM_LENGTH, "%d", patient->roomNumber);
+    }
+    else
+    {
+        normaliseText(patient->diagnosis, item, ITEM_LENGTH);
+    }
+}
+
+/*
+ * Adds every counter of the range's summaries to the table. missingBound
+ * receives the sum of the summaries' smallest counters, the most an item
+ * can have occurred in the months it has no counter.
+ */
+static int mergeSummaries(ItemTable *table, int kind, int fromMonth, int toMonth, long long *total,
+                          long long *missingBound)
+{
+    *total        = 0;
+    *missingBound = 0;
+
+    for(int i = 0; i < summaryCount; i++)
+    {
+        const HitterSummary *summary = &summaries[i];
+
+        if(summary->kind != kind || summary->month < fromMonth || summary->month > toMonth)
+        {
+            continue;
+        }
+
+        long long smallest = smallestCount(summary);
+        *total += summary->total;
+        *missingBound += smallest;
+
+        for(int c = 0; c < summary->counterCount; c++)
+        {
+            ItemTotal *item = findItem(table, summary->counters[c].item);
+            if(item == NULL)
+            {
+                return 0;
+            }
+            item->count += summary->counters[c].count;
+            item->error += summary->counters[c].error;
+            item->presentBound += smallest;
+        }
+    }
+
+    for(int i = 0; i < table->count; i++)
+    {
+        long long absent = *missingBound - table->items[i].presentBound;
+        table->items[i].count += absent;
+        table->items[i].error += absent;
+    }
+    return 1;
+}
+
+/*
+ * The exact mode: one pass over the archive, counting the range's
+ * discharges by item in the table.
+ */
+static int countArchive(ItemTable *table, int kind, int fromMonth, int toMonth, long long *total)
+{
+    *total = 0;
+
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return 1;
+    }
+
+    DischargedPatient *chunk = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    DateCache          dates;
+    int                ok = chunk != NULL;
+    size_t             read;
+    char               text[ITEM_LENGTH];
+
+    initDateCache(&dates);
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            int month = cachedMonthNumber(&dates, chunk[i].dischargeDate);
+            if(month < fromMonth || month > toMonth)
+            {
+                continue;
+            }
+
+            itemText(&chunk[i].patient, kind, text);
+            ItemTotal *item = findItem(table, text);
+
+            ok = item != NULL;
+            if(ok)
+            {
+                item->count++;
+                (*total)++;
+            }
+        }
+    }
+
+    free(chunk);
+    fclose(file);
+    return ok;
+}
+
+/*
+ * Returns the table's total for an item, adding a zeroed one if it is new.
+ */
+static ItemTotal *findItem(ItemTable *table, const char *item)
+{
+    if((table->count + 1) * 2 > table->slotCapacity && !growItemSlots(table))
+    {
+        return NULL;
+    }
+
+    int mask = table->slotCapacity - 1;
+    int slot = hashString(FNV_OFFSET_BASIS, item) & mask;
+
+    while(table->slots[slot] != EMPTY_SLOT)
+    {
+        ItemTotal *total = &table->items[table->slots[slot]];
+        if(strcmp(total->item, item) == 0)
+        {
+            return total;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if(table->count == table->capacity)
+    {
+        int        newCapacity = table->capacity == 0 ? MIN_TABLE_CAPACITY : table->capacity * 2;
+        ItemTotal *grown       = realloc(table->items, newCapacity * sizeof(ItemTotal));
+
+        if(grown == NULL)
+        {
+            return NULL;
+        }
+        table->items    = grown;
+        table->capacity = newCapacity;
+    }
+
+    ItemTotal *total = &table->items[table->count];
+    memset(total, 0, sizeof(ItemTotal));
+    snprintf(total->item, sizeof(total->item), "%s", item);
+
+    table->slots[slot] = table->count++;
+    return total;
+}
+
+/*
+ * Doubles the table's slots and reinserts every item.
+ */
+static int growItemSlots(ItemTable *table)
+{
+    int  newCapacity = table->slotCapacity == 0 ? MIN_TABLE_CAPACITY : table->slotCapacity * 2;
+    int *newSlots    = malloc(newCapacity * sizeof(int));
+
+    if(newSlots == NULL)
+    {
+        return 0;
+    }
+
+    for(int slot = 0; slot < newCapacity; slot++)
+    {
+        newSlots[slot] = EMPTY_SLOT;
+    }
+
+    for(int i = 0; i < table->count; i++)
+    {
+        int slot = hashString(FNV_OFFSET_BASIS, table->items[i].item) & (newCapacity - 1);
+
+        while(newSlots[slot] != EMPTY_SLOT)
+        {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newSlots[slot] = i;
+    }
+
+    free(table->slots);
+    table->slots        = newSlots;
+    table->slotCapacity = newCapacity;
+    return 1;
+}
+
+/*
+ * Frees a table's items and slots.
+ */
+static void freeItemTable(ItemTable *table)
+{
+    free(table->items);
+    free(table->slots);
+}
+
+/*
+ * Orders totals by count, largest first, then by item.
+ */
+static int compareTotals(const void *a, const void *b)
+{
+    const ItemTotal *first  = a;
+    const ItemTotal *second = b;
+
+    if(first->count != second->count)
+    {
+        return first->count < second->count ? 1 : -1;
+    }
+    return strcmp(first->item, second->item);
+}
+
+/*
+ * Shows a menu and reads a choice between 1 and maxChoice.
+ */
+static int promptChoice(const char *menu, int maxChoice)
+{
+    int choice;
+
+    printf("%s", menu);
+    while(1)
+    {
+        printf("Enter choice: ");
+        int read = scanf("%d", &choice);
+        clearInputBuffer();
+
+        if(read == SUCCESSFUL_READ && choice >= 1 && choice <= maxChoice)
+        {
+            return choice;
+        }
+        printf("Please enter a number between 1 and %d.\n", maxChoice);
+    }
+}
+
+/*
+ * Reads how many items to list; Enter gives DEFAULT_TOP.
+ */
+static int promptTopCount(void)
+{
+    char input[COUNT_INPUT_LENGTH];
+    int  top;
+
+    while(1)
+    {
+        printf("How many to list (1-%d, Enter for %d): ", MAX_TOP, DEFAULT_TOP);
+        if(fgets(input, sizeof(input), stdin) == NULL)
+        {
+            return DEFAULT_TOP;
+        }
+        if(strchr(input, '\n') == NULL)
+        {
+            clearInputBuffer();
+        }
+        if(input[strspn(input, " \t\n")] == '\0')
+        {
+            return DEFAULT_TOP;
+        }
+        if(sscanf(input, "%d", &top) == SUCCESSFUL_READ && top >= 1 && top <= MAX_TOP)
+        {
+            return top;
+        }
+        printf("Please enter a number between 1 and %d.\n", MAX_TOP);
+    }
+}
+
+/*
+ * Builds the item totals by merging summaries or counting the archive,
+ * sorts them and prints the first top of them.
+ */
+static void printTopReport(ReportSink *sink, int kind, int mode, int fromMonth, int toMonth, int top)
+{
+    ItemTable table        = { NULL, 0, 0, NULL, 0 };
+    long long total        = 0;
+    long long missingBound = 0;
+    int       ok           = mode == MODE_EXACT ? countArchive(&table, kind, fromMonth, toMonth, &total)
+                                                : mergeSummaries(&table, kind, fromMonth, toMonth, &total, &missingBound);
+
+    if(!ok)
+    {
+        puts("Error: Not enough memory for the top diagnosis report.");
+        freeItemTable(&table);
+        return;
+    }
+
+    qsort(table.items, table.count, sizeof(ItemTotal), compareTotals);
+
+    char fromText[MONTH_TEXT_LENGTH];
+    char toText[MONTH_TEXT_LENGTH];
+
+    formatMonthNumber(fromMonth, fromText);
+    formatMonthNumber(toMonth, toText);
+
+    sinkPrintf(sink, "   %s - %s to %s (%s)\n", kind == KIND_ROOM ? "Room Turnover" : "Most Common Diagnoses",
+               fromText, toText, mode == MODE_EXACT ? "exact" : "approximate");
+    sinkPrintf(sink, "=======================================\n");
+    sinkPrintf(sink, "Discharges: %lld\n", total);
+    sinkPrintf(sink, "%-5s| %-24s| %-9s| %-7s| %s\n", "Rank", kind == KIND_ROOM ? "Room" : "Diagnosis", "Count",
+               "Share", "Max Over");
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+    if(table.count == 0)
+    {
+        sinkPrintf(sink, "| No discharges in this range |\n");
+    }
+
+    int shown = table.count < top ? table.count : top;
+    for(int i = 0; i < shown; i++)
+    {
+        const ItemTotal *item = &table.items[i];
+
+        sinkPrintf(sink, "%-5d| %-24.24s| %-9lld| %5.1f%% | %lld\n", i + 1, item->item, item->count,
+                   total == 0 ? 0.0 : 100.0 * item->count / total, item->error);
+    }
+
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+    if(mode == MODE_APPROXIMATE)
+    {
+        long long unlisted = shown < table.count && table.items[shown].count > missingBound
+                                     ? table.items[shown].count
+                                     : missingBound;
+
+        sinkPrintf(sink, "Each true count is between Count - Max Over and Count.\n");
+        sinkPrintf(sink, "Anything not listed had at most %lld discharges.\n", unlisted);
+    }
+
+    freeItemTable(&table);
+}
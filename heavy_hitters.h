@@ -0,0 +1,42 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the top diagnosis and room turnover reports.
+ *          Each month keeps a Space-Saving summary of its discharges'
+ *          diagnoses and another of their rooms: a fixed number of
+ *          counters that always hold every item discharged more often than
+ *          1/64 of the month's discharges, each with a bound on how far its
+ *          count may be over. Reports for a month or a year merge at most a
+ *          year of summaries, whatever the size of the archive. An exact
+ *          mode counts the archive with a hash table instead.
+ */
+
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+#include "patient_management.h"
+
+/*
+ * Function: heavyHittersRecordDischarges
+ * --------------------------------------
+ * Adds newly archived discharges to their month's summaries and saves them
+ * to heavy_hitters.dat.
+ *
+ * records: The discharge records, in the order they were archived
+ * firstArchiveRecord: Position of records[0] in discharged_patients.dat
+ * count: Number of records
+ *
+ * Returns: 1 if the summaries were saved, 0 otherwise
+ */
+int heavyHittersRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count);
+
+/*
+ * Function: heavyHittersMenu
+ * --------------------------
+ * Prompts for diagnoses or rooms, a period, approximate or exact counting
+ * and how many to list, then shows the most frequent ones and appends the
+ * report to top_reports.txt.
+ */
+void heavyHittersMenu(void);
+
+#endif // HEAVY_HITTERS_H
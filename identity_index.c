@@ -0,0 +1,481 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the identity index. A name is normalised
+ *          and cut into letter trigrams ("  jo", " jon", ...). Each of
+ *          SIGNATURE_SIZE hash functions keeps its smallest trigram hash, and
+ *          two names agree on a position with a chance equal to the share of
+ *          trigrams they have in common. Every position is a band of its own,
+ *          so names sharing any one position are looked at; one typo leaves
+ *          a short name about half its trigrams, and missing all 32 positions
+ *          is then all but impossible. Candidates are compared by the edit
+ *          distance between the names themselves, not by the signatures.
+ *
+ *          Every entry is linked into one hash chain per band plus one for
+ *          the exact fingerprint. Chains hold entry positions, and removed
+ *          entries go on a free list for reuse.
+ */
+
+#include "identity_index.h"
+#include <stdlib.h>
+#include <string.h>
+#include "patient_data.h"
+#include "utils.h"
+
+// Private constants
+#define SIGNATURE_SIZE 32
+#define CHAIN_COUNT (SIGNATURE_SIZE + 1)
+#define FINGERPRINT_CHAIN 0
+#define MIN_BUCKET_CAPACITY 64
+#define NO_ENTRY (-1)
+
+static const double MIN_SIMILARITY = 0.5;
+static const int    MAX_TYPO_EDITS = 2;
+static const int    AGE_TOLERANCE  = 1;
+
+/*
+ * One indexed name and age. next links the entry into each chain; a free
+ * entry uses next[FINGERPRINT_CHAIN] for the free list.
+ */
+typedef struct
+{
+    char         name[MAX_PATIENT_NAME_LENGTH];
+    int          age;
+    int          key;
+    int          inUse;
+    unsigned int chainKeys[CHAIN_COUNT];
+    int          next[CHAIN_COUNT];
+} IdentityEntry;
+
+struct IdentityIndex
+{
+    IdentityEntry *entries;
+    int            entryCount;
+    int            entryCapacity;
+    int            freeEntry;
+    int            liveCount;
+    int           *buckets;
+    int            bucketCapacity;
+};
+
+// Function prototypes for internal helper functions
+static void         describeName(const char *name, int age, IdentityEntry *entry);
+static unsigned int mixHash(unsigned int hash);
+static int         *bucketOf(const IdentityIndex *index, int chain, unsigned int chainKey);
+static int          growBuckets(IdentityIndex *index);
+static void         linkEntry(IdentityIndex *index, int position);
+static void         unlinkEntry(IdentityIndex *index, int position);
+static double       similarityOf(const char *a, const char *b);
+static int          isListed(const IdentityMatch matches[], int count, int key);
+static int          addMatch(IdentityMatch matches[], int count, int maxMatches, int key, double similarity);
+
+/*
+ * Allocates an empty identity index.
+ */
+IdentityIndex *createIdentityIndex(void)
+{
+    IdentityIndex *index = malloc(sizeof(IdentityIndex));
+    if(index == NULL)
+    {
+        return NULL;
+    }
+
+    memset(index, 0, sizeof(IdentityIndex));
+    index->freeEntry = NO_ENTRY;
+    return index;
+}
+
+/*
+ * Frees every entry of the index and the index itself.
+ */
+void destroyIdentityIndex(IdentityIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    free(index->entries);
+    free(index->buckets);
+    free(index);
+}
+
+/*
+ * Removes every entry but keeps the allocations for reuse.
+ */
+void clearIdentityIndex(IdentityIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    index->entryCount = 0;
+    index->freeEntry  = NO_ENTRY;
+    index->liveCount  = 0;
+
+    for(int i = 0; i < CHAIN_COUNT * index->bucketCapacity; i++)
+    {
+        index->buckets[i] = NO_ENTRY;
+    }
+}
+
+/*
+ * Fills an entry, reusing a freed one if there is one, and links it into
+ * every chain.
+ */
+int identityIndexInsert(IdentityIndex *index, const char *name, int age, int key)
+{
+    if((index->liveCount + 1) * 2 > index->bucketCapacity && !growBuckets(index))
+    {
+        return 0;
+    }
+
+    int position = index->freeEntry;
+
+    if(position != NO_ENTRY)
+    {
+        index->freeEntry = index->entries[position].next[FINGERPRINT_CHAIN];
+    }
+    else
+    {
+        if(index->entryCount == index->entryCapacity)
+        {
+            int            newCapacity = index->entryCapacity == 0 ? MIN_BUCKET_CAPACITY : index->entryCapacity * 2;
+            IdentityEntry *grown       = realloc(index->entries, newCapacity * sizeof(IdentityEntry));
+
+            if(grown == NULL)
+            {
+                return 0;
+            }
+            index->entries       = grown;
+            index->entryCapacity = newCapacity;
+        }
+        position = index->entryCount++;
+    }
+
+    IdentityEntry *entry = &index->entries[position];
+    describeName(name, age, entry);
+    entry->key   = key;
+    entry->inUse = 1;
+
+    linkEntry(index, position);
+    index->liveCount++;
+    return 1;
+}
+
+/*
+ * Finds the entry through its fingerprint chain, unlinks it from every
+ * chain and frees it.
+ */
+void identityIndexRemove(IdentityIndex *index, const char *name, int age, int key)
+{
+    if(index == NULL || index->bucketCapacity == 0)
+    {
+        return;
+    }
+
+    IdentityEntry wanted;
+    describeName(name, age, &wanted);
+
+    int position = *bucketOf(index, FINGERPRINT_CHAIN, wanted.chainKeys[FINGERPRINT_CHAIN]);
+    while(position != NO_ENTRY && index->entries[position].key != key)
+    {
+        position = index->entries[position].next[FINGERPRINT_CHAIN];
+    }
+
+    if(position == NO_ENTRY)
+    {
+        return;
+    }
+
+    unlinkEntry(index, position);
+    index->entries[position].inUse                    = 0;
+    index->entries[position].next[FINGERPRINT_CHAIN] = index->freeEntry;
+    index->freeEntry                                  = position;
+    index->liveCount--;
+}
+
+/*
+ * Walks the fingerprint chain and each band's chain, scoring every entry
+ * whose key in that chain matches and that is not listed yet.
+ */
+int identityIndexSearch(const IdentityIndex *index, const char *name, int age, IdentityMatch matches[],
+                        int maxMatches)
+{
+    if(index == NULL || index->bucketCapacity == 0)
+    {
+        return 0;
+    }
+
+    IdentityEntry wanted;
+    int           count = 0;
+
+    describeName(name, age, &wanted);
+
+    for(int chain = 0; chain < CHAIN_COUNT; chain++)
+    {
+        int position = *bucketOf(index, chain, wanted.chainKeys[chain]);
+
+        for(; position != NO_ENTRY; position = index->entries[position].next[chain])
+        {
+            const IdentityEntry *entry = &index->entries[position];
+
+            if(entry->chainKeys[chain] != wanted.chainKeys[chain] || abs(entry->age - age) > AGE_TOLERANCE ||
+               isListed(matches, count, entry->key))
+            {
+                continue;
+            }
+
+            double similarity = similarityOf(entry->name, wanted.name);
+            if(similarity >= MIN_SIMILARITY)
+            {
+                count = addMatch(matches, count, maxMatches, entry->key, similarity);
+            }
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Normalises the name and computes its chain keys from its signature. The
+ * fingerprint covers the name and age; the bands cover the name only, so
+ * an age a year off still shares them.
+ */
+static void describeName(const char *name, int age, IdentityEntry *entry)
+{
+    normaliseText(name, entry->name, sizeof(entry->name));
+    entry->age = age;
+
+    // Two spaces in front and one behind give the first and last letters trigrams of their own
+    char   padded[MAX_PATIENT_NAME_LENGTH + 3];
+    size_t length = strlen(entry->name);
+
+    padded[0] = ' ';
+    padded[1] = ' ';
+    memcpy(padded + 2, entry->name, length);
+    padded[length + 2] = ' ';
+    length += 3;
+
+    unsigned int signature[SIGNATURE_SIZE];
+    for(int i = 0; i < SIGNATURE_SIZE; i++)
+    {
+        signature[i] = 0xffffffffu;
+    }
+
+    for(size_t start = 0; start + 3 <= length; start++)
+    {
+        unsigned int trigram = hashBytes(FNV_OFFSET_BASIS, padded + start, 3);
+
+        for(int i = 0; i < SIGNATURE_SIZE; i++)
+        {
+            unsigned int hash = mixHash(trigram ^ (0x9e3779b9u * (unsigned int) (i + 1)));
+            if(hash < signature[i])
+            {
+                signature[i] = hash;
+            }
+        }
+    }
+
+    unsigned int fingerprint = hashString(FNV_OFFSET_BASIS, entry->name);
+    entry->chainKeys[FINGERPRINT_CHAIN] = mixHash(fingerprint ^ (unsigned int) age);
+
+    for(int band = 0; band < SIGNATURE_SIZE; band++)
+    {
+        entry->chainKeys[band + 1] = mixHash((unsigned int) band ^ signature[band]);
+    }
+}
+
+/*
+ * The MurmurHash3 finalizer, which spreads every input bit over the result.
+ */
+static unsigned int mixHash(unsigned int hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/*
+ * Returns the head of the bucket a chain key falls in.
+ */
+static int *bucketOf(const IdentityIndex *index, int chain, unsigned int chainKey)
+{
+    return &index->buckets[chain * index->bucketCapacity + (int) (chainKey & (unsigned int) (index->bucketCapacity - 1))];
+}
+
+/*
+ * Doubles the buckets of every chain and relinks the live entries.
+ */
+static int growBuckets(IdentityIndex *index)
+{
+    int  newCapacity = index->bucketCapacity == 0 ? MIN_BUCKET_CAPACITY : index->bucketCapacity * 2;
+    int *newBuckets  = malloc(CHAIN_COUNT * newCapacity * sizeof(int));
+
+    if(newBuckets == NULL)
+    {
+        return 0;
+    }
+
+    free(index->buckets);
+    index->buckets        = newBuckets;
+    index->bucketCapacity = newCapacity;
+
+    for(int i = 0; i < CHAIN_COUNT * newCapacity; i++)
+    {
+        newBuckets[i] = NO_ENTRY;
+    }
+
+    for(int position = 0; position < index->entryCount; position++)
+    {
+        if(index->entries[position].inUse)
+        {
+            linkEntry(index, position);
+        }
+    }
+    return 1;
+}
+
+/*
+ * Pushes an entry onto the front of its bucket in every chain.
+ */
+static void linkEntry(IdentityIndex *index, int position)
+{
+    IdentityEntry *entry = &index->entries[position];
+
+    for(int chain = 0; chain < CHAIN_COUNT; chain++)
+    {
+        int *head          = bucketOf(index, chain, entry->chainKeys[chain]);
+        entry->next[chain] = *head;
+        *head              = position;
+    }
+}
+
+/*
+ * Takes an entry out of its bucket in every chain.
+ */
+static void unlinkEntry(IdentityIndex *index, int position)
+{
+    const IdentityEntry *entry = &index->entries[position];
+
+    for(int chain = 0; chain < CHAIN_COUNT; chain++)
+    {
+        int *link = bucketOf(index, chain, entry->chainKeys[chain]);
+
+        while(*link != NO_ENTRY && *link != position)
+        {
+            link = &index->entries[*link].next[chain];
+        }
+        if(*link == position)
+        {
+            *link = entry->next[chain];
+        }
+    }
+}
+
+/*
+ * Scores two normalised names as 1 less their edit distance over the longer
+ * length, counting a swap of neighbouring letters as one edit. Names more
+ * than MAX_TYPO_EDITS apart score 0.
+ */
+static double similarityOf(const char *a, const char *b)
+{
+    int lengthA = (int) strlen(a);
+    int lengthB = (int) strlen(b);
+    int longer  = lengthA > lengthB ? lengthA : lengthB;
+
+    if(abs(lengthA - lengthB) > MAX_TYPO_EDITS)
+    {
+        return 0;
+    }
+    if(longer == 0)
+    {
+        return 1;
+    }
+
+    // Row i of the distance table is kept in rows[i % 3], which is all a swap needs to look back
+    int rows[3][MAX_PATIENT_NAME_LENGTH + 1];
+
+    for(int j = 0; j <= lengthB; j++)
+    {
+        rows[0][j] = j;
+    }
+
+    for(int i = 1; i <= lengthA; i++)
+    {
+        int *current    = rows[i % 3];
+        int *last       = rows[(i + 2) % 3];
+        int *beforeLast = rows[(i + 1) % 3];
+
+        current[0] = i;
+        for(int j = 1; j <= lengthB; j++)
+        {
+            int cost     = a[i - 1] != b[j - 1];
+            int distance = last[j - 1] + cost;
+
+            if(last[j] + 1 < distance)
+            {
+                distance = last[j] + 1;
+            }
+            if(current[j - 1] + 1 < distance)
+            {
+                distance = current[j - 1] + 1;
+            }
+            if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] && beforeLast[j - 2] + 1 < distance)
+            {
+                distance = beforeLast[j - 2] + 1;
+            }
+            current[j] = distance;
+        }
+    }
+
+    int distance = rows[lengthA % 3][lengthB];
+    return distance > MAX_TYPO_EDITS ? 0 : 1.0 - (double) distance / longer;
+}
+
+/*
+ * Returns 1 if a key is already in the match list.
+ */
+static int isListed(const IdentityMatch matches[], int count, int key)
+{
+    for(int i = 0; i < count; i++)
+    {
+        if(matches[i].key == key)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Inserts a match in order of similarity, skipping keys already listed and
+ * dropping the least alike when the list is full. Returns the new count.
+ */
+static int addMatch(IdentityMatch matches[], int count, int maxMatches, int key, double similarity)
+{
+    if(isListed(matches, count, key))
+    {
+        return count;
+    }
+
+    int position = count < maxMatches ? count++ : maxMatches;
+    while(position > 0 && matches[position - 1].similarity < similarity)
+    {
+        if(position < maxMatches)
+        {
+            matches[position] = matches[position - 1];
+        }
+        position--;
+    }
+
+    if(position < maxMatches)
+    {
+        matches[position] = (IdentityMatch) { key, similarity };
+    }
+    return count;
+}
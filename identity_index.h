@@ -0,0 +1,104 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the patient identity index used to catch
+ *          duplicate admissions. Each entry is a name and age. An exact
+ *          fingerprint of the normalised name and age finds the same patient
+ *          in one lookup, and a MinHash signature of the name's letter
+ *          trigrams, split into bands, finds names a typo or two away
+ *          without comparing the name against every entry. The names found
+ *          are then checked by edit distance.
+ */
+
+#ifndef IDENTITY_INDEX_H
+#define IDENTITY_INDEX_H
+
+/*
+ * Opaque handle to an identity index. Each entry pairs a name and age with
+ * an integer key chosen by the owner (a patient ID).
+ */
+typedef struct IdentityIndex IdentityIndex;
+
+/*
+ * One entry found by identityIndexSearch and how alike its name is, from
+ * 0 to 1: 1 less the edit distance over the longer name's length, so 1 is
+ * the same name ignoring case and spacing.
+ */
+typedef struct
+{
+    int    key;
+    double similarity;
+} IdentityMatch;
+
+/*
+ * Function: createIdentityIndex
+ * -----------------------------
+ * Allocates an empty identity index.
+ *
+ * Returns: The new index, or NULL if memory could not be allocated
+ */
+IdentityIndex *createIdentityIndex(void);
+
+/*
+ * Function: destroyIdentityIndex
+ * ------------------------------
+ * Frees every entry of the index and the index itself.
+ *
+ * index: The index to free (may be NULL)
+ */
+void destroyIdentityIndex(IdentityIndex *index);
+
+/*
+ * Function: clearIdentityIndex
+ * ----------------------------
+ * Removes every entry, keeping the index ready for reuse.
+ *
+ * index: The index to clear (may be NULL)
+ */
+void clearIdentityIndex(IdentityIndex *index);
+
+/*
+ * Function: identityIndexInsert
+ * -----------------------------
+ * Adds an entry.
+ *
+ * index: The index
+ * name: The patient's name
+ * age: The patient's age in years
+ * key: The owner's key for the entry
+ *
+ * Returns: 1 on success, 0 if memory could not be allocated
+ */
+int identityIndexInsert(IdentityIndex *index, const char *name, int age, int key);
+
+/*
+ * Function: identityIndexRemove
+ * -----------------------------
+ * Removes the entry added with this name, age and key, if present.
+ *
+ * index: The index (may be NULL)
+ * name: The name the entry was added with
+ * age: The age the entry was added with
+ * key: The entry's key
+ */
+void identityIndexRemove(IdentityIndex *index, const char *name, int age, int key);
+
+/*
+ * Function: identityIndexSearch
+ * -----------------------------
+ * Finds the entries that may be the same person: a name at most two edits
+ * away (a swap of neighbouring letters is one edit) and at least half
+ * alike, and an age at most a year apart, most alike first.
+ *
+ * index: The index (may be NULL)
+ * name: The name to look for
+ * age: The age to look for
+ * matches: Receives up to maxMatches entries
+ * maxMatches: Capacity of matches
+ *
+ * Returns: The number of matches written
+ */
+int identityIndexSearch(const IdentityIndex *index, const char *name, int age, IdentityMatch matches[],
+                        int maxMatches);
+
+#endif // IDENTITY_INDEX_H
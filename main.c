@@ -8,11 +8,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "activity_calendar.h"
+#include "attending.h"
 #include "doctor_data.h"
 #include "doctor_schedule.h"
+#include "export.h"
+#include "facility.h"
+#include "heavy_hitters.h"
+#include "oncall.h"
 #include "patient_data.h"
+#include "patient_filter.h"
 #include "patient_management.h"
+#include "readmission.h"
+#include "report_query.h"
+#include "room_history.h"
+#include "room_usage.h"
+#include "roster.h"
+#include "stay_stats.h"
 #include "utils.h"
+#include "waitlist.h"
 
 // Constants representing menu options
 #define ENTER_PATIENT_RECORD 1
@@ -26,29 +40,68 @@
 #define PATIENT_DISCHARGE_REPORT 9
 #define DOC_SCHE_REPORT 10
 #define ROOM_USAGE_REPORT 11
-#define EXIT_PROGRAM 12
+#define SEARCH_PATIENT_BY_NAME 12
+#define SEARCH_BY_DIAGNOSIS 13
+#define DISCHARGE_MULTIPLE_PATIENTS 14
+#define ROOM_HISTORY_MENU 15
+#define WARD_OCCUPANCY_REPORT 16
+#define ADMISSION_WAITLIST 17
+#define EXPORT_DATA 18
+#define REPORT_QUERY 19
+#define FILTER_PATIENTS 20
+#define STAY_REPORT 21
+#define TOP_REPORT 22
+#define READMISSION_REPORT 23
+#define ACTIVITY_REPORT 24
+#define EXIT_PROGRAM 25
 
 #define DEFAULT_VALUE (-1)
 #define VALID_INPUT 1
 
+// Command line options
+#define DISCHARGE_OPTION "--discharge"
+#define EXPORT_OPTION "--export"
+
 // Function prototype for the main menu
 void menu();
 void doctorMenu();
+void onCallMenu();
+void caseloadMenu();
+void roomHistoryMenu();
+void waitlistMenu();
 int  getPatientReportChoice();
 static void handleRestoreConfirmation(void);
+static int  runCommandLine(int argc, char *argv[]);
+static int  runBatchDischarge(int argc, char *argv[]);
+static int  runCommandLineExport(int argc, char *argv[]);
 
 /*
  * Function: main
  * --------------
  * Entry point of the hospital management system.
- * Calls the menu function to interact with the user.
+ * Runs a single command when options are given, otherwise
+ * calls the menu function to interact with the user.
  */
-int main(void)
+int main(int argc, char *argv[])
 {
-    // Initialize systems
+    // Finish any interrupted discharge before the archive is read
+    recoverDischarges();
+
+    // Initialize systems (the facility layout and room history first, so they can track the loaded census)
+    initializeFacility();
+    initializeWaitlist();
+    initializeRoomHistory();
     initializePatientSystem();
     initializeDoctors();
     initializeSchedule();
+    initializeOnCall();
+    initializeAttending();
+    initializeRoomUsage();
+
+    if(argc > 1)
+    {
+        return runCommandLine(argc, argv);
+    }
 
     menu();
 
@@ -84,8 +137,21 @@ void menu()
                "9: Patient Discharge Report Menu\n"
                "10: Doctor Schedule Report\n"
                "11: Room Usage Report\n"
+               "12: Search Patient by Name.\n"
+               "13: Search Patients by Diagnosis.\n"
+               "14: Discharge Multiple Patients.\n"
+               "15: Room Occupancy History.\n"
+               "16: Ward Occupancy Report.\n"
+               "17: Admission Waitlist.\n"
+               "18: Export Data.\n"
+               "19: Report Query.\n"
+               "20: Filter Patients.\n"
+               "21: Length of Stay Report.\n"
+               "22: Top Diagnoses and Room Turnover.\n"
+               "23: Readmission Report.\n"
+               "24: Activity Report.\n"
                "\n"
-               "12: Exit.\n");
+               "25: Exit.\n");
 
         // Read user input and validate
         if(scanf("%d", &userInput) != VALID_INPUT)
@@ -142,12 +208,64 @@ void menu()
                 clearInputBuffer();
                 displayRoomUsageReport();
                 break;
+            case SEARCH_PATIENT_BY_NAME:
+                clearInputBuffer();
+                searchPatientByName();
+                break;
+            case SEARCH_BY_DIAGNOSIS:
+                clearInputBuffer();
+                searchPatientsByDiagnosis();
+                break;
+            case DISCHARGE_MULTIPLE_PATIENTS:
+                clearInputBuffer();
+                dischargeMultiplePatients();
+                break;
+            case ROOM_HISTORY_MENU:
+                clearInputBuffer();
+                roomHistoryMenu();
+                break;
+            case WARD_OCCUPANCY_REPORT:
+                clearInputBuffer();
+                displayWardOccupancyReport();
+                break;
+            case ADMISSION_WAITLIST:
+                clearInputBuffer();
+                waitlistMenu();
+                break;
+            case EXPORT_DATA:
+                clearInputBuffer();
+                exportData();
+                break;
+            case REPORT_QUERY:
+                clearInputBuffer();
+                reportQueryMenu();
+                break;
+            case FILTER_PATIENTS:
+                clearInputBuffer();
+                filterPatients();
+                break;
+            case STAY_REPORT:
+                clearInputBuffer();
+                displayStayReport();
+                break;
+            case TOP_REPORT:
+                clearInputBuffer();
+                heavyHittersMenu();
+                break;
+            case READMISSION_REPORT:
+                clearInputBuffer();
+                readmissionReport();
+                break;
+            case ACTIVITY_REPORT:
+                clearInputBuffer();
+                showActivityReport();
+                break;
             case EXIT_PROGRAM:
                 puts("Exiting program, have a nice day!\n");
                 clearMemory();
                 return;
             default:
-                printf("Invalid option. Please enter a number between 1 and 6.\n");
+                printf("Invalid option. Please enter a number between 1 and %d.\n", EXIT_PROGRAM);
         }
     }
     while(userInput != EXIT_PROGRAM);
@@ -170,7 +288,19 @@ void doctorMenu()
         printf("\nDoctor Menu\n"
                "1: Assign Doctor\n"
                "2: Print Full Schedule\n"
-               "3: Exit\n");
+               "3: Add Doctor\n"
+               "4: Update Doctor\n"
+               "5: Remove Doctor\n"
+               "6: List Doctors\n"
+               "7: Search Doctors by Name\n"
+               "8: Copy Week Roster\n"
+               "9: Who Is On Duty\n"
+               "10: Uncovered Shifts\n"
+               "11: Check Doctor Availability\n"
+               "12: Generate Roster\n"
+               "13: On-Call Blocks\n"
+               "14: Patient Caseloads\n"
+               "15: Exit\n");
 
         if(scanf("%d", &userInput) != VALID_INPUT)
         {
@@ -190,6 +320,54 @@ void doctorMenu()
                 printFullSchedule();
                 break;
             case 3:
+                clearInputBuffer();
+                addDoctor();
+                break;
+            case 4:
+                clearInputBuffer();
+                updateDoctor();
+                break;
+            case 5:
+                clearInputBuffer();
+                removeDoctor();
+                break;
+            case 6:
+                clearInputBuffer();
+                listDoctors();
+                break;
+            case 7:
+                clearInputBuffer();
+                searchDoctorsByName();
+                break;
+            case 8:
+                clearInputBuffer();
+                copyScheduleWeek();
+                break;
+            case 9:
+                clearInputBuffer();
+                showDoctorsOnDuty();
+                break;
+            case 10:
+                clearInputBuffer();
+                showUncoveredShifts();
+                break;
+            case 11:
+                clearInputBuffer();
+                checkDoctorAvailability();
+                break;
+            case 12:
+                clearInputBuffer();
+                generateRoster();
+                break;
+            case 13:
+                clearInputBuffer();
+                onCallMenu();
+                break;
+            case 14:
+                clearInputBuffer();
+                caseloadMenu();
+                break;
+            case 15:
                 puts("Exiting doctor menu...\n");
                 return;
             default:
@@ -201,6 +379,227 @@ void doctorMenu()
     while(userInput != EXIT_PROGRAM);
 }
 
+/*
+ * Function: onCallMenu
+ * --------------------
+ * Displays a menu for maintaining on-call blocks, which may have any length
+ * and are checked against the regular schedule.
+ * Repeats until the user chooses to go back.
+ */
+void onCallMenu()
+{
+    int userInput;
+
+    do
+    {
+        userInput = DEFAULT_VALUE;
+
+        printf("\nOn-Call Blocks\n"
+               "1: Add On-Call Block\n"
+               "2: Remove On-Call Block\n"
+               "3: List On-Call Blocks\n"
+               "4: Import On-Call Roster\n"
+               "5: Back\n");
+
+        if(scanf("%d", &userInput) != VALID_INPUT)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+
+        switch(userInput)
+        {
+            case 1:
+                clearInputBuffer();
+                addOnCallBlock();
+                break;
+            case 2:
+                clearInputBuffer();
+                removeOnCallBlock();
+                break;
+            case 3:
+                clearInputBuffer();
+                listOnCallBlocks();
+                break;
+            case 4:
+                clearInputBuffer();
+                importOnCallRoster();
+                break;
+            case 5:
+                clearInputBuffer();
+                return;
+            default:
+                printf("Not a valid input, please enter "
+                       "one of the options above.\n");
+                userInput = DEFAULT_VALUE;
+        }
+    }
+    while(1);
+}
+
+/*
+ * Function: caseloadMenu
+ * ----------------------
+ * Displays a menu for viewing and changing the attending doctors of
+ * admitted patients.
+ * Repeats until the user chooses to go back.
+ */
+void caseloadMenu()
+{
+    int userInput;
+
+    do
+    {
+        userInput = DEFAULT_VALUE;
+
+        printf("\nPatient Caseloads\n"
+               "1: Doctor's Current Patients\n"
+               "2: Caseload Balance Report\n"
+               "3: Change Attending Doctor\n"
+               "4: Back\n");
+
+        if(scanf("%d", &userInput) != VALID_INPUT)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+
+        switch(userInput)
+        {
+            case 1:
+                clearInputBuffer();
+                showDoctorCaseload();
+                break;
+            case 2:
+                clearInputBuffer();
+                printCaseloadReport();
+                break;
+            case 3:
+                clearInputBuffer();
+                changeAttendingDoctor();
+                break;
+            case 4:
+                clearInputBuffer();
+                return;
+            default:
+                printf("Not a valid input, please enter "
+                       "one of the options above.\n");
+                userInput = DEFAULT_VALUE;
+        }
+    }
+    while(1);
+}
+
+/*
+ * Function: roomHistoryMenu
+ * -------------------------
+ * Displays a menu of point-in-time and date-range room occupancy queries.
+ * Repeats until the user chooses to go back.
+ */
+void roomHistoryMenu()
+{
+    int userInput;
+
+    do
+    {
+        userInput = DEFAULT_VALUE;
+
+        printf("\nRoom Occupancy History\n"
+               "1: Who Was In A Room At A Given Time\n"
+               "2: Stays In A Room Between Two Dates\n"
+               "3: Room Utilization Between Two Dates\n"
+               "4: Back\n");
+
+        if(scanf("%d", &userInput) != VALID_INPUT)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+
+        switch(userInput)
+        {
+            case 1:
+                clearInputBuffer();
+                showRoomOccupantsAt();
+                break;
+            case 2:
+                clearInputBuffer();
+                showRoomStaysBetween();
+                break;
+            case 3:
+                clearInputBuffer();
+                showRoomUtilization();
+                break;
+            case 4:
+                clearInputBuffer();
+                return;
+            default:
+                printf("Not a valid input, please enter "
+                       "one of the options above.\n");
+                userInput = DEFAULT_VALUE;
+        }
+    }
+    while(1);
+}
+
+/*
+ * Function: waitlistMenu
+ * ----------------------
+ * Displays a menu for viewing and maintaining the admission waitlist.
+ * Patients join the waitlist from Enter Patient Record when no bed is free.
+ * Repeats until the user chooses to go back.
+ */
+void waitlistMenu()
+{
+    int userInput;
+
+    do
+    {
+        userInput = DEFAULT_VALUE;
+
+        printf("\nAdmission Waitlist (%d waiting)\n"
+               "1: View Waitlist\n"
+               "2: Change Triage Priority\n"
+               "3: Remove Patient From Waitlist\n"
+               "4: Back\n",
+               waitlistSize());
+
+        if(scanf("%d", &userInput) != VALID_INPUT)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+
+        switch(userInput)
+        {
+            case 1:
+                clearInputBuffer();
+                displayWaitlist();
+                break;
+            case 2:
+                clearInputBuffer();
+                changeWaitlistPriority();
+                break;
+            case 3:
+                clearInputBuffer();
+                removeFromWaitlist();
+                break;
+            case 4:
+                clearInputBuffer();
+                return;
+            default:
+                printf("Not a valid input, please enter "
+                       "one of the options above.\n");
+                userInput = DEFAULT_VALUE;
+        }
+    }
+    while(1);
+}
+
 /*
  * Function: getPatientReportChoice
  * --------------------------------
@@ -258,3 +657,68 @@ static void handleRestoreConfirmation(void)
         printf("Restore operation cancelled.\n");
     }
 }
+
+/*
+ * Dispatches a non-interactive command given on the command line.
+ * Returns the process exit status.
+ */
+static int runCommandLine(int argc, char *argv[])
+{
+    if(strcmp(argv[1], DISCHARGE_OPTION) == 0)
+    {
+        return runBatchDischarge(argc, argv);
+    }
+    if(strcmp(argv[1], EXPORT_OPTION) == 0 && (argc == 4 || argc == 5))
+    {
+        return runCommandLineExport(argc, argv);
+    }
+
+    printf("Usage:\n"
+           "  %s                                 Start the interactive menu\n"
+           "  %s --discharge ID ...              Discharge the listed patients in one batch\n"
+           "  %s --export DATASET FORMAT [FILE]  Export admissions, discharges, rooms or\n"
+           "                                     utilization as csv, jsonl or col\n",
+           argv[0], argv[0], argv[0]);
+    clearMemory();
+    return EXIT_FAILURE;
+}
+
+/*
+ * Handles --discharge: every following argument holds one or more
+ * comma-separated patient IDs, all discharged as a single batch.
+ */
+static int runBatchDischarge(int argc, char *argv[])
+{
+    int patientIds[MAX_BATCH_DISCHARGE];
+    int count = 0;
+
+    for(int i = 2; i < argc; i++)
+    {
+        int parsed = parseIntegerList(argv[i], &patientIds[count], MAX_BATCH_DISCHARGE - count);
+
+        if(parsed < 0)
+        {
+            printf("Invalid patient ID list: %s\n", argv[i]);
+            clearMemory();
+            return EXIT_FAILURE;
+        }
+        count += parsed;
+    }
+
+    int result = dischargePatientsById(patientIds, count);
+    clearMemory();
+
+    return result == BATCH_DISCHARGE_FAILED ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*
+ * Handles --export: writes one data set in one format, to the given file
+ * or to <dataset>.<format>.
+ */
+static int runCommandLineExport(int argc, char *argv[])
+{
+    long rows = runExport(argv[2], argv[3], argc == 5 ? argv[4] : NULL);
+    clearMemory();
+
+    return rows == EXPORT_FAILED ? EXIT_FAILURE : EXIT_SUCCESS;
+}
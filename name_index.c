@@ -0,0 +1,389 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the sorted name index as a treap (a randomized
+ *          balanced binary search tree, see treap.h) whose nodes also track
+ *          subtree sizes. The sizes let a search jump straight to the
+ *          requested page of results instead of walking every earlier match.
+ */
+
+#include "name_index.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "treap.h"
+
+// Private constants
+#define EMPTY_SIZE 0
+
+/*
+ * Node of the treap. Entries are ordered by case-folded name, then by key,
+ * so identical names for different records can coexist.
+ */
+typedef struct NameNode
+{
+    TreapLink link;
+    char     *name;
+    int       key;
+    int       size;
+} NameNode;
+
+struct NameIndex
+{
+    NameNode    *root;
+    unsigned int seed;
+};
+
+// Function prototypes for internal helper functions
+static int       compareFolded(const char *a, const char *b, size_t length, int prefixOnly);
+static int       compareEntry(const NameNode *node, const char *name, int key);
+static int       compareNodes(const TreapLink *a, const TreapLink *b);
+static NameNode *leftOf(const NameNode *node);
+static NameNode *rightOf(const NameNode *node);
+static int       sizeOf(const NameNode *node);
+static void      updateSize(TreapLink *link);
+static NameNode *findNode(NameNode *node, const char *name, int key);
+static void      freeNodes(NameNode *node);
+static int       countBefore(const NameNode *node, const char *query, size_t length, int prefixOnly, int inclusive);
+static const NameNode *selectNode(const NameNode *node, int rank);
+
+/*
+ * Allocates an empty name index.
+ */
+NameIndex *createNameIndex(void)
+{
+    NameIndex *index = malloc(sizeof(NameIndex));
+    if(index == NULL)
+    {
+        return NULL;
+    }
+
+    index->root = NULL;
+    index->seed = 2463534242u;
+    return index;
+}
+
+/*
+ * Frees every entry of the index and the index itself.
+ */
+void destroyNameIndex(NameIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    freeNodes(index->root);
+    free(index);
+}
+
+/*
+ * Removes every entry while keeping the index usable.
+ */
+void clearNameIndex(NameIndex *index)
+{
+    if(index == NULL)
+    {
+        return;
+    }
+
+    freeNodes(index->root);
+    index->root = NULL;
+}
+
+/*
+ * Adds a (name, key) pair to the index.
+ */
+int nameIndexInsert(NameIndex *index, const char *name, int key)
+{
+    NameNode *newNode = malloc(sizeof(NameNode));
+    if(newNode == NULL)
+    {
+        return 0;
+    }
+
+    newNode->name = malloc(strlen(name) + 1);
+    if(newNode->name == NULL)
+    {
+        free(newNode);
+        return 0;
+    }
+
+    strcpy(newNode->name, name);
+    newNode->key           = key;
+    newNode->link.priority = treapNextPriority(&index->seed);
+
+    index->root = (NameNode *) treapInsert((TreapLink *) index->root, &newNode->link, compareNodes, updateSize);
+    return 1;
+}
+
+/*
+ * Removes a (name, key) pair previously added with nameIndexInsert.
+ */
+int nameIndexRemove(NameIndex *index, const char *name, int key)
+{
+    NameNode *node = findNode(index->root, name, key);
+    if(node == NULL)
+    {
+        return 0;
+    }
+
+    index->root = (NameNode *) treapRemove((TreapLink *) index->root, &node->link, compareNodes, updateSize);
+    free(node->name);
+    free(node);
+    return 1;
+}
+
+/*
+ * Returns the number of entries in the index.
+ */
+int nameIndexSize(const NameIndex *index)
+{
+    return index == NULL ? EMPTY_SIZE : sizeOf(index->root);
+}
+
+/*
+ * Looks up names matching a query and returns one page of keys in name order.
+ * The matching entries always form one contiguous run of ranks [first, last),
+ * found with two descents of the tree; the page is then read by rank.
+ */
+int nameIndexSearch(const NameIndex *index,
+                    const char      *query,
+                    int              matchMode,
+                    int              offset,
+                    int              limit,
+                    int              keys[],
+                    int             *totalMatches)
+{
+    size_t length     = strlen(query);
+    int    prefixOnly = (matchMode == NAME_MATCH_PREFIX);
+    int    first      = countBefore(index->root, query, length, prefixOnly, 0);
+    int    last       = countBefore(index->root, query, length, prefixOnly, 1);
+    int    written    = 0;
+
+    if(offset < 0)
+    {
+        offset = 0;
+    }
+
+    if(matchMode != NAME_MATCH_EXACT)
+    {
+        if(totalMatches != NULL)
+        {
+            *totalMatches = last - first;
+        }
+
+        for(int rank = first + offset; rank < last && written < limit; rank++)
+        {
+            keys[written++] = selectNode(index->root, rank)->key;
+        }
+
+        return written;
+    }
+
+    // Case-sensitive matches are a subset of the case-insensitive run
+    int matches = 0;
+
+    for(int rank = first; rank < last; rank++)
+    {
+        const NameNode *node = selectNode(index->root, rank);
+
+        if(strcmp(node->name, query) != 0)
+        {
+            continue;
+        }
+
+        if(matches >= offset && written < limit)
+        {
+            keys[written++] = node->key;
+        }
+        matches++;
+    }
+
+    if(totalMatches != NULL)
+    {
+        *totalMatches = matches;
+    }
+
+    return written;
+}
+
+/*
+ * Compares two names ignoring case. When prefixOnly is set, only the first
+ * length characters of a are compared against b.
+ */
+static int compareFolded(const char *a, const char *b, size_t length, int prefixOnly)
+{
+    size_t i = 0;
+
+    while(!prefixOnly || i < length)
+    {
+        int charA = tolower((unsigned char) a[i]);
+        int charB = tolower((unsigned char) b[i]);
+
+        if(charA != charB)
+        {
+            return charA - charB;
+        }
+
+        if(charA == '\0')
+        {
+            return 0;
+        }
+
+        i++;
+    }
+
+    return 0;
+}
+
+/*
+ * Orders a node against a (name, key) pair: by folded name, then exact name,
+ * then key, so every stored pair has a unique position.
+ */
+static int compareEntry(const NameNode *node, const char *name, int key)
+{
+    int result = compareFolded(node->name, name, 0, 0);
+
+    if(result == 0)
+    {
+        result = strcmp(node->name, name);
+    }
+
+    if(result == 0)
+    {
+        result = (node->key > key) - (node->key < key);
+    }
+
+    return result;
+}
+
+/*
+ * Orders two nodes for the treap.
+ */
+static int compareNodes(const TreapLink *a, const TreapLink *b)
+{
+    const NameNode *other = (const NameNode *) b;
+    return compareEntry((const NameNode *) a, other->name, other->key);
+}
+
+/*
+ * Returns a node's left child.
+ */
+static NameNode *leftOf(const NameNode *node)
+{
+    return (NameNode *) node->link.left;
+}
+
+/*
+ * Returns a node's right child.
+ */
+static NameNode *rightOf(const NameNode *node)
+{
+    return (NameNode *) node->link.right;
+}
+
+/*
+ * Returns the number of nodes in a subtree.
+ */
+static int sizeOf(const NameNode *node)
+{
+    return node == NULL ? EMPTY_SIZE : node->size;
+}
+
+/*
+ * Recomputes a node's subtree size from its children.
+ */
+static void updateSize(TreapLink *link)
+{
+    NameNode *node = (NameNode *) link;
+    node->size     = 1 + sizeOf(leftOf(node)) + sizeOf(rightOf(node));
+}
+
+/*
+ * Returns the node holding (name, key), or NULL if there is none.
+ */
+static NameNode *findNode(NameNode *node, const char *name, int key)
+{
+    while(node != NULL)
+    {
+        int result = compareEntry(node, name, key);
+
+        if(result == 0)
+        {
+            return node;
+        }
+        node = result > 0 ? leftOf(node) : rightOf(node);
+    }
+
+    return NULL;
+}
+
+/*
+ * Frees a subtree and the names it owns.
+ */
+static void freeNodes(NameNode *node)
+{
+    if(node == NULL)
+    {
+        return;
+    }
+
+    freeNodes(leftOf(node));
+    freeNodes(rightOf(node));
+    free(node->name);
+    free(node);
+}
+
+/*
+ * Counts the entries that sort before the query (inclusive == 0) or
+ * not after it (inclusive == 1), ignoring case.
+ */
+static int countBefore(const NameNode *node, const char *query, size_t length, int prefixOnly, int inclusive)
+{
+    int count = 0;
+
+    while(node != NULL)
+    {
+        int result = compareFolded(node->name, query, length, prefixOnly);
+
+        if(result < 0 || (inclusive && result == 0))
+        {
+            count += sizeOf(leftOf(node)) + 1;
+            node = rightOf(node);
+        }
+        else
+        {
+            node = leftOf(node);
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Returns the node at the given zero-based rank.
+ */
+static const NameNode *selectNode(const NameNode *node, int rank)
+{
+    while(node != NULL)
+    {
+        int leftSize = sizeOf(leftOf(node));
+
+        if(rank < leftSize)
+        {
+            node = leftOf(node);
+        }
+        else if(rank == leftSize)
+        {
+            return node;
+        }
+        else
+        {
+            rank -= leftSize + 1;
+            node = rightOf(node);
+        }
+    }
+
+    return NULL;
+}
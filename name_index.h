@@ -0,0 +1,107 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines a sorted, case-insensitive name index.
+ *          Names are kept in an order-statistic tree so exact, prefix and
+ *          case-insensitive lookups return a page of matching keys in
+ *          logarithmic time, no matter how many names are indexed.
+ */
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+// Match modes accepted by nameIndexSearch
+#define NAME_MATCH_EXACT 1
+#define NAME_MATCH_EXACT_IGNORE_CASE 2
+#define NAME_MATCH_PREFIX 3
+
+/*
+ * Opaque handle to a name index. Each entry pairs a name with an integer key
+ * chosen by the owner (a patient ID, an archive record number, a doctor ID).
+ */
+typedef struct NameIndex NameIndex;
+
+/*
+ * Function: createNameIndex
+ * -------------------------
+ * Allocates an empty name index.
+ *
+ * Returns: The new index, or NULL if memory could not be allocated
+ */
+NameIndex *createNameIndex(void);
+
+/*
+ * Function: destroyNameIndex
+ * --------------------------
+ * Frees every entry of the index and the index itself.
+ *
+ * index: The index to free (may be NULL)
+ */
+void destroyNameIndex(NameIndex *index);
+
+/*
+ * Function: clearNameIndex
+ * ------------------------
+ * Removes every entry while keeping the index usable.
+ *
+ * index: The index to empty
+ */
+void clearNameIndex(NameIndex *index);
+
+/*
+ * Function: nameIndexInsert
+ * -------------------------
+ * Adds a (name, key) pair to the index.
+ *
+ * index: The index to update
+ * name: The name to index (copied)
+ * key: The owner's key for the record
+ *
+ * Returns: 1 on success, 0 if memory could not be allocated
+ */
+int nameIndexInsert(NameIndex *index, const char *name, int key);
+
+/*
+ * Function: nameIndexRemove
+ * -------------------------
+ * Removes a (name, key) pair previously added with nameIndexInsert.
+ *
+ * index: The index to update
+ * name: The indexed name
+ * key: The owner's key for the record
+ *
+ * Returns: 1 if the pair was found and removed, 0 otherwise
+ */
+int nameIndexRemove(NameIndex *index, const char *name, int key);
+
+/*
+ * Function: nameIndexSize
+ * -----------------------
+ * Returns: The number of entries in the index
+ */
+int nameIndexSize(const NameIndex *index);
+
+/*
+ * Function: nameIndexSearch
+ * -------------------------
+ * Looks up names matching a query and returns one page of keys in name order.
+ *
+ * index: The index to search
+ * query: The name or prefix to look for
+ * matchMode: NAME_MATCH_EXACT, NAME_MATCH_EXACT_IGNORE_CASE or NAME_MATCH_PREFIX
+ * offset: Number of matches to skip (for pagination)
+ * limit: Maximum number of keys to write to keys[]
+ * keys: Output array receiving up to limit keys
+ * totalMatches: Receives the total number of matches (may be NULL)
+ *
+ * Returns: The number of keys written to keys[]
+ */
+int nameIndexSearch(const NameIndex *index,
+                    const char      *query,
+                    int              matchMode,
+                    int              offset,
+                    int              limit,
+                    int              keys[],
+                    int             *totalMatches);
+
+#endif // NAME_INDEX_H
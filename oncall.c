@@ -0,0 +1,1002 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the on-call store.
+ *          Each doctor's blocks form a treap (see treap.h) ordered by start
+ *          time, where every node also keeps the latest end time in its
+ *          subtree. A search
+ *          for a block overlapping [lo, hi) skips any subtree whose latest end
+ *          is not after lo, so it follows a single path down the tree. Rest
+ *          gaps are checked the same way with the period widened by the
+ *          minimum rest. Every node is also listed in one array, which
+ *          saving, importing and removal by number walk.
+ *
+ *          oncall.dat holds a header followed by every block. An imported
+ *          roster is sorted together with the existing blocks by doctor and
+ *          start time, so every double-booking and short rest is found by
+ *          comparing each block with the latest-ending block before it.
+ */
+
+#include "oncall.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "doctor_data.h"
+#include "schedule_store.h"
+#include "treap.h"
+#include "utils.h"
+
+// Private constants
+#define INITIAL_NODE_CAPACITY 64
+#define CSV_LINE_LENGTH 128
+#define FILE_NAME_LENGTH 256
+#define TIME_TEXT_LENGTH 17
+#define DESCRIPTION_LENGTH 128
+#define MAX_LISTED_PROBLEMS 20
+
+static const char   ONCALL_MAGIC[4]     = { 'O', 'N', 'C', 'L' };
+static const int    ONCALL_VERSION      = 1;
+static const int    NO_CONFLICT         = 0;
+static const int    SHORT_REST          = 1;
+static const int    DOUBLE_BOOKED       = 2;
+static const long   MIN_REST_SECONDS    = ONCALL_MIN_REST_HOURS * 60L * 60;
+static const long   DEFAULT_BLOCK_HOURS = 12;
+static const long   SECONDS_PER_HOUR    = 60L * 60;
+static const long   SECONDS_PER_MINUTE  = 60;
+static const int    DAYS_PER_WEEK       = 7;
+static const char  *ONCALL_FILE         = "oncall.dat";
+static const char  *ONCALL_TEMP         = "oncall.tmp";
+
+/*
+ * Header at the start of oncall.dat.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+    int  count;
+    int  nextId;
+} OnCallFileHeader;
+
+/*
+ * A block in a doctor's treap. maxEnd is the latest end in the subtree and
+ * slot is the node's position in nodes[].
+ */
+typedef struct
+{
+    TreapLink   link;
+    OnCallBlock block;
+    time_t      maxEnd;
+    int         slot;
+} BlockNode;
+
+/*
+ * The root of one doctor's treap.
+ */
+typedef struct
+{
+    int        doctorId;
+    BlockNode *root;
+} DoctorTree;
+
+/*
+ * A block taking part in the import sweep. line is 0 for existing blocks.
+ */
+typedef struct
+{
+    OnCallBlock block;
+    int         line;
+} SweepEntry;
+
+static BlockNode **nodes         = NULL;
+static int         nodeCapacity  = 0;
+static int         blockCount    = 0;
+static int         nextBlockId   = 1;
+static DoctorTree *trees         = NULL;
+static int         treeCount     = 0;
+static unsigned    priorityState = 2463534242u;
+
+// Function prototypes for internal helper functions
+static int         loadOnCallFile(void);
+static int         saveOnCallFile(void);
+static int         insertBlock(const OnCallBlock *block);
+static int         deleteBlock(int blockId);
+static BlockNode  *newNode(const OnCallBlock *block);
+static void        releaseNode(BlockNode *node);
+static BlockNode  *leftOf(const BlockNode *node);
+static BlockNode  *rightOf(const BlockNode *node);
+static void        updateMaxEnd(TreapLink *link);
+static int         compareNodes(const TreapLink *a, const TreapLink *b);
+static BlockNode  *findOverlap(BlockNode *node, time_t lo, time_t hi);
+static int         collectOverlaps(const BlockNode *node, time_t lo, time_t hi, OnCallBlock **found, int *count,
+                                   int *capacity);
+static DoctorTree *findTree(int doctorId, int create);
+static int         checkBlock(int doctorId, time_t start, time_t end, char description[], size_t size);
+static int         findShiftConflict(int doctorId, time_t lo, time_t hi, char description[], size_t size);
+static int         readImportFile(FILE *file, SweepEntry **entries, int *count);
+static int         sweepEntries(SweepEntry entries[], int count, int *warnings);
+static int         compareSweepEntries(const void *a, const void *b);
+static int         compareBlockStarts(const void *a, const void *b);
+static int         appendEntry(SweepEntry **entries, int *count, int *capacity, const SweepEntry *entry);
+static void        formatTime(time_t when, char text[], size_t size);
+static void        printBlock(const OnCallBlock *block);
+
+/*
+ * Loads oncall.dat into the doctors' treaps.
+ */
+void initializeOnCall(void)
+{
+    if(loadOnCallFile())
+    {
+        printf("\nLoaded %d on-call blocks.\n", blockCount);
+    }
+}
+
+/*
+ * Returns 1 if any of the doctor's blocks overlaps [start, end).
+ */
+int isDoctorOnCall(int doctorId, time_t start, time_t end)
+{
+    DoctorTree *tree = findTree(doctorId, 0);
+    return tree != NULL && findOverlap(tree->root, start, end) != NULL;
+}
+
+/*
+ * Returns 1 if any of the doctor's blocks overlaps [start, end) widened by
+ * the minimum rest on both sides.
+ */
+int isDoctorOnCallNear(int doctorId, time_t start, time_t end)
+{
+    return isDoctorOnCall(doctorId, start - MIN_REST_SECONDS, end + MIN_REST_SECONDS);
+}
+
+/*
+ * Empties the doctor's treap and saves once.
+ */
+int removeDoctorOnCall(int doctorId)
+{
+    DoctorTree *tree    = findTree(doctorId, 0);
+    int         removed = 0;
+
+    while(tree != NULL && tree->root != NULL)
+    {
+        BlockNode *root = tree->root;
+        tree->root      = (BlockNode *) treapRemove(&root->link, &root->link, compareNodes, updateMaxEnd);
+        releaseNode(root);
+        removed++;
+    }
+
+    if(removed > 0 && !saveOnCallFile())
+    {
+        puts("Error saving oncall.dat.");
+    }
+
+    return removed;
+}
+
+/*
+ * Prompts for a block and adds it after checking it against the doctor's
+ * shifts and other blocks.
+ */
+void addOnCallBlock(void)
+{
+    char description[DESCRIPTION_LENGTH];
+    char confirm = YES;
+
+    OnCallBlock block;
+    block.doctorId = chooseDoctor();
+    block.start    = promptDateTime("On call from (YYYY-MM-DD HH:MM):\n", time(NULL));
+    block.end      = promptDateTime("On call until (YYYY-MM-DD HH:MM, Enter for 12 hours later):\n",
+                                    block.start + DEFAULT_BLOCK_HOURS * SECONDS_PER_HOUR);
+
+    if(block.end <= block.start)
+    {
+        puts("The block must end after it starts.");
+        return;
+    }
+
+    int conflict = checkBlock(block.doctorId, block.start, block.end, description, sizeof(description));
+
+    if(conflict == DOUBLE_BOOKED)
+    {
+        printf("Dr.%s is already booked: %s.\n", getDoctorWithId(block.doctorId)->name, description);
+        return;
+    }
+
+    if(conflict == SHORT_REST)
+    {
+        printf("Less than %ld hours of rest next to %s. Add anyway? (y/n)\n", MIN_REST_SECONDS / SECONDS_PER_HOUR,
+               description);
+        do
+        {
+            scanf(" %c", &confirm);
+            clearInputBuffer();
+        }
+        while(confirm != YES && confirm != NO);
+    }
+
+    if(confirm != YES)
+    {
+        puts("Block not added.");
+        return;
+    }
+
+    block.blockId = nextBlockId++;
+    if(!insertBlock(&block) || !saveOnCallFile())
+    {
+        puts("Error saving oncall.dat.");
+        return;
+    }
+
+    printf("On-call block #%d added.\n", block.blockId);
+}
+
+/*
+ * Prompts for a block number and removes the block.
+ */
+void removeOnCallBlock(void)
+{
+    int blockId;
+
+    printf("Enter on-call block number:\n");
+    if(scanf("%d", &blockId) != SUCCESSFUL_READ)
+    {
+        clearInputBuffer();
+        puts("Invalid input.");
+        return;
+    }
+    clearInputBuffer();
+
+    if(!deleteBlock(blockId))
+    {
+        puts("No on-call block has that number.");
+        return;
+    }
+
+    if(!saveOnCallFile())
+    {
+        puts("Error saving oncall.dat.");
+        return;
+    }
+
+    printf("On-call block #%d removed.\n", blockId);
+}
+
+/*
+ * Collects the blocks overlapping a date range from every treap and prints
+ * them in time order.
+ */
+void listOnCallBlocks(void)
+{
+    int    today    = toDayNumber(time(NULL));
+    time_t from     = promptDateTime("List from (YYYY-MM-DD, Enter for today):\n", dayNumberToTime(today));
+    int    fromDay  = toDayNumber(from);
+    time_t to       = promptDateTime("List to (YYYY-MM-DD, Enter for a week later):\n",
+                                     dayNumberToTime(fromDay + DAYS_PER_WEEK - 1));
+    time_t rangeEnd = dayNumberToTime(toDayNumber(to) + 1);
+
+    OnCallBlock *found    = NULL;
+    int          count    = 0;
+    int          capacity = 0;
+
+    for(int i = 0; i < treeCount; i++)
+    {
+        if(!collectOverlaps(trees[i].root, from, rangeEnd, &found, &count, &capacity))
+        {
+            puts("Error: Not enough memory to list the on-call blocks.");
+            free(found);
+            return;
+        }
+    }
+
+    if(count == 0)
+    {
+        puts("No on-call blocks in that range.");
+        free(found);
+        return;
+    }
+
+    qsort(found, count, sizeof(OnCallBlock), compareBlockStarts);
+
+    printf("%-6s%-30s%-18s%s\n", "Block", "Doctor", "From", "Until");
+    for(int i = 0; i < count; i++)
+    {
+        printBlock(&found[i]);
+    }
+
+    free(found);
+}
+
+/*
+ * Reads a CSV roster, validates it in one sweep and adds it as a whole.
+ */
+void importOnCallRoster(void)
+{
+    char fileName[FILE_NAME_LENGTH];
+
+    printf("Enter the CSV file to import:\n");
+    if(fgets(fileName, sizeof(fileName), stdin) == NULL)
+    {
+        return;
+    }
+    fileName[strcspn(fileName, "\r\n")] = '\0';
+
+    FILE *file = fopen(fileName, "r");
+    if(file == NULL)
+    {
+        perror("Error opening the roster file");
+        return;
+    }
+
+    SweepEntry *entries = NULL;
+    int         count   = 0;
+    int         errors  = readImportFile(file, &entries, &count);
+    int         warnings;
+
+    fclose(file);
+
+    int imported = 0;
+    for(int i = 0; i < count; i++)
+    {
+        imported += entries[i].line > 0;
+    }
+
+    errors += sweepEntries(entries, count, &warnings);
+
+    if(errors > 0)
+    {
+        printf("Import rejected: %d problems found.\n", errors);
+        free(entries);
+        return;
+    }
+
+    if(imported == 0)
+    {
+        puts("The file has no on-call blocks.");
+        free(entries);
+        return;
+    }
+
+    char confirm;
+    printf("%d blocks are valid (%d short rest warnings). Import them? (y/n)\n", imported, warnings);
+    do
+    {
+        scanf(" %c", &confirm);
+        clearInputBuffer();
+    }
+    while(confirm != YES && confirm != NO);
+
+    if(confirm == YES)
+    {
+        int added = 0;
+
+        for(int i = 0; i < count; i++)
+        {
+            if(entries[i].line > 0)
+            {
+                entries[i].block.blockId = nextBlockId++;
+                added += insertBlock(&entries[i].block);
+            }
+        }
+
+        if(saveOnCallFile())
+        {
+            printf("Imported %d on-call blocks.\n", added);
+        }
+        else
+        {
+            puts("Error saving oncall.dat.");
+        }
+    }
+
+    free(entries);
+}
+
+/*
+ * Reads oncall.dat. Returns 0 if there is no valid file.
+ */
+static int loadOnCallFile(void)
+{
+    FILE *file = fopen(ONCALL_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    OnCallFileHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, ONCALL_MAGIC, sizeof(ONCALL_MAGIC)) != 0 || header.version != ONCALL_VERSION ||
+       header.count < 0)
+    {
+        puts("\nError reading oncall.dat. Starting with no on-call blocks.");
+        fclose(file);
+        return 0;
+    }
+
+    OnCallBlock block;
+    for(int i = 0; i < header.count; i++)
+    {
+        if(fread(&block, sizeof(block), 1, file) != 1 || !insertBlock(&block))
+        {
+            puts("\nError reading oncall.dat. Some on-call blocks were not loaded.");
+            break;
+        }
+    }
+
+    nextBlockId = header.nextId;
+    fclose(file);
+    return 1;
+}
+
+/*
+ * Writes every block to oncall.tmp and renames it over oncall.dat.
+ */
+static int saveOnCallFile(void)
+{
+    FILE *file = fopen(ONCALL_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating oncall.tmp");
+        return 0;
+    }
+
+    OnCallFileHeader header;
+    memcpy(header.magic, ONCALL_MAGIC, sizeof(ONCALL_MAGIC));
+    header.version = ONCALL_VERSION;
+    header.count   = blockCount;
+    header.nextId  = nextBlockId;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(int i = 0; written && i < blockCount; i++)
+    {
+        written = fwrite(&nodes[i]->block, sizeof(OnCallBlock), 1, file) == 1;
+    }
+
+    written = written && flushToDisk(file);
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing oncall.tmp");
+        remove(ONCALL_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(ONCALL_TEMP, ONCALL_FILE))
+    {
+        perror("Error renaming oncall.tmp to oncall.dat");
+        remove(ONCALL_TEMP);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Adds a block to its doctor's treap.
+ */
+static int insertBlock(const OnCallBlock *block)
+{
+    DoctorTree *tree = findTree(block->doctorId, 1);
+    BlockNode  *node = tree == NULL ? NULL : newNode(block);
+
+    if(node == NULL)
+    {
+        puts("Error: Not enough memory for the on-call blocks.");
+        return 0;
+    }
+
+    tree->root = (BlockNode *) treapInsert((TreapLink *) tree->root, &node->link, compareNodes, updateMaxEnd);
+    return 1;
+}
+
+/*
+ * Removes a block by number. Returns 0 if there is no such block.
+ */
+static int deleteBlock(int blockId)
+{
+    for(int i = 0; i < blockCount; i++)
+    {
+        if(blockId > 0 && nodes[i]->block.blockId == blockId)
+        {
+            BlockNode  *node = nodes[i];
+            DoctorTree *tree = findTree(node->block.doctorId, 0);
+
+            tree->root = (BlockNode *) treapRemove((TreapLink *) tree->root, &node->link, compareNodes, updateMaxEnd);
+            releaseNode(node);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Allocates a node for a block and lists it at the end of nodes[].
+ */
+static BlockNode *newNode(const OnCallBlock *block)
+{
+    if(blockCount == nodeCapacity)
+    {
+        int         newCapacity = nodeCapacity == 0 ? INITIAL_NODE_CAPACITY : nodeCapacity * 2;
+        BlockNode **newNodes    = realloc(nodes, newCapacity * sizeof(BlockNode *));
+
+        if(newNodes == NULL)
+        {
+            return NULL;
+        }
+
+        nodes        = newNodes;
+        nodeCapacity = newCapacity;
+    }
+
+    BlockNode *node = malloc(sizeof(BlockNode));
+    if(node == NULL)
+    {
+        return NULL;
+    }
+
+    node->block         = *block;
+    node->link.priority = treapNextPriority(&priorityState);
+    node->slot          = blockCount;
+    nodes[blockCount++] = node;
+    return node;
+}
+
+/*
+ * Frees a node that is no longer in a treap, moving the last listed node
+ * into its slot.
+ */
+static void releaseNode(BlockNode *node)
+{
+    nodes[node->slot]       = nodes[--blockCount];
+    nodes[node->slot]->slot = node->slot;
+    free(node);
+}
+
+/*
+ * Returns a node's left child.
+ */
+static BlockNode *leftOf(const BlockNode *node)
+{
+    return (BlockNode *) node->link.left;
+}
+
+/*
+ * Returns a node's right child.
+ */
+static BlockNode *rightOf(const BlockNode *node)
+{
+    return (BlockNode *) node->link.right;
+}
+
+/*
+ * Recomputes a node's maxEnd from its block and children.
+ */
+static void updateMaxEnd(TreapLink *link)
+{
+    BlockNode *node   = (BlockNode *) link;
+    time_t     maxEnd = node->block.end;
+
+    if(leftOf(node) != NULL && leftOf(node)->maxEnd > maxEnd)
+    {
+        maxEnd = leftOf(node)->maxEnd;
+    }
+    if(rightOf(node) != NULL && rightOf(node)->maxEnd > maxEnd)
+    {
+        maxEnd = rightOf(node)->maxEnd;
+    }
+
+    node->maxEnd = maxEnd;
+}
+
+/*
+ * Orders blocks by start time, then block number.
+ */
+static int compareNodes(const TreapLink *a, const TreapLink *b)
+{
+    const OnCallBlock *left  = &((const BlockNode *) a)->block;
+    const OnCallBlock *right = &((const BlockNode *) b)->block;
+
+    if(left->start != right->start)
+    {
+        return left->start < right->start ? -1 : 1;
+    }
+    if(left->blockId != right->blockId)
+    {
+        return left->blockId < right->blockId ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Returns a node whose block overlaps [lo, hi), or NULL. If the left
+ * subtree ends after lo but holds no overlap, its latest-ending block starts
+ * at or after hi, and so does everything to the right; one path suffices.
+ */
+static BlockNode *findOverlap(BlockNode *node, time_t lo, time_t hi)
+{
+    while(node != NULL)
+    {
+        if(node->block.start < hi && node->block.end > lo)
+        {
+            return node;
+        }
+
+        if(leftOf(node) != NULL && leftOf(node)->maxEnd > lo)
+        {
+            node = leftOf(node);
+        }
+        else if(node->block.start < hi)
+        {
+            node = rightOf(node);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Appends every block in a subtree overlapping [lo, hi) to found[].
+ * Returns 0 if memory runs out.
+ */
+static int collectOverlaps(const BlockNode *node, time_t lo, time_t hi, OnCallBlock **found, int *count,
+                           int *capacity)
+{
+    if(node == NULL || node->maxEnd <= lo)
+    {
+        return 1;
+    }
+
+    if(!collectOverlaps(leftOf(node), lo, hi, found, count, capacity))
+    {
+        return 0;
+    }
+
+    if(node->block.start >= hi)
+    {
+        return 1;
+    }
+
+    if(node->block.end > lo)
+    {
+        if(*count == *capacity)
+        {
+            int          newCapacity = *capacity == 0 ? INITIAL_NODE_CAPACITY : *capacity * 2;
+            OnCallBlock *newFound    = realloc(*found, newCapacity * sizeof(OnCallBlock));
+
+            if(newFound == NULL)
+            {
+                return 0;
+            }
+
+            *found    = newFound;
+            *capacity = newCapacity;
+        }
+        (*found)[(*count)++] = node->block;
+    }
+
+    return collectOverlaps(rightOf(node), lo, hi, found, count, capacity);
+}
+
+/*
+ * Returns a doctor's treap, adding an empty one when create is set.
+ */
+static DoctorTree *findTree(int doctorId, int create)
+{
+    for(int i = 0; i < treeCount; i++)
+    {
+        if(trees[i].doctorId == doctorId)
+        {
+            return &trees[i];
+        }
+    }
+
+    if(!create)
+    {
+        return NULL;
+    }
+
+    DoctorTree *newTrees = realloc(trees, (treeCount + 1) * sizeof(DoctorTree));
+    if(newTrees == NULL)
+    {
+        return NULL;
+    }
+
+    trees                      = newTrees;
+    trees[treeCount].doctorId  = doctorId;
+    trees[treeCount].root      = NULL;
+    return &trees[treeCount++];
+}
+
+/*
+ * Checks a new block against the doctor's blocks and shifts. Returns
+ * DOUBLE_BOOKED, SHORT_REST or NO_CONFLICT and describes the clash.
+ */
+static int checkBlock(int doctorId, time_t start, time_t end, char description[], size_t size)
+{
+    DoctorTree *tree = findTree(doctorId, 0);
+    BlockNode  *root = tree == NULL ? NULL : tree->root;
+    char        fromText[TIME_TEXT_LENGTH];
+    BlockNode  *node;
+
+    for(int conflict = DOUBLE_BOOKED; conflict >= SHORT_REST; conflict--)
+    {
+        long   rest = conflict == SHORT_REST ? MIN_REST_SECONDS : 0;
+        time_t lo   = start - rest;
+        time_t hi   = end + rest;
+
+        if((node = findOverlap(root, lo, hi)) != NULL)
+        {
+            formatTime(node->block.start, fromText, sizeof(fromText));
+            snprintf(description, size, "on-call block #%d from %s", node->block.blockId, fromText);
+            return conflict;
+        }
+
+        if(findShiftConflict(doctorId, lo, hi, description, size))
+        {
+            return conflict;
+        }
+    }
+
+    return NO_CONFLICT;
+}
+
+/*
+ * Looks for one of the doctor's scheduled shifts overlapping [lo, hi).
+ * Shifts are at most a day long, so only the days from the one before lo
+ * to the one holding hi can reach the period.
+ */
+static int findShiftConflict(int doctorId, time_t lo, time_t hi, char description[], size_t size)
+{
+    for(int day = toDayNumber(lo) - 1; day <= toDayNumber(hi); day++)
+    {
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
+        {
+            const ShiftDefinition *shift = scheduleShift(shiftIndex);
+            time_t shiftStart = dayNumberToTime(day) + (time_t) shift->startMinute * SECONDS_PER_MINUTE;
+            time_t shiftEnd   = shiftStart + (time_t) shift->lengthMinutes * SECONDS_PER_MINUTE;
+
+            if(shiftStart < hi && shiftEnd > lo && scheduleDoctorAt(day, shiftIndex) == doctorId)
+            {
+                char startText[TIME_TEXT_LENGTH];
+
+                formatTime(shiftStart, startText, sizeof(startText));
+                snprintf(description, size, "%s shift from %s", shift->name, startText);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Parses every line of the roster into entries[] and adds the existing
+ * blocks after them. Returns the number of invalid lines.
+ */
+static int readImportFile(FILE *file, SweepEntry **entries, int *count)
+{
+    char line[CSV_LINE_LENGTH];
+    int  capacity   = 0;
+    int  lineNumber = 0;
+    int  errors     = 0;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        char       startText[CSV_LINE_LENGTH];
+        char       endText[CSV_LINE_LENGTH];
+        SweepEntry entry;
+
+        lineNumber++;
+        if(line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0')
+        {
+            continue;
+        }
+
+        entry.line           = lineNumber;
+        entry.block.blockId  = 0;
+
+        if(sscanf(line, " %d , %[^,] , %[^\r\n]", &entry.block.doctorId, startText, endText) != 3 ||
+           !parseDateTime(startText, &entry.block.start) || !parseDateTime(endText, &entry.block.end))
+        {
+            if(errors++ < MAX_LISTED_PROBLEMS)
+            {
+                printf("Line %d: expected doctor ID,YYYY-MM-DD HH:MM,YYYY-MM-DD HH:MM\n", lineNumber);
+            }
+            continue;
+        }
+
+        if(getDoctorWithId(entry.block.doctorId) == NULL || entry.block.end <= entry.block.start)
+        {
+            if(errors++ < MAX_LISTED_PROBLEMS)
+            {
+                printf("Line %d: %s\n", lineNumber,
+                       entry.block.end <= entry.block.start ? "the block ends before it starts" : "unknown doctor");
+            }
+            continue;
+        }
+
+        if(!appendEntry(entries, count, &capacity, &entry))
+        {
+            puts("Error: Not enough memory to read the roster.");
+            return errors + 1;
+        }
+    }
+
+    for(int i = 0; i < blockCount; i++)
+    {
+        SweepEntry existing = { nodes[i]->block, 0 };
+
+        if(!appendEntry(entries, count, &capacity, &existing))
+        {
+            puts("Error: Not enough memory to read the roster.");
+            return errors + 1;
+        }
+    }
+
+    return errors;
+}
+
+/*
+ * Sorts the entries by doctor and start time and compares each imported
+ * block with the latest-ending earlier block of the same doctor, and with
+ * the doctor's scheduled shifts. Returns the number of double-bookings and
+ * stores the number of short rest gaps in warnings.
+ */
+static int sweepEntries(SweepEntry entries[], int count, int *warnings)
+{
+    char description[DESCRIPTION_LENGTH];
+    int  errors  = 0;
+    int  latest  = 0;
+
+    *warnings = 0;
+    qsort(entries, count, sizeof(SweepEntry), compareSweepEntries);
+
+    for(int i = 0; i < count; i++)
+    {
+        const OnCallBlock *block = &entries[i].block;
+
+        if(entries[i].line > 0)
+        {
+            if(findShiftConflict(block->doctorId, block->start, block->end, description, sizeof(description)))
+            {
+                if(errors++ < MAX_LISTED_PROBLEMS)
+                {
+                    printf("Line %d: Dr.%s is already booked: %s.\n", entries[i].line,
+                           getDoctorWithId(block->doctorId)->name, description);
+                }
+            }
+            else if(findShiftConflict(block->doctorId, block->start - MIN_REST_SECONDS,
+                                      block->end + MIN_REST_SECONDS, description, sizeof(description)))
+            {
+                (*warnings)++;
+            }
+        }
+
+        if(i == 0 || entries[latest].block.doctorId != block->doctorId)
+        {
+            latest = i;
+            continue;
+        }
+
+        const SweepEntry *previous = &entries[latest];
+
+        // Two existing blocks were already accepted together, so only pairs with an imported block count
+        if(entries[i].line > 0 || previous->line > 0)
+        {
+            if(block->start < previous->block.end)
+            {
+                const SweepEntry *imported = entries[i].line > 0 ? &entries[i] : previous;
+                const SweepEntry *other    = imported == previous ? &entries[i] : previous;
+
+                if(errors++ < MAX_LISTED_PROBLEMS)
+                {
+                    if(other->line > 0)
+                    {
+                        printf("Line %d: Dr.%s is double-booked with line %d.\n", imported->line,
+                               getDoctorWithId(block->doctorId)->name, other->line);
+                    }
+                    else
+                    {
+                        printf("Line %d: Dr.%s is double-booked with on-call block #%d.\n", imported->line,
+                               getDoctorWithId(block->doctorId)->name, other->block.blockId);
+                    }
+                }
+            }
+            else if(block->start - previous->block.end < MIN_REST_SECONDS)
+            {
+                (*warnings)++;
+            }
+        }
+
+        if(block->end > previous->block.end)
+        {
+            latest = i;
+        }
+    }
+
+    return errors;
+}
+
+/*
+ * qsort comparison: by doctor, then start time.
+ */
+static int compareSweepEntries(const void *a, const void *b)
+{
+    const OnCallBlock *left  = &((const SweepEntry *) a)->block;
+    const OnCallBlock *right = &((const SweepEntry *) b)->block;
+
+    if(left->doctorId != right->doctorId)
+    {
+        return left->doctorId < right->doctorId ? -1 : 1;
+    }
+    return compareBlockStarts(left, right);
+}
+
+/*
+ * qsort comparison: by start time, then end time.
+ */
+static int compareBlockStarts(const void *a, const void *b)
+{
+    const OnCallBlock *left  = a;
+    const OnCallBlock *right = b;
+
+    if(left->start != right->start)
+    {
+        return left->start < right->start ? -1 : 1;
+    }
+    if(left->end != right->end)
+    {
+        return left->end < right->end ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Appends an entry to a growing array. Returns 0 if memory runs out.
+ */
+static int appendEntry(SweepEntry **entries, int *count, int *capacity, const SweepEntry *entry)
+{
+    if(*count == *capacity)
+    {
+        int         newCapacity = *capacity == 0 ? INITIAL_NODE_CAPACITY : *capacity * 2;
+        SweepEntry *newEntries  = realloc(*entries, newCapacity * sizeof(SweepEntry));
+
+        if(newEntries == NULL)
+        {
+            return 0;
+        }
+
+        *entries  = newEntries;
+        *capacity = newCapacity;
+    }
+
+    (*entries)[(*count)++] = *entry;
+    return 1;
+}
+
+/*
+ * Formats a time as YYYY-MM-DD HH:MM.
+ */
+static void formatTime(time_t when, char text[], size_t size)
+{
+    strftime(text, size, "%Y-%m-%d %H:%M", localtime(&when));
+}
+
+/*
+ * Prints one block as a row of the block list.
+ */
+static void printBlock(const OnCallBlock *block)
+{
+    const Doctor *doctor = getDoctorWithId(block->doctorId);
+    char          fromText[TIME_TEXT_LENGTH];
+    char          untilText[TIME_TEXT_LENGTH];
+
+    formatTime(block->start, fromText, sizeof(fromText));
+    formatTime(block->end, untilText, sizeof(untilText));
+    printf("#%-5dDr.%-27s%-18s%s\n", block->blockId, doctor == NULL ? "(removed)" : doctor->name, fromText,
+           untilText);
+}
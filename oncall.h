@@ -0,0 +1,109 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the on-call store. On-call blocks have any
+ *          start and end time, may overlap other doctors' blocks and are kept
+ *          in oncall.dat. Each doctor's blocks are indexed in an interval tree,
+ *          so double-booking and short rest gaps are found in O(log n) per
+ *          block, and an imported roster is validated in one sorted sweep.
+ */
+
+#ifndef ONCALL_H
+#define ONCALL_H
+
+#include <time.h>
+
+#define ONCALL_MIN_REST_HOURS 8
+
+/*
+ * One on-call block of a doctor, from start up to (not including) end.
+ */
+typedef struct
+{
+    int    blockId;
+    int    doctorId;
+    time_t start;
+    time_t end;
+} OnCallBlock;
+
+/*
+ * Function: initializeOnCall
+ * --------------------------
+ * Loads the on-call blocks from oncall.dat, or starts with none if the
+ * file does not exist.
+ */
+void initializeOnCall(void);
+
+/*
+ * Function: isDoctorOnCall
+ * ------------------------
+ * Checks whether a doctor has an on-call block overlapping a period.
+ *
+ * doctorId: The doctor to check
+ * start: The start of the period
+ * end: The end of the period
+ *
+ * Returns: 1 if any block overlaps the period, 0 otherwise
+ */
+int isDoctorOnCall(int doctorId, time_t start, time_t end);
+
+/*
+ * Function: isDoctorOnCallNear
+ * ----------------------------
+ * Checks whether a doctor has an on-call block within the minimum rest
+ * (ONCALL_MIN_REST_HOURS) of a period, or overlapping it.
+ *
+ * doctorId: The doctor to check
+ * start: The start of the period
+ * end: The end of the period
+ *
+ * Returns: 1 if any block leaves less than the minimum rest, 0 otherwise
+ */
+int isDoctorOnCallNear(int doctorId, time_t start, time_t end);
+
+/*
+ * Function: removeDoctorOnCall
+ * ----------------------------
+ * Removes every on-call block of a doctor (used when the doctor is removed)
+ * and saves oncall.dat.
+ *
+ * doctorId: The doctor whose blocks are removed
+ *
+ * Returns: The number of blocks removed
+ */
+int removeDoctorOnCall(int doctorId);
+
+/*
+ * Function: addOnCallBlock
+ * ------------------------
+ * Prompts for a doctor and a start and end time, and adds the block unless
+ * it overlaps one of the doctor's shifts or on-call blocks. A rest gap
+ * shorter than the minimum is flagged and needs confirmation.
+ */
+void addOnCallBlock(void);
+
+/*
+ * Function: removeOnCallBlock
+ * ---------------------------
+ * Prompts for a block number and removes that block.
+ */
+void removeOnCallBlock(void);
+
+/*
+ * Function: listOnCallBlocks
+ * --------------------------
+ * Prompts for a date range and lists the blocks overlapping it in time order.
+ */
+void listOnCallBlocks(void);
+
+/*
+ * Function: importOnCallRoster
+ * ----------------------------
+ * Prompts for a CSV file of "doctor ID,YYYY-MM-DD HH:MM,YYYY-MM-DD HH:MM"
+ * lines and validates all of it against itself, the existing blocks and the
+ * schedule in one sweep. The import is rejected if any line is invalid or
+ * double-books a doctor; otherwise it is added as a whole once confirmed.
+ */
+void importOnCallRoster(void);
+
+#endif // ONCALL_H
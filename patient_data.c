@@ -8,15 +8,17 @@
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include "attending.h"
+#include "doctor_data.h"
+#include "facility.h"
 #include "patient_data.h"
+#include "patient_management.h"
+#include "report_format.h"
 #include "utils.h"
 
 // Private constants
 #define IS_EMPTY 0
 
-static const int MAX_ROOM_NUMBER = 50;
-static const int MIN_ROOM_NUMBER = 1;
-
 static const int MIN_PATIENT_NAME_LENGTH = 1;
 static const int MIN_DIAGNOSIS_LENGTH = 1;
 
@@ -27,6 +29,9 @@ static const int NULL_TERMINATOR = 0;
 static const int NO_LETTERS = 0;
 static const int HAS_LETTERS = 1;
 
+/* Day of the last admission time printed, reused while listing many patients */
+static DateCache timestampCache;
+
 /*
  * Creates a new patient record with the given details.
  */
@@ -140,13 +145,12 @@ int validatePatientDiagnosis(char patientDiagnosis[])
 }
 
 /*
- * Validates if a room number is within acceptable range.
- * Note: This function only checks the range, not occupancy.
+ * Validates if a room number is part of the configured facility.
+ * Note: This function only checks the layout, not occupancy.
  */
 int validateRoomNumber(int roomNumber)
 {
-    if (roomNumber < MIN_ROOM_NUMBER || 
-        roomNumber > MAX_ROOM_NUMBER)
+    if (!facilityHasRoom(roomNumber))
     {
         return IS_NOT_VALID;
     }
@@ -165,7 +169,18 @@ void printPatient(const Patient patient)
     printf("Age: %d\n", patient.ageInYears);
     printf("Diagnosis: %s\n", patient.diagnosis);
     printf("Room Number: %d\n", patient.roomNumber);
-    printf("Time Admitted: %s", ctime(&patient.admissionDate));
+    char admittedText[TIMESTAMP_TEXT_LENGTH];
+    formatTimestamp(&timestampCache, patient.admissionDate, admittedText);
+    printf("Time Admitted: %s", admittedText);
+
+    // Archived records may share an ID with a later admission, so match the admission too
+    const Patient *admitted = findAdmittedPatient(patient.patientId);
+    const Doctor  *doctor   = getDoctorWithId(attendingDoctorOf(patient.patientId));
+
+    if(admitted != NULL && admitted->admissionDate == patient.admissionDate && doctor != NULL)
+    {
+        printf("Attending Doctor: Dr.%s\n", doctor->name);
+    }
     printf("---------------------------------------\n");
 }
 
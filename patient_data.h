@@ -13,6 +13,9 @@
 #define MAX_PATIENT_NAME_LENGTH 100
 #define MAX_DIAGNOSIS_LENGTH 255
 
+// Lowest valid room number; the highest comes from facility.cfg
+#define MIN_ROOM_NUMBER 1
+
 /*
  * Structure representing a patient in the system.
  * Contains identifying information and medical details.
@@ -82,7 +85,7 @@ int validatePatientDiagnosis(char patientDiagnosis[]);
 /*
  * Function: validateRoomNumber
  * ---------------------------
- * Validates if a room number is within acceptable range.
+ * Validates if a room number is part of the configured facility.
  * 
  * roomNumber: The room number to validate
  * 
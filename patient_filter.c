@@ -0,0 +1,1088 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements patient filter expressions.
+ *          The expression is parsed into a small tree, then compiled to a
+ *          flat program: every comparison becomes one test instruction with
+ *          a jump for true and one for false, so "and", "or" and "not" cost
+ *          nothing at run time and evaluation stops as soon as the result is
+ *          known. Number and time comparisons all become a half-open range
+ *          test. Within "and" and "or" the cheaper side is tested first.
+ *
+ *          Tests joined at the top level by "and" also narrow the search:
+ *          status picks the census or the archive, id = N is one hash lookup
+ *          in the census, and a discharged range is found by binary search
+ *          in the archive, whose records are appended at discharge time and
+ *          so are in discharge order, with the scan stopping past its end.
+ */
+
+#include "patient_filter.h"
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "facility.h"
+#include "patient_management.h"
+#include "report_format.h"
+#include "report_sink.h"
+#include "utils.h"
+
+// Private constants
+#define MAX_FILTER_NODES 64
+#define MAX_FILTER_LABELS (2 * MAX_FILTER_NODES + 2)
+#define MAX_ERROR_LENGTH 128
+#define ARCHIVE_CHUNK 256
+#define NO_NODE (-1)
+
+#define NODE_TEST 1
+#define NODE_AND 2
+#define NODE_OR 3
+#define NODE_NOT 4
+
+#define TEST_RANGE 1
+#define TEST_EQUALS 2
+#define TEST_CONTAINS 3
+
+#define FIELD_ID 1
+#define FIELD_AGE 2
+#define FIELD_ROOM 3
+#define FIELD_WARD 4
+#define FIELD_NAME 5
+#define FIELD_DIAGNOSIS 6
+#define FIELD_ADMITTED 7
+#define FIELD_DISCHARGED 8
+#define FIELD_STAY 9
+#define FIELD_STATUS 10
+
+#define TYPE_INTEGER 1
+#define TYPE_TEXT 2
+#define TYPE_TIME 3
+#define TYPE_DAYS 4
+#define TYPE_STATUS 5
+
+static const int       ACCEPT             = -1;
+static const int       REJECT             = -2;
+static const int       LABEL_ACCEPT       = 0;
+static const int       LABEL_REJECT       = 1;
+static const int       MAX_SHOWN_MATCHES  = 50;
+static const long long SECONDS_PER_DAY    = 24 * 60 * 60;
+static const long long SECONDS_PER_MINUTE = 60;
+static const int       STATUS_ADMITTED    = 0;
+static const int       STATUS_DISCHARGED  = 1;
+
+/*
+ * A field that can be tested and the type of its values.
+ */
+typedef struct
+{
+    const char *name;
+    int         field;
+    int         type;
+} FilterField;
+
+static const FilterField filterFields[] = {
+    { "id", FIELD_ID, TYPE_INTEGER },          { "age", FIELD_AGE, TYPE_INTEGER },
+    { "room", FIELD_ROOM, TYPE_INTEGER },      { "ward", FIELD_WARD, TYPE_TEXT },
+    { "name", FIELD_NAME, TYPE_TEXT },         { "diagnosis", FIELD_DIAGNOSIS, TYPE_TEXT },
+    { "admitted", FIELD_ADMITTED, TYPE_TIME }, { "discharged", FIELD_DISCHARGED, TYPE_TIME },
+    { "stay", FIELD_STAY, TYPE_DAYS },         { "status", FIELD_STATUS, TYPE_STATUS },
+};
+
+static const int FIELD_COUNT = (int) (sizeof(filterFields) / sizeof(filterFields[0]));
+
+/*
+ * One comparison: a range [low, high) for numbers and times, or text for
+ * text fields (stored lowercase in the filter's text pool).
+ */
+typedef struct
+{
+    int       test;
+    int       field;
+    long long low;
+    long long high;
+    int       textOffset;
+} FilterTest;
+
+/*
+ * A node of the parsed expression.
+ */
+typedef struct
+{
+    int        kind;
+    int        left;
+    int        right;
+    FilterTest test;
+} FilterNode;
+
+/*
+ * One instruction of a compiled filter: a test and where to continue when
+ * it is true or false (the next instruction, ACCEPT or REJECT).
+ */
+typedef struct
+{
+    FilterTest test;
+    int        onTrue;
+    int        onFalse;
+} FilterInstruction;
+
+struct PatientFilter
+{
+    FilterInstruction program[MAX_FILTER_NODES];
+    int               length;
+    char              texts[2 * MAX_FILTER_LENGTH];
+    int               textLength;
+    time_t            now;
+
+    // What the top-level tests allow, so records outside can be skipped
+    int       searchAdmitted;
+    int       searchDischarged;
+    long long idLow;
+    long long idHigh;
+    long long dischargedLow;
+    long long dischargedHigh;
+};
+
+/*
+ * State while parsing and compiling one expression.
+ */
+typedef struct
+{
+    const char    *text;
+    int            position;
+    char          *error;
+    size_t         errorSize;
+    int            failed;
+    FilterNode     nodes[MAX_FILTER_NODES];
+    int            nodeCount;
+    int            labels[MAX_FILTER_LABELS];
+    int            labelCount;
+    PatientFilter *filter;
+} FilterParser;
+
+// Function prototypes for internal helper functions
+static int         parseOr(FilterParser *parser);
+static int         parseAnd(FilterParser *parser);
+static int         parseNot(FilterParser *parser);
+static int         parseTest(FilterParser *parser);
+static int         parseValue(FilterParser *parser, int type, long long *low, long long *high, char text[]);
+static int         parseTime(FilterParser *parser, const char *word, long long *low, long long *high);
+static int         readWord(FilterParser *parser, char word[]);
+static int         matchKeyword(FilterParser *parser, const char *keyword);
+static int         matchSymbol(FilterParser *parser, const char *symbol);
+static void        skipSpaces(FilterParser *parser);
+static int         addNode(FilterParser *parser, int kind, int left, int right);
+static void        parseError(FilterParser *parser, const char *message);
+static int         storeText(FilterParser *parser, const char *text);
+static int         nodeCost(const FilterParser *parser, int node);
+static void        compileNode(FilterParser *parser, int node, int onTrue, int onFalse);
+static int         newLabel(FilterParser *parser);
+static void        narrowSearch(FilterParser *parser, int node);
+static int         fieldNumber(const PatientFilter *filter, int field, const Patient *patient, time_t dischargeDate,
+                               long long *value);
+static const char *fieldText(int field, const Patient *patient);
+static int         equalsIgnoreCase(const char *text, const char *lowered);
+static int         containsIgnoreCase(const char *text, const char *lowered);
+static long        firstDischargeFrom(FILE *file, long recordCount, long long when);
+static void        showMatch(ReportSink *sink, DateCache *dates, const Patient *patient, time_t dischargeDate);
+
+/*
+ * Parses the whole expression into a tree, then compiles the tree into the
+ * flat program and works out which records can be skipped.
+ */
+PatientFilter *compilePatientFilter(const char *text, char error[], size_t errorSize)
+{
+    FilterParser  *parser = calloc(1, sizeof(FilterParser));
+    PatientFilter *filter = calloc(1, sizeof(PatientFilter));
+
+    if(parser == NULL || filter == NULL)
+    {
+        snprintf(error, errorSize, "not enough memory");
+        free(parser);
+        free(filter);
+        return NULL;
+    }
+
+    parser->text      = text;
+    parser->error     = error;
+    parser->errorSize = errorSize;
+    parser->filter    = filter;
+    filter->now       = time(NULL);
+
+    if(strlen(text) >= MAX_FILTER_LENGTH)
+    {
+        parseError(parser, "the filter is too long");
+    }
+
+    int root = parser->failed ? NO_NODE : parseOr(parser);
+
+    skipSpaces(parser);
+    if(!parser->failed && parser->text[parser->position] != '\0')
+    {
+        parseError(parser, "expected and, or or the end of the filter");
+    }
+
+    if(parser->failed)
+    {
+        free(parser);
+        free(filter);
+        return NULL;
+    }
+
+    // Labels 0 and 1 stand for accept and reject
+    parser->labels[LABEL_ACCEPT] = ACCEPT;
+    parser->labels[LABEL_REJECT] = REJECT;
+    parser->labelCount           = 2;
+    compileNode(parser, root, LABEL_ACCEPT, LABEL_REJECT);
+
+    for(int pc = 0; pc < filter->length; pc++)
+    {
+        filter->program[pc].onTrue  = parser->labels[filter->program[pc].onTrue];
+        filter->program[pc].onFalse = parser->labels[filter->program[pc].onFalse];
+    }
+
+    filter->searchAdmitted   = 1;
+    filter->searchDischarged = 1;
+    filter->idLow            = LLONG_MIN;
+    filter->idHigh           = LLONG_MAX;
+    filter->dischargedLow    = LLONG_MIN;
+    filter->dischargedHigh   = LLONG_MAX;
+    narrowSearch(parser, root);
+
+    free(parser);
+    return filter;
+}
+
+/*
+ * Runs the program from the first instruction until it accepts or rejects.
+ */
+int patientFilterMatches(const PatientFilter *filter, const Patient *patient, time_t dischargeDate)
+{
+    int pc = 0;
+
+    while(pc >= 0)
+    {
+        const FilterInstruction *instruction = &filter->program[pc];
+        const FilterTest        *test        = &instruction->test;
+        int                      result;
+        long long                value;
+
+        switch(test->test)
+        {
+            case TEST_RANGE:
+                result = fieldNumber(filter, test->field, patient, dischargeDate, &value) && value >= test->low &&
+                         value < test->high;
+                break;
+            case TEST_EQUALS:
+                result = equalsIgnoreCase(fieldText(test->field, patient), &filter->texts[test->textOffset]);
+                break;
+            default:
+                result = containsIgnoreCase(fieldText(test->field, patient), &filter->texts[test->textOffset]);
+                break;
+        }
+
+        pc = result ? instruction->onTrue : instruction->onFalse;
+    }
+
+    return pc == ACCEPT;
+}
+
+/*
+ * Frees the filter; it is a single allocation.
+ */
+void freePatientFilter(PatientFilter *filter)
+{
+    free(filter);
+}
+
+/*
+ * Reads a filter, then walks the census and the part of the archive it can
+ * match, showing the first matches and counting the rest.
+ */
+void filterPatients(void)
+{
+    char text[MAX_FILTER_LENGTH + 2];
+    char error[MAX_ERROR_LENGTH];
+
+    printf("Enter a filter, e.g. age > 65 and room in 10..20 and admitted >= today-7\n"
+           "Fields: id age room ward name diagnosis admitted discharged stay status\n");
+    if(fgets(text, sizeof(text), stdin) == NULL)
+    {
+        return;
+    }
+    text[strcspn(text, "\r\n")] = '\0';
+
+    PatientFilter *filter = compilePatientFilter(text, error, sizeof(error));
+    if(filter == NULL)
+    {
+        printf("Invalid filter: %s\n", error);
+        return;
+    }
+
+    ReportSink *sink = openReportSink(NULL, 1);
+    if(sink == NULL)
+    {
+        freePatientFilter(filter);
+        return;
+    }
+
+    DateCache dates;
+    long      admittedMatches   = 0;
+    long      dischargedMatches = 0;
+    long      checked           = 0;
+
+    initDateCache(&dates);
+
+    if(filter->searchAdmitted && filter->idHigh - filter->idLow == 1 && filter->idLow > 0 &&
+       filter->idLow <= INT_MAX)
+    {
+        const Patient *patient = findAdmittedPatient((int) filter->idLow);
+
+        checked += patient != NULL;
+        if(patient != NULL && patientFilterMatches(filter, patient, 0))
+        {
+            showMatch(sink, &dates, patient, 0);
+            admittedMatches++;
+        }
+    }
+    else if(filter->searchAdmitted)
+    {
+        for(const PatientNode *node = admittedPatients(); node != NULL; node = node->nextNode)
+        {
+            checked++;
+            if(patientFilterMatches(filter, &node->data, 0) && ++admittedMatches <= MAX_SHOWN_MATCHES)
+            {
+                showMatch(sink, &dates, &node->data, 0);
+            }
+        }
+    }
+
+    FILE              *file  = filter->searchDischarged ? fopen("discharged_patients.dat", "rb") : NULL;
+    DischargedPatient *chunk = file != NULL ? malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient)) : NULL;
+
+    if(chunk != NULL && fseek(file, 0, SEEK_END) == 0)
+    {
+        long   recordCount = ftell(file) / (long) sizeof(DischargedPatient);
+        long   first       = firstDischargeFrom(file, recordCount, filter->dischargedLow);
+        int    pastRange   = 0;
+        size_t read;
+
+        fseek(file, first * (long) sizeof(DischargedPatient), SEEK_SET);
+        while(!pastRange && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+        {
+            for(size_t i = 0; i < read; i++)
+            {
+                if(chunk[i].dischargeDate >= filter->dischargedHigh)
+                {
+                    pastRange = 1;
+                    break;
+                }
+
+                checked++;
+                if(patientFilterMatches(filter, &chunk[i].patient, chunk[i].dischargeDate) &&
+                   admittedMatches + ++dischargedMatches <= MAX_SHOWN_MATCHES)
+                {
+                    showMatch(sink, &dates, &chunk[i].patient, chunk[i].dischargeDate);
+                }
+            }
+        }
+    }
+
+    free(chunk);
+    if(file != NULL)
+    {
+        fclose(file);
+    }
+
+    long matches = admittedMatches + dischargedMatches;
+    if(matches > MAX_SHOWN_MATCHES)
+    {
+        sinkPrintf(sink, "Showing the first %d matches.\n", MAX_SHOWN_MATCHES);
+    }
+    sinkPrintf(sink, "Matched %ld admitted and %ld discharged patients (%ld records checked).\n", admittedMatches,
+               dischargedMatches, checked);
+
+    closeReportSink(sink);
+    freePatientFilter(filter);
+}
+
+/*
+ * or-expression: and-expressions joined by "or".
+ */
+static int parseOr(FilterParser *parser)
+{
+    int node = parseAnd(parser);
+
+    while(!parser->failed && matchKeyword(parser, "or"))
+    {
+        node = addNode(parser, NODE_OR, node, parseAnd(parser));
+    }
+    return node;
+}
+
+/*
+ * and-expression: terms joined by "and".
+ */
+static int parseAnd(FilterParser *parser)
+{
+    int node = parseNot(parser);
+
+    while(!parser->failed && matchKeyword(parser, "and"))
+    {
+        node = addNode(parser, NODE_AND, node, parseNot(parser));
+    }
+    return node;
+}
+
+/*
+ * term: "not" term, a parenthesised expression or a comparison.
+ */
+static int parseNot(FilterParser *parser)
+{
+    if(parser->failed)
+    {
+        return NO_NODE;
+    }
+
+    if(matchKeyword(parser, "not"))
+    {
+        return addNode(parser, NODE_NOT, parseNot(parser), NO_NODE);
+    }
+
+    if(matchSymbol(parser, "("))
+    {
+        int node = parseOr(parser);
+
+        if(!parser->failed && !matchSymbol(parser, ")"))
+        {
+            parseError(parser, "expected )");
+        }
+        return node;
+    }
+
+    return parseTest(parser);
+}
+
+/*
+ * comparison: field followed by an operator and a value, "in LOW..HIGH" or
+ * "contains TEXT". Every number or time value stands for a range
+ * [low, high), so each operator picks a side of it.
+ */
+static int parseTest(FilterParser *parser)
+{
+    char word[MAX_FILTER_LENGTH];
+    char text[MAX_FILTER_LENGTH];
+
+    if(!readWord(parser, word))
+    {
+        parseError(parser, "expected a field name");
+        return NO_NODE;
+    }
+
+    const FilterField *field = NULL;
+    for(int i = 0; i < FIELD_COUNT; i++)
+    {
+        if(strcmp(filterFields[i].name, word) == 0)
+        {
+            field = &filterFields[i];
+        }
+    }
+    if(field == NULL)
+    {
+        parseError(parser, "unknown field");
+        return NO_NODE;
+    }
+
+    int       node   = addNode(parser, NODE_TEST, NO_NODE, NO_NODE);
+    int       negate = 0;
+    long long low;
+    long long high;
+
+    if(node == NO_NODE)
+    {
+        return NO_NODE;
+    }
+
+    FilterTest *test = &parser->nodes[node].test;
+    test->field      = field->field;
+    test->test       = field->type == TYPE_TEXT ? TEST_EQUALS : TEST_RANGE;
+    test->low        = LLONG_MIN;
+    test->high       = LLONG_MAX;
+
+    if(matchKeyword(parser, "contains"))
+    {
+        if(field->type != TYPE_TEXT)
+        {
+            parseError(parser, "contains only applies to ward, name and diagnosis");
+            return NO_NODE;
+        }
+        test->test = TEST_CONTAINS;
+        parseValue(parser, field->type, &low, &high, text);
+    }
+    else if(matchKeyword(parser, "in"))
+    {
+        long long ignored;
+
+        if(field->type == TYPE_TEXT)
+        {
+            parseError(parser, "in only applies to numbers and times");
+            return NO_NODE;
+        }
+        if(parseValue(parser, field->type, &test->low, &ignored, text) && !matchSymbol(parser, ".."))
+        {
+            parseError(parser, "expected .. between the two ends of the range");
+        }
+        parseValue(parser, field->type, &ignored, &test->high, text);
+    }
+    else
+    {
+        const char *operators[] = { "!=", "<=", ">=", "=", "<", ">" };
+        const char *operator    = NULL;
+
+        for(int i = 0; operator == NULL && i < (int) (sizeof(operators) / sizeof(operators[0])); i++)
+        {
+            if(matchSymbol(parser, operators[i]))
+            {
+                operator = operators[i];
+            }
+        }
+
+        if(operator == NULL)
+        {
+            parseError(parser, "expected =, !=, <, <=, >, >=, in or contains");
+            return NO_NODE;
+        }
+        if(field->type == TYPE_TEXT && strcmp(operator, "=") != 0 && strcmp(operator, "!=") != 0)
+        {
+            parseError(parser, "text can only be compared with =, != or contains");
+            return NO_NODE;
+        }
+        if(!parseValue(parser, field->type, &low, &high, text))
+        {
+            return NO_NODE;
+        }
+
+        negate = strcmp(operator, "!=") == 0;
+        if(strcmp(operator, "=") == 0 || negate)
+        {
+            test->low  = low;
+            test->high = high;
+        }
+        else if(operator[0] == '<')
+        {
+            test->high = operator[1] == '=' ? high : low;
+        }
+        else
+        {
+            test->low = operator[1] == '=' ? low : high;
+        }
+    }
+
+    if(parser->failed)
+    {
+        return NO_NODE;
+    }
+    if(field->type == TYPE_TEXT)
+    {
+        test->textOffset = storeText(parser, text);
+    }
+
+    return negate ? addNode(parser, NODE_NOT, node, NO_NODE) : node;
+}
+
+/*
+ * Reads a value of a field's type. Numbers, times and statuses give the
+ * range [low, high) they stand for; text is copied lowercase.
+ */
+static int parseValue(FilterParser *parser, int type, long long *low, long long *high, char text[])
+{
+    int length = 0;
+
+    skipSpaces(parser);
+
+    const char *start = &parser->text[parser->position];
+    if(*start == '"')
+    {
+        const char *end = strchr(start + 1, '"');
+        if(end == NULL)
+        {
+            parseError(parser, "missing closing quote");
+            return 0;
+        }
+        length = (int) (end - start - 1);
+        memcpy(text, start + 1, length);
+        parser->position += length + 2;
+    }
+    else
+    {
+        while(start[length] != '\0' && !isspace((unsigned char) start[length]) &&
+              strchr("()=<>!\"", start[length]) == NULL && strncmp(&start[length], "..", 2) != 0)
+        {
+            text[length] = start[length];
+            length++;
+        }
+        parser->position += length;
+    }
+    text[length] = '\0';
+
+    if(length == 0 && type != TYPE_TEXT)
+    {
+        parseError(parser, "expected a value");
+        return 0;
+    }
+
+    for(int i = 0; i < length; i++)
+    {
+        text[i] = (char) tolower((unsigned char) text[i]);
+    }
+
+    char  *end;
+    double days;
+
+    switch(type)
+    {
+        case TYPE_INTEGER:
+            *low = strtoll(text, &end, 10);
+            if(*end != '\0')
+            {
+                parseError(parser, "expected a whole number");
+                return 0;
+            }
+            *high = *low + 1;
+            return 1;
+        case TYPE_DAYS:
+            days = strtod(text, &end);
+            if(*end != '\0' || days < 0)
+            {
+                parseError(parser, "expected a number of days");
+                return 0;
+            }
+            *low  = (long long) (days * SECONDS_PER_DAY);
+            *high = *low + 1;
+            return 1;
+        case TYPE_STATUS:
+            if(strcmp(text, "admitted") != 0 && strcmp(text, "discharged") != 0)
+            {
+                parseError(parser, "status is admitted or discharged");
+                return 0;
+            }
+            *low  = strcmp(text, "admitted") == 0 ? STATUS_ADMITTED : STATUS_DISCHARGED;
+            *high = *low + 1;
+            return 1;
+        case TYPE_TIME:
+            return parseTime(parser, text, low, high);
+        default:
+            return 1;
+    }
+}
+
+/*
+ * Reads today, today-N, a date (the whole day) or a date and time (that
+ * minute).
+ */
+static int parseTime(FilterParser *parser, const char *word, long long *low, long long *high)
+{
+    int    today = toDayNumber(parser->filter->now);
+    time_t when;
+
+    if(strncmp(word, "today", strlen("today")) == 0)
+    {
+        const char *offset = word + strlen("today");
+        char       *end;
+        long        days = *offset == '\0' ? 0 : strtol(offset, &end, 10);
+
+        if(*offset != '\0' && (*offset != '-' || *end != '\0'))
+        {
+            parseError(parser, "expected today or today-N");
+            return 0;
+        }
+
+        *low  = dayNumberToTime(today + (int) days);
+        *high = dayNumberToTime(today + (int) days + 1);
+        return 1;
+    }
+
+    if(!parseDateTime(word, &when))
+    {
+        parseError(parser, "expected a date as YYYY-MM-DD or \"YYYY-MM-DD HH:MM\"");
+        return 0;
+    }
+
+    *low  = when;
+    *high = strchr(word, ':') != NULL ? when + SECONDS_PER_MINUTE : dayNumberToTime(toDayNumber(when) + 1);
+    return 1;
+}
+
+/*
+ * Reads a run of letters, lowercased. Returns 0 if there is none.
+ */
+static int readWord(FilterParser *parser, char word[])
+{
+    int length = 0;
+
+    skipSpaces(parser);
+    while(isalpha((unsigned char) parser->text[parser->position]))
+    {
+        word[length++] = (char) tolower((unsigned char) parser->text[parser->position++]);
+    }
+    word[length] = '\0';
+    return length > 0;
+}
+
+/*
+ * Consumes a keyword if it comes next as a whole word, ignoring case.
+ */
+static int matchKeyword(FilterParser *parser, const char *keyword)
+{
+    size_t length = strlen(keyword);
+
+    skipSpaces(parser);
+
+    const char *next = &parser->text[parser->position];
+    for(size_t i = 0; i < length; i++)
+    {
+        if(tolower((unsigned char) next[i]) != keyword[i])
+        {
+            return 0;
+        }
+    }
+    if(isalnum((unsigned char) next[length]))
+    {
+        return 0;
+    }
+
+    parser->position += (int) length;
+    return 1;
+}
+
+/*
+ * Consumes a symbol if it comes next.
+ */
+static int matchSymbol(FilterParser *parser, const char *symbol)
+{
+    size_t length = strlen(symbol);
+
+    skipSpaces(parser);
+    if(strncmp(&parser->text[parser->position], symbol, length) != 0)
+    {
+        return 0;
+    }
+
+    parser->position += (int) length;
+    return 1;
+}
+
+/*
+ * Moves past spaces and tabs.
+ */
+static void skipSpaces(FilterParser *parser)
+{
+    while(isspace((unsigned char) parser->text[parser->position]))
+    {
+        parser->position++;
+    }
+}
+
+/*
+ * Adds a node to the tree. Returns NO_NODE if parsing already failed or the
+ * expression is too large.
+ */
+static int addNode(FilterParser *parser, int kind, int left, int right)
+{
+    if(parser->failed)
+    {
+        return NO_NODE;
+    }
+    if(parser->nodeCount == MAX_FILTER_NODES)
+    {
+        parseError(parser, "the filter has too many tests");
+        return NO_NODE;
+    }
+
+    FilterNode *node = &parser->nodes[parser->nodeCount];
+    memset(node, 0, sizeof(FilterNode));
+    node->kind  = kind;
+    node->left  = left;
+    node->right = right;
+    return parser->nodeCount++;
+}
+
+/*
+ * Records the first error and where it happened.
+ */
+static void parseError(FilterParser *parser, const char *message)
+{
+    if(!parser->failed)
+    {
+        snprintf(parser->error, parser->errorSize, "%s (at position %d)", message, parser->position + 1);
+        parser->failed = 1;
+    }
+}
+
+/*
+ * Copies text into the filter's text pool. Returns its offset.
+ */
+static int storeText(FilterParser *parser, const char *text)
+{
+    PatientFilter *filter = parser->filter;
+    int            offset = filter->textLength;
+
+    // The pool holds every literal of an expression no longer than MAX_FILTER_LENGTH
+    strcpy(&filter->texts[offset], text);
+    filter->textLength += (int) strlen(text) + 1;
+    return offset;
+}
+
+/*
+ * Estimates the work of evaluating a node: range tests are cheapest, then
+ * text equality, then substring search.
+ */
+static int nodeCost(const FilterParser *parser, int node)
+{
+    const FilterNode *current = &parser->nodes[node];
+
+    switch(current->kind)
+    {
+        case NODE_TEST:
+            return current->test.test;
+        case NODE_NOT:
+            return nodeCost(parser, current->left);
+        default:
+            return nodeCost(parser, current->left) + nodeCost(parser, current->right);
+    }
+}
+
+/*
+ * Emits the instructions for a node so that control reaches onTrue or
+ * onFalse. Both sides of "and" and "or" are free of side effects, so the
+ * cheaper one is emitted first.
+ */
+static void compileNode(FilterParser *parser, int node, int onTrue, int onFalse)
+{
+    const FilterNode *current = &parser->nodes[node];
+    PatientFilter    *filter  = parser->filter;
+
+    if(current->kind == NODE_TEST)
+    {
+        FilterInstruction *instruction = &filter->program[filter->length++];
+        instruction->test              = current->test;
+        instruction->onTrue            = onTrue;
+        instruction->onFalse           = onFalse;
+        return;
+    }
+
+    if(current->kind == NODE_NOT)
+    {
+        compileNode(parser, current->left, onFalse, onTrue);
+        return;
+    }
+
+    int first  = current->left;
+    int second = current->right;
+    if(nodeCost(parser, second) < nodeCost(parser, first))
+    {
+        first  = current->right;
+        second = current->left;
+    }
+
+    int next = newLabel(parser);
+    if(current->kind == NODE_AND)
+    {
+        compileNode(parser, first, next, onFalse);
+    }
+    else
+    {
+        compileNode(parser, first, onTrue, next);
+    }
+
+    parser->labels[next] = filter->length;
+    compileNode(parser, second, onTrue, onFalse);
+}
+
+/*
+ * Allocates a label; its position is set when it is placed.
+ */
+static int newLabel(FilterParser *parser)
+{
+    return parser->labelCount++;
+}
+
+/*
+ * Walks the tests joined to the root by "and" and narrows the search to
+ * the records they allow.
+ */
+static void narrowSearch(FilterParser *parser, int node)
+{
+    const FilterNode *current = &parser->nodes[node];
+    PatientFilter    *filter  = parser->filter;
+
+    if(current->kind == NODE_AND)
+    {
+        narrowSearch(parser, current->left);
+        narrowSearch(parser, current->right);
+        return;
+    }
+    if(current->kind != NODE_TEST || current->test.test != TEST_RANGE)
+    {
+        return;
+    }
+
+    const FilterTest *test = &current->test;
+    switch(test->field)
+    {
+        case FIELD_STATUS:
+            filter->searchAdmitted &= test->low <= STATUS_ADMITTED && STATUS_ADMITTED < test->high;
+            filter->searchDischarged &= test->low <= STATUS_DISCHARGED && STATUS_DISCHARGED < test->high;
+            break;
+        case FIELD_DISCHARGED:
+            filter->searchAdmitted = 0;
+            filter->dischargedLow  = test->low > filter->dischargedLow ? test->low : filter->dischargedLow;
+            filter->dischargedHigh = test->high < filter->dischargedHigh ? test->high : filter->dischargedHigh;
+            break;
+        case FIELD_ID:
+            filter->idLow  = test->low > filter->idLow ? test->low : filter->idLow;
+            filter->idHigh = test->high < filter->idHigh ? test->high : filter->idHigh;
+            break;
+    }
+}
+
+/*
+ * Gives a number or time field's value. Returns 0 when the patient has no
+ * such value (the discharge time of an admitted patient).
+ */
+static int fieldNumber(const PatientFilter *filter, int field, const Patient *patient, time_t dischargeDate,
+                       long long *value)
+{
+    switch(field)
+    {
+        case FIELD_ID:
+            *value = patient->patientId;
+            return 1;
+        case FIELD_AGE:
+            *value = patient->ageInYears;
+            return 1;
+        case FIELD_ROOM:
+            *value = patient->roomNumber;
+            return 1;
+        case FIELD_ADMITTED:
+            *value = patient->admissionDate;
+            return 1;
+        case FIELD_DISCHARGED:
+            *value = dischargeDate;
+            return dischargeDate != 0;
+        case FIELD_STAY:
+            *value = (dischargeDate != 0 ? dischargeDate : filter->now) - patient->admissionDate;
+            return 1;
+        default:
+            *value = dischargeDate != 0 ? STATUS_DISCHARGED : STATUS_ADMITTED;
+            return 1;
+    }
+}
+
+/*
+ * Gives a text field's value.
+ */
+static const char *fieldText(int field, const Patient *patient)
+{
+    int ward;
+
+    switch(field)
+    {
+        case FIELD_NAME:
+            return patient->name;
+        case FIELD_DIAGNOSIS:
+            return patient->diagnosis;
+        default:
+            ward = facilityRoomWard(patient->roomNumber);
+            return ward == NO_WARD ? "" : facilityWardName(ward);
+    }
+}
+
+/*
+ * Compares text with an already lowercased pattern, ignoring case.
+ */
+static int equalsIgnoreCase(const char *text, const char *lowered)
+{
+    while(*lowered != '\0' && tolower((unsigned char) *text) == *lowered)
+    {
+        text++;
+        lowered++;
+    }
+    return *text == '\0' && *lowered == '\0';
+}
+
+/*
+ * Looks for an already lowercased pattern anywhere in the text, ignoring case.
+ */
+static int containsIgnoreCase(const char *text, const char *lowered)
+{
+    for(; *text != '\0' || *lowered == '\0'; text++)
+    {
+        int i = 0;
+        while(lowered[i] != '\0' && tolower((unsigned char) text[i]) == lowered[i])
+        {
+            i++;
+        }
+        if(lowered[i] == '\0')
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Binary search over the archive, which is in discharge order: the first
+ * record discharged at or after a time.
+ */
+static long firstDischargeFrom(FILE *file, long recordCount, long long when)
+{
+    long              low  = 0;
+    long              high = recordCount;
+    DischargedPatient record;
+
+    if(when == LLONG_MIN)
+    {
+        return 0;
+    }
+
+    while(low < high)
+    {
+        long middle = low + (high - low) / 2;
+
+        if(fseek(file, middle * (long) sizeof(DischargedPatient), SEEK_SET) != 0 ||
+           fread(&record, sizeof(DischargedPatient), 1, file) != 1)
+        {
+            return 0;
+        }
+
+        if(record.dischargeDate < when)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * Writes one matching patient as a report row.
+ */
+static void showMatch(ReportSink *sink, DateCache *dates, const Patient *patient, time_t dischargeDate)
+{
+    char row[MAX_REPORT_ROW_LENGTH];
+
+    if(dischargeDate != 0)
+    {
+        sinkWrite(sink, row, renderPatientRow(row, patient, "Discharged", cachedDateText(dates, dischargeDate)));
+    }
+    else
+    {
+        sinkWrite(sink, row,
+                  renderPatientRow(row, patient, "Admitted", cachedDateText(dates, patient->admissionDate)));
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines patient filter expressions. A filter such as
+ *
+ *              age > 65 and room in 10..20 and admitted >= today-7
+ *
+ *          is parsed once and compiled to a flat program of field tests
+ *          joined by jumps, so each patient is checked with no parsing and
+ *          stops at the first test that decides the result.
+ *
+ *          Fields: id, age, room, ward, name, diagnosis, admitted,
+ *          discharged, stay (days) and status (admitted or discharged).
+ *          Tests: = != < <= > >=, "in LOW..HIGH" and "contains", joined
+ *          with and, or, not and parentheses. Text is compared ignoring
+ *          case and may be quoted. Times are written YYYY-MM-DD (the whole
+ *          day), "YYYY-MM-DD HH:MM", today or today-N.
+ */
+
+#ifndef PATIENT_FILTER_H
+#define PATIENT_FILTER_H
+
+#include <stddef.h>
+#include <time.h>
+#include "patient_data.h"
+
+// Longest filter expression accepted
+#define MAX_FILTER_LENGTH 256
+
+/*
+ * Opaque handle to a compiled filter.
+ */
+typedef struct PatientFilter PatientFilter;
+
+/*
+ * Function: compilePatientFilter
+ * ------------------------------
+ * Parses and compiles a filter expression.
+ *
+ * text: The expression
+ * error: Receives a description of the first error, if any
+ * errorSize: Size of error in bytes
+ *
+ * Returns: The compiled filter, or NULL if the expression is invalid
+ */
+PatientFilter *compilePatientFilter(const char *text, char error[], size_t errorSize);
+
+/*
+ * Function: patientFilterMatches
+ * ------------------------------
+ * Runs a compiled filter on one patient.
+ *
+ * filter: The compiled filter
+ * patient: The patient record
+ * dischargeDate: When the patient was discharged, or 0 if still admitted
+ *
+ * Returns: 1 if the patient matches, 0 otherwise
+ */
+int patientFilterMatches(const PatientFilter *filter, const Patient *patient, time_t dischargeDate);
+
+/*
+ * Function: freePatientFilter
+ * ---------------------------
+ * Frees a compiled filter.
+ *
+ * filter: The filter to free (may be NULL)
+ */
+void freePatientFilter(PatientFilter *filter);
+
+/*
+ * Function: filterPatients
+ * ------------------------
+ * Prompts for a filter expression and lists the admitted and discharged
+ * patients that match it.
+ */
+void filterPatients(void);
+
+#endif // PATIENT_FILTER_H
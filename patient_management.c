@@ -10,43 +10,112 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "activity_calendar.h"
+#include "attending.h"
+#include "diagnosis_index.h"
+#include "facility.h"
+#include "heavy_hitters.h"
+#include "identity_index.h"
+#include "name_index.h"
 #include "patient_data.h"
+#include "readmission.h"
+#include "report_format.h"
+#include "report_sink.h"
+#include "room_history.h"
+#include "room_usage.h"
+#include "stay_stats.h"
 #include "utils.h"
+#include "waitlist.h"
 
 // Private constants
 #define INITIAL_CAPACITY 1
 #define IS_EMPTY 0
 #define DEFAULT_ID 1
+#define MAX_ID_LIST_LENGTH 2048
+#define MAX_CONSOLE_REPORT_ROWS 500
+#define REPORT_HEADER_LENGTH 64
+#define MAX_DUPLICATE_MATCHES 5
 
 static const int PATIENT_NOT_FOUND        = -1;
 static const int INVALID_ID               = 0;
 static const int REMOVE_PATIENT_ARRAY_MAX = 49;
 static const int NEXT_INDEX_OFFSET        = 1;
-static const int ROOM_UNOCCUPIED          = -1;
+static const int AUTO_ASSIGN_ROOM         = 0;
+static const int PATIENT_WAITLISTED       = 2;
+static const int RESULTS_PER_PAGE         = 10;
+static const int MIN_TABLE_CAPACITY       = 64;
+
+// Journal written while a discharge batch is in flight
+static const char  DISCHARGE_JOURNAL_MAGIC[4] = { 'D', 'J', 'R', 'N' };
+static const char *DISCHARGE_JOURNAL          = "discharge.journal";
+
+/*
+ * Contents of discharge.journal: the archive length before the batch.
+ */
+typedef struct
+{
+    char magic[4];
+    long archiveLength;
+} DischargeJournal;
+
+// Report timeframe names, indexed by timeframe (1=Daily, 2=Weekly, 3=Monthly)
+static const char *timeframeNames[] = { "", "Daily", "Weekly", "Monthly" };
 
 // Global patient data
 static PatientNode *patientHead      = NULL;
 static int          totalPatients    = IS_EMPTY;
 static int          patientIDCounter = DEFAULT_ID;
 
+// Lookup indexes over the active census and the discharge archive
+static PatientNode **patientTable         = NULL;
+static int           patientTableCapacity = IS_EMPTY;
+static NameIndex    *activeNameIndex      = NULL;
+static NameIndex    *dischargedNameIndex  = NULL;
+static DiagnosisIndex *activeDiagnosisIndex     = NULL;
+static DiagnosisIndex *dischargedDiagnosisIndex = NULL;
+static IdentityIndex  *activeIdentityIndex      = NULL;
+
 // Function prototypes for internal helper functions
 static char        *getPatientName(char patientName[]);
 static int          getPatientAge(int *patientAge);
 static char        *getPatientDiagnosis(char patientDiagnosis[]);
-static int          getRoomNumber(int *roomNumber);
+static int          getRoomNumber(int *roomNumber, int *waitWard);
 static Patient     *getPatientToDischarge(void);
 static int          confirmDischarge(Patient *patient);
-static void         removePatientFromSystem(Patient *patient);
+static int          showPossibleDuplicates(const char name[], int age);
+static int          confirmDuplicateAdmission(void);
+static void         unlinkPatients(const int sortedIds[], int count);
+static int          commitDischarges(const int sortedIds[], int count);
+static long         archiveFileLength(void);
+static int          writeDischargeJournal(long archiveLength);
+static void         rollBackDischarges(long archiveLength);
+static int          compareIds(const void *a, const void *b);
 static Patient     *getPatientFromList(int id);
-static void         writePatientToFile(Patient newPatient);
+static int          writePatientToFile(Patient newPatient);
 static void         updatePatientsFile(void);
+static int          writePatientsTempFile(const int excludedIds[], int excludedCount);
+static int          replacePatientsFile(void);
 static PatientNode *insertPatientAtEndOfList(PatientNode *head, Patient data);
-static int          isRoomOccupiedInList(int roomNumber, PatientNode *head);
+static int          promptWardName(int *wardIndex);
+static int          askToWaitlist(void);
+static int          admitPatient(const char name[], int age, const char diagnosis[], int roomNumber, Patient *admitted);
+static void         admitFromWaitlist(const DischargedPatient records[], int count);
 static int          computeNextPatientId(void);
 static int          countPatientsByTimeframe(int timeframe);
-static void         logRoomUsage(int roomNumber);
+static int          logRoomUsage(const DischargedPatient records[], int count);
 static void         clearBinaryFile(const char* fileName);
 static int          countDischargedPatientsByTimeframe(int timeframe);
+static void         timeframeDays(int timeframe, int *firstDay, int *lastDay);
+static void         indexPatientNode(PatientNode *node);
+static void         unindexPatientNode(const PatientNode *node);
+static PatientNode *findPatientNode(int id);
+static int          growPatientTable(void);
+static void         loadDischargedIndexes(void);
+static int          getNameMatchMode(void);
+static int          showNameMatches(NameIndex *index, const char *query, int matchMode, int isArchive);
+static int          showDiagnosisMatches(DiagnosisIndex *index, const char *query, int isArchive);
+static void         printPatientPage(const int keys[], int count, int isArchive);
+static int          askForNextPage(void);
 
 /*
  * Initializes the patient management system.
@@ -55,6 +124,7 @@ static int          countDischargedPatientsByTimeframe(int timeframe);
 void initializePatientSystem(void)
 {
     clearMemory();
+    loadDischargedIndexes();
 
     FILE *file = fopen("patients.dat", "rb");
 
@@ -105,7 +175,43 @@ void initializePatientSystem(void)
     {
         patientIDCounter = computeNextPatientId();
         puts("Patients successfully loaded from file.");
+        loadActivityCalendar();
+    }
+}
+
+/*
+ * Finishes a discharge batch cut short by a crash. Once patients.tmp has
+ * been renamed the batch is committed and only the journal is left over;
+ * otherwise the archive is cut back to where the batch started.
+ */
+void recoverDischarges(void)
+{
+    FILE *file = fopen(DISCHARGE_JOURNAL, "rb");
+    if(file == NULL)
+    {
+        return;
     }
+
+    DischargeJournal journal;
+    int              valid = fread(&journal, sizeof(journal), 1, file) == 1 &&
+                memcmp(journal.magic, DISCHARGE_JOURNAL_MAGIC, sizeof(DISCHARGE_JOURNAL_MAGIC)) == 0;
+    fclose(file);
+
+    FILE *pending = fopen("patients.tmp", "rb");
+    if(pending == NULL || !valid)
+    {
+        // Committed, or the journal itself was never completed
+        if(pending != NULL)
+        {
+            fclose(pending);
+        }
+        remove(DISCHARGE_JOURNAL);
+        return;
+    }
+    fclose(pending);
+
+    puts("Undoing a discharge that was interrupted before it was saved.");
+    rollBackDischarges(journal.archiveLength);
 }
 
 /*
@@ -133,10 +239,21 @@ static void clearBinaryFile(const char* fileName)
  */
 void initializePatientSystemDefault(void)
 {
+    free(patientTable);
+    patientTable         = NULL;
+    patientTableCapacity = IS_EMPTY;
+    clearNameIndex(activeNameIndex);
+    clearDiagnosisIndex(activeDiagnosisIndex);
+    clearIdentityIndex(activeIdentityIndex);
+    activityClearAdmitted();
+    roomHistoryClearOpenStays();
+    facilityResetOccupancy();
+
     patientHead      = NULL;
     totalPatients    = IS_EMPTY;
     patientIDCounter = DEFAULT_ID;
     puts("Patient system initialized with default settings using linked list.");
+    loadActivityCalendar();
 }
 
 
@@ -149,19 +266,46 @@ void addPatientRecord(void)
     int  patientAge;
     char patientDiagnosis[MAX_DIAGNOSIS_LENGTH];
     int  roomNumber;
+    int  waitWard;
 
     getPatientName(patientName);
     getPatientAge(&patientAge);
     getPatientDiagnosis(patientDiagnosis);
-    getRoomNumber(&roomNumber);
 
-    // Create and store new patient record
-    Patient newPatient = createPatient(patientName, patientAge, patientDiagnosis, roomNumber, patientIDCounter);
-    patientHead        = insertPatientAtEndOfList(patientHead, newPatient);
-    totalPatients++;
-    patientIDCounter++;
+    if(showPossibleDuplicates(patientName, patientAge) > 0 && !confirmDuplicateAdmission())
+    {
+        puts("Admission cancelled.");
+        return;
+    }
+
+    // With every bed taken there is no room to choose, so the patient waits
+    if(facilityFirstFreeRoomInWard(NO_WARD) == NO_FREE_ROOM)
+    {
+        puts("All beds are full. The patient will be placed on the waitlist.");
+        while(!promptWardName(&waitWard))
+        {
+        }
+        waitlistPatient(patientName, patientAge, patientDiagnosis, waitWard);
+        return;
+    }
+
+    if(getRoomNumber(&roomNumber, &waitWard) == PATIENT_WAITLISTED)
+    {
+        waitlistPatient(patientName, patientAge, patientDiagnosis, waitWard);
+        return;
+    }
+
+    Patient newPatient;
+    if(!admitPatient(patientName, patientAge, patientDiagnosis, roomNumber, &newPatient))
+    {
+        puts("Admission cancelled.");
+        return;
+    }
 
-    writePatientToFile(newPatient);
+    if(!assignAttendingDoctor(newPatient.patientId, promptAttendingDoctor()))
+    {
+        puts("Warning: Unable to save the attending doctor.");
+    }
 
     printf("--- Patient Added ---\n");
     printPatient(newPatient);
@@ -204,18 +348,116 @@ void searchPatientById(void)
     scanf("%d", &id);
     clearInputBuffer();
 
-    PatientNode *current = patientHead;
-    while(current != NULL)
+    PatientNode *found = findPatientNode(id);
+    if(found != NULL)
+    {
+        printPatient(found->data);
+        return;
+    }
+
+    puts("Patient doesn't exist!");
+}
+
+/*
+ * Searches active (and optionally discharged) patients by name and displays
+ * the matches one page at a time.
+ */
+void searchPatientByName(void)
+{
+    char query[MAX_PATIENT_NAME_LENGTH];
+
+    printf("Enter Patient Name (or the start of it):\n");
+    if(fgets(query, sizeof(query), stdin) == NULL)
+    {
+        return;
+    }
+    query[strcspn(query, "\n")] = '\0';
+
+    if(strlen(query) == IS_EMPTY)
     {
-        if(current->data.patientId == id)
+        puts("No name entered.");
+        return;
+    }
+
+    int matchMode = getNameMatchMode();
+
+    printf("Include discharged patients? (y/n)\n");
+    char includeArchive = getchar();
+    if(includeArchive != '\n')
+    {
+        clearInputBuffer();
+    }
+
+    int found = showNameMatches(activeNameIndex, query, matchMode, 0);
+
+    if(includeArchive == YES || includeArchive == 'Y')
+    {
+        found += showNameMatches(dischargedNameIndex, query, matchMode, 1);
+    }
+
+    if(found == IS_EMPTY)
+    {
+        puts("No patients match that name.");
+    }
+}
+
+/*
+ * Searches current and/or discharged patients by diagnosis keywords using
+ * the inverted diagnosis indexes, and shows the matches page by page.
+ */
+void searchPatientsByDiagnosis(void)
+{
+    char query[MAX_DIAGNOSIS_LENGTH];
+    int  scope;
+
+    printf("Enter diagnosis keywords (e.g. \"fracture and wrist or pneumonia\"):\n");
+    if(fgets(query, sizeof(query), stdin) == NULL)
+    {
+        return;
+    }
+    query[strcspn(query, "\n")] = '\0';
+
+    do
+    {
+        printf("Search:\n"
+               "1: Current patients\n"
+               "2: Discharged patients\n"
+               "3: Both\n");
+
+        if(scanf("%d", &scope) != SUCCESSFUL_READ)
+        {
+            scope = IS_EMPTY;
+        }
+        clearInputBuffer();
+    }
+    while(scope < 1 || scope > 3);
+
+    int found = 0;
+
+    if(scope != 2)
+    {
+        int matches = showDiagnosisMatches(activeDiagnosisIndex, query, 0);
+        if(matches < 0)
         {
-            printPatient(current->data);
             return;
         }
-        current = current->nextNode;
+        found += matches;
     }
 
-    puts("Patient doesn't exist!");
+    if(scope != 1)
+    {
+        int matches = showDiagnosisMatches(dischargedDiagnosisIndex, query, 1);
+        if(matches < 0)
+        {
+            return;
+        }
+        found += matches;
+    }
+
+    if(found == IS_EMPTY)
+    {
+        puts("No patients match those keywords.");
+    }
 }
 
 /*
@@ -239,37 +481,122 @@ void dischargePatient(void)
 
     if(confirmDischarge(patientToDischarge))
     {
-        // Save discharged patient data
-        DischargedPatient dischargedPatient;
-        dischargedPatient.patient       = *patientToDischarge;
-        dischargedPatient.dischargeDate = time(NULL); // Current time as discharge time
+        // Copied, since the node holding the ID is freed during the commit
+        int patientId = patientToDischarge->patientId;
 
-        // Append to discharged patients file
-        FILE *file = fopen("discharged_patients.dat", "ab");
-        if(file == NULL)
+        if(commitDischarges(&patientId, 1))
         {
-            perror("Error opening discharged_patients.dat");            
-            return;
+            printf("Patient has been discharged!\n");
+        }
+    }
+    else
+    {
+        printf("Patient discharge cancelled.\n");
+    }
+}
+
+/*
+ * Discharges several patients at once. Every ID is validated first; if any
+ * is unknown or repeated, nothing is discharged.
+ */
+int dischargePatientsById(const int patientIds[], int count)
+{
+    if(count <= IS_EMPTY)
+    {
+        puts("No patient IDs given.");
+        return BATCH_DISCHARGE_FAILED;
+    }
+
+    int *sortedIds = malloc(count * sizeof(int));
+    if(sortedIds == NULL)
+    {
+        puts("Error: Not enough memory to discharge patients.");
+        return BATCH_DISCHARGE_FAILED;
+    }
+
+    memcpy(sortedIds, patientIds, count * sizeof(int));
+    qsort(sortedIds, count, sizeof(int), compareIds);
+
+    int isValid = IS_VALID;
+
+    for(int i = 0; i < count; i++)
+    {
+        if(i > 0 && sortedIds[i] == sortedIds[i - 1])
+        {
+            printf("Patient ID %d is listed more than once.\n", sortedIds[i]);
+            isValid = IS_NOT_VALID;
         }
+        else if(findPatientNode(sortedIds[i]) == NULL)
+        {
+            printf("Patient ID %d is not an admitted patient.\n", sortedIds[i]);
+            isValid = IS_NOT_VALID;
+        }
+    }
+
+    if(isValid == IS_NOT_VALID || !commitDischarges(sortedIds, count))
+    {
+        puts("No patients were discharged.");
+        free(sortedIds);
+        return BATCH_DISCHARGE_FAILED;
+    }
+
+    free(sortedIds);
+    printf("%d patients have been discharged!\n", count);
+    return count;
+}
+
+/*
+ * Prompts for a list of patient IDs, shows who will be discharged, and
+ * discharges them all in one batch once confirmed.
+ */
+void dischargeMultiplePatients(void)
+{
+    char line[MAX_ID_LIST_LENGTH];
+    int  patientIds[MAX_BATCH_DISCHARGE];
+
+    if(patientHead == NULL)
+    {
+        puts("No patients to discharge!");
+        return;
+    }
+
+    printf("Enter the IDs of the patients to discharge, separated by spaces or commas:\n");
+    if(fgets(line, sizeof(line), stdin) == NULL)
+    {
+        return;
+    }
+
+    int count = parseIntegerList(line, patientIds, MAX_BATCH_DISCHARGE);
+    if(count <= IS_EMPTY)
+    {
+        printf("Please enter between 1 and %d numeric patient IDs.\n", MAX_BATCH_DISCHARGE);
+        return;
+    }
 
-        if(fwrite(&dischargedPatient, sizeof(DischargedPatient), 1, file) != 1)
+    for(int i = 0; i < count; i++)
+    {
+        PatientNode *node = findPatientNode(patientIds[i]);
+        if(node == NULL)
         {
-            perror("Error writing to discharged_patients.dat");
-            fclose(file);
+            printf("Patient ID %d not found. No patients were discharged.\n", patientIds[i]);
             return;
         }
-        fclose(file);
-
-        logRoomUsage(patientToDischarge->roomNumber); // Log the room usage
 
-        // Remove from the active patient list
-        removePatientFromSystem(patientToDischarge); // Pass the pointer
-        printf("Patient has been discharged!\n");
+        printf("ID: %-5d Name: %-15s Room: %d\n", node->data.patientId, node->data.name, node->data.roomNumber);
     }
-    else
+
+    printf("Are you sure you want to discharge these %d patients? (y/n)\n", count);
+    char confirm;
+    scanf(" %c", &confirm);
+    clearInputBuffer();
+
+    if(confirm != YES)
     {
         printf("Patient discharge cancelled.\n");
+        return;
     }
+
+    dischargePatientsById(patientIds, count);
 }
 
 /*
@@ -286,6 +613,7 @@ void backupPatientSystem()
 void restoreDataFromFile()
 {
     initializePatientSystem();
+    resyncAttendingDoctors();
 }
 
 /*
@@ -299,103 +627,78 @@ void clearMemory()
         patientHead       = patientHead->nextNode;
         free(temp);
     }
+
+    free(patientTable);
+    patientTable         = NULL;
+    patientTableCapacity = IS_EMPTY;
+    clearNameIndex(activeNameIndex);
+    clearDiagnosisIndex(activeDiagnosisIndex);
+    clearIdentityIndex(activeIdentityIndex);
+    activityClearAdmitted();
+    roomHistoryClearOpenStays();
+    facilityResetOccupancy();
+
     patientHead      = NULL;
     totalPatients    = IS_EMPTY;
     patientIDCounter = DEFAULT_ID;
 }
 
 /*
- * Prints a formatted patient report to both console and file.
+ * Prints a formatted patient report to a report sink.
  *
  * Parameters:
- *   file: Output file stream (must be open)
+ *   sink: Report sink for the console and file copies
  *   header: Report title text
  *   result: Total patient count for the report
  *   timeframe: Time period filter (1=Daily, 2=Weekly, 3=Monthly)
  *
- * Formats and displays the report header, patient count, and detailed
- * information for each matching patient. Output is mirrored to both
- * console and the specified file.
+ * Formats the report header, patient count, and detailed information for
+ * each matching patient. Each line is formatted once; the sink mirrors it
+ * to the console and the file.
  */
-void printFormattedReport(FILE *file, const char *header, int result, int timeframe)
+void printFormattedReport(ReportSink *sink, const char *header, int result, int timeframe)
 {
     // Get current time and format it as YYYY-MM-DD
-    time_t     now         = time(NULL);
-    struct tm *currentTime = localtime(&now);
-    char       currentTimeStr[20];
-    strftime(currentTimeStr, sizeof(currentTimeStr), "%Y-%m-%d", currentTime);
-
-    // Print report header to console
-    printf("%s - %s\n", header, currentTimeStr);
-    printf("=======================================\n");
-    printf("Total patients admitted: %d\n", result);
-    printf("---------------------------------------\n");
-
-    // Print same header to file
-    fprintf(file, "%s - %s\n", header, currentTimeStr);
-    fprintf(file, "=======================================\n");
-    fprintf(file, "Total patients admitted: %d\n", result);
-    fprintf(file, "---------------------------------------\n");
+    // Copied, because localtime reuses one buffer for every call below
+    time_t    now         = time(NULL);
+    struct tm currentTime = *localtime(&now);
+    char      currentTimeStr[20];
+    strftime(currentTimeStr, sizeof(currentTimeStr), "%Y-%m-%d", &currentTime);
+
+    // Print report header
+    sinkPrintf(sink, "%s - %s\n", header, currentTimeStr);
+    sinkPrintf(sink, "=======================================\n");
+    sinkPrintf(sink, "Total patients admitted: %d\n", result);
+    sinkPrintf(sink, "---------------------------------------\n");
 
     if(result == 0)
     {
         // Handle case when no patients match the timeframe
-        printf("| No patients admitted in this timeframe |\n");
-        printf("---------------------------------------\n");
-
-        fprintf(file, "| No patients admitted in this timeframe |\n");
-        fprintf(file, "---------------------------------------\n");
+        sinkPrintf(sink, "| No patients admitted in this timeframe |\n");
+        sinkPrintf(sink, "---------------------------------------\n");
     }
     else
     {
         PatientNode *patient = patientHead;
-        struct tm   *admissionTime;
-        char         admissionDateStr[20];
+        DateCache    admissionDates;
+        char         row[MAX_REPORT_ROW_LENGTH];
+        int          firstDay;
+        int          lastDay;
+
+        initDateCache(&admissionDates);
+        timeframeDays(timeframe, &firstDay, &lastDay);
 
         while(patient != NULL)
         {
-            // Get admission timestamp and convert to struct tm
             time_t admissionTimestamp = patient->data.admissionDate;
-            admissionTime             = localtime(&admissionTimestamp);
-
-            // Calculate time difference in hours between now and admission
-            double secondsDiff = difftime(now, admissionTimestamp);
-            int    hoursDiff   = secondsDiff / 3600;
-
-            // Determine if patient falls within requested timeframe
-            int past24Hours = (hoursDiff <= 24);  // Within last 24 hours
-            int sameWeek    = (admissionTime->tm_year == currentTime->tm_year &&
-                            (currentTime->tm_yday - admissionTime->tm_yday) < 7);  // Same week (within 7 days)
-            int sameMonth =
-                    (admissionTime->tm_year == currentTime->tm_year && 
-                     admissionTime->tm_mon == currentTime->tm_mon);  // Same month
-
-            // Filter patients based on timeframe parameter (1=daily, 2=weekly, 3=monthly)
-            if((timeframe == 1 && past24Hours) || (timeframe == 2 && sameWeek) || (timeframe == 3 && sameMonth))
+            int    admissionDay       = toDayNumber(admissionTimestamp);
+
+            // Filter patients to the timeframe's calendar days (1=daily, 2=weekly, 3=monthly)
+            if(admissionDay >= firstDay && admissionDay <= lastDay)
             {
-                // Format admission date as YYYY-MM-DD
-                strftime(admissionDateStr, sizeof(admissionDateStr), "%Y-%m-%d", admissionTime);
-
-                // Print patient details to console with formatted columns
-                printf("| ID: %-5d Name: %-15s | Age: %-3d Room: %-5d Diagnosis: %-20s | Admitted: %-10s |\n",
-                       patient->data.patientId,
-                       patient->data.name,
-                       patient->data.ageInYears,
-                       patient->data.roomNumber,
-                       patient->data.diagnosis,
-                       admissionDateStr);
-                printf("---------------------------------------\n");
-
-                // Print same details to file with identical formatting
-                fprintf(file,
-                        "| ID: %-5d Name: %-15s | Age: %-3d Room: %-5d Diagnosis: %-20s | Admitted: %-10s |\n",
-                        patient->data.patientId,
-                        patient->data.name,
-                        patient->data.ageInYears,
-                        patient->data.roomNumber,
-                        patient->data.diagnosis,
-                        admissionDateStr);
-                fprintf(file, "---------------------------------------\n");
+                // Print patient details with formatted columns and the admission date as YYYY-MM-DD
+                const char *admissionDateStr = cachedDateText(&admissionDates, admissionTimestamp);
+                sinkWrite(sink, row, renderPatientRow(row, &patient->data, "Admitted", admissionDateStr));
             }
 
             patient = patient->nextNode;  // Move to next patient in list
@@ -420,44 +723,54 @@ void displayPatientReport(int choice)
 
     fprintf(file, "\n");
 
-    printFormattedReport(file, "   Patient Admission Report - Daily", result, choice);
+    // A report too long to read on screen only goes to the file
+    int         echoToConsole = result <= MAX_CONSOLE_REPORT_ROWS;
+    ReportSink *sink          = openReportSink(file, echoToConsole);
 
-    fclose(file);
+    if(!echoToConsole)
+    {
+        printf("The report lists %d patients, so it is only written to the file.\n", result);
+    }
+
+    if(sink != NULL)
+    {
+        char header[REPORT_HEADER_LENGTH];
+        snprintf(header, sizeof(header), "   Patient Admission Report - %s", timeframeNames[choice]);
+        printFormattedReport(sink, header, result, choice);
+    }
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing patient_reports.txt\n");
+        return;
+    }
     printf("\nReport successfully written to patient_reports.txt\n");
 }
 
 /*
  * Prints a formatted report of discharged patients within
- * the selected timeframe to both console and file.
+ * the selected timeframe to a report sink.
  */
-void printDischargedFormattedReport(FILE *file, const char *header, int result, int timeframe)
+void printDischargedFormattedReport(ReportSink *sink, const char *header, int result, int timeframe)
 {
     // Get current time for report header
-    time_t     now         = time(NULL);
-    struct tm *currentTime = localtime(&now);
-    char       currentTimeStr[20];
-    strftime(currentTimeStr, sizeof(currentTimeStr), "%Y-%m-%d", currentTime);
-
-    // Print report header to console
-    printf("%s - %s\n", header, currentTimeStr);
-    printf("=======================================\n");
-    printf("Total patients discharged: %d\n", result);
-    printf("---------------------------------------\n");
-
-    // Print report header to file
-    fprintf(file, "%s - %s\n", header, currentTimeStr);
-    fprintf(file, "=======================================\n");
-    fprintf(file, "Total patients discharged: %d\n", result);
-    fprintf(file, "---------------------------------------\n");
+    // Copied, because localtime reuses one buffer for every call below
+    time_t    now         = time(NULL);
+    struct tm currentTime = *localtime(&now);
+    char      currentTimeStr[20];
+    strftime(currentTimeStr, sizeof(currentTimeStr), "%Y-%m-%d", &currentTime);
+
+    // Print report header
+    sinkPrintf(sink, "%s - %s\n", header, currentTimeStr);
+    sinkPrintf(sink, "=======================================\n");
+    sinkPrintf(sink, "Total patients discharged: %d\n", result);
+    sinkPrintf(sink, "---------------------------------------\n");
 
     if(result == 0)
     {
         // Handle case when no patients were discharged in the timeframe
-        printf("| No patients discharged in this timeframe |\n");
-        printf("---------------------------------------\n");
-
-        fprintf(file, "| No patients discharged in this timeframe |\n");
-        fprintf(file, "---------------------------------------\n");
+        sinkPrintf(sink, "| No patients discharged in this timeframe |\n");
+        sinkPrintf(sink, "---------------------------------------\n");
     }
     else
     {
@@ -465,57 +778,33 @@ void printDischargedFormattedReport(FILE *file, const char *header, int result,
         FILE *fileRead = fopen("discharged_patients.dat", "rb");
         if(fileRead == NULL)
         {
+            flushReportSink(sink);
             printf("Error opening file to read discharged patients.\n");
             return;
         }
 
         DischargedPatient dischargedPatient;
+        DateCache         dischargeDates;
+        char              row[MAX_REPORT_ROW_LENGTH];
+        int               firstDay;
+        int               lastDay;
+
+        initDateCache(&dischargeDates);
+        timeframeDays(timeframe, &firstDay, &lastDay);
+
         // Read each discharged patient record
         while(fread(&dischargedPatient, sizeof(DischargedPatient), 1, fileRead) == 1)
         {
-            // Format discharge date for display
-            time_t     dischargeTimestamp = dischargedPatient.dischargeDate;
-            struct tm *dischargeTime      = localtime(&dischargeTimestamp);
-            char       dischargeDateStr[20];
-            strftime(dischargeDateStr, sizeof(dischargeDateStr), "%Y-%m-%d", dischargeTime);
-
-            // Calculate time difference for filtering
-            double secondsDiff = difftime(now, dischargeTimestamp);
-            int    hoursDiff   = secondsDiff / 3600;
-
-            // Determine if patient falls within selected timeframe
-            int past24Hours = (hoursDiff <= 24);  // Within last 24 hours
-            int sameWeek    = (dischargeTime->tm_year == currentTime->tm_year &&
-                            (currentTime->tm_yday - dischargeTime->tm_yday) < 7);  // Within last 7 days
-            int sameMonth =
-                    (dischargeTime->tm_year == currentTime->tm_year && 
-                     dischargeTime->tm_mon == currentTime->tm_mon);  // Within current month
-
-            // Filter discharged patients by timeframe (1=daily, 2=weekly, 3=monthly)
-            if((timeframe == 1 && past24Hours) || (timeframe == 2 && sameWeek) || (timeframe == 3 && sameMonth))
+            time_t dischargeTimestamp = dischargedPatient.dischargeDate;
+            int    dischargeDay       = toDayNumber(dischargeTimestamp);
+
+            // Filter discharged patients to the timeframe's calendar days (1=daily, 2=weekly, 3=monthly)
+            if(dischargeDay >= firstDay && dischargeDay <= lastDay)
             {
-                // Print patient details to console with formatted columns
-                printf("| ID: %-5d Name: %-15s | Age: %-3d Room: %-5d Diagnosis: %-20s | Discharged: %-10s |\n",
-                       dischargedPatient.patient.patientId,
-                       dischargedPatient.patient.name,
-                       dischargedPatient.patient.ageInYears,
-                       dischargedPatient.patient.roomNumber,
-                       dischargedPatient.patient.diagnosis,
-                       dischargeDateStr);
-                
-                // Print same patient details to file
-                fprintf(file,
-                        "| ID: %-5d Name: %-15s | Age: %-3d Room: %-5d Diagnosis: %-20s | Discharged: %-10s |\n",
-                        dischargedPatient.patient.patientId,
-                        dischargedPatient.patient.name,
-                        dischargedPatient.patient.ageInYears,
-                        dischargedPatient.patient.roomNumber,
-                        dischargedPatient.patient.diagnosis,
-                        dischargeDateStr);
-
-                // Add separator after each patient entry
-                printf("---------------------------------------\n");
-                fprintf(file, "---------------------------------------\n");
+                // Print patient details with formatted columns and the discharge date, then a separator
+                const char *dischargeDateStr = cachedDateText(&dischargeDates, dischargeTimestamp);
+                sinkWrite(sink, row,
+                          renderPatientRow(row, &dischargedPatient.patient, "Discharged", dischargeDateStr));
             }
         }
 
@@ -540,72 +829,28 @@ void displayDischargedPatientReport(int choice)
 
     fprintf(file, "\n");
 
-    printDischargedFormattedReport(file, "   Discharged Patient Report - Weekly", result, choice);
-
-    fclose(file);
-    printf("\nDischarge Report successfully written to discharged_reports.txt\n");
-}
-
-/*
- * Reads room_usage.txt and displays a usage report
- * showing how many times each valid room (1-50) was used.
- */
-void displayRoomUsageReport(void)
-{
-    FILE *file = fopen("room_usage.txt", "r");
-    int   roomCounts[50 + 1] = { 0 }; // Array to store counts (index 0 unused)
-    int   roomNumber;
-    int   totalEntries = 0;
-    int   validEntries = 0;
-
-    printf("\n--- Room Usage Report ---\n");
+    // A report too long to read on screen only goes to the file
+    int         echoToConsole = result <= MAX_CONSOLE_REPORT_ROWS;
+    ReportSink *sink          = openReportSink(file, echoToConsole);
 
-    if(file == NULL)
-    {
-        printf("Error opening room_usage.txt for reading");
-        return;
-    }
-
-    // Read each room number from the file
-    while(fscanf(file, "%d", &roomNumber) == 1)
+    if(!echoToConsole)
     {
-        totalEntries++;
-        // Validate the room number and increment the count
-        if(roomNumber >= 1 && roomNumber <= 50)
-        {
-            roomCounts[roomNumber]++;
-            validEntries++;
-        }
-        else
-        {
-            fprintf(stderr, "Warning: Found invalid room number '%d' in room_usage.txt\n", roomNumber);
-        }
+        printf("The report lists %d patients, so it is only written to the file.\n", result);
     }
 
-    fclose(file);
-
-    printf("Room | Usage Count\n");
-    printf("-----|------------\n");
-
-    int roomsReported = 0;
-    for(int i = 1; i <= 50; i++)
+    if(sink != NULL)
     {
-        if(roomCounts[i] > 0)
-        {
-            printf("%-4d | %d\n", i, roomCounts[i]);
-            roomsReported++;
-        }
+        char header[REPORT_HEADER_LENGTH];
+        snprintf(header, sizeof(header), "   Discharged Patient Report - %s", timeframeNames[choice]);
+        printDischargedFormattedReport(sink, header, result, choice);
     }
 
-    if(roomsReported == 0 && validEntries == 0)
+    if(!closeReportSink(sink) || fclose(file) != 0)
     {
-        printf("No valid room usage data found in the file.\n");
+        printf("Error writing discharged_reports.txt\n");
+        return;
     }
-
-    printf("-------------------------\n");
-    printf("Total entries read: %d\n", totalEntries);
-    printf("Valid rooms logged: %d\n", validEntries);
-    printf("-------------------------\n");
+    printf("\nDischarge Report successfully written to discharged_reports.txt\n");
 }
 
 /*
@@ -695,14 +940,16 @@ static char *getPatientDiagnosis(char patientDiagnosis[])
 
 /*
  * Reads and validates the room number for the patient.
+ * Returns PATIENT_WAITLISTED (with the ward in waitWard) if the patient
+ * should wait for a bed instead.
  */
-static int getRoomNumber(int *roomNumber)
+static int getRoomNumber(int *roomNumber, int *waitWard)
 {
     int isValid;
 
     do
     {
-        printf("Enter Patient Room:\n");
+        printf("Enter Patient Room (0 to assign a free bed automatically):\n");
         if(scanf("%d", roomNumber) != SUCCESSFUL_READ)
         {
             printf("Invalid input. Please enter a number.\n");
@@ -712,7 +959,32 @@ static int getRoomNumber(int *roomNumber)
         }
         clearInputBuffer();
 
-        // First check if the room number is in valid range
+        if(*roomNumber == AUTO_ASSIGN_ROOM)
+        {
+            if(!promptWardName(waitWard))
+            {
+                isValid = IS_NOT_VALID;
+                continue;
+            }
+
+            *roomNumber = facilityFirstFreeRoomInWard(*waitWard);
+            if(*roomNumber != NO_FREE_ROOM)
+            {
+                printf("Assigned room %d.\n", *roomNumber);
+                isValid = IS_VALID;
+                continue;
+            }
+
+            printf("No free beds are available in that ward.\n");
+            if(askToWaitlist())
+            {
+                return PATIENT_WAITLISTED;
+            }
+            isValid = IS_NOT_VALID;
+            continue;
+        }
+
+        // First check if the room is part of the facility
         isValid = validateRoomNumber(*roomNumber);
 
         if(isValid == IS_NOT_VALID)
@@ -721,10 +993,10 @@ static int getRoomNumber(int *roomNumber)
             continue;
         }
 
-        // Check if the room is already occupied by traversing the linked list.
-        if(isRoomOccupiedInList(*roomNumber, patientHead) != ROOM_UNOCCUPIED)
+        // Check the room's bed map for a free bed
+        if(facilityFreeBeds(*roomNumber) == 0)
         {
-            printf("Room already occupied. Please choose another room.\n");
+            printf("Room is full. Please choose another room, or 0 to pick a ward.\n");
             isValid = IS_NOT_VALID;
         }
     }
@@ -760,61 +1032,262 @@ static int confirmDischarge(Patient *patient)
 }
 
 /*
- * Removes a patient from the system by unlinking the corresponding node from the linked list.
+ * Lists the admitted patients whose name and age are close to a new
+ * admission's. Returns how many were listed.
  */
-static void removePatientFromSystem(Patient *patient)
+static int showPossibleDuplicates(const char name[], int age)
 {
-    if(patientHead == NULL || patient == NULL)
-    {
-        return;
-    }
-
-    PatientNode *current  = patientHead;
-    PatientNode *prevNode = NULL;
-
-    if(current != NULL && current->data.patientId == patient->patientId)
-    {
-        patientHead = current->nextNode;
-        free(current);
-        totalPatients--;
-        updatePatientsFile();
-        return;
-    }
+    IdentityMatch matches[MAX_DUPLICATE_MATCHES];
+    int           count = identityIndexSearch(activeIdentityIndex, name, age, matches, MAX_DUPLICATE_MATCHES);
 
-    // Search for the patient to remove
-    while(current != NULL && current->data.patientId != patient->patientId)
+    if(count == IS_EMPTY)
     {
-        prevNode = current;
-        current  = current->nextNode;
+        return IS_EMPTY;
     }
 
-    // If patient was not found
-    if(current == NULL)
+    printf("Possible duplicate: %s (age %d) is close to %s already admitted:\n", name, age,
+           count == 1 ? "a patient" : "these patients");
+    for(int i = 0; i < count; i++)
     {
-        return;
+        const PatientNode *node = findPatientNode(matches[i].key);
+        if(node != NULL)
+        {
+            printf("  ID %d: %s, age %d, room %d (%.0f%% alike)\n", node->data.patientId, node->data.name,
+                   node->data.ageInYears, node->data.roomNumber, matches[i].similarity * 100);
+        }
     }
-
-    // Unlink the node and free memory
-    prevNode->nextNode = current->nextNode;
-    free(current);
-    totalPatients--;
-
-    updatePatientsFile();
+    return count;
 }
 
-
-/**
- * Rewrites the patients.dat file with current patient data.
- * Opens file in write binary mode and writes all active patient records.
+/*
+ * Asks the user whether a possible duplicate should be admitted anyway.
  */
-static void updatePatientsFile(void)
+static int confirmDuplicateAdmission(void)
 {
-    FILE *pTemp;
-    pTemp = fopen("patients.tmp", "wb");
-    if(pTemp == NULL)
-    {
+    char confirm;
+    printf("Admit as a new patient anyway? (y/n)\n");
+    scanf(" %c", &confirm);
+    clearInputBuffer();
+    return confirm == 'y';
+}
+
+/*
+ * Unlinks and frees every patient whose ID is in the sorted list, in a single
+ * pass over the linked list.
+ */
+static void unlinkPatients(const int sortedIds[], int count)
+{
+    PatientNode **link = &patientHead;
+
+    while(*link != NULL)
+    {
+        PatientNode *current = *link;
+
+        if(bsearch(&current->data.patientId, sortedIds, count, sizeof(int), compareIds) == NULL)
+        {
+            link = &current->nextNode;
+            continue;
+        }
+
+        *link = current->nextNode;
+        unindexPatientNode(current);
+        free(current);
+        totalPatients--;
+    }
+}
+
+/*
+ * Discharges a validated, sorted list of admitted patients as one unit:
+ *   1. the new patients.dat is written to patients.tmp,
+ *   2. the archive's length is saved in discharge.journal,
+ *   3. all discharge records are appended to the archive in one write,
+ *   4. patients.tmp is renamed over patients.dat, which commits the batch.
+ * A failure in steps 1-4 cuts the archive back and leaves every file and the
+ * in-memory census as they were; a crash is undone by recoverDischarges.
+ * Room usage, history and the other recorders are only told once it commits.
+ */
+static int commitDischarges(const int sortedIds[], int count)
+{
+    DischargedPatient *records = malloc(count * sizeof(DischargedPatient));
+    if(records == NULL)
+    {
+        puts("Error: Not enough memory to discharge patients.");
+        return 0;
+    }
+
+    time_t now = time(NULL);
+    for(int i = 0; i < count; i++)
+    {
+        records[i].patient       = findPatientNode(sortedIds[i])->data;
+        records[i].dischargeDate = now;
+    }
+
+    if(!writePatientsTempFile(sortedIds, count))
+    {
+        free(records);
+        return 0;
+    }
+
+    long archiveLength = archiveFileLength();
+    if(!writeDischargeJournal(archiveLength))
+    {
+        remove("patients.tmp");
+        free(records);
+        return 0;
+    }
+
+    FILE *file     = fopen("discharged_patients.dat", "ab");
+    int   archived = file != NULL && fwrite(records, sizeof(DischargedPatient), count, file) == (size_t) count &&
+                   flushToDisk(file);
+
+    if(file != NULL && fclose(file) != 0)
+    {
+        archived = 0;
+    }
+
+    if(!archived)
+    {
+        perror("Error writing to discharged_patients.dat");
+    }
+
+    if(!archived || !replacePatientsFile())
+    {
+        rollBackDischarges(archiveLength);
+        puts("The discharge was cancelled. No patient was discharged.");
+        free(records);
+        return 0;
+    }
+    remove(DISCHARGE_JOURNAL);
+
+    // The records just written are the last ones in the archive
+    long firstRecordNumber = archiveLength / (long) sizeof(DischargedPatient);
+
+    logRoomUsage(records, count);
+    roomHistoryRecordStays(records, firstRecordNumber, count);
+    heavyHittersRecordDischarges(records, firstRecordNumber, count);
+    stayStatsRecordDischarges(records, firstRecordNumber, count);
+    readmissionRecordDischarges(records, firstRecordNumber, count);
+
+    for(int i = 0; i < count; i++)
+    {
+        int recordNumber = (int) (firstRecordNumber + i);
+
+        if(dischargedNameIndex != NULL)
+        {
+            nameIndexInsert(dischargedNameIndex, records[i].patient.name, recordNumber);
+        }
+        if(dischargedDiagnosisIndex != NULL)
+        {
+            diagnosisIndexAdd(dischargedDiagnosisIndex, records[i].patient.diagnosis, recordNumber);
+        }
+    }
+
+    releaseAttendingDoctors(sortedIds, firstRecordNumber, count);
+
+    unlinkPatients(sortedIds, count);
+    activityRecordDischarges(records, firstRecordNumber, count, totalPatients);
+    admitFromWaitlist(records, count);
+    free(records);
+    return 1;
+}
+
+/*
+ * Returns the length of discharged_patients.dat in bytes, or 0 if it does
+ * not exist yet.
+ */
+static long archiveFileLength(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fclose(file);
+    return length < 0 ? 0 : length;
+}
+
+/*
+ * Saves the archive length a discharge batch starts from, flushed to disk
+ * before the archive is touched.
+ */
+static int writeDischargeJournal(long archiveLength)
+{
+    FILE *file = fopen(DISCHARGE_JOURNAL, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating discharge.journal");
+        return 0;
+    }
+
+    DischargeJournal journal;
+    memset(&journal, 0, sizeof(journal));
+    memcpy(journal.magic, DISCHARGE_JOURNAL_MAGIC, sizeof(DISCHARGE_JOURNAL_MAGIC));
+    journal.archiveLength = archiveLength;
+
+    int written = fwrite(&journal, sizeof(journal), 1, file) == 1 && flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing discharge.journal");
+        remove(DISCHARGE_JOURNAL);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Undoes an uncommitted discharge batch: cuts the archive back to its old
+ * length and drops patients.tmp and the journal.
+ */
+static void rollBackDischarges(long archiveLength)
+{
+    if(archiveFileLength() > archiveLength && !truncateFile("discharged_patients.dat", archiveLength))
+    {
+        perror("Error truncating discharged_patients.dat");
+        return; // Keep the journal so the next start retries
+    }
+
+    remove("patients.tmp");
+    remove(DISCHARGE_JOURNAL);
+}
+
+/*
+ * Orders patient IDs for qsort and bsearch.
+ */
+static int compareIds(const void *a, const void *b)
+{
+    int left  = *(const int *) a;
+    int right = *(const int *) b;
+    return (left > right) - (left < right);
+}
+
+/**
+ * Rewrites the patients.dat file with current patient data.
+ * Writes a temporary file first so patients.dat is only replaced once the new copy is complete.
+ */
+static void updatePatientsFile(void)
+{
+    if(writePatientsTempFile(NULL, IS_EMPTY))
+    {
+        replacePatientsFile();
+    }
+}
+
+/**
+ * Writes every active patient except the excluded (sorted) IDs to patients.tmp.
+ * Removes the temporary file and returns 0 if anything fails.
+ */
+static int writePatientsTempFile(const int excludedIds[], int excludedCount)
+{
+    FILE *pTemp;
+    pTemp = fopen("patients.tmp", "wb");
+    if(pTemp == NULL)
+    {
         perror("Error creating temporary backup file");
-        return; // Keep original patients.dat
+        return 0; // Keep original patients.dat
     }
 
     PatientNode *current;
@@ -825,6 +1298,13 @@ static void updatePatientsFile(void)
 
     while(current != NULL)
     {
+        if(excludedCount > IS_EMPTY &&
+           bsearch(&current->data.patientId, excludedIds, excludedCount, sizeof(int), compareIds) != NULL)
+        {
+            current = current->nextNode;
+            continue;
+        }
+
         if(fwrite(&(current->data), sizeof(Patient), 1, pTemp) != 1)
         {
             perror("Error writing patient to temporary file");
@@ -834,89 +1314,179 @@ static void updatePatientsFile(void)
         current = current->nextNode;
     }
 
+    // The rename of patients.tmp commits a discharge, so it must be on disk first
+    if(!write_error && !flushToDisk(pTemp))
+    {
+        perror("Error flushing temporary backup file");
+        write_error = 1;
+    }
+
     if(fclose(pTemp) != 0)
     { // Also check fclose error
         perror("Error closing temporary backup file");
         write_error = 1;
     }
 
-    if(!write_error)
-    {
-        // Only replace original if temp write was fully successful
-        if(remove("patients.dat") != 0 && errno != ENOENT)
-        {
-            perror("Error removing old patients.dat");
-        }
-        if(rename("patients.tmp", "patients.dat") != 0)
-        {
-            perror("Error renaming temporary file to patients.dat");
-        }
-        else
-        {
-            puts("patients.dat updated successfully."); // Success message only after rename
-        }
-    }
-    else
+    if(write_error)
     {
         puts("Backup failed. Original patients.dat remains unchanged.");
         remove("patients.tmp"); // Clean up failed temp file
+        return 0;
     }
+
+    return 1;
 }
 
-/*
- * Prompts user for a patient ID and returns a pointer to the patient record in the linked list.
+/**
+ * Replaces patients.dat with the completed patients.tmp.
  */
-static Patient *getPatientFromList(int id)
+static int replacePatientsFile(void)
 {
-    if(patientHead == NULL)
+    // Only replace original if temp write was fully successful
+    if(!replaceFile("patients.tmp", "patients.dat"))
     {
-        return NULL;
+        perror("Error renaming temporary file to patients.dat");
+        return 0;
     }
 
-    PatientNode *current = patientHead;
-    while(current != NULL)
-    {
-        if(current->data.patientId == id)
-        {
-            return &(current->data);
-        }
-        current = current->nextNode;
-    }
-    return NULL;
+    puts("patients.dat updated successfully."); // Success message only after rename
+    return 1;
+}
+
+/*
+ * Prompts user for a patient ID and returns a pointer to the patient record in the linked list.
+ */
+static Patient *getPatientFromList(int id)
+{
+    PatientNode *found = findPatientNode(id);
+    return found == NULL ? NULL : &(found->data);
 }
 
 /**
  * Appends a single patient record to the patients.dat file.
  * Opens file in append binary mode, writes patient data, and handles errors.
+ * Returns 1 once the record is on disk.
  */
-static void writePatientToFile(Patient newPatient)
+static int writePatientToFile(Patient newPatient)
 {
     FILE *pPatients = fopen("patients.dat", "ab");
 
     if(pPatients == NULL)
     {
         puts("\nUnable to find patients.dat. Patient not added to file.");
-        return;
+        return 0;
+    }
+
+    int written = fwrite(&newPatient, sizeof(Patient), 1, pPatients) == 1 && flushToDisk(pPatients);
+
+    if(fclose(pPatients) != 0 || !written)
+    {
+        perror("Error writing to patients.dat");
+        return 0;
     }
 
-    fwrite(&newPatient, sizeof(Patient), 1, pPatients);
-    fclose(pPatients);
     puts("\nPatient successfully added to file.\n");
+    return 1;
 }
 
 /*
- * Checks if a room is currently occupied.
+ * Prompts for a ward name. An empty name means any ward.
+ * Returns 0 if the name does not match a ward.
  */
-static int isRoomOccupiedInList(int roomNumber, PatientNode *head)
+static int promptWardName(int *wardIndex)
 {
-    PatientNode *current = head;
-    while(current != NULL)
+    char wardName[MAX_WARD_NAME_LENGTH];
+
+    *wardIndex = NO_WARD;
+
+    printf("Enter ward name (Enter for any ward):\n");
+    if(fgets(wardName, sizeof(wardName), stdin) == NULL)
     {
-        if(current->data.roomNumber == roomNumber)
-            return 1;
-        current = current->nextNode;
+        return 1;
+    }
+    wardName[strcspn(wardName, "\n")] = '\0';
+
+    if(wardName[0] != '\0')
+    {
+        *wardIndex = facilityFindWard(wardName);
+        if(*wardIndex == NO_WARD)
+        {
+            printf("No ward named '%s'.\n", wardName);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Asks whether a patient who cannot get a bed should join the waitlist.
+ */
+static int askToWaitlist(void)
+{
+    char answer;
+
+    printf("Add the patient to the waitlist instead? (y/n)\n");
+    scanf(" %c", &answer);
+    clearInputBuffer();
+    return answer == YES || answer == 'Y';
+}
+
+/*
+ * Creates a patient record in the given room, appends it to patients.dat and,
+ * once it is saved, adds it to the census. Returns 0 if it could not be saved,
+ * leaving the census unchanged.
+ */
+static int admitPatient(const char name[], int age, const char diagnosis[], int roomNumber, Patient *admitted)
+{
+    Patient newPatient = createPatient(name, age, diagnosis, roomNumber, patientIDCounter);
+
+    if(!writePatientToFile(newPatient))
+    {
+        return 0;
+    }
+
+    patientHead = insertPatientAtEndOfList(patientHead, newPatient);
+    totalPatients++;
+    patientIDCounter++;
+
+    activityRecordAdmission(newPatient.admissionDate, totalPatients);
+    checkReadmission(&newPatient);
+    *admitted = newPatient;
+    return 1;
+}
+
+/*
+ * Fills the beds freed by a discharge with the most urgent eligible
+ * patients from the waitlist. A patient only leaves the waitlist once their
+ * admission is saved; if it cannot be, they keep their place.
+ */
+static void admitFromWaitlist(const DischargedPatient records[], int count)
+{
+    for(int i = 0; i < count && waitlistSize() > 0; i++)
+    {
+        int            roomNumber = records[i].patient.roomNumber;
+        WaitingPatient waiting;
+
+        while(facilityFreeBeds(roomNumber) > 0 && waitlistPeekForRoom(roomNumber, &waiting))
+        {
+            Patient admitted;
+
+            showPossibleDuplicates(waiting.name, waiting.age);
+            if(!admitPatient(waiting.name, waiting.age, waiting.diagnosis, roomNumber, &admitted))
+            {
+                printf("%s could not be admitted and stays on the waitlist.\n", waiting.name);
+                return;
+            }
+            waitlistRemoveEntry(&waiting);
+
+            // Nobody is at the keyboard for these admissions, so the suggestion is taken as is
+            assignAttendingDoctor(admitted.patientId, suggestAttendingDoctor());
+
+            printf("--- Patient Admitted From Waitlist (priority %d) ---\n", waiting.priority);
+            printPatient(admitted);
+        }
     }
-    return ROOM_UNOCCUPIED;
 }
 
 /*
@@ -951,7 +1521,9 @@ static PatientNode *insertPatientAtEndOfList(PatientNode *head, Patient data)
     }
 
     newNode->data     = data;
+    newNode->holdsBed = 0;
     newNode->nextNode = NULL;
+    indexPatientNode(newNode);
 
     if(head == NULL)
     {
@@ -972,6 +1544,8 @@ static PatientNode *insertPatientAtEndOfList(PatientNode *head, Patient data)
 /*
  * Counts the number of patients admitted within
  * the specified timeframe (daily, weekly, or monthly).
+ * The activity calendar keeps the admitted patients by admission day,
+ * so this sums at most a month of day counts.
  */
 static int countPatientsByTimeframe(int timeframe)
 {
@@ -981,116 +1555,481 @@ static int countPatientsByTimeframe(int timeframe)
         return 0;
     }
 
-    int        count       = 0;
-    time_t     now         = time(NULL);
-    struct tm *currentTime = localtime(&now);
+    int firstDay;
+    int lastDay;
 
-    // Extract current year, day of year, and month
-    int currentYear      = currentTime->tm_year;
-    int currentDayOfYear = currentTime->tm_yday;
-    int currentMonth     = currentTime->tm_mon;
+    timeframeDays(timeframe, &firstDay, &lastDay);
+    return activityTotal(ACTIVITY_STILL_ADMITTED, firstDay, lastDay);
+}
 
-    PatientNode *current = patientHead;
-    while(current != NULL)
+/*
+ * Counts the number of discharged patients within the specified
+ * timeframe from the activity calendar's daily discharge counts.
+ */
+static int countDischargedPatientsByTimeframe(int timeframe)
+{
+    int firstDay;
+    int lastDay;
+
+    timeframeDays(timeframe, &firstDay, &lastDay);
+    return activityTotal(ACTIVITY_DISCHARGES, firstDay, lastDay);
+}
+
+/*
+ * Gives the calendar days a report timeframe covers: today (daily), the
+ * last seven days (weekly) or the current month (monthly).
+ */
+static void timeframeDays(int timeframe, int *firstDay, int *lastDay)
+{
+    time_t    now   = time(NULL);
+    struct tm date  = *localtime(&now);
+    int       today = toDayNumber(now);
+
+    *firstDay = today;
+    *lastDay  = today;
+
+    if(timeframe == 2)
+    {
+        *firstDay = today - 6;
+    }
+    else if(timeframe == 3)
+    {
+        // The month ends the day before the first of the next one
+        *firstDay     = today - (date.tm_mday - 1);
+        date.tm_mday  = 1;
+        date.tm_mon  += 1;
+        date.tm_isdst = -1;
+        *lastDay      = toDayNumber(mktime(&date)) - 1;
+    }
+}
+
+/*
+ * Counts one use of each discharged patient's room in the
+ * binary room usage counters.
+ */
+static int logRoomUsage(const DischargedPatient records[], int count)
+{
+    int *roomNumbers = malloc(count * sizeof(int));
+    if(roomNumbers == NULL)
+    {
+        puts("Error: Not enough memory to log room usage.");
+        return 0;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        roomNumbers[i] = records[i].patient.roomNumber;
+    }
+
+    // Room usage is informational, so the discharge itself still goes ahead on failure.
+    int logged = recordRoomUsage(roomNumbers, count, records[0].dischargeDate);
+
+    free(roomNumbers);
+    return logged;
+}
+
+/*
+ * Adds a freshly linked patient node to the ID table and the name index.
+ */
+static void indexPatientNode(PatientNode *node)
+{
+    activityTrackAdmitted(node->data.admissionDate, 1);
+
+    if((totalPatients + 1) * 2 > patientTableCapacity && !growPatientTable())
+    {
+        puts("Warning: Unable to grow patient ID table.");
+        return;
+    }
+
+    int mask = patientTableCapacity - 1;
+    int slot = (unsigned int) node->data.patientId & mask;
+
+    while(patientTable[slot] != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+    patientTable[slot] = node;
+
+    if(activeNameIndex == NULL)
+    {
+        activeNameIndex = createNameIndex();
+    }
+
+    if(activeNameIndex == NULL || !nameIndexInsert(activeNameIndex, node->data.name, node->data.patientId))
+    {
+        puts("Warning: Unable to add patient to the name index.");
+    }
+
+    if(activeDiagnosisIndex == NULL)
+    {
+        activeDiagnosisIndex = createDiagnosisIndex();
+    }
+
+    if(activeDiagnosisIndex == NULL ||
+       !diagnosisIndexAdd(activeDiagnosisIndex, node->data.diagnosis, node->data.patientId))
+    {
+        puts("Warning: Unable to add patient to the diagnosis index.");
+    }
+
+    if(activeIdentityIndex == NULL)
+    {
+        activeIdentityIndex = createIdentityIndex();
+    }
+
+    if(activeIdentityIndex == NULL ||
+       !identityIndexInsert(activeIdentityIndex, node->data.name, node->data.ageInYears, node->data.patientId))
     {
-        time_t     admissionTimestamp = current->data.admissionDate;
-        struct tm *admissionTime      = localtime(&admissionTimestamp);
+        puts("Warning: Unable to add patient to the identity index.");
+    }
+
+    node->holdsBed = facilityOccupyBed(node->data.roomNumber);
+    if(!node->holdsBed)
+    {
+        printf("Warning: Patient %d is in room %d, which has no free bed in the facility layout.\n",
+               node->data.patientId, node->data.roomNumber);
+    }
+
+    roomHistoryOpenStay(node->data.roomNumber, node->data.patientId, node->data.admissionDate);
+}
+
+/*
+ * Removes a patient node from the ID table and the name index before it is freed,
+ * releasing its bed only if it was given one.
+ * Entries after the freed slot are shifted back so probe chains stay unbroken.
+ */
+static void unindexPatientNode(const PatientNode *node)
+{
+    if(node->holdsBed)
+    {
+        facilityReleaseBed(node->data.roomNumber);
+    }
+    activityTrackAdmitted(node->data.admissionDate, -1);
+
+    if(patientTable == NULL)
+    {
+        return;
+    }
 
-        // Extract admission year, day of year, and month
-        int admissionYear      = admissionTime->tm_year;
-        int admissionDayOfYear = admissionTime->tm_yday;
-        int admissionMonth     = admissionTime->tm_mon;
+    int mask = patientTableCapacity - 1;
+    int slot = (unsigned int) node->data.patientId & mask;
+
+    while(patientTable[slot] != NULL && patientTable[slot] != node)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    if(patientTable[slot] == NULL)
+    {
+        return;
+    }
 
-        // Calculate the difference in hours directly
-        double secondsDiff = difftime(now, admissionTimestamp);
-        int    hoursDiff   = (int) (secondsDiff / 3600);
+    patientTable[slot] = NULL;
 
-        // Adjusted time conditions
-        int past24Hours = (hoursDiff <= 24);
-        int sameWeek    = (admissionYear == currentYear && (currentDayOfYear - admissionDayOfYear) < 7);
-        int sameMonth   = (admissionYear == currentYear && admissionMonth == currentMonth);
+    int next = (slot + 1) & mask;
+    while(patientTable[next] != NULL)
+    {
+        PatientNode *moved = patientTable[next];
+        int          home  = (unsigned int) moved->data.patientId & mask;
 
-        // Increment count based on timeframe
-        if((timeframe == 1 && past24Hours) || // Daily
-           (timeframe == 2 && sameWeek) ||    // Weekly
-           (timeframe == 3 && sameMonth))     // Monthly
+        // Move the entry back if the hole lies between its home slot and its current slot
+        if(((next - home) & mask) >= ((next - slot) & mask))
         {
-            count++;
+            patientTable[slot] = moved;
+            patientTable[next] = NULL;
+            slot               = next;
         }
+        next = (next + 1) & mask;
+    }
 
-        current = current->nextNode;
+    nameIndexRemove(activeNameIndex, node->data.name, node->data.patientId);
+    diagnosisIndexRemove(activeDiagnosisIndex, node->data.diagnosis, node->data.patientId);
+    identityIndexRemove(activeIdentityIndex, node->data.name, node->data.ageInYears, node->data.patientId);
+    roomHistoryDropOpenStay(node->data.roomNumber, node->data.patientId);
+}
+
+/*
+ * Returns the admitted patient with the given ID, or NULL if there is none.
+ */
+const Patient *findAdmittedPatient(int patientId)
+{
+    PatientNode *found = findPatientNode(patientId);
+    return found == NULL ? NULL : &(found->data);
+}
+
+/*
+ * Returns the head of the admitted patient list.
+ */
+const PatientNode *admittedPatients(void)
+{
+    return patientHead;
+}
+
+/*
+ * Looks up an active patient by ID in constant expected time.
+ */
+static PatientNode *findPatientNode(int id)
+{
+    if(patientTable == NULL)
+    {
+        return NULL;
     }
 
-    return count;
+    int mask = patientTableCapacity - 1;
+    int slot = (unsigned int) id & mask;
+
+    while(patientTable[slot] != NULL)
+    {
+        if(patientTable[slot]->data.patientId == id)
+        {
+            return patientTable[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
 }
 
 /*
- * Counts the number of discharged patients from a
- * binary file within the specified timeframe.
+ * Doubles the ID table and re-inserts every active patient.
  */
-static int countDischargedPatientsByTimeframe(int timeframe)
+static int growPatientTable(void)
 {
+    int           newCapacity = patientTableCapacity == IS_EMPTY ? MIN_TABLE_CAPACITY : patientTableCapacity * 2;
+    PatientNode **newTable    = calloc(newCapacity, sizeof(PatientNode *));
+
+    if(newTable == NULL)
+    {
+        return 0;
+    }
+
+    for(int i = 0; i < patientTableCapacity; i++)
+    {
+        PatientNode *node = patientTable[i];
+        if(node == NULL)
+        {
+            continue;
+        }
+
+        int slot = (unsigned int) node->data.patientId & (newCapacity - 1);
+        while(newTable[slot] != NULL)
+        {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newTable[slot] = node;
+    }
+
+    free(patientTable);
+    patientTable         = newTable;
+    patientTableCapacity = newCapacity;
+    return 1;
+}
+
+/*
+ * Builds the name and diagnosis indexes over discharged_patients.dat. Each
+ * entry is keyed by its record number in the file, since patient IDs can be
+ * reused over time.
+ */
+static void loadDischargedIndexes(void)
+{
+    if(dischargedNameIndex == NULL)
+    {
+        dischargedNameIndex = createNameIndex();
+    }
+    if(dischargedDiagnosisIndex == NULL)
+    {
+        dischargedDiagnosisIndex = createDiagnosisIndex();
+    }
+
+    if(dischargedNameIndex == NULL || dischargedDiagnosisIndex == NULL)
+    {
+        puts("Warning: Unable to create the discharged patient indexes.");
+        return;
+    }
+
+    clearNameIndex(dischargedNameIndex);
+    clearDiagnosisIndex(dischargedDiagnosisIndex);
+
     FILE *file = fopen("discharged_patients.dat", "rb");
     if(file == NULL)
     {
-        printf("No discharged patients found!\n");
-        return 0;
+        return;
     }
 
-    int        count       = 0;
-    time_t     now         = time(NULL);
-    struct tm *currentTime = localtime(&now);
+    DischargedPatient record;
+    int               recordNumber = 0;
 
-    DischargedPatient dischargedPatient;
-    while(fread(&dischargedPatient, sizeof(DischargedPatient), 1, file) == 1)
+    while(fread(&record, sizeof(DischargedPatient), 1, file) == 1)
     {
-        time_t     dischargeTimestamp = dischargedPatient.dischargeDate;
-        struct tm *dischargeTime      = localtime(&dischargeTimestamp);
+        nameIndexInsert(dischargedNameIndex, record.patient.name, recordNumber);
+        diagnosisIndexAdd(dischargedDiagnosisIndex, record.patient.diagnosis, recordNumber);
+        recordNumber++;
+    }
+
+    fclose(file);
+}
 
-        double secondsDiff = difftime(now, dischargeTimestamp);
-        int    hoursDiff   = secondsDiff / 3600;
+/*
+ * Reads one record of discharged_patients.dat by its position in the file.
+ */
+int readDischargedPatient(long recordNumber, DischargedPatient *record)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
 
-        int past24Hours = (hoursDiff <= 24);
-        int sameWeek =
-                (dischargeTime->tm_year == currentTime->tm_year && (currentTime->tm_yday - dischargeTime->tm_yday) < 7);
-        int sameMonth =
-                (dischargeTime->tm_year == currentTime->tm_year && dischargeTime->tm_mon == currentTime->tm_mon);
+    int found = fseek(file, recordNumber * (long) sizeof(DischargedPatient), SEEK_SET) == 0 &&
+                fread(record, sizeof(DischargedPatient), 1, file) == 1;
 
-        if((timeframe == 1 && past24Hours) || (timeframe == 2 && sameWeek) || (timeframe == 3 && sameMonth))
+    fclose(file);
+    return found;
+}
+
+/*
+ * Prompts for how a name search should match.
+ */
+static int getNameMatchMode(void)
+{
+    int matchMode;
+
+    do
+    {
+        printf("Match type:\n"
+               "1: Exact\n"
+               "2: Exact (ignore case)\n"
+               "3: Starts with (ignore case)\n");
+
+        if(scanf("%d", &matchMode) != SUCCESSFUL_READ)
+        {
+            matchMode = IS_EMPTY;
+        }
+        clearInputBuffer();
+
+        if(matchMode < NAME_MATCH_EXACT || matchMode > NAME_MATCH_PREFIX)
         {
-            count++;
+            printf("Invalid choice. Please enter 1, 2 or 3.\n");
         }
     }
+    while(matchMode < NAME_MATCH_EXACT || matchMode > NAME_MATCH_PREFIX);
 
-    fclose(file);
-    return count;
+    return matchMode;
 }
 
+/*
+ * Prints the matches of one name index a page at a time, asking before each
+ * further page. Returns the total number of matches.
+ */
+static int showNameMatches(NameIndex *index, const char *query, int matchMode, int isArchive)
+{
+    int keys[RESULTS_PER_PAGE];
+    int totalMatches = 0;
+    int offset       = 0;
+
+    if(index == NULL)
+    {
+        return 0;
+    }
+
+    do
+    {
+        int count = nameIndexSearch(index, query, matchMode, offset, RESULTS_PER_PAGE, keys, &totalMatches);
+
+        if(count == IS_EMPTY)
+        {
+            break;
+        }
 
+        printf("--- %s patients %d-%d of %d ---\n",
+               isArchive ? "Discharged" : "Active", offset + 1, offset + count, totalMatches);
+        printPatientPage(keys, count, isArchive);
+
+        offset += count;
+    }
+    while(offset < totalMatches && askForNextPage());
+
+    return totalMatches;
+}
 
 /*
- * Appends the given room number to the
- * room_usage.txt file for logging purposes.
+ * Prints the matches of one diagnosis index a page at a time, asking before
+ * each further page. Returns the total number of matches, or -1 if the query
+ * was rejected as too long.
  */
-static void logRoomUsage(int roomNumber)
+static int showDiagnosisMatches(DiagnosisIndex *index, const char *query, int isArchive)
 {
-    FILE *file = fopen("room_usage.txt", "a"); // Open in append mode
+    int *keys = NULL;
 
-    if(file == NULL)
+    if(index == NULL)
     {
-        perror("Error opening room_usage.txt for logging");
-        // Decide if this is a critical error or just a warning.
-        // For now, we'll print an error and continue.
-        return;
+        return 0;
     }
 
-    // Write the room number followed by a newline
-    fprintf(file, "%d\n", roomNumber);
+    int totalMatches = diagnosisIndexSearch(index, query, &keys);
+    if(totalMatches == DIAGNOSIS_QUERY_TOO_LONG)
+    {
+        printf("The search has more than %d words. Please shorten it and try again.\n", MAX_DIAGNOSIS_QUERY_TERMS);
+        return -1;
+    }
+    if(totalMatches < 0)
+    {
+        puts("Error: Not enough memory to run the diagnosis search.");
+        return 0;
+    }
 
-    fclose(file);
-    // Optional: Add a confirmation message here if desired
-    // printf("Room %d usage logged.\n", roomNumber);
+    for(int offset = 0; offset < totalMatches; offset += RESULTS_PER_PAGE)
+    {
+        int count = totalMatches - offset < RESULTS_PER_PAGE ? totalMatches - offset : RESULTS_PER_PAGE;
+
+        printf("--- %s patients %d-%d of %d ---\n",
+               isArchive ? "Discharged" : "Active", offset + 1, offset + count, totalMatches);
+        printPatientPage(&keys[offset], count, isArchive);
+
+        if(offset + count < totalMatches && !askForNextPage())
+        {
+            break;
+        }
+    }
+
+    free(keys);
+    return totalMatches;
 }
 
+/*
+ * Prints one page of search results. Keys are patient IDs for active
+ * patients and record numbers for discharged ones.
+ */
+static void printPatientPage(const int keys[], int count, int isArchive)
+{
+    for(int i = 0; i < count; i++)
+    {
+        DischargedPatient record;
 
+        if(!isArchive)
+        {
+            printPatient(findPatientNode(keys[i])->data);
+        }
+        else if(readDischargedPatient(keys[i], &record))
+        {
+            printPatient(record.patient);
+            printf("Time Discharged: %s", ctime(&record.dischargeDate));
+        }
+    }
+}
+
+/*
+ * Asks whether to show the next page of results.
+ */
+static int askForNextPage(void)
+{
+    printf("Enter n for the next page, or anything else to stop:\n");
+
+    char next = getchar();
+    if(next != '\n')
+    {
+        clearInputBuffer();
+    }
+
+    return next == 'n' || next == 'N';
+}
 
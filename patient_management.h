@@ -7,11 +7,17 @@
 #ifndef PATIENT_MANAGEMENT_H
 #define PATIENT_MANAGEMENT_H
 #include "patient_data.h"
+#include "report_sink.h"
 #include <stdio.h>
 
+// Batch discharge limits and results
+#define MAX_BATCH_DISCHARGE 256
+#define BATCH_DISCHARGE_FAILED (-1)
+
 typedef struct PatientNode
 {
     Patient data;
+    int holdsBed;  // 1 once the patient occupies a bed in the facility layout
     struct PatientNode *nextNode;
 } PatientNode;
 
@@ -28,6 +34,15 @@ typedef struct DischargedPatient {
  */
 void initializePatientSystem(void);
 
+/*
+ * Function: recoverDischarges
+ * ---------------------------
+ * Rolls back a discharge batch a crash interrupted before it was committed,
+ * or clears its journal if it was. Must run before anything reads the
+ * discharge archive.
+ */
+void recoverDischarges(void);
+
 /*
  * Function: initializePatientSystemDefault
  * ----------------------------------------
@@ -50,6 +65,38 @@ void addPatientRecord(void);
  */
 void viewPatientRecords(void);
 
+/*
+ * Function: findAdmittedPatient
+ * -----------------------------
+ * Looks up a currently admitted patient by ID.
+ *
+ * patientId: The ID to look up
+ *
+ * Returns: The patient record, or NULL if no admitted patient has that ID
+ */
+const Patient *findAdmittedPatient(int patientId);
+
+/*
+ * Function: admittedPatients
+ * --------------------------
+ * Gives read access to the census for code that walks every admitted patient.
+ *
+ * Returns: The first node of the admitted patient list, or NULL if it is empty
+ */
+const PatientNode *admittedPatients(void);
+
+/*
+ * Function: readDischargedPatient
+ * -------------------------------
+ * Reads one discharge record by its position in discharged_patients.dat.
+ *
+ * recordNumber: Zero-based position of the record in the archive
+ * record: Receives the discharge record
+ *
+ * Returns: 1 if the record was read, 0 otherwise
+ */
+int readDischargedPatient(long recordNumber, DischargedPatient *record);
+
 /*
  * Function: searchPatientById
  * ---------------------------
@@ -57,6 +104,22 @@ void viewPatientRecords(void);
  */
 void searchPatientById(void);
 
+/*
+ * Function: searchPatientByName
+ * -----------------------------
+ * Searches active patients, and optionally discharged patients, by exact,
+ * case-insensitive or prefix name match and shows the results page by page.
+ */
+void searchPatientByName(void);
+
+/*
+ * Function: searchPatientsByDiagnosis
+ * -----------------------------------
+ * Finds current and/or discharged patients whose diagnosis mentions the
+ * given keywords, combined with "and" / "or".
+ */
+void searchPatientsByDiagnosis(void);
+
 /*
  * Function: dischargePatient
  * --------------------------
@@ -64,6 +127,27 @@ void searchPatientById(void);
  */
 void dischargePatient(void);
 
+/*
+ * Function: dischargePatientsById
+ * -------------------------------
+ * Discharges a batch of patients in one transaction. All IDs are validated
+ * first; if any is unknown or repeated, nothing is discharged. The archive,
+ * room usage counters and patients.dat are each written once for the whole batch.
+ *
+ * patientIds: IDs of the patients to discharge
+ * count: Number of IDs
+ *
+ * Returns: The number of patients discharged, or BATCH_DISCHARGE_FAILED
+ */
+int dischargePatientsById(const int patientIds[], int count);
+
+/*
+ * Function: dischargeMultiplePatients
+ * -----------------------------------
+ * Prompts for a list of patient IDs and discharges them as one batch.
+ */
+void dischargeMultiplePatients(void);
+
 /*
  * Function: backupPatientSystem
  * -----------------------------
@@ -110,24 +194,18 @@ void displayPatientReport(int choice);
  */
 void displayDischargedPatientReport(int choice);
 
-/*
- * Function: displayRoomUsageReport
- * --------------------------------
- * Displays a report summarizing room usage based on "room_usage.txt".
- */
-void displayRoomUsageReport(void);
-
 /*
  * Function: printFormattedReport
  * ------------------------------
- * Helper to print a patient report (admission/discharge) to console and file.
+ * Helper to print a patient admission report to a report sink, which
+ * mirrors it to the console and a file.
  *
- * file: Output file stream.
+ * sink: Report sink receiving the report.
  * header: Report title.
  * result: Total patient count for the report.
  * timeframe: Timeframe used for filtering patient details.
  */
-void printFormattedReport(FILE *file, const char *header, int result, int timeframe);
+void printFormattedReport(ReportSink *sink, const char *header, int result, int timeframe);
 
 
 #endif // PATIENT_MANAGEMENT_H 
\ No newline at end of file
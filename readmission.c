@@ -0,0 +1,944 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements readmission detection. The identity table
+ *          is an open-addressing hash of (normalised name, age band) to the
+ *          identity's stay count and last discharge. An admission looks up
+ *          its own age band and the one below it, so a birthday between two
+ *          stays does not hide the earlier one.
+ *
+ *          readmission_index.dat records how many archive records the table
+ *          covers. Discharges are added in memory as they are archived and
+ *          the file is rewritten every SAVE_INTERVAL records; the archive is
+ *          append-only, so anything newer is read from its tail on load.
+ *
+ *          The report turns every stay into an admission and a discharge
+ *          event keyed by a 64-bit hash of the normalised name, sorts the
+ *          events by name and time, and walks each name's run remembering
+ *          the last discharge per age band. Each admission is then matched
+ *          to its previous discharge without a second pass over the stays.
+ */
+
+#include "readmission.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "report_format.h"
+#include "report_sink.h"
+#include "utils.h"
+
+// Private constants
+#define AGE_BAND_YEARS 5
+#define AGE_BAND_COUNT (150 / AGE_BAND_YEARS)
+#define MIN_INDEX_CAPACITY 256
+#define ARCHIVE_CHUNK 256
+#define SAVE_INTERVAL 256
+#define WINDOW_INPUT_LENGTH 16
+#define MAX_CONSOLE_REPORT_ROWS 500
+
+static const char    INDEX_MAGIC[4]          = { 'R', 'E', 'A', 'D' };
+static const int     INDEX_VERSION           = 1;
+static const int     EMPTY_SLOT              = -1;
+static const long    NO_RECORD               = -1;
+static const int     READMISSION_DAYS        = 30;
+static const int     DEFAULT_REPORT_DAYS     = 90;
+static const int     MAX_WINDOW_DAYS         = 3650;
+static const double  SECONDS_PER_DAY         = 24.0 * 60.0 * 60.0;
+static const char   *INDEX_FILE              = "readmission_index.dat";
+static const char   *INDEX_TEMP              = "readmission_index.tmp";
+static const char   *READMISSION_REPORT_FILE = "readmission_reports.txt";
+static const char   *SEPARATOR_LINE          = "---------------------------------------\n";
+
+/*
+ * One discharged identity and its most recent discharge.
+ */
+typedef struct
+{
+    char      name[MAX_PATIENT_NAME_LENGTH];
+    int       ageBand;
+    int       stays;
+    long long lastRecord;
+    time_t    lastDischarge;
+} DischargedIdentity;
+
+/*
+ * Header of readmission_index.dat, followed by identityCount identities.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    long long coveredRecords;
+    int       identityCount;
+} IdentityFileHeader;
+
+/*
+ * An admission or discharge of one stay. record is the stay's position in
+ * the archive, or NO_RECORD for a patient still admitted.
+ */
+typedef struct
+{
+    unsigned long long nameKey;
+    time_t             when;
+    long               record;
+    int                patientId;
+    int                age;
+    int                isDischarge;
+} StayEvent;
+
+/*
+ * An admission matched to the same patient's previous discharge.
+ */
+typedef struct
+{
+    long    previousRecord;
+    long    record;
+    int     patientId;
+    time_t  discharged;
+    time_t  readmitted;
+    Patient previous;
+    Patient current;
+} Readmission;
+
+/*
+ * A patient record the report needs from the archive.
+ */
+typedef struct
+{
+    long     record;
+    Patient *target;
+} RecordRequest;
+
+static DischargedIdentity *identities       = NULL;
+static int                 identityCount    = 0;
+static int                 identityCapacity = 0;
+static int                *identitySlots    = NULL;
+static int                 slotCapacity     = 0;
+static long long           coveredRecords   = 0;
+static long long           savedRecords     = 0;
+static int                 identitiesLoaded = 0;
+
+// Function prototypes for internal helper functions
+static int                 ensureIdentities(void);
+static void                loadIdentities(void);
+static int                 updateIdentities(void);
+static int                 saveIdentities(void);
+static void                resetIdentities(void);
+static int                 addDischarge(const DischargedPatient *record, long long recordNumber);
+static DischargedIdentity *findIdentity(const char *name, int ageBand, int create);
+static int                 growIdentitySlots(void);
+static unsigned int        hashIdentity(const char *name, int ageBand);
+static unsigned long long  nameKeyOf(const char *name);
+static int                 ageBandOf(int age);
+static StayEvent          *buildStayEvents(int *eventCount);
+static int                 addStayEvent(StayEvent **events, int *count, int *capacity, const Patient *patient,
+                                        time_t when, long record, int isDischarge);
+static Readmission        *joinReadmissions(const StayEvent events[], int eventCount, time_t from, time_t to,
+                                            int windowDays, int *admissions, int *readmissionCount);
+static int                 fillPatients(Readmission readmissions[], int count);
+static int                 compareEvents(const void *a, const void *b);
+static int                 compareRequests(const void *a, const void *b);
+static int                 compareReadmissions(const void *a, const void *b);
+static int                 promptWindowDays(void);
+static void                printReadmissions(ReportSink *sink, const Readmission readmissions[], int count,
+                                             int admissions, time_t from, time_t to, int windowDays);
+
+/*
+ * Adds the records to the loaded table, or leaves them for the next load
+ * when the table is not in memory or is missing earlier records.
+ */
+void readmissionRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count)
+{
+    if(!identitiesLoaded || firstArchiveRecord != coveredRecords)
+    {
+        return;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        if(!addDischarge(&records[i], firstArchiveRecord + i))
+        {
+            puts("Error: Not enough memory for the readmission index.");
+            resetIdentities();
+            return;
+        }
+    }
+
+    coveredRecords += count;
+    if(coveredRecords - savedRecords >= SAVE_INTERVAL)
+    {
+        saveIdentities();
+    }
+}
+
+/*
+ * Looks up the patient's age band and the band below it and reports the
+ * more recent of the discharges found.
+ */
+int checkReadmission(const Patient *patient)
+{
+    if(!ensureIdentities())
+    {
+        return 0;
+    }
+
+    char name[MAX_PATIENT_NAME_LENGTH];
+    normaliseText(patient->name, name, sizeof(name));
+
+    int                 band  = ageBandOf(patient->ageInYears);
+    int                 below = ageBandOf(patient->ageInYears - 1);
+    DischargedIdentity *found = findIdentity(name, band, 0);
+    DischargedIdentity *other = below != band ? findIdentity(name, below, 0) : NULL;
+
+    if(found == NULL || (other != NULL && other->lastDischarge > found->lastDischarge))
+    {
+        found = other;
+    }
+    if(found == NULL)
+    {
+        return 0;
+    }
+
+    DischargedPatient previous;
+    DateCache         dates;
+    double            daysAgo     = difftime(patient->admissionDate, found->lastDischarge) / SECONDS_PER_DAY;
+    int               readmission = daysAgo >= 0 && daysAgo <= READMISSION_DAYS;
+
+    initDateCache(&dates);
+
+    printf("Note: A patient named %s of a similar age has %d previous stay%s, last discharged on %s",
+           patient->name, found->stays, found->stays == 1 ? "" : "s", cachedDateText(&dates, found->lastDischarge));
+    if(readDischargedPatient((long) found->lastRecord, &previous))
+    {
+        printf(" (ID %d, room %d, diagnosis: %s)", previous.patient.patientId, previous.patient.roomNumber,
+               previous.patient.diagnosis);
+    }
+    printf(".\n");
+
+    if(readmission)
+    {
+        printf("This is a readmission within %d days of discharge.\n", READMISSION_DAYS);
+    }
+    return readmission;
+}
+
+/*
+ * Prompts for the range and window, joins the stays and prints the
+ * readmissions found.
+ */
+void readmissionReport(void)
+{
+    int    today      = toDayNumber(time(NULL));
+    time_t from       = promptDateTime("Readmitted from (YYYY-MM-DD, Enter for 90 days ago):\n",
+                                       dayNumberToTime(today - DEFAULT_REPORT_DAYS + 1));
+    time_t lastDay    = promptDateTime("To, inclusive (YYYY-MM-DD, Enter for today):\n", dayNumberToTime(today));
+    time_t to         = dayNumberToTime(toDayNumber(lastDay) + 1);
+    int    windowDays = promptWindowDays();
+
+    if(to <= from)
+    {
+        puts("The range ends before it starts.");
+        return;
+    }
+
+    int        eventCount;
+    StayEvent *events = buildStayEvents(&eventCount);
+    if(events == NULL)
+    {
+        puts("Error: Not enough memory for the readmission report.");
+        return;
+    }
+
+    int          admissions;
+    int          count;
+    Readmission *readmissions = joinReadmissions(events, eventCount, from, to, windowDays, &admissions, &count);
+    free(events);
+
+    if(readmissions == NULL || !fillPatients(readmissions, count))
+    {
+        puts("Error: Not enough memory for the readmission report.");
+        free(readmissions);
+        return;
+    }
+
+    qsort(readmissions, count, sizeof(Readmission), compareReadmissions);
+
+    FILE *file = fopen(READMISSION_REPORT_FILE, "a");
+    if(file == NULL)
+    {
+        printf("Error opening file for writing!\n");
+        free(readmissions);
+        return;
+    }
+
+    fprintf(file, "\n");
+
+    int         echoToConsole = count <= MAX_CONSOLE_REPORT_ROWS;
+    ReportSink *sink          = openReportSink(file, echoToConsole);
+
+    if(sink != NULL)
+    {
+        printReadmissions(sink, readmissions, count, admissions, from, to, windowDays);
+    }
+    free(readmissions);
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing %s\n", READMISSION_REPORT_FILE);
+        return;
+    }
+
+    if(!echoToConsole)
+    {
+        printf("%d readmissions found; too many to show here.\n", count);
+    }
+    printf("\nReport successfully written to %s\n", READMISSION_REPORT_FILE);
+}
+
+/*
+ * Loads the table on first use and adds any newly archived discharges.
+ */
+static int ensureIdentities(void)
+{
+    if(!identitiesLoaded)
+    {
+        loadIdentities();
+    }
+    return updateIdentities();
+}
+
+/*
+ * Reads readmission_index.dat. A missing or unreadable file leaves the
+ * table empty, so it is rebuilt from the whole archive.
+ */
+static void loadIdentities(void)
+{
+    identitiesLoaded = 1;
+
+    FILE *file = fopen(INDEX_FILE, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    IdentityFileHeader header;
+    DischargedIdentity stored;
+    int                valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 && header.version == INDEX_VERSION;
+
+    for(int i = 0; valid && i < header.identityCount; i++)
+    {
+        valid = fread(&stored, sizeof(stored), 1, file) == 1;
+        stored.name[MAX_PATIENT_NAME_LENGTH - 1] = '\0';
+
+        DischargedIdentity *identity = valid ? findIdentity(stored.name, stored.ageBand, 1) : NULL;
+        valid                        = identity != NULL;
+
+        if(valid)
+        {
+            *identity = stored;
+        }
+    }
+
+    fclose(file);
+
+    if(!valid)
+    {
+        puts("Error reading readmission_index.dat. The readmission index will be rebuilt.");
+        resetIdentities();
+        return;
+    }
+    coveredRecords = header.coveredRecords;
+    savedRecords   = header.coveredRecords;
+}
+
+/*
+ * Adds the discharges archived after the covered records and saves the
+ * table if any were added. Returns 0 if the table could not be updated.
+ */
+static int updateIdentities(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        resetIdentities();
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long long recordCount = ftell(file) / (long long) sizeof(DischargedPatient);
+
+    if(recordCount < coveredRecords)
+    {
+        resetIdentities();
+    }
+    if(recordCount == coveredRecords)
+    {
+        fclose(file);
+        return 1;
+    }
+
+    DischargedPatient *chunk = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    int                ok = chunk != NULL && fseek(file, (long) (coveredRecords * sizeof(DischargedPatient)), SEEK_SET) == 0;
+    size_t             read;
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            ok = addDischarge(&chunk[i], coveredRecords + (long long) i);
+        }
+        coveredRecords += ok ? (long long) read : 0;
+    }
+
+    free(chunk);
+    fclose(file);
+
+    if(!ok)
+    {
+        puts("Error: Not enough memory for the readmission index.");
+        resetIdentities();
+        return 0;
+    }
+
+    saveIdentities();
+    return 1;
+}
+
+/*
+ * Writes the table to readmission_index.tmp and renames it over
+ * readmission_index.dat.
+ */
+static int saveIdentities(void)
+{
+    FILE *file = fopen(INDEX_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating readmission_index.tmp");
+        return 0;
+    }
+
+    IdentityFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version        = INDEX_VERSION;
+    header.coveredRecords = coveredRecords;
+    header.identityCount  = identityCount;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(identities, sizeof(DischargedIdentity), identityCount, file) == (size_t) identityCount;
+
+    written = written && flushToDisk(file);
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing readmission_index.tmp");
+        remove(INDEX_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(INDEX_TEMP, INDEX_FILE))
+    {
+        perror("Error renaming readmission_index.tmp to readmission_index.dat");
+        remove(INDEX_TEMP);
+        return 0;
+    }
+
+    savedRecords = coveredRecords;
+    return 1;
+}
+
+/*
+ * Empties the table so it is rebuilt from the first archive record.
+ */
+static void resetIdentities(void)
+{
+    free(identities);
+    free(identitySlots);
+    identities       = NULL;
+    identityCount    = 0;
+    identityCapacity = 0;
+    identitySlots    = NULL;
+    slotCapacity     = 0;
+    coveredRecords   = 0;
+    savedRecords     = 0;
+}
+
+/*
+ * Counts one discharge against its identity and makes it the identity's
+ * last one.
+ */
+static int addDischarge(const DischargedPatient *record, long long recordNumber)
+{
+    char name[MAX_PATIENT_NAME_LENGTH];
+    normaliseText(record->patient.name, name, sizeof(name));
+
+    DischargedIdentity *identity = findIdentity(name, ageBandOf(record->patient.ageInYears), 1);
+    if(identity == NULL)
+    {
+        return 0;
+    }
+
+    identity->stays++;
+    identity->lastRecord    = recordNumber;
+    identity->lastDischarge = record->dischargeDate;
+    return 1;
+}
+
+/*
+ * Returns the identity with a name and age band, adding an empty one when
+ * create is set. Returns NULL if there is none or memory ran out.
+ */
+static DischargedIdentity *findIdentity(const char *name, int ageBand, int create)
+{
+    if(create && (identityCount + 1) * 2 > slotCapacity && !growIdentitySlots())
+    {
+        return NULL;
+    }
+    if(identitySlots == NULL)
+    {
+        return NULL;
+    }
+
+    int mask = slotCapacity - 1;
+    int slot = hashIdentity(name, ageBand) & mask;
+
+    while(identitySlots[slot] != EMPTY_SLOT)
+    {
+        DischargedIdentity *identity = &identities[identitySlots[slot]];
+
+        if(identity->ageBand == ageBand && strcmp(identity->name, name) == 0)
+        {
+            return identity;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if(!create)
+    {
+        return NULL;
+    }
+
+    if(identityCount == identityCapacity)
+    {
+        int                 newCapacity = identityCapacity == 0 ? MIN_INDEX_CAPACITY : identityCapacity * 2;
+        DischargedIdentity *grown       = realloc(identities, newCapacity * sizeof(DischargedIdentity));
+
+        if(grown == NULL)
+        {
+            return NULL;
+        }
+        identities       = grown;
+        identityCapacity = newCapacity;
+    }
+
+    DischargedIdentity *identity = &identities[identityCount];
+    memset(identity, 0, sizeof(DischargedIdentity));
+    snprintf(identity->name, sizeof(identity->name), "%s", name);
+    identity->ageBand    = ageBand;
+    identity->lastRecord = NO_RECORD;
+
+    identitySlots[slot] = identityCount++;
+    return identity;
+}
+
+/*
+ * Doubles the slot array and reinserts every identity.
+ */
+static int growIdentitySlots(void)
+{
+    int  newCapacity = slotCapacity == 0 ? MIN_INDEX_CAPACITY : slotCapacity * 2;
+    int *newSlots    = malloc(newCapacity * sizeof(int));
+
+    if(newSlots == NULL)
+    {
+        return 0;
+    }
+
+    for(int slot = 0; slot < newCapacity; slot++)
+    {
+        newSlots[slot] = EMPTY_SLOT;
+    }
+
+    for(int i = 0; i < identityCount; i++)
+    {
+        int slot = hashIdentity(identities[i].name, identities[i].ageBand) & (newCapacity - 1);
+
+        while(newSlots[slot] != EMPTY_SLOT)
+        {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newSlots[slot] = i;
+    }
+
+    free(identitySlots);
+    identitySlots = newSlots;
+    slotCapacity  = newCapacity;
+    return 1;
+}
+
+/*
+ * FNV-1a over the age band and the name.
+ */
+static unsigned int hashIdentity(const char *name, int ageBand)
+{
+    return hashString(hashBytes(FNV_OFFSET_BASIS, &ageBand, sizeof(ageBand)), name);
+}
+
+/*
+ * 64-bit FNV-1a of the normalised name, so the report can sort stays by
+ * name without keeping the names.
+ */
+static unsigned long long nameKeyOf(const char *name)
+{
+    char               normalised[MAX_PATIENT_NAME_LENGTH];
+    unsigned long long key = 14695981039346656037ull;
+
+    normaliseText(name, normalised, sizeof(normalised));
+    for(const char *c = normalised; *c != '\0'; c++)
+    {
+        key = (key ^ (unsigned char) *c) * 1099511628211ull;
+    }
+    return key;
+}
+
+/*
+ * Maps an age to its band, keeping out-of-range ages in the end bands.
+ */
+static int ageBandOf(int age)
+{
+    int band = age / AGE_BAND_YEARS;
+
+    if(band < 0)
+    {
+        return 0;
+    }
+    return band < AGE_BAND_COUNT ? band : AGE_BAND_COUNT - 1;
+}
+
+/*
+ * Makes an admission and a discharge event for every archived stay and an
+ * admission event for every admitted patient.
+ */
+static StayEvent *buildStayEvents(int *eventCount)
+{
+    StayEvent *events   = NULL;
+    int        count    = 0;
+    int        capacity = 0;
+    int        ok       = 1;
+
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file != NULL)
+    {
+        DischargedPatient *chunk  = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+        long               record = 0;
+        size_t             read;
+
+        ok = chunk != NULL;
+        while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+        {
+            for(size_t i = 0; ok && i < read; i++, record++)
+            {
+                ok = addStayEvent(&events, &count, &capacity, &chunk[i].patient, chunk[i].patient.admissionDate,
+                                  record, 0) &&
+                     addStayEvent(&events, &count, &capacity, &chunk[i].patient, chunk[i].dischargeDate, record, 1);
+            }
+        }
+
+        free(chunk);
+        fclose(file);
+    }
+
+    for(const PatientNode *node = admittedPatients(); ok && node != NULL; node = node->nextNode)
+    {
+        ok = addStayEvent(&events, &count, &capacity, &node->data, node->data.admissionDate, NO_RECORD, 0);
+    }
+
+    if(!ok)
+    {
+        free(events);
+        return NULL;
+    }
+
+    qsort(events, count, sizeof(StayEvent), compareEvents);
+    *eventCount = count;
+
+    // An empty result is still a valid list
+    return events != NULL ? events : malloc(sizeof(StayEvent));
+}
+
+/*
+ * Appends one event, growing the array as needed.
+ */
+static int addStayEvent(StayEvent **events, int *count, int *capacity, const Patient *patient, time_t when,
+                        long record, int isDischarge)
+{
+    if(*count == *capacity)
+    {
+        int        newCapacity = *capacity == 0 ? MIN_INDEX_CAPACITY : *capacity * 2;
+        StayEvent *grown       = realloc(*events, newCapacity * sizeof(StayEvent));
+
+        if(grown == NULL)
+        {
+            return 0;
+        }
+        *events   = grown;
+        *capacity = newCapacity;
+    }
+
+    StayEvent *event   = &(*events)[(*count)++];
+    event->nameKey     = nameKeyOf(patient->name);
+    event->when        = when;
+    event->record      = record;
+    event->patientId   = patient->patientId;
+    event->age         = patient->ageInYears;
+    event->isDischarge = isDischarge;
+    return 1;
+}
+
+/*
+ * Walks the sorted events one name at a time, remembering the last
+ * discharge in each age band, and matches each admission in [from, to) to
+ * the latest discharge in its band or the one below within the window.
+ */
+static Readmission *joinReadmissions(const StayEvent events[], int eventCount, time_t from, time_t to,
+                                     int windowDays, int *admissions, int *readmissionCount)
+{
+    time_t       lastDischarge[AGE_BAND_COUNT];
+    long         lastRecord[AGE_BAND_COUNT];
+    Readmission *readmissions = malloc((eventCount + 1) * sizeof(Readmission));
+    int          count        = 0;
+
+    *admissions       = 0;
+    *readmissionCount = 0;
+    if(readmissions == NULL)
+    {
+        return NULL;
+    }
+
+    for(int i = 0; i < eventCount; i++)
+    {
+        const StayEvent *event = &events[i];
+        int              band  = ageBandOf(event->age);
+
+        if(i == 0 || event->nameKey != events[i - 1].nameKey)
+        {
+            for(int b = 0; b < AGE_BAND_COUNT; b++)
+            {
+                lastRecord[b] = NO_RECORD;
+            }
+        }
+
+        if(event->isDischarge)
+        {
+            lastDischarge[band] = event->when;
+            lastRecord[band]    = event->record;
+            continue;
+        }
+
+        if(event->when < from || event->when >= to)
+        {
+            continue;
+        }
+        (*admissions)++;
+
+        int previous = ageBandOf(event->age - 1);
+        if(lastRecord[band] == NO_RECORD ||
+           (lastRecord[previous] != NO_RECORD && lastDischarge[previous] > lastDischarge[band]))
+        {
+            band = previous;
+        }
+
+        if(lastRecord[band] == NO_RECORD || difftime(event->when, lastDischarge[band]) > windowDays * SECONDS_PER_DAY)
+        {
+            continue;
+        }
+
+        Readmission *readmission    = &readmissions[count++];
+        readmission->previousRecord = lastRecord[band];
+        readmission->record         = event->record;
+        readmission->patientId      = event->patientId;
+        readmission->discharged     = lastDischarge[band];
+        readmission->readmitted     = event->when;
+    }
+
+    *readmissionCount = count;
+    return readmissions;
+}
+
+/*
+ * Copies each readmission's previous and current patient records in one
+ * pass over the archive, taking admitted patients from the census.
+ */
+static int fillPatients(Readmission readmissions[], int count)
+{
+    RecordRequest *requests     = malloc((2 * count + 1) * sizeof(RecordRequest));
+    int            requestCount = 0;
+
+    if(requests == NULL)
+    {
+        return 0;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        requests[requestCount++] = (RecordRequest) { readmissions[i].previousRecord, &readmissions[i].previous };
+
+        if(readmissions[i].record != NO_RECORD)
+        {
+            requests[requestCount++] = (RecordRequest) { readmissions[i].record, &readmissions[i].current };
+        }
+        else
+        {
+            const Patient *admitted = findAdmittedPatient(readmissions[i].patientId);
+            memset(&readmissions[i].current, 0, sizeof(Patient));
+            if(admitted != NULL)
+            {
+                readmissions[i].current = *admitted;
+            }
+        }
+    }
+
+    qsort(requests, requestCount, sizeof(RecordRequest), compareRequests);
+
+    FILE *file = requestCount > 0 ? fopen("discharged_patients.dat", "rb") : NULL;
+    int   ok   = 1;
+
+    if(file != NULL)
+    {
+        DischargedPatient *chunk  = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+        long               record = 0;
+        int                next   = 0;
+        size_t             read;
+
+        ok = chunk != NULL;
+        while(ok && next < requestCount &&
+              (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+        {
+            for(; next < requestCount && requests[next].record < record + (long) read; next++)
+            {
+                *requests[next].target = chunk[requests[next].record - record].patient;
+            }
+            record += (long) read;
+        }
+
+        free(chunk);
+        fclose(file);
+    }
+
+    free(requests);
+    return ok;
+}
+
+/*
+ * Orders events by name key, then time; an admission at the same moment
+ * as a discharge sorts first so a stay never follows its own discharge.
+ */
+static int compareEvents(const void *a, const void *b)
+{
+    const StayEvent *first  = a;
+    const StayEvent *second = b;
+
+    if(first->nameKey != second->nameKey)
+    {
+        return first->nameKey < second->nameKey ? -1 : 1;
+    }
+    if(first->when != second->when)
+    {
+        return first->when < second->when ? -1 : 1;
+    }
+    return first->isDischarge - second->isDischarge;
+}
+
+/*
+ * Orders record requests by archive position.
+ */
+static int compareRequests(const void *a, const void *b)
+{
+    const RecordRequest *first  = a;
+    const RecordRequest *second = b;
+
+    return (first->record > second->record) - (first->record < second->record);
+}
+
+/*
+ * Orders readmissions by readmission time.
+ */
+static int compareReadmissions(const void *a, const void *b)
+{
+    const Readmission *first  = a;
+    const Readmission *second = b;
+
+    return (first->readmitted > second->readmitted) - (first->readmitted < second->readmitted);
+}
+
+/*
+ * Reads the readmission window in days; Enter gives READMISSION_DAYS.
+ */
+static int promptWindowDays(void)
+{
+    char input[WINDOW_INPUT_LENGTH];
+    int  days;
+
+    while(1)
+    {
+        printf("Readmitted within how many days of discharge (Enter for %d): ", READMISSION_DAYS);
+        if(fgets(input, sizeof(input), stdin) == NULL)
+        {
+            return READMISSION_DAYS;
+        }
+        if(strchr(input, '\n') == NULL)
+        {
+            clearInputBuffer();
+        }
+        if(input[strspn(input, " \t\n")] == '\0')
+        {
+            return READMISSION_DAYS;
+        }
+        if(sscanf(input, "%d", &days) == SUCCESSFUL_READ && days >= 1 && days <= MAX_WINDOW_DAYS)
+        {
+            return days;
+        }
+        printf("Please enter a number between 1 and %d.\n", MAX_WINDOW_DAYS);
+    }
+}
+
+/*
+ * Prints the readmission rate and one row per readmission.
+ */
+static void printReadmissions(ReportSink *sink, const Readmission readmissions[], int count, int admissions,
+                              time_t from, time_t to, int windowDays)
+{
+    DateCache dischargeDates;
+    DateCache admissionDates;
+
+    initDateCache(&dischargeDates);
+    initDateCache(&admissionDates);
+
+    sinkPrintf(sink, "   %d-Day Readmission Report - %s", windowDays, cachedDateText(&dischargeDates, from));
+    sinkPrintf(sink, " to %s\n", cachedDateText(&admissionDates, to - 1));
+    sinkPrintf(sink, "=======================================\n");
+    sinkPrintf(sink, "Admissions: %d, readmissions: %d (%.1f%%)\n", admissions, count,
+               admissions == 0 ? 0.0 : 100.0 * count / admissions);
+    sinkPrintf(sink, "%-20s| %-4s| %-11s| %-11s| %-5s| %-20s| %s\n", "Name", "Age", "Discharged", "Readmitted",
+               "Days", "Previous Diagnosis", "Diagnosis");
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+    if(count == 0)
+    {
+        sinkPrintf(sink, "| No readmissions in this range |\n");
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        const Readmission *readmission = &readmissions[i];
+
+        sinkPrintf(sink, "%-20.20s| %-4d| %-11s| ", readmission->current.name, readmission->current.ageInYears,
+                   cachedDateText(&dischargeDates, readmission->discharged));
+        sinkPrintf(sink, "%-11s| %-5d| %-20.20s| %.20s\n", cachedDateText(&admissionDates, readmission->readmitted),
+                   (int) (difftime(readmission->readmitted, readmission->discharged) / SECONDS_PER_DAY),
+                   readmission->previous.diagnosis, readmission->current.diagnosis);
+    }
+
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+}
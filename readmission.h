@@ -0,0 +1,59 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines readmission detection. A patient's identity is
+ *          their name, ignoring case and spacing, plus a five-year age band.
+ *          Every discharged identity is kept in a hash table with its last
+ *          discharge, so an admission is checked against the whole archive
+ *          with one or two lookups. The table is saved in
+ *          readmission_index.dat and brought up to date with the records
+ *          archived since it was saved.
+ *
+ *          The readmission report joins every admission in a date range to
+ *          the same identity's previous discharge by sorting the stays once,
+ *          rather than comparing each admission with every discharge.
+ */
+
+#ifndef READMISSION_H
+#define READMISSION_H
+
+#include "patient_management.h"
+
+/*
+ * Function: readmissionRecordDischarges
+ * -------------------------------------
+ * Adds newly archived discharges to the identity table if it is loaded.
+ * The table is saved once enough discharges have been added since the
+ * last save; until then the archive itself holds them.
+ *
+ * records: The discharge records, in the order they were archived
+ * firstArchiveRecord: Position of records[0] in discharged_patients.dat
+ * count: Number of records
+ */
+void readmissionRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count);
+
+/*
+ * Function: checkReadmission
+ * --------------------------
+ * Looks up a newly admitted patient among the discharged identities and,
+ * if they have been discharged before, prints when, from which room and
+ * with which diagnosis.
+ *
+ * patient: The admitted patient
+ *
+ * Returns: 1 if the patient was discharged within the last 30 days,
+ *          0 otherwise
+ */
+int checkReadmission(const Patient *patient);
+
+/*
+ * Function: readmissionReport
+ * ---------------------------
+ * Prompts for a date range and a window in days, then lists every
+ * admission in the range that came within the window of the same
+ * patient's previous discharge and appends the report to
+ * readmission_reports.txt.
+ */
+void readmissionReport(void);
+
+#endif // READMISSION_H
@@ -0,0 +1,261 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the report row formatter.
+ *          Rows are assembled by copying fixed text and padded fields into
+ *          the output. Dates come from a one-day cache: a timestamp inside
+ *          the cached day reuses its text, and on a day without a daylight
+ *          saving change the time of day is worked out from the seconds
+ *          since midnight, so only the first timestamp of each day is
+ *          converted with localtime.
+ */
+
+#include "report_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Private constants
+#define MAX_DIGITS 11
+
+static const time_t SECONDS_PER_DAY    = 24 * 60 * 60;
+static const int    SECONDS_PER_HOUR   = 60 * 60;
+static const int    SECONDS_PER_MINUTE = 60;
+static const int    TM_BASE_YEAR       = 1900;
+static const int    MONTHS_PER_YEAR    = 12;
+static const char  *SEPARATOR_LINE     = "---------------------------------------\n";
+
+/* Names used by ctime, which ignores the locale */
+static const char *weekdayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+static const char *monthNames[]   = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                      "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+// Function prototypes for internal helper functions
+static void   loadDay(DateCache *cache, time_t when);
+static char  *appendTimeOfDay(char *out, const DateCache *cache, time_t when);
+static char  *appendText(char *out, const char *text);
+static char  *appendPadded(char *out, const char *text, size_t maxLength, int width);
+static char  *appendInteger(char *out, int value, int width);
+static char  *appendTwoDigits(char *out, int value);
+
+/*
+ * Marks the cache as holding no day.
+ */
+void initDateCache(DateCache *cache)
+{
+    cache->dayStart = 0;
+    cache->dayEnd   = 0;
+    cache->fullDay  = 0;
+    cache->date[0]  = '\0';
+}
+
+/*
+ * Returns the cached date text, loading the timestamp's day on a miss.
+ */
+const char *cachedDateText(DateCache *cache, time_t when)
+{
+    if(when < cache->dayStart || when >= cache->dayEnd)
+    {
+        loadDay(cache, when);
+    }
+
+    return cache->date;
+}
+
+/*
+ * Reads the year and month back out of the cached date text.
+ */
+int cachedMonthNumber(DateCache *cache, time_t when)
+{
+    const char *date = cachedDateText(cache, when);
+    return atoi(date) * MONTHS_PER_YEAR + atoi(date + 5) - 1;
+}
+
+/*
+ * Builds "Www Mmm dd hh:mm:ss yyyy\n" from the cached day and the time of day.
+ */
+void formatTimestamp(DateCache *cache, time_t when, char text[])
+{
+    cachedDateText(cache, when);
+
+    char *out = appendText(text, cache->dayPrefix);
+    out       = appendTimeOfDay(out, cache, when);
+    out       = appendText(out, cache->yearSuffix);
+    *out      = '\0';
+}
+
+/*
+ * Builds "YYYY-MM-DD HH:MM:SS" from the cached date and the time of day.
+ */
+void formatDateTime(DateCache *cache, time_t when, char text[])
+{
+    char *out = appendText(text, cachedDateText(cache, when));
+    *out++    = ' ';
+    out       = appendTimeOfDay(out, cache, when);
+    *out      = '\0';
+}
+
+/*
+ * Copies the row's fixed text and fields in order, then the separator.
+ */
+size_t renderPatientRow(char row[], const Patient *patient, const char *label, const char *date)
+{
+    char *out = appendText(row, "| ID: ");
+    out       = appendInteger(out, patient->patientId, 5);
+    out       = appendText(out, " Name: ");
+    out       = appendPadded(out, patient->name, MAX_PATIENT_NAME_LENGTH, 15);
+    out       = appendText(out, " | Age: ");
+    out       = appendInteger(out, patient->ageInYears, 3);
+    out       = appendText(out, " Room: ");
+    out       = appendInteger(out, patient->roomNumber, 5);
+    out       = appendText(out, " Diagnosis: ");
+    out       = appendPadded(out, patient->diagnosis, MAX_DIAGNOSIS_LENGTH, 20);
+    out       = appendText(out, " | ");
+    out       = appendText(out, label);
+    out       = appendText(out, ": ");
+    out       = appendPadded(out, date, MAX_REPORT_ROW_LENGTH, 10);
+    out       = appendText(out, " |\n");
+    out       = appendText(out, SEPARATOR_LINE);
+    return (size_t) (out - row);
+}
+
+/*
+ * Converts a timestamp with localtime and caches the text of its day and
+ * the day's bounds. Midnight is found with mktime so that days with a
+ * daylight saving change get their real length.
+ */
+static void loadDay(DateCache *cache, time_t when)
+{
+    struct tm local = *localtime(&when);
+
+    struct tm midnight = local;
+    midnight.tm_hour   = 0;
+    midnight.tm_min    = 0;
+    midnight.tm_sec    = 0;
+    midnight.tm_isdst  = -1;
+    cache->dayStart    = mktime(&midnight);
+
+    midnight.tm_mday++;
+    midnight.tm_isdst = -1;
+    cache->dayEnd     = mktime(&midnight);
+    cache->fullDay    = cache->dayEnd - cache->dayStart == SECONDS_PER_DAY;
+
+    // A time zone with no midnight on this day cannot be cached safely
+    if(cache->dayStart > when || cache->dayEnd <= when)
+    {
+        cache->dayStart = when;
+        cache->dayEnd   = when + 1;
+        cache->fullDay  = 0;
+    }
+
+    strftime(cache->date, sizeof(cache->date), "%Y-%m-%d", &local);
+    snprintf(cache->dayPrefix, sizeof(cache->dayPrefix), "%.3s %.3s%3d ", weekdayNames[local.tm_wday],
+             monthNames[local.tm_mon], local.tm_mday);
+    snprintf(cache->yearSuffix, sizeof(cache->yearSuffix), " %d\n", TM_BASE_YEAR + local.tm_year);
+}
+
+/*
+ * Writes "hh:mm:ss" for a timestamp in the cached day. On a day of normal
+ * length it is worked out from the seconds since midnight; otherwise
+ * localtime decides.
+ */
+static char *appendTimeOfDay(char *out, const DateCache *cache, time_t when)
+{
+    int sinceMidnight;
+
+    if(cache->fullDay)
+    {
+        sinceMidnight = (int) (when - cache->dayStart);
+    }
+    else
+    {
+        const struct tm *local = localtime(&when);
+        sinceMidnight          = local->tm_hour * SECONDS_PER_HOUR + local->tm_min * SECONDS_PER_MINUTE +
+                                 local->tm_sec;
+    }
+
+    out    = appendTwoDigits(out, sinceMidnight / SECONDS_PER_HOUR);
+    *out++ = ':';
+    out    = appendTwoDigits(out, sinceMidnight % SECONDS_PER_HOUR / SECONDS_PER_MINUTE);
+    *out++ = ':';
+    out    = appendTwoDigits(out, sinceMidnight % SECONDS_PER_MINUTE);
+    return out;
+}
+
+/*
+ * Copies a terminated string and returns the end of the output.
+ */
+static char *appendText(char *out, const char *text)
+{
+    while(*text != '\0')
+    {
+        *out++ = *text++;
+    }
+    return out;
+}
+
+/*
+ * Copies at most maxLength bytes of a string, then pads with spaces to
+ * width, as "%-<width>s" does.
+ */
+static char *appendPadded(char *out, const char *text, size_t maxLength, int width)
+{
+    size_t length = 0;
+
+    while(length < maxLength && text[length] != '\0')
+    {
+        length++;
+    }
+
+    memcpy(out, text, length);
+    out += length;
+
+    for(int pad = width - (int) length; pad > 0; pad--)
+    {
+        *out++ = ' ';
+    }
+    return out;
+}
+
+/*
+ * Writes an integer left-aligned and padded with spaces to width, as
+ * "%-<width>d" does.
+ */
+static char *appendInteger(char *out, int value, int width)
+{
+    char     digits[MAX_DIGITS];
+    int      count     = 0;
+    unsigned magnitude = value < 0 ? 0u - (unsigned) value : (unsigned) value;
+    char    *start     = out;
+
+    do
+    {
+        digits[count++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    while(magnitude != 0);
+
+    if(value < 0)
+    {
+        *out++ = '-';
+    }
+    while(count > 0)
+    {
+        *out++ = digits[--count];
+    }
+    while(out - start < width)
+    {
+        *out++ = ' ';
+    }
+    return out;
+}
+
+/*
+ * Writes a value from 0 to 99 as two digits.
+ */
+static char *appendTwoDigits(char *out, int value)
+{
+    *out++ = (char) ('0' + value / 10);
+    *out++ = (char) ('0' + value % 10);
+    return out;
+}
@@ -0,0 +1,112 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the report row formatter. It renders patient
+ *          report rows and timestamps with the same text printf, strftime
+ *          and ctime produce, but converts numbers by hand and reuses the
+ *          date text of the last day seen, so long reports are not bound by
+ *          format-string parsing and time zone conversion.
+ */
+
+#ifndef REPORT_FORMAT_H
+#define REPORT_FORMAT_H
+
+#include <stddef.h>
+#include <time.h>
+#include "patient_data.h"
+
+// Longest row renderPatientRow can produce, including the separator line
+#define MAX_REPORT_ROW_LENGTH 512
+
+// Length of a ctime string, including the newline and terminator
+#define TIMESTAMP_TEXT_LENGTH 26
+
+// Length of a "YYYY-MM-DD HH:MM:SS" string, including the terminator
+#define DATETIME_TEXT_LENGTH 20
+
+/*
+ * The local calendar day last converted and its date text. Start a cache
+ * with initDateCache; a cache only speeds up later lookups.
+ */
+typedef struct
+{
+    time_t dayStart;
+    time_t dayEnd;
+    int    fullDay;
+    char   date[11];
+    char   dayPrefix[12];
+    char   yearSuffix[16];
+} DateCache;
+
+/*
+ * Function: initDateCache
+ * -----------------------
+ * Empties a date cache.
+ *
+ * cache: The cache to empty
+ */
+void initDateCache(DateCache *cache);
+
+/*
+ * Function: cachedDateText
+ * ------------------------
+ * Gives the local date of a timestamp as "YYYY-MM-DD", as strftime("%Y-%m-%d")
+ * does, converting only when the day differs from the cached one.
+ *
+ * cache: The date cache
+ * when: The timestamp
+ *
+ * Returns: The date text, valid until the next call with this cache
+ */
+const char *cachedDateText(DateCache *cache, time_t when);
+
+/*
+ * Function: cachedMonthNumber
+ * ---------------------------
+ * Gives the local month of a timestamp as a month number (see promptMonth).
+ *
+ * cache: The date cache
+ * when: The timestamp
+ *
+ * Returns: year * 12 + month - 1
+ */
+int cachedMonthNumber(DateCache *cache, time_t when);
+
+/*
+ * Function: formatTimestamp
+ * -------------------------
+ * Writes a timestamp in the form ctime uses ("Sun Oct 18 22:31:41 2026\n").
+ *
+ * cache: The date cache
+ * when: The timestamp
+ * text: Receives the text (at least TIMESTAMP_TEXT_LENGTH bytes)
+ */
+void formatTimestamp(DateCache *cache, time_t when, char text[]);
+
+/*
+ * Function: formatDateTime
+ * ------------------------
+ * Writes a timestamp as "YYYY-MM-DD HH:MM:SS" in local time.
+ *
+ * cache: The date cache
+ * when: The timestamp
+ * text: Receives the text (at least DATETIME_TEXT_LENGTH bytes)
+ */
+void formatDateTime(DateCache *cache, time_t when, char text[]);
+
+/*
+ * Function: renderPatientRow
+ * --------------------------
+ * Writes one report row and its separator line, matching
+ * "| ID: %-5d Name: %-15s | Age: %-3d Room: %-5d Diagnosis: %-20s | <label>: %-10s |\n".
+ *
+ * row: Receives the row (at least MAX_REPORT_ROW_LENGTH bytes, not terminated)
+ * patient: The patient on the row
+ * label: The date column's label, e.g. "Admitted"
+ * date: The date text
+ *
+ * Returns: The number of bytes written
+ */
+size_t renderPatientRow(char row[], const Patient *patient, const char *label, const char *date);
+
+#endif // REPORT_FORMAT_H
@@ -0,0 +1,614 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements report queries.
+ *          Each stay in range is reduced to its group key (up to three
+ *          integers plus a normalised diagnosis) and added to that key's
+ *          running totals in an open-addressing table, so the census and the
+ *          archive are each read once whatever the grouping. The archive is
+ *          read in fixed-size chunks. Only the groups are sorted for printing.
+ */
+
+#include "report_query.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "attending.h"
+#include "doctor_data.h"
+#include "patient_data.h"
+#include "patient_management.h"
+#include "report_format.h"
+#include "utils.h"
+
+// Private constants
+#define MIN_GROUP_CAPACITY 64
+#define ARCHIVE_CHUNK 256
+#define INPUT_LENGTH 64
+#define KEY_TEXT_LENGTH (NAME_LENGTH + 8)
+#define NO_DIAGNOSIS_KEY (-1)
+
+static const double SECONDS_PER_DAY   = 24.0 * 60.0 * 60.0;
+static const int    DEFAULT_DAYS      = 30;
+static const int    AGE_BAND_WIDTH    = 10;
+static const int    LAST_AGE_BAND     = 90;
+static const int    KEY_COLUMN_WIDTH  = 24;
+static const char  *QUERY_REPORT_FILE = "query_reports.txt";
+static const char  *SEPARATOR_LINE    = "---------------------------------------\n";
+static const char  *keyNames[]        = { "", "Day", "Room", "Diagnosis", "Age Band", "Doctor" };
+
+/*
+ * The running totals of one group. diagnosis is set only when the query
+ * groups by diagnosis. A count of 0 marks a free slot.
+ */
+typedef struct
+{
+    unsigned int hash;
+    int          values[MAX_GROUP_KEYS];
+    char        *diagnosis;
+    long         count;
+    long         completedStays;
+    double       staySeconds;
+    double       bedSeconds;
+} QueryGroup;
+
+/*
+ * The groups of a query being run.
+ */
+typedef struct
+{
+    const ReportQuery *query;
+    int                diagnosisKey;
+    int                byDoctor;
+    time_t             now;
+    time_t             windowEnd;
+    QueryGroup        *groups;
+    int                capacity;
+    int                count;
+    QueryGroup         total;
+} GroupTable;
+
+// Key position compareGroups treats as text, set before sorting
+static int sortDiagnosisKey = NO_DIAGNOSIS_KEY;
+
+// Function prototypes for internal helper functions
+static int          addStay(GroupTable *table, const Patient *patient, time_t dischargeDate, int doctorId);
+static void         addToTotals(QueryGroup *group, const GroupTable *table, const Patient *patient,
+                                time_t dischargeDate);
+static QueryGroup  *findGroup(GroupTable *table, const int values[], const char *diagnosis, unsigned int hash);
+static int          growGroupTable(GroupTable *table);
+static int          keyValue(int key, const Patient *patient, time_t eventTime, int doctorId);
+static unsigned int hashGroupKey(const int values[], int keyCount, const char *diagnosis);
+static int          compareGroups(const void *a, const void *b);
+static void         printQueryReport(ReportSink *sink, const GroupTable *table, QueryGroup *sorted[]);
+static void         printGroupRow(ReportSink *sink, const GroupTable *table, const QueryGroup *group,
+                                  DateCache *dates);
+static void         formatKey(char text[], int key, int value, const char *diagnosis, DateCache *dates);
+static void         freeGroupTable(GroupTable *table);
+static int          promptGroupKeys(int keys[]);
+
+/*
+ * Feeds the census and the archive through the group table, then prints the
+ * groups in key order.
+ */
+int runReportQuery(const ReportQuery *query, ReportSink *sink)
+{
+    GroupTable table;
+
+    memset(&table, 0, sizeof(table));
+    table.query        = query;
+    table.diagnosisKey = NO_DIAGNOSIS_KEY;
+    table.now          = time(NULL);
+    table.windowEnd    = query->to < table.now ? query->to : table.now;
+
+    for(int k = 0; k < query->keyCount; k++)
+    {
+        if(query->keys[k] == GROUP_BY_DIAGNOSIS)
+        {
+            table.diagnosisKey = k;
+        }
+        table.byDoctor |= query->keys[k] == GROUP_BY_DOCTOR;
+    }
+
+    int ok = 1;
+
+    if(query->event == QUERY_ADMISSIONS)
+    {
+        for(const PatientNode *node = admittedPatients(); ok && node != NULL; node = node->nextNode)
+        {
+            ok = addStay(&table, &node->data, 0, attendingDoctorOf(node->data.patientId));
+        }
+    }
+
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file != NULL)
+    {
+        DischargedPatient *chunk       = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+        long               recordCount = 0;
+        size_t             read;
+
+        ok = ok && chunk != NULL;
+        while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+        {
+            for(size_t i = 0; ok && i < read; i++)
+            {
+                int doctorId = table.byDoctor ? pastAttendingDoctorOf(recordCount + (long) i) : NO_ATTENDING_DOCTOR;
+
+                ok = addStay(&table, &chunk[i].patient, chunk[i].dischargeDate, doctorId);
+            }
+            recordCount += (long) read;
+        }
+
+        free(chunk);
+        fclose(file);
+    }
+
+    QueryGroup **sorted = ok ? malloc((table.count + 1) * sizeof(QueryGroup *)) : NULL;
+    if(sorted == NULL)
+    {
+        puts("Error: Not enough memory for the report query.");
+        freeGroupTable(&table);
+        return QUERY_FAILED;
+    }
+
+    int count = 0;
+    for(int slot = 0; slot < table.capacity; slot++)
+    {
+        if(table.groups[slot].count > 0)
+        {
+            sorted[count++] = &table.groups[slot];
+        }
+    }
+
+    sortDiagnosisKey = table.diagnosisKey;
+    qsort(sorted, count, sizeof(QueryGroup *), compareGroups);
+
+    printQueryReport(sink, &table, sorted);
+
+    free(sorted);
+    freeGroupTable(&table);
+    return count;
+}
+
+/*
+ * Prompts for the event, the range and the grouping, then runs the query
+ * to the console and query_reports.txt.
+ */
+void reportQueryMenu(void)
+{
+    ReportQuery query;
+
+    printf("Report on:\n1: Admissions\n2: Discharges\n");
+    while(1)
+    {
+        printf("Enter choice: ");
+        int read = scanf("%d", &query.event);
+        clearInputBuffer();
+
+        if(read == SUCCESSFUL_READ && (query.event == QUERY_ADMISSIONS || query.event == QUERY_DISCHARGES))
+        {
+            break;
+        }
+        printf("Please enter 1 or 2.\n");
+    }
+
+    int today  = toDayNumber(time(NULL));
+    query.from = promptDateTime("From (YYYY-MM-DD, Enter for 30 days ago):\n",
+                                dayNumberToTime(today - DEFAULT_DAYS + 1));
+    time_t to  = promptDateTime("To, inclusive (YYYY-MM-DD, Enter for today):\n", dayNumberToTime(today));
+    query.to   = dayNumberToTime(toDayNumber(to) + 1);
+
+    if(query.to <= query.from)
+    {
+        puts("The range ends before it starts.");
+        return;
+    }
+
+    query.keyCount = promptGroupKeys(query.keys);
+
+    FILE *file = fopen(QUERY_REPORT_FILE, "a");
+    if(file == NULL)
+    {
+        printf("Error opening file for writing!\n");
+        return;
+    }
+
+    fprintf(file, "\n");
+
+    ReportSink *sink   = openReportSink(file, 1);
+    int         result = sink == NULL ? QUERY_FAILED : runReportQuery(&query, sink);
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing %s\n", QUERY_REPORT_FILE);
+        return;
+    }
+
+    if(result != QUERY_FAILED)
+    {
+        printf("\nReport successfully written to %s\n", QUERY_REPORT_FILE);
+    }
+}
+
+/*
+ * Adds one stay to its group and to the total if its event time is in the
+ * query's range. Returns 0 if the table could not grow.
+ */
+static int addStay(GroupTable *table, const Patient *patient, time_t dischargeDate, int doctorId)
+{
+    const ReportQuery *query     = table->query;
+    time_t             eventTime = query->event == QUERY_ADMISSIONS ? patient->admissionDate : dischargeDate;
+
+    if(eventTime < query->from || eventTime >= query->to)
+    {
+        return 1;
+    }
+
+    int  values[MAX_GROUP_KEYS] = { 0 };
+    char diagnosis[MAX_DIAGNOSIS_LENGTH + 1];
+
+    for(int k = 0; k < query->keyCount; k++)
+    {
+        values[k] = keyValue(query->keys[k], patient, eventTime, doctorId);
+    }
+    if(table->diagnosisKey != NO_DIAGNOSIS_KEY)
+    {
+        normaliseText(patient->diagnosis, diagnosis, sizeof(diagnosis));
+    }
+
+    const char  *groupText = table->diagnosisKey != NO_DIAGNOSIS_KEY ? diagnosis : NULL;
+    unsigned int hash      = hashGroupKey(values, query->keyCount, groupText);
+    QueryGroup  *group     = findGroup(table, values, groupText, hash);
+
+    if(group == NULL)
+    {
+        return 0;
+    }
+
+    addToTotals(group, table, patient, dischargeDate);
+    addToTotals(&table->total, table, patient, dischargeDate);
+    return 1;
+}
+
+/*
+ * Counts a stay, its length if it is complete and its bed time inside the
+ * range.
+ */
+static void addToTotals(QueryGroup *group, const GroupTable *table, const Patient *patient, time_t dischargeDate)
+{
+    time_t stayEnd = dischargeDate != 0 ? dischargeDate : table->now;
+    time_t inFrom  = patient->admissionDate > table->query->from ? patient->admissionDate : table->query->from;
+    time_t inTo    = stayEnd < table->windowEnd ? stayEnd : table->windowEnd;
+
+    group->count++;
+    if(dischargeDate != 0)
+    {
+        group->completedStays++;
+        group->staySeconds += difftime(dischargeDate, patient->admissionDate);
+    }
+    if(inTo > inFrom)
+    {
+        group->bedSeconds += difftime(inTo, inFrom);
+    }
+}
+
+/*
+ * Returns the group with a key, adding an empty one if there is none.
+ * Returns NULL if the table could not grow.
+ */
+static QueryGroup *findGroup(GroupTable *table, const int values[], const char *diagnosis, unsigned int hash)
+{
+    if((table->count + 1) * 2 > table->capacity && !growGroupTable(table))
+    {
+        return NULL;
+    }
+
+    int mask = table->capacity - 1;
+    int slot = hash & mask;
+
+    while(table->groups[slot].count > 0)
+    {
+        QueryGroup *group = &table->groups[slot];
+
+        if(group->hash == hash && memcmp(group->values, values, sizeof(group->values)) == 0 &&
+           (diagnosis == NULL || strcmp(group->diagnosis, diagnosis) == 0))
+        {
+            return group;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    QueryGroup *group = &table->groups[slot];
+    if(diagnosis != NULL)
+    {
+        group->diagnosis = malloc(strlen(diagnosis) + 1);
+        if(group->diagnosis == NULL)
+        {
+            return NULL;
+        }
+        strcpy(group->diagnosis, diagnosis);
+    }
+
+    group->hash = hash;
+    memcpy(group->values, values, sizeof(group->values));
+    table->count++;
+    return group;
+}
+
+/*
+ * Doubles the group table and moves every group to its new slot.
+ */
+static int growGroupTable(GroupTable *table)
+{
+    int         newCapacity = table->capacity == 0 ? MIN_GROUP_CAPACITY : table->capacity * 2;
+    QueryGroup *newGroups   = calloc(newCapacity, sizeof(QueryGroup));
+
+    if(newGroups == NULL)
+    {
+        return 0;
+    }
+
+    for(int slot = 0; slot < table->capacity; slot++)
+    {
+        if(table->groups[slot].count > 0)
+        {
+            int newSlot = table->groups[slot].hash & (newCapacity - 1);
+
+            while(newGroups[newSlot].count > 0)
+            {
+                newSlot = (newSlot + 1) & (newCapacity - 1);
+            }
+            newGroups[newSlot] = table->groups[slot];
+        }
+    }
+
+    free(table->groups);
+    table->groups   = newGroups;
+    table->capacity = newCapacity;
+    return 1;
+}
+
+/*
+ * Returns a stay's value for one integer key. Diagnosis keys use the
+ * group's text instead and have the value 0.
+ */
+static int keyValue(int key, const Patient *patient, time_t eventTime, int doctorId)
+{
+    switch(key)
+    {
+        case GROUP_BY_DAY:
+            return toDayNumber(eventTime);
+        case GROUP_BY_ROOM:
+            return patient->roomNumber;
+        case GROUP_BY_AGE_BAND:
+            return patient->ageInYears >= LAST_AGE_BAND ? LAST_AGE_BAND
+                                                        : patient->ageInYears / AGE_BAND_WIDTH * AGE_BAND_WIDTH;
+        case GROUP_BY_DOCTOR:
+            return doctorId;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * FNV-1a over the key values and the diagnosis text.
+ */
+static unsigned int hashGroupKey(const int values[], int keyCount, const char *diagnosis)
+{
+    unsigned int hash = hashBytes(FNV_OFFSET_BASIS, values, (size_t) keyCount * sizeof(int));
+
+    return diagnosis == NULL ? hash : hashString(hash, diagnosis);
+}
+
+/*
+ * Orders groups by each key in turn for qsort.
+ */
+static int compareGroups(const void *a, const void *b)
+{
+    const QueryGroup *first  = *(const QueryGroup *const *) a;
+    const QueryGroup *second = *(const QueryGroup *const *) b;
+
+    for(int k = 0; k < MAX_GROUP_KEYS; k++)
+    {
+        int order = k == sortDiagnosisKey ? strcmp(first->diagnosis, second->diagnosis)
+                                          : (first->values[k] > second->values[k]) -
+                                                    (first->values[k] < second->values[k]);
+        if(order != 0)
+        {
+            return order;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Prints the query, a row per group and the total.
+ */
+static void printQueryReport(ReportSink *sink, const GroupTable *table, QueryGroup *sorted[])
+{
+    const ReportQuery *query = table->query;
+    DateCache          dates;
+    char               from[DATETIME_TEXT_LENGTH];
+    char               to[DATETIME_TEXT_LENGTH];
+
+    initDateCache(&dates);
+    formatDateTime(&dates, query->from, from);
+    formatDateTime(&dates, query->to, to);
+
+    sinkPrintf(sink, "   Report Query - %s from %s until %s\n",
+               query->event == QUERY_ADMISSIONS ? "Admissions" : "Discharges", from, to);
+    sinkPrintf(sink, "=======================================\n");
+
+    if(query->keyCount > 0)
+    {
+        sinkPrintf(sink, "Grouped by:");
+        for(int k = 0; k < query->keyCount; k++)
+        {
+            sinkPrintf(sink, k == 0 ? " %s" : ", %s", keyNames[query->keys[k]]);
+        }
+        sinkPrintf(sink, "\n");
+    }
+
+    for(int k = 0; k < query->keyCount; k++)
+    {
+        sinkPrintf(sink, "%-*s| ", KEY_COLUMN_WIDTH, keyNames[query->keys[k]]);
+    }
+    sinkPrintf(sink, "%-8s| %-17s| %s\n", "Count", "Mean Stay (days)", "Avg Beds Occupied");
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+    for(int i = 0; i < table->count; i++)
+    {
+        printGroupRow(sink, table, sorted[i], &dates);
+    }
+
+    if(table->count == 0)
+    {
+        sinkPrintf(sink, "| No patients in this range |\n");
+    }
+    else if(query->keyCount > 0)
+    {
+        sinkPrintf(sink, "%s", SEPARATOR_LINE);
+        for(int k = 0; k < query->keyCount; k++)
+        {
+            sinkPrintf(sink, "%-*s| ", KEY_COLUMN_WIDTH, k == 0 ? "Total" : "");
+        }
+        printGroupRow(sink, table, &table->total, NULL);
+    }
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+}
+
+/*
+ * Prints a group's keys (unless dates is NULL) and its totals.
+ */
+static void printGroupRow(ReportSink *sink, const GroupTable *table, const QueryGroup *group, DateCache *dates)
+{
+    char text[KEY_TEXT_LENGTH];
+
+    for(int k = 0; dates != NULL && k < table->query->keyCount; k++)
+    {
+        formatKey(text, table->query->keys[k], group->values[k], group->diagnosis, dates);
+        sinkPrintf(sink, "%-*.*s| ", KEY_COLUMN_WIDTH, KEY_COLUMN_WIDTH, text);
+    }
+
+    if(group->completedStays > 0)
+    {
+        snprintf(text, sizeof(text), "%.1f", group->staySeconds / group->completedStays / SECONDS_PER_DAY);
+    }
+    else
+    {
+        strcpy(text, "-");
+    }
+    sinkPrintf(sink, "%-8ld| %-17s| ", group->count, text);
+
+    double window = difftime(table->windowEnd, table->query->from);
+    if(window > 0)
+    {
+        sinkPrintf(sink, "%.2f\n", group->bedSeconds / window);
+    }
+    else
+    {
+        sinkPrintf(sink, "-\n");
+    }
+}
+
+/*
+ * Writes the text shown for one key of a group.
+ */
+static void formatKey(char text[], int key, int value, const char *diagnosis, DateCache *dates)
+{
+    const Doctor *doctor;
+
+    switch(key)
+    {
+        case GROUP_BY_DAY:
+            snprintf(text, KEY_TEXT_LENGTH, "%s", cachedDateText(dates, dayNumberToTime(value)));
+            break;
+        case GROUP_BY_ROOM:
+            snprintf(text, KEY_TEXT_LENGTH, "%d", value);
+            break;
+        case GROUP_BY_DIAGNOSIS:
+            snprintf(text, KEY_TEXT_LENGTH, "%s", diagnosis);
+            break;
+        case GROUP_BY_AGE_BAND:
+            if(value >= LAST_AGE_BAND)
+            {
+                snprintf(text, KEY_TEXT_LENGTH, "%d+", value);
+            }
+            else
+            {
+                snprintf(text, KEY_TEXT_LENGTH, "%d-%d", value, value + AGE_BAND_WIDTH - 1);
+            }
+            break;
+        case GROUP_BY_DOCTOR:
+            doctor = getDoctorWithId(value);
+            if(value == NO_ATTENDING_DOCTOR)
+            {
+                snprintf(text, KEY_TEXT_LENGTH, "None");
+            }
+            else if(doctor == NULL)
+            {
+                snprintf(text, KEY_TEXT_LENGTH, "Removed doctor %d", value);
+            }
+            else
+            {
+                snprintf(text, KEY_TEXT_LENGTH, "Dr.%s", doctor->name);
+            }
+            break;
+    }
+}
+
+/*
+ * Frees the groups and their diagnosis text.
+ */
+static void freeGroupTable(GroupTable *table)
+{
+    for(int slot = 0; slot < table->capacity; slot++)
+    {
+        free(table->groups[slot].diagnosis);
+    }
+    free(table->groups);
+}
+
+/*
+ * Reads up to MAX_GROUP_KEYS distinct group-by keys. Returns how many were
+ * chosen.
+ */
+static int promptGroupKeys(int keys[])
+{
+    char input[INPUT_LENGTH];
+
+    while(1)
+    {
+        printf("Group by (up to %d, comma-separated, Enter for none):\n", MAX_GROUP_KEYS);
+        for(int key = GROUP_BY_DAY; key <= GROUP_BY_DOCTOR; key++)
+        {
+            printf("%d: %s\n", key, keyNames[key]);
+        }
+
+        if(fgets(input, sizeof(input), stdin) == NULL)
+        {
+            return 0;
+        }
+        if(input[strspn(input, " \t\r\n")] == '\0')
+        {
+            return 0;
+        }
+
+        int count = parseIntegerList(input, keys, MAX_GROUP_KEYS);
+        int valid = count > 0;
+
+        for(int k = 0; valid && k < count; k++)
+        {
+            valid = keys[k] >= GROUP_BY_DAY && keys[k] <= GROUP_BY_DOCTOR;
+            for(int earlier = 0; valid && earlier < k; earlier++)
+            {
+                valid = keys[earlier] != keys[k];
+            }
+        }
+
+        if(valid)
+        {
+            return count;
+        }
+        printf("Please enter up to %d different key numbers, e.g. 1,3.\n", MAX_GROUP_KEYS);
+    }
+}
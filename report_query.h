@@ -0,0 +1,69 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines report queries. A query selects the admissions
+ *          or the discharges that fall in any [from, to) range, groups them
+ *          by up to three keys (day, room, diagnosis, age band, attending
+ *          doctor) and gives each group its count, mean length of stay and
+ *          average number of beds occupied. The census and the discharge
+ *          archive are read once, with every group aggregated in a hash table.
+ */
+
+#ifndef REPORT_QUERY_H
+#define REPORT_QUERY_H
+
+#include <time.h>
+#include "report_sink.h"
+
+// Which time a query's range applies to
+#define QUERY_ADMISSIONS 1
+#define QUERY_DISCHARGES 2
+
+// Group-by keys
+#define GROUP_BY_DAY 1
+#define GROUP_BY_ROOM 2
+#define GROUP_BY_DIAGNOSIS 3
+#define GROUP_BY_AGE_BAND 4
+#define GROUP_BY_DOCTOR 5
+
+#define MAX_GROUP_KEYS 3
+
+// Returned by runReportQuery when the query could not be run
+#define QUERY_FAILED (-1)
+
+/*
+ * A report query. Stays whose admission (or discharge) time is in
+ * [from, to) are grouped by keys[0..keyCount-1]; with no keys every stay
+ * falls in one group.
+ */
+typedef struct
+{
+    int    event;
+    time_t from;
+    time_t to;
+    int    keys[MAX_GROUP_KEYS];
+    int    keyCount;
+} ReportQuery;
+
+/*
+ * Function: runReportQuery
+ * ------------------------
+ * Runs a query and writes its table to a report sink. Length of stay is
+ * averaged over completed stays; occupancy is the stays' bed time inside the
+ * range (up to now) divided by the length of that range.
+ *
+ * query: The query to run
+ * sink: Receives the report
+ *
+ * Returns: The number of groups, or QUERY_FAILED
+ */
+int runReportQuery(const ReportQuery *query, ReportSink *sink);
+
+/*
+ * Function: reportQueryMenu
+ * -------------------------
+ * Prompts for a query, shows the result and appends it to query_reports.txt.
+ */
+void reportQueryMenu(void);
+
+#endif // REPORT_QUERY_H
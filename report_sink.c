@@ -0,0 +1,174 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the report output sink.
+ *          Lines are formatted straight into a 64 KB buffer. When the buffer
+ *          fills, it goes to the console and the file with one fwrite each,
+ *          so a report costs one formatting pass and a few large writes
+ *          instead of two printf calls and two small writes per line.
+ */
+
+#include "report_sink.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Private constants
+#define SINK_BUFFER_SIZE (64 * 1024)
+
+/*
+ * The buffered report and where it goes.
+ */
+struct ReportSink
+{
+    FILE  *file;
+    int    echoToConsole;
+    int    failed;
+    size_t length;
+    char   buffer[SINK_BUFFER_SIZE];
+};
+
+// Function prototypes for internal helper functions
+static void writeOut(ReportSink *sink, const char *text, size_t length);
+
+/*
+ * Allocates a sink with an empty buffer.
+ */
+ReportSink *openReportSink(FILE *file, int echoToConsole)
+{
+    ReportSink *sink = malloc(sizeof(ReportSink));
+    if(sink == NULL)
+    {
+        puts("Error: Not enough memory for the report.");
+        return NULL;
+    }
+
+    sink->file          = file;
+    sink->echoToConsole = echoToConsole;
+    sink->failed        = 0;
+    sink->length        = 0;
+    return sink;
+}
+
+/*
+ * Formats into the free end of the buffer. If the text does not fit, the
+ * buffer is flushed and the text formatted again; text longer than the
+ * whole buffer is formatted into its own allocation and written directly.
+ */
+void sinkPrintf(ReportSink *sink, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int needed = vsnprintf(sink->buffer + sink->length, SINK_BUFFER_SIZE - sink->length, format, args);
+    va_end(args);
+
+    if(needed < 0)
+    {
+        sink->failed = 1;
+        return;
+    }
+
+    if(sink->length + needed < SINK_BUFFER_SIZE)
+    {
+        sink->length += needed;
+        return;
+    }
+
+    flushReportSink(sink);
+
+    if(needed < SINK_BUFFER_SIZE)
+    {
+        va_start(args, format);
+        vsnprintf(sink->buffer, SINK_BUFFER_SIZE, format, args);
+        va_end(args);
+        sink->length = needed;
+        return;
+    }
+
+    char *text = malloc(needed + 1);
+    if(text == NULL)
+    {
+        sink->failed = 1;
+        return;
+    }
+
+    va_start(args, format);
+    vsnprintf(text, needed + 1, format, args);
+    va_end(args);
+
+    writeOut(sink, text, needed);
+    free(text);
+}
+
+/*
+ * Copies text into the buffer, flushing first if it does not fit.
+ */
+void sinkWrite(ReportSink *sink, const char *text, size_t length)
+{
+    if(sink->length + length > SINK_BUFFER_SIZE)
+    {
+        flushReportSink(sink);
+    }
+
+    if(length >= SINK_BUFFER_SIZE)
+    {
+        writeOut(sink, text, length);
+        return;
+    }
+
+    memcpy(sink->buffer + sink->length, text, length);
+    sink->length += length;
+}
+
+/*
+ * Writes the buffer to every destination and empties it.
+ */
+void flushReportSink(ReportSink *sink)
+{
+    writeOut(sink, sink->buffer, sink->length);
+    sink->length = 0;
+}
+
+/*
+ * Flushes the sink and the console, then frees the sink.
+ */
+int closeReportSink(ReportSink *sink)
+{
+    if(sink == NULL)
+    {
+        return 0;
+    }
+
+    flushReportSink(sink);
+    if(sink->echoToConsole && fflush(stdout) != 0)
+    {
+        sink->failed = 1;
+    }
+
+    int succeeded = !sink->failed;
+    free(sink);
+    return succeeded;
+}
+
+/*
+ * Writes a block of text to the console and the file.
+ */
+static void writeOut(ReportSink *sink, const char *text, size_t length)
+{
+    if(length == 0)
+    {
+        return;
+    }
+
+    if(sink->echoToConsole && fwrite(text, 1, length, stdout) != length)
+    {
+        sink->failed = 1;
+    }
+
+    if(sink->file != NULL && fwrite(text, 1, length, sink->file) != length)
+    {
+        sink->failed = 1;
+    }
+}
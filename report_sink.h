@@ -0,0 +1,75 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the report output sink. Reports that go to
+ *          both the console and a file format each line once into a shared
+ *          buffer, which is written to both destinations in large blocks.
+ *          The console copy can be turned off for large reports.
+ */
+
+#ifndef REPORT_SINK_H
+#define REPORT_SINK_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * A buffered destination for one report. Its fields are private to report_sink.c.
+ */
+typedef struct ReportSink ReportSink;
+
+/*
+ * Function: openReportSink
+ * ------------------------
+ * Starts a report written to a file and, optionally, the console.
+ *
+ * file: An open file that receives every line (may be NULL for console only)
+ * echoToConsole: 1 to also write every line to the console, 0 for file only
+ *
+ * Returns: The sink, or NULL if memory runs out
+ */
+ReportSink *openReportSink(FILE *file, int echoToConsole);
+
+/*
+ * Function: sinkPrintf
+ * --------------------
+ * Formats text once into the sink's buffer.
+ *
+ * sink: The report sink
+ * format: A printf format string, followed by its arguments
+ */
+void sinkPrintf(ReportSink *sink, const char *format, ...);
+
+/*
+ * Function: sinkWrite
+ * -------------------
+ * Copies already formatted text into the sink's buffer.
+ *
+ * sink: The report sink
+ * text: The text to add
+ * length: The number of bytes of text
+ */
+void sinkWrite(ReportSink *sink, const char *text, size_t length);
+
+/*
+ * Function: flushReportSink
+ * -------------------------
+ * Writes out everything buffered so far, e.g. before printing to the
+ * console outside the report.
+ *
+ * sink: The report sink
+ */
+void flushReportSink(ReportSink *sink);
+
+/*
+ * Function: closeReportSink
+ * -------------------------
+ * Writes out the rest of the report and frees the sink. The file is left open.
+ *
+ * sink: The report sink (may be NULL)
+ *
+ * Returns: 1 if every write succeeded, 0 otherwise
+ */
+int closeReportSink(ReportSink *sink);
+
+#endif // REPORT_SINK_H
@@ -0,0 +1,824 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the room occupancy history.
+ *          Each room keeps its completed stays sorted by admission time, with
+ *          a max segment tree over their discharge times and a running total
+ *          of stay length alongside. Binary search on admission time finds
+ *          where a query starts; the segment tree then jumps straight to each
+ *          earlier stay still running at a given moment, in logarithmic time
+ *          per stay found; the running totals give occupied time over any
+ *          range without visiting each stay.
+ *
+ *          On disk the stays live in room_history.dat as room-by-room sorted
+ *          runs, plus room_history.log holding stays added since the runs were
+ *          last rewritten. The log is folded into the runs on start-up once
+ *          it grows large. If room_history.dat is missing or unreadable the
+ *          runs are rebuilt from the discharge archive, which holds every stay
+ *          the log does.
+ */
+
+#include "room_history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "facility.h"
+#include "patient_data.h"
+#include "patient_management.h"
+#include "utils.h"
+
+// Private constants
+#define INITIAL_STAY_CAPACITY 8
+
+static const char  HISTORY_MAGIC[4]  = { 'R', 'H', 'S', 'T' };
+static const int   HISTORY_VERSION   = 1;
+static const int   COMPACT_THRESHOLD = 1024;
+static const int   NO_ARCHIVE_RECORD = -1;
+static const int   NO_STAY           = -1;
+static const char *HISTORY_FILE      = "room_history.dat";
+static const char *HISTORY_TEMP      = "room_history.tmp";
+static const char *HISTORY_LOG       = "room_history.log";
+
+/*
+ * One stay in a room. archiveRecord is the stay's position in
+ * discharged_patients.dat, or NO_ARCHIVE_RECORD while the patient is admitted.
+ */
+typedef struct
+{
+    int    roomNumber;
+    int    patientId;
+    int    archiveRecord;
+    time_t start;
+    time_t end;
+} StayRecord;
+
+/*
+ * Header of room_history.dat. It is followed by (roomCount + 1) stay counts
+ * (index 0 unused) and then every room's stays, room by room, in admission order.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+    int  roomCount;
+    int  stayCount;
+} HistoryHeader;
+
+/*
+ * Stays of one room. endTree is a max segment tree over the stays'
+ * discharge times: endTree[capacity + i] is stays[i].end and every other
+ * node holds the later of its two children. durationSum[i] is the total
+ * length of stays[0..i-1].
+ */
+typedef struct
+{
+    StayRecord *stays;
+    time_t     *endTree;
+    long long  *durationSum;
+    int         count;
+    int         capacity;
+    StayRecord *open;
+    int         openCount;
+    int         openCapacity;
+} RoomStays;
+
+static RoomStays *rooms       = NULL;
+static int        roomCount   = 0;
+static int        loggedStays = 0;
+
+// Function prototypes for internal helper functions
+static int        ensureRoom(int roomNumber);
+static RoomStays *getRoom(int roomNumber);
+static int        insertClosedStay(const StayRecord *stay);
+static int        growRoom(RoomStays *room);
+static void       rebuildRunningTotals(RoomStays *room, int from);
+static void       rebuildEndTree(RoomStays *room);
+static int        countStartsBefore(const RoomStays *room, time_t when, int inclusive);
+static int        previousEndingAfter(const RoomStays *room, int before, time_t when);
+static long long  occupiedSeconds(const RoomStays *room, time_t from, time_t to, time_t now);
+static int        loadHistoryFile(void);
+static void       loadHistoryLog(void);
+static void       buildFromArchive(void);
+static int        compactHistory(void);
+static int        promptRoomNumber(void);
+static void       printStay(const StayRecord *stay);
+
+/*
+ * Loads the stored history, building it from the discharge archive the
+ * first time, and folds a large log back into the sorted runs.
+ */
+void initializeRoomHistory(void)
+{
+    if(!ensureRoom(facilityMaxRoomNumber()))
+    {
+        puts("Error: Not enough memory for the room history.");
+        return;
+    }
+
+    int hasBase = loadHistoryFile();
+    loadHistoryLog();
+
+    // The archive holds every logged stay too, and duplicates are skipped
+    if(!hasBase)
+    {
+        buildFromArchive();
+        compactHistory();
+    }
+    else if(loggedStays >= COMPACT_THRESHOLD)
+    {
+        compactHistory();
+    }
+}
+
+/*
+ * Records that a patient currently occupies a room.
+ */
+void roomHistoryOpenStay(int roomNumber, int patientId, time_t admittedAt)
+{
+    RoomStays *room = getRoom(roomNumber);
+    if(room == NULL)
+    {
+        return;
+    }
+
+    if(room->openCount == room->openCapacity)
+    {
+        int         beds        = facilityRoomCapacity(roomNumber);
+        int         newCapacity = room->openCapacity == 0 ? (beds > 0 ? beds : 1) : room->openCapacity * 2;
+        StayRecord *grown       = realloc(room->open, newCapacity * sizeof(StayRecord));
+
+        if(grown == NULL)
+        {
+            puts("Warning: Unable to track the current room occupant.");
+            return;
+        }
+
+        room->open         = grown;
+        room->openCapacity = newCapacity;
+    }
+
+    room->open[room->openCount++] = (StayRecord) { roomNumber, patientId, NO_ARCHIVE_RECORD, admittedAt, admittedAt };
+}
+
+/*
+ * Forgets a current occupant.
+ */
+void roomHistoryDropOpenStay(int roomNumber, int patientId)
+{
+    RoomStays *room = getRoom(roomNumber);
+    if(room == NULL)
+    {
+        return;
+    }
+
+    for(int i = 0; i < room->openCount; i++)
+    {
+        if(room->open[i].patientId == patientId)
+        {
+            room->open[i] = room->open[--room->openCount];
+            return;
+        }
+    }
+}
+
+/*
+ * Forgets every current occupant.
+ */
+void roomHistoryClearOpenStays(void)
+{
+    for(int roomNumber = 0; rooms != NULL && roomNumber <= roomCount; roomNumber++)
+    {
+        rooms[roomNumber].openCount = 0;
+    }
+}
+
+/*
+ * Adds completed stays to the history and appends them to the log in one write.
+ */
+int roomHistoryRecordStays(const DischargedPatient records[], long firstArchiveRecord, int count)
+{
+    StayRecord *stays = malloc(count * sizeof(StayRecord));
+    if(stays == NULL)
+    {
+        puts("Error: Not enough memory to record room history.");
+        return 0;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        stays[i] = (StayRecord) { records[i].patient.roomNumber, records[i].patient.patientId,
+                                  (int) (firstArchiveRecord + i), records[i].patient.admissionDate,
+                                  records[i].dischargeDate };
+        insertClosedStay(&stays[i]);
+    }
+
+    FILE *file  = fopen(HISTORY_LOG, "ab");
+    int   saved = file != NULL && fwrite(stays, sizeof(StayRecord), count, file) == (size_t) count;
+
+    if(file == NULL || fclose(file) != 0 || !saved)
+    {
+        perror("Error writing room_history.log");
+        saved = 0;
+    }
+    else
+    {
+        loggedStays += count;
+    }
+
+    free(stays);
+    return saved;
+}
+
+/*
+ * Lists who occupied a room at a given moment. Only stays that began at or
+ * before that moment can contain it, and of those the segment tree visits
+ * just the ones that end after it.
+ */
+void showRoomOccupantsAt(void)
+{
+    int        roomNumber = promptRoomNumber();
+    time_t     now        = time(NULL);
+    time_t     when       = promptDateTime("Enter date and time (YYYY-MM-DD HH:MM, Enter for now):\n", now);
+    RoomStays *room       = getRoom(roomNumber);
+    int        found      = 0;
+
+    printf("--- Room %d occupants ---\n", roomNumber);
+
+    for(int i = previousEndingAfter(room, countStartsBefore(room, when, 1), when); i != NO_STAY;
+        i     = previousEndingAfter(room, i, when))
+    {
+        printStay(&room->stays[i]);
+        found++;
+    }
+
+    for(int i = 0; i < room->openCount; i++)
+    {
+        if(room->open[i].start <= when && when <= now)
+        {
+            printStay(&room->open[i]);
+            found++;
+        }
+    }
+
+    if(found == 0)
+    {
+        puts("The room was empty at that time.");
+    }
+}
+
+/*
+ * Lists every stay in a room that overlaps a date range.
+ */
+void showRoomStaysBetween(void)
+{
+    int        roomNumber = promptRoomNumber();
+    time_t     now        = time(NULL);
+    time_t     from       = promptDateTime("Enter start date (YYYY-MM-DD [HH:MM]):\n", now);
+    time_t     to         = promptDateTime("Enter end date (YYYY-MM-DD [HH:MM], Enter for now):\n", now);
+    RoomStays *room       = getRoom(roomNumber);
+    int        found      = 0;
+
+    printf("--- Room %d stays ---\n", roomNumber);
+
+    for(int i = previousEndingAfter(room, countStartsBefore(room, to, 0), from); i != NO_STAY;
+        i     = previousEndingAfter(room, i, from))
+    {
+        printStay(&room->stays[i]);
+        found++;
+    }
+
+    for(int i = 0; i < room->openCount; i++)
+    {
+        if(room->open[i].start < to && now > from)
+        {
+            printStay(&room->open[i]);
+            found++;
+        }
+    }
+
+    if(found == 0)
+    {
+        puts("No stays overlap that range.");
+    }
+}
+
+/*
+ * Prints the share of time each room was occupied during a date range,
+ * plus the average across all rooms.
+ */
+void showRoomUtilization(void)
+{
+    time_t now  = time(NULL);
+    time_t from = promptDateTime("Enter start date (YYYY-MM-DD [HH:MM]):\n", now);
+    time_t to   = promptDateTime("Enter end date (YYYY-MM-DD [HH:MM], Enter for now):\n", now);
+
+    if(to <= from)
+    {
+        puts("The end date must be after the start date.");
+        return;
+    }
+
+    double    rangeSeconds  = difftime(to, from);
+    long long totalOccupied = 0;
+    long long totalCapacity = 0;
+
+    printf("Room | Occupied %%\n");
+    printf("-----|-----------\n");
+
+    for(int roomNumber = MIN_ROOM_NUMBER; roomNumber <= facilityMaxRoomNumber(); roomNumber++)
+    {
+        int beds = facilityRoomCapacity(roomNumber);
+        if(beds == 0)
+        {
+            continue;
+        }
+
+        long long occupied = occupiedSeconds(getRoom(roomNumber), from, to, now);
+
+        totalOccupied += occupied;
+        totalCapacity += beds;
+
+        if(occupied > 0)
+        {
+            printf("%-4d | %6.2f\n", roomNumber, 100.0 * occupied / (beds * rangeSeconds));
+        }
+    }
+
+    printf("-----------------\n");
+    printf("Average occupancy: %.2f%%\n", totalCapacity == 0 ? 0.0 : 100.0 * totalOccupied / (totalCapacity * rangeSeconds));
+}
+
+/*
+ * Grows the room table so rooms up to roomNumber exist.
+ */
+static int ensureRoom(int roomNumber)
+{
+    if(roomNumber <= roomCount && rooms != NULL)
+    {
+        return 1;
+    }
+
+    RoomStays *grown = realloc(rooms, (roomNumber + 1) * sizeof(RoomStays));
+    if(grown == NULL)
+    {
+        return 0;
+    }
+
+    int firstNew = rooms == NULL ? 0 : roomCount + 1;
+    memset(&grown[firstNew], 0, (roomNumber + 1 - firstNew) * sizeof(RoomStays));
+
+    rooms     = grown;
+    roomCount = roomNumber;
+    return 1;
+}
+
+/*
+ * Returns a room's stays, or NULL if the room number is out of range.
+ */
+static RoomStays *getRoom(int roomNumber)
+{
+    if(roomNumber < 0 || !ensureRoom(roomNumber))
+    {
+        return NULL;
+    }
+
+    return &rooms[roomNumber];
+}
+
+/*
+ * Inserts a completed stay at its admission-time position. Stays are
+ * usually added in admission order, so this is normally an append.
+ * A stay already present (same patient and times) is ignored, which keeps
+ * a log replayed after an interrupted compaction from adding duplicates.
+ */
+static int insertClosedStay(const StayRecord *stay)
+{
+    RoomStays *room = getRoom(stay->roomNumber);
+    if(room == NULL)
+    {
+        return 0;
+    }
+
+    int position = countStartsBefore(room, stay->start, 1);
+
+    for(int i = position - 1; i >= 0 && room->stays[i].start == stay->start; i--)
+    {
+        if(room->stays[i].patientId == stay->patientId && room->stays[i].end == stay->end)
+        {
+            return 1;
+        }
+    }
+
+    if(room->count == room->capacity && !growRoom(room))
+    {
+        return 0;
+    }
+
+    memmove(&room->stays[position + 1], &room->stays[position], (room->count - position) * sizeof(StayRecord));
+    room->stays[position] = *stay;
+    room->count++;
+
+    rebuildRunningTotals(room, position);
+    return 1;
+}
+
+/*
+ * Doubles the capacity of a room's stay arrays.
+ */
+static int growRoom(RoomStays *room)
+{
+    int newCapacity = room->capacity == 0 ? INITIAL_STAY_CAPACITY : room->capacity * 2;
+
+    StayRecord *stays = realloc(room->stays, newCapacity * sizeof(StayRecord));
+    if(stays == NULL)
+    {
+        return 0;
+    }
+    room->stays = stays;
+
+    time_t *endTree = realloc(room->endTree, 2 * newCapacity * sizeof(time_t));
+    if(endTree == NULL)
+    {
+        return 0;
+    }
+    room->endTree = endTree;
+
+    long long *durationSum = realloc(room->durationSum, (newCapacity + 1) * sizeof(long long));
+    if(durationSum == NULL)
+    {
+        return 0;
+    }
+    room->durationSum = durationSum;
+
+    if(room->capacity == 0)
+    {
+        room->durationSum[0] = 0;
+    }
+
+    // The leaves start at the capacity, so the whole tree moves
+    room->capacity = newCapacity;
+    rebuildEndTree(room);
+    return 1;
+}
+
+/*
+ * Recomputes the segment tree and the running totals from a position on.
+ * An appended stay only updates its path to the root; an insertion shifts
+ * every later leaf, so the tree is rebuilt.
+ */
+static void rebuildRunningTotals(RoomStays *room, int from)
+{
+    for(int i = from; i < room->count; i++)
+    {
+        room->durationSum[i + 1] = room->durationSum[i] + (long long) (room->stays[i].end - room->stays[i].start);
+    }
+
+    if(from < room->count - 1)
+    {
+        rebuildEndTree(room);
+        return;
+    }
+
+    int node            = room->capacity + from;
+    room->endTree[node] = room->stays[from].end;
+
+    for(node /= 2; node >= 1; node /= 2)
+    {
+        time_t left         = room->endTree[2 * node];
+        time_t right        = room->endTree[2 * node + 1];
+        room->endTree[node] = left > right ? left : right;
+    }
+}
+
+/*
+ * Fills the segment tree's leaves from the stays and recomputes every
+ * other node. Leaves past the last stay are never searched.
+ */
+static void rebuildEndTree(RoomStays *room)
+{
+    for(int i = 0; i < room->capacity; i++)
+    {
+        room->endTree[room->capacity + i] = i < room->count ? room->stays[i].end : 0;
+    }
+
+    for(int node = room->capacity - 1; node >= 1; node--)
+    {
+        time_t left         = room->endTree[2 * node];
+        time_t right        = room->endTree[2 * node + 1];
+        room->endTree[node] = left > right ? left : right;
+    }
+}
+
+/*
+ * Binary search: the number of stays admitted before the given time
+ * (or at or before it when inclusive is set).
+ */
+static int countStartsBefore(const RoomStays *room, time_t when, int inclusive)
+{
+    int low  = 0;
+    int high = room->count;
+
+    while(low < high)
+    {
+        int    middle = low + (high - low) / 2;
+        time_t start  = room->stays[middle].start;
+
+        if(start < when || (inclusive && start == when))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * Segment tree search: the last of stays[0..before-1] discharged after the
+ * given time, or NO_STAY. Climbs from the leaf before the limit until a left
+ * sibling holds a late enough discharge, then descends to its rightmost
+ * such leaf, so each call is logarithmic in the room's stay count.
+ */
+static int previousEndingAfter(const RoomStays *room, int before, time_t when)
+{
+    if(room == NULL || before <= 0)
+    {
+        return NO_STAY;
+    }
+
+    const time_t *tree = room->endTree;
+    int           node = room->capacity + before - 1;
+
+    if(tree[node] > when)
+    {
+        return before - 1;
+    }
+
+    for(; node > 1; node /= 2)
+    {
+        if(node % 2 == 1 && tree[node - 1] > when)
+        {
+            node--;
+            while(node < room->capacity)
+            {
+                node = tree[2 * node + 1] > when ? 2 * node + 1 : 2 * node;
+            }
+            return node - room->capacity;
+        }
+    }
+
+    return NO_STAY;
+}
+
+/*
+ * Total time the room's beds were occupied within [from, to). Stays admitted
+ * inside the range are summed from the running totals; only stays crossing
+ * either end of the range are visited, through the segment tree, to trim or
+ * add their overlap.
+ */
+static long long occupiedSeconds(const RoomStays *room, time_t from, time_t to, time_t now)
+{
+    if(room == NULL)
+    {
+        return 0;
+    }
+
+    int       first = countStartsBefore(room, from, 0);
+    int       last  = countStartsBefore(room, to, 0);
+    long long total = room->count == 0 ? 0 : room->durationSum[last] - room->durationSum[first];
+
+    // Stays admitted inside the range but discharged after it
+    for(int i = previousEndingAfter(room, last, to); i >= first; i = previousEndingAfter(room, i, to))
+    {
+        total -= (long long) (room->stays[i].end - to);
+    }
+
+    // Stays admitted before the range that were still running when it began
+    for(int i = previousEndingAfter(room, first, from); i != NO_STAY; i = previousEndingAfter(room, i, from))
+    {
+        time_t end = room->stays[i].end < to ? room->stays[i].end : to;
+        total += (long long) (end - from);
+    }
+
+    // Current occupants count up to now
+    for(int i = 0; i < room->openCount; i++)
+    {
+        time_t start = room->open[i].start > from ? room->open[i].start : from;
+        time_t end   = now < to ? now : to;
+
+        if(end > start)
+        {
+            total += (long long) (end - start);
+        }
+    }
+
+    return total;
+}
+
+/*
+ * Reads the sorted runs from room_history.dat. Returns 0 if there is no valid file.
+ */
+static int loadHistoryFile(void)
+{
+    FILE *file = fopen(HISTORY_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    HistoryHeader header;
+    int           loaded = fread(&header, sizeof(header), 1, file) == 1 &&
+                 memcmp(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) == 0 &&
+                 header.version == HISTORY_VERSION && header.roomCount >= 0 && ensureRoom(header.roomCount);
+
+    int *stayCounts = loaded ? malloc((header.roomCount + 1) * sizeof(int)) : NULL;
+
+    loaded = stayCounts != NULL &&
+             fread(stayCounts, sizeof(int), header.roomCount + 1, file) == (size_t) header.roomCount + 1;
+
+    // Runs are already sorted, so each stay is appended at the end of its room
+    for(int roomNumber = 0; loaded && roomNumber <= header.roomCount; roomNumber++)
+    {
+        for(int i = 0; i < stayCounts[roomNumber] && loaded; i++)
+        {
+            StayRecord stay;
+            loaded = fread(&stay, sizeof(StayRecord), 1, file) == 1 && insertClosedStay(&stay);
+        }
+    }
+
+    free(stayCounts);
+    fclose(file);
+
+    if(!loaded)
+    {
+        puts("Error reading room_history.dat. Some room history may be missing.");
+    }
+
+    return loaded;
+}
+
+/*
+ * Applies the stays appended to room_history.log since the last compaction.
+ */
+static void loadHistoryLog(void)
+{
+    FILE *file = fopen(HISTORY_LOG, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    StayRecord stay;
+    while(fread(&stay, sizeof(StayRecord), 1, file) == 1)
+    {
+        insertClosedStay(&stay);
+        loggedStays++;
+    }
+
+    fclose(file);
+}
+
+/*
+ * Builds the history from discharged_patients.dat when no history file exists.
+ */
+static void buildFromArchive(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    DischargedPatient record;
+    int               recordNumber = 0;
+
+    while(fread(&record, sizeof(DischargedPatient), 1, file) == 1)
+    {
+        StayRecord stay = { record.patient.roomNumber, record.patient.patientId, recordNumber,
+                            record.patient.admissionDate, record.dischargeDate };
+        insertClosedStay(&stay);
+        recordNumber++;
+    }
+
+    fclose(file);
+    printf("Room history built from %d discharge records.\n", recordNumber);
+}
+
+/*
+ * Rewrites room_history.dat with every stay in sorted runs and empties the log.
+ */
+static int compactHistory(void)
+{
+    FILE *file = fopen(HISTORY_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating room_history.tmp");
+        return 0;
+    }
+
+    HistoryHeader header;
+    memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+    header.version   = HISTORY_VERSION;
+    header.roomCount = roomCount;
+    header.stayCount = 0;
+
+    for(int roomNumber = 0; roomNumber <= roomCount; roomNumber++)
+    {
+        header.stayCount += rooms[roomNumber].count;
+    }
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int roomNumber = 0; written && roomNumber <= roomCount; roomNumber++)
+    {
+        written = fwrite(&rooms[roomNumber].count, sizeof(int), 1, file) == 1;
+    }
+
+    for(int roomNumber = 0; written && roomNumber <= roomCount; roomNumber++)
+    {
+        const RoomStays *room = &rooms[roomNumber];
+        written = room->count == 0 ||
+                  fwrite(room->stays, sizeof(StayRecord), room->count, file) == (size_t) room->count;
+    }
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing room_history.tmp");
+        remove(HISTORY_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(HISTORY_TEMP, HISTORY_FILE))
+    {
+        perror("Error renaming room_history.tmp to room_history.dat");
+        return 0;
+    }
+
+    // Every logged stay is now in the runs; replaying it later would be harmless
+    remove(HISTORY_LOG);
+    loggedStays = 0;
+    return 1;
+}
+
+/*
+ * Prompts until a valid room number is entered.
+ */
+static int promptRoomNumber(void)
+{
+    int roomNumber;
+
+    while(1)
+    {
+        printf("Enter Room Number:\n");
+
+        if(scanf("%d", &roomNumber) == SUCCESSFUL_READ && validateRoomNumber(roomNumber) == IS_VALID)
+        {
+            clearInputBuffer();
+            return roomNumber;
+        }
+
+        clearInputBuffer();
+        printf("Invalid room number. Please try again.\n");
+    }
+}
+
+/*
+ * Prints one stay with the patient's name and the admission/discharge times.
+ */
+static void printStay(const StayRecord *stay)
+{
+    const char       *name = "(unknown)";
+    DischargedPatient record;
+    char              startStr[20];
+    char              endStr[20];
+
+    if(stay->archiveRecord == NO_ARCHIVE_RECORD)
+    {
+        const Patient *patient = findAdmittedPatient(stay->patientId);
+        if(patient != NULL)
+        {
+            name = patient->name;
+        }
+    }
+    else if(readDischargedPatient(stay->archiveRecord, &record))
+    {
+        name = record.patient.name;
+    }
+
+    strftime(startStr, sizeof(startStr), "%Y-%m-%d %H:%M", localtime(&stay->start));
+
+    if(stay->archiveRecord == NO_ARCHIVE_RECORD)
+    {
+        strcpy(endStr, "still admitted");
+    }
+    else
+    {
+        strftime(endStr, sizeof(endStr), "%Y-%m-%d %H:%M", localtime(&stay->end));
+    }
+
+    printf("| ID: %-5d Name: %-15s | Admitted: %-16s | Discharged: %-16s |\n",
+           stay->patientId, name, startStr, endStr);
+}
@@ -0,0 +1,90 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the room occupancy history. Every stay is kept
+ *          as an interval [admission, discharge) in per-room runs sorted by
+ *          admission time, so "who was in room R at time T", "who used room R
+ *          between two dates" and room utilization are answered with binary
+ *          searches instead of scanning the discharge archive.
+ */
+
+#ifndef ROOM_HISTORY_H
+#define ROOM_HISTORY_H
+
+#include <time.h>
+#include "patient_management.h"
+
+/*
+ * Function: initializeRoomHistory
+ * -------------------------------
+ * Loads the past stays from room_history.dat and room_history.log. If no
+ * history exists yet, it is built once from discharged_patients.dat.
+ * Must run before the patient system loads the current census.
+ */
+void initializeRoomHistory(void);
+
+/*
+ * Function: roomHistoryOpenStay
+ * -----------------------------
+ * Records that a patient currently occupies a room.
+ *
+ * roomNumber: The occupied room
+ * patientId: The admitted patient
+ * admittedAt: The admission time
+ */
+void roomHistoryOpenStay(int roomNumber, int patientId, time_t admittedAt);
+
+/*
+ * Function: roomHistoryDropOpenStay
+ * ---------------------------------
+ * Forgets a current occupant (on discharge or when the census is reloaded).
+ *
+ * roomNumber: The occupied room
+ * patientId: The patient leaving the census
+ */
+void roomHistoryDropOpenStay(int roomNumber, int patientId);
+
+/*
+ * Function: roomHistoryClearOpenStays
+ * -----------------------------------
+ * Forgets every current occupant before the census is reloaded.
+ */
+void roomHistoryClearOpenStays(void);
+
+/*
+ * Function: roomHistoryRecordStays
+ * --------------------------------
+ * Adds completed stays to the history and appends them to room_history.log
+ * in a single write.
+ *
+ * records: The discharge records, in the order they were archived
+ * firstArchiveRecord: Position of records[0] in discharged_patients.dat
+ * count: Number of records
+ *
+ * Returns: 1 if the stays were saved, 0 otherwise
+ */
+int roomHistoryRecordStays(const DischargedPatient records[], long firstArchiveRecord, int count);
+
+/*
+ * Function: showRoomOccupantsAt
+ * -----------------------------
+ * Prompts for a room and a date/time and lists who occupied the room then.
+ */
+void showRoomOccupantsAt(void);
+
+/*
+ * Function: showRoomStaysBetween
+ * ------------------------------
+ * Prompts for a room and a date range and lists every stay overlapping it.
+ */
+void showRoomStaysBetween(void);
+
+/*
+ * Function: showRoomUtilization
+ * -----------------------------
+ * Prompts for a date range and prints the percentage of time each room
+ * was occupied during it.
+ */
+void showRoomUtilization(void);
+
+#endif // ROOM_HISTORY_H
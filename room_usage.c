@@ -0,0 +1,440 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the binary room usage counters.
+ *          room_usage.dat holds a small header, one counter per room and
+ *          one counter per calendar day since the first recorded use.
+ *          Every save writes the counters to room_usage.tmp, syncs it and
+ *          renames it over room_usage.dat, so the file never holds a
+ *          partially applied update. A missing or unreadable file is rebuilt
+ *          from discharged_patients.dat, unless the old room_usage.txt log is
+ *          still waiting to be imported.
+ */
+
+#include "room_usage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "facility.h"
+#include "patient_data.h"
+#include "patient_management.h"
+#include "utils.h"
+
+// Private constants
+#define RECENT_DAYS 7
+#define ARCHIVE_CHUNK 256
+
+static const char  USAGE_MAGIC[4] = { 'R', 'U', 'S', 'G' };
+static const int   USAGE_VERSION  = 1;
+static const int   NO_DAYS        = 0;
+static const char *USAGE_FILE     = "room_usage.dat";
+static const char *USAGE_TEMP     = "room_usage.tmp";
+static const char *LEGACY_LOG     = "room_usage.txt";
+static const char *IMPORTED_LOG   = "room_usage.imported.txt";
+
+/*
+ * Header at the start of room_usage.dat. It is followed by
+ * (roomCount + 1) room counters (index 0 unused) and dayCount day counters,
+ * the first of which is for day number firstDay.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+    int  roomCount;
+    int  firstDay;
+    int  dayCount;
+} RoomUsageHeader;
+
+// In-memory copy of room_usage.dat
+static RoomUsageHeader usageHeader;
+static int            *roomCounts = NULL;
+static int            *dayCounts  = NULL;
+
+// Function prototypes for internal helper functions
+static int  loadUsageFile(void);
+static void resetUsage(void);
+static int  ensureRoomCapacity(int roomCount);
+static int  ensureDayBucket(int dayNumber);
+static int  importLegacyLog(void);
+static void rebuildFromArchive(void);
+static int  saveUsageFile(void);
+
+/*
+ * Loads the counters, importing room_usage.txt if no binary file exists.
+ * The text log is renamed once imported so it is never counted twice; after
+ * that, a lost or damaged file is rebuilt from the discharge archive.
+ */
+void initializeRoomUsage(void)
+{
+    resetUsage();
+
+    if(loadUsageFile())
+    {
+        return;
+    }
+
+    resetUsage();
+    if(!importLegacyLog())
+    {
+        rebuildFromArchive();
+    }
+}
+
+/*
+ * Counts one use of each listed room and saves the counters in one step.
+ */
+int recordRoomUsage(const int roomNumbers[], int count, time_t usedAt)
+{
+    int dayNumber = toDayNumber(usedAt);
+
+    if(!ensureRoomCapacity(facilityMaxRoomNumber()) || !ensureDayBucket(dayNumber))
+    {
+        puts("Error: Not enough memory to record room usage.");
+        return 0;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        if(validateRoomNumber(roomNumbers[i]) == IS_NOT_VALID)
+        {
+            fprintf(stderr, "Warning: Room usage not recorded for invalid room number '%d'\n", roomNumbers[i]);
+            continue;
+        }
+
+        roomCounts[roomNumbers[i]]++;
+        dayCounts[dayNumber - usageHeader.firstDay]++;
+    }
+
+    return saveUsageFile();
+}
+
+/*
+ * Returns a room's counter.
+ */
+int roomUsageCount(int roomNumber)
+{
+    if(roomCounts == NULL || roomNumber < MIN_ROOM_NUMBER || roomNumber > usageHeader.roomCount)
+    {
+        return 0;
+    }
+    return roomCounts[roomNumber];
+}
+
+/*
+ * Displays how many times each room was used and the uses for each of
+ * the last seven days. Reads only the counters, never the usage history.
+ */
+void displayRoomUsageReport(void)
+{
+    int totalUses     = 0;
+    int roomsReported = 0;
+
+    printf("\n--- Room Usage Report ---\n");
+    printf("Room | Usage Count\n");
+    printf("-----|------------\n");
+
+    for(int room = MIN_ROOM_NUMBER; room <= usageHeader.roomCount; room++)
+    {
+        if(roomCounts[room] > 0)
+        {
+            printf("%-4d | %d\n", room, roomCounts[room]);
+            totalUses += roomCounts[room];
+            roomsReported++;
+        }
+    }
+
+    if(roomsReported == 0)
+    {
+        printf("No room usage has been recorded.\n");
+    }
+
+    printf("-------------------------\n");
+    printf("Total room uses: %d\n", totalUses);
+    printf("Rooms used: %d\n", roomsReported);
+    printf("-------------------------\n");
+    printf("Date       | Room Uses\n");
+
+    int today = toDayNumber(time(NULL));
+
+    for(int day = today - RECENT_DAYS + 1; day <= today; day++)
+    {
+        int    bucket   = day - usageHeader.firstDay;
+        int    uses     = (bucket >= 0 && bucket < usageHeader.dayCount) ? dayCounts[bucket] : 0;
+        time_t midnight = dayNumberToTime(day);
+        char   dateStr[20];
+
+        strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", localtime(&midnight));
+        printf("%-10s | %d\n", dateStr, uses);
+    }
+
+    printf("-------------------------\n");
+}
+
+/*
+ * Reads room_usage.dat into memory. Returns 0 if the file is missing or invalid.
+ */
+static int loadUsageFile(void)
+{
+    FILE *file = fopen(USAGE_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    RoomUsageHeader header;
+    int            *rooms  = NULL;
+    int            *days   = NULL;
+    int             loaded = fread(&header, sizeof(header), 1, file) == 1 &&
+                 memcmp(header.magic, USAGE_MAGIC, sizeof(USAGE_MAGIC)) == 0 &&
+                 header.version == USAGE_VERSION && header.roomCount >= 0 && header.dayCount >= 0;
+
+    if(loaded)
+    {
+        rooms = calloc(header.roomCount + 1, sizeof(int));
+        days  = calloc(header.dayCount + 1, sizeof(int));
+
+        loaded = rooms != NULL && days != NULL &&
+                 fread(rooms, sizeof(int), header.roomCount + 1, file) == (size_t) header.roomCount + 1 &&
+                 fread(days, sizeof(int), header.dayCount, file) == (size_t) header.dayCount;
+    }
+
+    fclose(file);
+
+    if(!loaded)
+    {
+        free(rooms);
+        free(days);
+        puts("Error reading room_usage.dat. Room usage counters will be rebuilt.");
+        return 0;
+    }
+
+    free(roomCounts);
+    free(dayCounts);
+    roomCounts     = rooms;
+    dayCounts      = days;
+    usageHeader    = header;
+    return ensureRoomCapacity(facilityMaxRoomNumber());
+}
+
+/*
+ * Empties the in-memory counters.
+ */
+static void resetUsage(void)
+{
+    free(roomCounts);
+    free(dayCounts);
+    roomCounts = NULL;
+    dayCounts  = NULL;
+
+    memcpy(usageHeader.magic, USAGE_MAGIC, sizeof(USAGE_MAGIC));
+    usageHeader.version   = USAGE_VERSION;
+    usageHeader.roomCount = facilityMaxRoomNumber();
+    usageHeader.firstDay  = 0;
+    usageHeader.dayCount  = NO_DAYS;
+
+    roomCounts = calloc(usageHeader.roomCount + 1, sizeof(int));
+}
+
+/*
+ * Grows the room counter array so every room up to roomCount has a counter.
+ */
+static int ensureRoomCapacity(int roomCount)
+{
+    if(roomCounts != NULL && roomCount <= usageHeader.roomCount)
+    {
+        return 1;
+    }
+
+    int *grown = realloc(roomCounts, (roomCount + 1) * sizeof(int));
+    if(grown == NULL)
+    {
+        return 0;
+    }
+
+    int firstNew = roomCounts == NULL ? 0 : usageHeader.roomCount + 1;
+    memset(&grown[firstNew], 0, (roomCount + 1 - firstNew) * sizeof(int));
+
+    roomCounts            = grown;
+    usageHeader.roomCount = roomCount;
+    return 1;
+}
+
+/*
+ * Makes sure a day counter exists for the given day, extending the
+ * range of days forwards or backwards as needed.
+ */
+static int ensureDayBucket(int dayNumber)
+{
+    if(usageHeader.dayCount == NO_DAYS)
+    {
+        free(dayCounts);
+        dayCounts = calloc(1, sizeof(int));
+        if(dayCounts == NULL)
+        {
+            return 0;
+        }
+
+        usageHeader.firstDay = dayNumber;
+        usageHeader.dayCount = 1;
+        return 1;
+    }
+
+    int lastDay  = usageHeader.firstDay + usageHeader.dayCount - 1;
+    int firstDay = dayNumber < usageHeader.firstDay ? dayNumber : usageHeader.firstDay;
+    int newLast  = dayNumber > lastDay ? dayNumber : lastDay;
+
+    if(firstDay == usageHeader.firstDay && newLast == lastDay)
+    {
+        return 1;
+    }
+
+    int  newCount = newLast - firstDay + 1;
+    int *grown    = calloc(newCount, sizeof(int));
+    if(grown == NULL)
+    {
+        return 0;
+    }
+
+    memcpy(&grown[usageHeader.firstDay - firstDay], dayCounts, usageHeader.dayCount * sizeof(int));
+    free(dayCounts);
+
+    dayCounts            = grown;
+    usageHeader.firstDay = firstDay;
+    usageHeader.dayCount = newCount;
+    return 1;
+}
+
+/*
+ * One-time conversion of the old text log (one room number per line).
+ * The text log has no dates, so imported uses only count towards room totals.
+ * Returns 0 if there is no log to import.
+ */
+static int importLegacyLog(void)
+{
+    FILE *file = fopen(LEGACY_LOG, "r");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    int roomNumber;
+    int imported = 0;
+
+    while(fscanf(file, "%d", &roomNumber) == 1)
+    {
+        if(validateRoomNumber(roomNumber) == IS_NOT_VALID)
+        {
+            fprintf(stderr, "Warning: Found invalid room number '%d' in room_usage.txt\n", roomNumber);
+            continue;
+        }
+
+        roomCounts[roomNumber]++;
+        imported++;
+    }
+
+    fclose(file);
+
+    if(saveUsageFile())
+    {
+        printf("Imported %d room usage entries from room_usage.txt.\n", imported);
+
+        if(rename(LEGACY_LOG, IMPORTED_LOG) != 0)
+        {
+            perror("Error renaming room_usage.txt to room_usage.imported.txt");
+        }
+    }
+    return 1;
+}
+
+/*
+ * Counts the room of every archived discharge on its discharge day and
+ * saves the result.
+ */
+static void rebuildFromArchive(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    DischargedPatient *chunk   = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    int                ok      = chunk != NULL;
+    int                counted = 0;
+    size_t             read;
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            int room      = chunk[i].patient.roomNumber;
+            int dayNumber = toDayNumber(chunk[i].dischargeDate);
+
+            if(validateRoomNumber(room) == IS_NOT_VALID)
+            {
+                continue;
+            }
+
+            ok = ensureRoomCapacity(room) && ensureDayBucket(dayNumber);
+            if(ok)
+            {
+                roomCounts[room]++;
+                dayCounts[dayNumber - usageHeader.firstDay]++;
+                counted++;
+            }
+        }
+    }
+
+    free(chunk);
+    fclose(file);
+
+    if(!ok)
+    {
+        puts("Error: Not enough memory to rebuild the room usage counters.");
+        resetUsage();
+        return;
+    }
+
+    if(counted > 0 && saveUsageFile())
+    {
+        printf("Room usage counters rebuilt from %d discharge records.\n", counted);
+    }
+}
+
+/*
+ * Writes the counters to room_usage.tmp, syncs it and renames it over
+ * room_usage.dat.
+ */
+static int saveUsageFile(void)
+{
+    FILE *file = fopen(USAGE_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating room_usage.tmp");
+        return 0;
+    }
+
+    int written = fwrite(&usageHeader, sizeof(usageHeader), 1, file) == 1 &&
+                  fwrite(roomCounts, sizeof(int), usageHeader.roomCount + 1, file) ==
+                          (size_t) usageHeader.roomCount + 1 &&
+                  (usageHeader.dayCount == NO_DAYS ||
+                   fwrite(dayCounts, sizeof(int), usageHeader.dayCount, file) == (size_t) usageHeader.dayCount);
+
+    written = written && flushToDisk(file);
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing room_usage.tmp");
+        remove(USAGE_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(USAGE_TEMP, USAGE_FILE))
+    {
+        perror("Error renaming room_usage.tmp to room_usage.dat");
+        remove(USAGE_TEMP);
+        return 0;
+    }
+
+    return 1;
+}
@@ -0,0 +1,55 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the room usage counters. Usage is kept as a
+ *          binary file of per-room totals plus per-day totals, so reports
+ *          read a fixed-size summary instead of the whole usage history.
+ */
+
+#ifndef ROOM_USAGE_H
+#define ROOM_USAGE_H
+
+#include <time.h>
+
+/*
+ * Function: initializeRoomUsage
+ * -----------------------------
+ * Loads the counters from room_usage.dat. If that file does not exist yet
+ * but the old room_usage.txt log does, the log is imported once; otherwise a
+ * missing or unreadable file is rebuilt from discharged_patients.dat.
+ */
+void initializeRoomUsage(void);
+
+/*
+ * Function: recordRoomUsage
+ * -------------------------
+ * Counts one use of each listed room on the day of the given time and saves
+ * the counters. The file is written to a temporary file, synced and renamed
+ * over room_usage.dat, so it never holds a partially applied update.
+ *
+ * roomNumbers: The rooms that were used (one entry per use)
+ * count: Number of entries in roomNumbers
+ * usedAt: When the rooms were used (the discharge time)
+ *
+ * Returns: 1 if the counters were saved, 0 otherwise
+ */
+int recordRoomUsage(const int roomNumbers[], int count, time_t usedAt);
+
+/*
+ * Function: roomUsageCount
+ * ------------------------
+ * roomNumber: The room to look up
+ *
+ * Returns: How many times the room has been used, or 0 if it has no counter
+ */
+int roomUsageCount(int roomNumber);
+
+/*
+ * Function: displayRoomUsageReport
+ * --------------------------------
+ * Displays a report summarizing how many times each room was used,
+ * plus the number of room uses for each of the last seven days.
+ */
+void displayRoomUsageReport(void);
+
+#endif // ROOM_USAGE_H
@@ -0,0 +1,759 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the automatic roster generator.
+ *          The shifts of the chosen weeks, plus two days on either side, are
+ *          numbered in time order. Each doctor has a bitset of the shifts they
+ *          hold and a bitset of the shifts they cannot take, and each shift
+ *          has a list of the shifts too close to it to leave the minimum rest.
+ *          A doctor can take a shift when neither bitset blocks it, none of
+ *          its close shifts is set in their busy bitset and they are under
+ *          the weekly limit. Shifts overlapping a doctor's on-call block, or
+ *          closer to one than the minimum rest, are marked unavailable.
+ *
+ *          Open shifts are filled most-constrained first (the shift with the
+ *          fewest doctors able to take it), each going to the least loaded
+ *          doctor who can. Only the shifts near a filled one are re-counted.
+ *          A local search then moves shifts from busier to less busy doctors
+ *          until the loads are as even as the constraints allow.
+ *
+ *          unavailability.cfg holds one line per absence:
+ *              doctor ID, first day off (YYYY-MM-DD), last day off
+ */
+
+#include "roster.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "doctor_data.h"
+#include "oncall.h"
+#include "schedule_store.h"
+#include "utils.h"
+
+// Private constants
+#define BITS_PER_WORD 64
+#define CONFIG_LINE_LENGTH 128
+#define DATE_TEXT_LENGTH 11
+#define MAX_LISTED_UNCOVERED 20
+
+static const int   DAYS_PER_WEEK       = 7;
+static const int   MARGIN_DAYS         = 2;
+static const int   MINUTES_PER_DAY     = 24 * 60;
+static const int   MINUTES_PER_HOUR    = 60;
+static const long  SECONDS_PER_MINUTE  = 60;
+static const int   MAX_WEEKS           = 52;
+static const int   MAX_REST_HOURS      = 24;
+static const int   MAX_BALANCE_PASSES  = 100;
+static const int   NO_HOLDER           = -1;
+static const char *UNAVAILABILITY_FILE = "unavailability.cfg";
+
+/*
+ * One shift of the roster. start and end are minutes since day 0. Shifts in
+ * the margin days have week set to -1 and are only used for rest checks.
+ */
+typedef struct
+{
+    int  dayNumber;
+    int  shiftIndex;
+    long start;
+    long end;
+    int  week;
+    int  holder;
+    int  fixed;
+    int  covered;
+} RosterSlot;
+
+/*
+ * A doctor's constraints and the shifts they hold. load counts their shifts
+ * inside the roster weeks, including the ones assigned before generation.
+ */
+typedef struct
+{
+    int       doctorId;
+    uint64_t *busy;
+    uint64_t *unavailable;
+    int      *weekShifts;
+    int       load;
+} RosterDoctor;
+
+static RosterSlot   *slots         = NULL;
+static int           slotCount     = 0;
+static int          *conflictStart = NULL;
+static int          *conflicts     = NULL;
+static RosterDoctor *doctors       = NULL;
+static int           doctorCount   = 0;
+static int           wordCount     = 0;
+static int           weekCount     = 0;
+static int           maxPerWeek    = 0;
+static long          restMinutes   = 0;
+
+// Function prototypes for internal helper functions
+static int  buildRoster(int firstDay);
+static int  buildConflicts(void);
+static void loadUnavailability(int firstDay, int lastDay);
+static void markOnCall(void);
+static int  fillOpenSlots(void);
+static int  countCandidates(int slot);
+static int  pickDoctor(int slot);
+static int  balanceLoads(void);
+static int  isFeasible(int doctor, int slot);
+static int  isOpen(int slot);
+static void takeSlot(int slot, int doctor);
+static void releaseSlot(int slot);
+static int  findDoctorPosition(int doctorId);
+static void printRosterSummary(int firstDay, int filled, int open, double milliseconds);
+static int  saveRoster(void);
+static void freeRoster(void);
+static void formatDate(int dayNumber, char dateStr[], size_t size);
+static void setBit(uint64_t bits[], int bit, int value);
+static int  testBit(const uint64_t bits[], int bit);
+
+/*
+ * Prompts for the roster settings, generates the roster and saves it once
+ * the user confirms it.
+ */
+void generateRoster(void)
+{
+    if(getDoctorCount() == 0)
+    {
+        puts("There are no doctors in the registry.");
+        return;
+    }
+
+    int    today    = toDayNumber(time(NULL));
+    int    nextWeek = today - dayOfWeek(today) + DAYS_PER_WEEK;
+    time_t weekOf   = promptDateTime("Enter a date in the first week to fill (YYYY-MM-DD, Enter for next week):\n",
+                                     dayNumberToTime(nextWeek));
+    int    firstDay = toDayNumber(weekOf) - dayOfWeek(toDayNumber(weekOf));
+
+    weekCount   = promptNumber("Number of weeks to fill (1-52):\n", 1, MAX_WEEKS);
+    maxPerWeek  = promptNumber("Maximum shifts per doctor per week:\n", 1, DAYS_PER_WEEK * scheduleShiftCount());
+    restMinutes = (long) promptNumber("Minimum rest between shifts in hours (0-24):\n", 0, MAX_REST_HOURS) *
+                  MINUTES_PER_HOUR;
+
+    clock_t started = clock();
+
+    if(!buildRoster(firstDay) || !buildConflicts())
+    {
+        puts("Error: Not enough memory to generate the roster.");
+        freeRoster();
+        return;
+    }
+
+    loadUnavailability(firstDay, firstDay + weekCount * DAYS_PER_WEEK - 1);
+    markOnCall();
+
+    int open = 0;
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        open += isOpen(slot);
+    }
+
+    fillOpenSlots();
+    if(balanceLoads() > 0)
+    {
+        // Moving shifts between doctors can free someone for a shift that was left open
+        fillOpenSlots();
+    }
+
+    int filled = 0;
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        filled += slots[slot].week >= 0 && !slots[slot].fixed && slots[slot].holder != NO_HOLDER;
+    }
+
+    double milliseconds = 1000.0 * (double) (clock() - started) / CLOCKS_PER_SEC;
+    printRosterSummary(firstDay, filled, open, milliseconds);
+
+    if(filled > 0)
+    {
+        char confirm;
+
+        do
+        {
+            printf("Save this roster? (y/n)\n");
+            scanf(" %c", &confirm);
+            clearInputBuffer();
+        }
+        while(confirm != YES && confirm != NO);
+
+        if(confirm == YES)
+        {
+            if(saveRoster() == filled)
+            {
+                printf("\nRoster saved: %d shifts assigned.\n", filled);
+            }
+            else
+            {
+                puts("\nError saving the roster to the schedule.");
+            }
+        }
+    }
+
+    freeRoster();
+}
+
+/*
+ * Lays out the shifts of the roster weeks and margin days and loads the
+ * existing assignments. Returns 0 if memory runs out.
+ */
+static int buildRoster(int firstDay)
+{
+    int shiftCount = scheduleShiftCount();
+    int dayCount   = weekCount * DAYS_PER_WEEK + 2 * MARGIN_DAYS;
+
+    slotCount   = dayCount * shiftCount;
+    wordCount   = (slotCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    doctorCount = getDoctorCount();
+    slots       = calloc(slotCount, sizeof(RosterSlot));
+    doctors     = calloc(doctorCount, sizeof(RosterDoctor));
+
+    if(slots == NULL || doctors == NULL)
+    {
+        return 0;
+    }
+
+    for(int doctor = 0; doctor < doctorCount; doctor++)
+    {
+        doctors[doctor].doctorId    = getDoctorAt(doctor)->id;
+        doctors[doctor].busy        = calloc(wordCount, sizeof(uint64_t));
+        doctors[doctor].unavailable = calloc(wordCount, sizeof(uint64_t));
+        doctors[doctor].weekShifts  = calloc(weekCount, sizeof(int));
+
+        if(doctors[doctor].busy == NULL || doctors[doctor].unavailable == NULL || doctors[doctor].weekShifts == NULL)
+        {
+            return 0;
+        }
+    }
+
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        RosterSlot            *entry  = &slots[slot];
+        int                    day    = slot / shiftCount - MARGIN_DAYS;
+        const ShiftDefinition *shift;
+
+        entry->dayNumber  = firstDay + day;
+        entry->shiftIndex = slot % shiftCount;
+        shift             = scheduleShift(entry->shiftIndex);
+        entry->start      = (long) (day + MARGIN_DAYS) * MINUTES_PER_DAY + shift->startMinute;
+        entry->end        = entry->start + shift->lengthMinutes;
+        entry->week       = (day >= 0 && day < weekCount * DAYS_PER_WEEK) ? day / DAYS_PER_WEEK : -1;
+        entry->holder     = NO_HOLDER;
+
+        int doctorId = scheduleDoctorAt(entry->dayNumber, entry->shiftIndex);
+        if(doctorId != NO_DOCTOR_ASSIGNED)
+        {
+            int doctor = findDoctorPosition(doctorId);
+
+            entry->fixed   = 1;
+            entry->covered = 1;
+            if(doctor != NO_HOLDER)
+            {
+                takeSlot(slot, doctor);
+            }
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Lists, for every shift, the other shifts that overlap it or end or start
+ * less than the minimum rest away from it.
+ */
+static int buildConflicts(void)
+{
+    int shiftCount = scheduleShiftCount();
+    int window     = MARGIN_DAYS * shiftCount;
+    int capacity   = slotCount * (2 * window + shiftCount);
+
+    conflictStart = malloc((slotCount + 1) * sizeof(int));
+    conflicts     = malloc((capacity + 1) * sizeof(int));
+
+    if(conflictStart == NULL || conflicts == NULL)
+    {
+        return 0;
+    }
+
+    int count = 0;
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        int dayStart = slot - slot % shiftCount;
+        int first    = dayStart - window < 0 ? 0 : dayStart - window;
+        int last     = dayStart + shiftCount + window > slotCount ? slotCount : dayStart + shiftCount + window;
+
+        conflictStart[slot] = count;
+        for(int other = first; other < last; other++)
+        {
+            if(other != slot && slots[other].start < slots[slot].end + restMinutes &&
+               slots[slot].start < slots[other].end + restMinutes)
+            {
+                conflicts[count++] = other;
+            }
+        }
+    }
+    conflictStart[slotCount] = count;
+
+    return 1;
+}
+
+/*
+ * Marks the shifts on each listed day off as unavailable to the doctor.
+ */
+static void loadUnavailability(int firstDay, int lastDay)
+{
+    FILE *file = fopen(UNAVAILABILITY_FILE, "r");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    char line[CONFIG_LINE_LENGTH];
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        char   fromText[DATE_TEXT_LENGTH];
+        char   toText[DATE_TEXT_LENGTH];
+        int    doctorId;
+        time_t from, to;
+
+        if(line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0')
+        {
+            continue;
+        }
+
+        if(sscanf(line, " %d , %10[^, ] , %10s", &doctorId, fromText, toText) != 3 ||
+           !parseDateTime(fromText, &from) || !parseDateTime(toText, &to))
+        {
+            printf("Warning: Ignoring invalid line in unavailability.cfg: %s", line);
+            continue;
+        }
+
+        int doctor = findDoctorPosition(doctorId);
+        if(doctor == NO_HOLDER)
+        {
+            printf("Warning: unavailability.cfg lists unknown doctor %d.\n", doctorId);
+            continue;
+        }
+
+        int fromDay = toDayNumber(from) < firstDay ? firstDay : toDayNumber(from);
+        int toDay   = toDayNumber(to) > lastDay ? lastDay : toDayNumber(to);
+
+        for(int slot = 0; slot < slotCount; slot++)
+        {
+            if(slots[slot].dayNumber >= fromDay && slots[slot].dayNumber <= toDay)
+            {
+                setBit(doctors[doctor].unavailable, slot, 1);
+            }
+        }
+    }
+
+    fclose(file);
+}
+
+/*
+ * Marks the roster shifts that overlap a doctor's on-call block, or leave
+ * less than the longer of the roster's and the on-call minimum rest next to
+ * one, as unavailable to the doctor.
+ */
+static void markOnCall(void)
+{
+    long restSeconds = restMinutes * SECONDS_PER_MINUTE;
+
+    if(restSeconds < ONCALL_MIN_REST_HOURS * MINUTES_PER_HOUR * SECONDS_PER_MINUTE)
+    {
+        restSeconds = ONCALL_MIN_REST_HOURS * MINUTES_PER_HOUR * SECONDS_PER_MINUTE;
+    }
+
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        const ShiftDefinition *shift = scheduleShift(slots[slot].shiftIndex);
+        time_t start = dayNumberToTime(slots[slot].dayNumber) + (time_t) shift->startMinute * SECONDS_PER_MINUTE;
+        time_t end   = start + (time_t) shift->lengthMinutes * SECONDS_PER_MINUTE;
+
+        if(slots[slot].week < 0)
+        {
+            continue;
+        }
+
+        for(int doctor = 0; doctor < doctorCount; doctor++)
+        {
+            if(isDoctorOnCall(doctors[doctor].doctorId, start - restSeconds, end + restSeconds))
+            {
+                setBit(doctors[doctor].unavailable, slot, 1);
+            }
+        }
+    }
+}
+
+/*
+ * Fills open shifts, always taking next the one with the fewest doctors able
+ * to work it. Returns the number of shifts filled.
+ */
+static int fillOpenSlots(void)
+{
+    int  *candidates = malloc(slotCount * sizeof(int));
+    char *stuck      = calloc(slotCount, sizeof(char));
+    int   filled     = 0;
+
+    if(candidates == NULL || stuck == NULL)
+    {
+        free(candidates);
+        free(stuck);
+        return 0;
+    }
+
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        candidates[slot] = isOpen(slot) ? countCandidates(slot) : 0;
+    }
+
+    while(1)
+    {
+        int best = NO_HOLDER;
+
+        for(int slot = 0; slot < slotCount; slot++)
+        {
+            if(isOpen(slot) && !stuck[slot] && (best == NO_HOLDER || candidates[slot] < candidates[best]))
+            {
+                best = slot;
+            }
+        }
+
+        if(best == NO_HOLDER)
+        {
+            break;
+        }
+
+        if(candidates[best] == 0)
+        {
+            stuck[best] = 1;
+            continue;
+        }
+
+        takeSlot(best, pickDoctor(best));
+        filled++;
+
+        // Only the close shifts and the rest of the same week can have lost a candidate
+        int shiftCount = scheduleShiftCount();
+        int weekStart  = (MARGIN_DAYS + slots[best].week * DAYS_PER_WEEK) * shiftCount;
+
+        for(int i = conflictStart[best]; i < conflictStart[best + 1]; i++)
+        {
+            if(isOpen(conflicts[i]))
+            {
+                candidates[conflicts[i]] = countCandidates(conflicts[i]);
+            }
+        }
+        for(int slot = weekStart; slot < weekStart + DAYS_PER_WEEK * shiftCount; slot++)
+        {
+            if(isOpen(slot))
+            {
+                candidates[slot] = countCandidates(slot);
+            }
+        }
+    }
+
+    free(candidates);
+    free(stuck);
+    return filled;
+}
+
+/*
+ * Returns the number of doctors who could take a shift.
+ */
+static int countCandidates(int slot)
+{
+    int count = 0;
+
+    for(int doctor = 0; doctor < doctorCount; doctor++)
+    {
+        count += isFeasible(doctor, slot);
+    }
+
+    return count;
+}
+
+/*
+ * Returns the doctor who should take a shift: the one with the fewest
+ * shifts overall, then the fewest that week. The shift must have a candidate.
+ */
+static int pickDoctor(int slot)
+{
+    int best = NO_HOLDER;
+    int week = slots[slot].week;
+
+    for(int doctor = 0; doctor < doctorCount; doctor++)
+    {
+        if(!isFeasible(doctor, slot))
+        {
+            continue;
+        }
+
+        if(best == NO_HOLDER || doctors[doctor].load < doctors[best].load ||
+           (doctors[doctor].load == doctors[best].load &&
+            doctors[doctor].weekShifts[week] < doctors[best].weekShifts[week]))
+        {
+            best = doctor;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Moves generated shifts from a doctor to one with at least two fewer
+ * shifts whenever the constraints allow. Each move lowers the sum of the
+ * squared loads, so the search always ends. Returns the number of moves.
+ */
+static int balanceLoads(void)
+{
+    int moves = 0;
+
+    for(int pass = 0; pass < MAX_BALANCE_PASSES; pass++)
+    {
+        int moved = 0;
+
+        for(int slot = 0; slot < slotCount; slot++)
+        {
+            if(slots[slot].fixed || slots[slot].holder == NO_HOLDER)
+            {
+                continue;
+            }
+
+            int holder = slots[slot].holder;
+            int best   = NO_HOLDER;
+
+            for(int doctor = 0; doctor < doctorCount; doctor++)
+            {
+                if(doctors[doctor].load + 1 < doctors[holder].load && isFeasible(doctor, slot) &&
+                   (best == NO_HOLDER || doctors[doctor].load < doctors[best].load))
+                {
+                    best = doctor;
+                }
+            }
+
+            if(best != NO_HOLDER)
+            {
+                releaseSlot(slot);
+                takeSlot(slot, best);
+                moved++;
+            }
+        }
+
+        moves += moved;
+        if(moved == 0)
+        {
+            break;
+        }
+    }
+
+    return moves;
+}
+
+/*
+ * Returns 1 if the doctor could take the shift.
+ */
+static int isFeasible(int doctor, int slot)
+{
+    const RosterDoctor *entry = &doctors[doctor];
+    int                 week  = slots[slot].week;
+
+    if(testBit(entry->unavailable, slot) || testBit(entry->busy, slot) ||
+       (week >= 0 && entry->weekShifts[week] >= maxPerWeek))
+    {
+        return 0;
+    }
+
+    for(int i = conflictStart[slot]; i < conflictStart[slot + 1]; i++)
+    {
+        if(testBit(entry->busy, conflicts[i]))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Returns 1 if a shift is inside the roster weeks and still needs a doctor.
+ */
+static int isOpen(int slot)
+{
+    return slots[slot].week >= 0 && !slots[slot].covered && slots[slot].holder == NO_HOLDER;
+}
+
+/*
+ * Gives a shift to a doctor.
+ */
+static void takeSlot(int slot, int doctor)
+{
+    RosterDoctor *entry = &doctors[doctor];
+
+    setBit(entry->busy, slot, 1);
+    slots[slot].holder = doctor;
+
+    if(slots[slot].week >= 0)
+    {
+        entry->load++;
+        entry->weekShifts[slots[slot].week]++;
+    }
+}
+
+/*
+ * Takes a shift back from its doctor.
+ */
+static void releaseSlot(int slot)
+{
+    RosterDoctor *entry = &doctors[slots[slot].holder];
+
+    setBit(entry->busy, slot, 0);
+    slots[slot].holder = NO_HOLDER;
+
+    if(slots[slot].week >= 0)
+    {
+        entry->load--;
+        entry->weekShifts[slots[slot].week]--;
+    }
+}
+
+/*
+ * Returns a doctor's position in the roster, or NO_HOLDER if they are not
+ * in the registry.
+ */
+static int findDoctorPosition(int doctorId)
+{
+    for(int doctor = 0; doctor < doctorCount; doctor++)
+    {
+        if(doctors[doctor].doctorId == doctorId)
+        {
+            return doctor;
+        }
+    }
+
+    return NO_HOLDER;
+}
+
+/*
+ * Prints how many shifts were filled, the shifts left open and each
+ * doctor's shifts over the roster weeks.
+ */
+static void printRosterSummary(int firstDay, int filled, int open, double milliseconds)
+{
+    char fromStr[DATE_TEXT_LENGTH];
+    char toStr[DATE_TEXT_LENGTH];
+    int  listed = 0;
+
+    formatDate(firstDay, fromStr, sizeof(fromStr));
+    formatDate(firstDay + weekCount * DAYS_PER_WEEK - 1, toStr, sizeof(toStr));
+    printf("\nRoster for %s to %s: filled %d of %d open shifts in %.1f ms.\n", fromStr, toStr, filled, open,
+           milliseconds);
+
+    if(filled < open)
+    {
+        printf("%d shifts could not be covered:\n", open - filled);
+        for(int slot = 0; slot < slotCount && listed < MAX_LISTED_UNCOVERED; slot++)
+        {
+            if(isOpen(slot))
+            {
+                formatDate(slots[slot].dayNumber, fromStr, sizeof(fromStr));
+                printf("  %s %s\n", fromStr, scheduleShift(slots[slot].shiftIndex)->name);
+                listed++;
+            }
+        }
+        if(open - filled > listed)
+        {
+            printf("  ... and %d more\n", open - filled - listed);
+        }
+    }
+
+    printf("%-30sShifts\n", "Doctor");
+    for(int doctor = 0; doctor < doctorCount; doctor++)
+    {
+        printf("Dr.%-27s%d\n", getDoctorWithId(doctors[doctor].doctorId)->name, doctors[doctor].load);
+    }
+}
+
+/*
+ * Writes the generated shifts to the schedule as one batch.
+ * Returns the number of shifts saved.
+ */
+static int saveRoster(void)
+{
+    scheduleBeginBatch();
+
+    for(int slot = 0; slot < slotCount; slot++)
+    {
+        const RosterSlot *entry = &slots[slot];
+
+        if(entry->week >= 0 && !entry->fixed && entry->holder != NO_HOLDER &&
+           !scheduleBatchAssign(entry->dayNumber, entry->shiftIndex, doctors[entry->holder].doctorId))
+        {
+            scheduleCancelBatch();
+            return 0;
+        }
+    }
+
+    return scheduleCommitBatch();
+}
+
+/*
+ * Releases everything allocated for the roster.
+ */
+static void freeRoster(void)
+{
+    for(int doctor = 0; doctors != NULL && doctor < doctorCount; doctor++)
+    {
+        free(doctors[doctor].busy);
+        free(doctors[doctor].unavailable);
+        free(doctors[doctor].weekShifts);
+    }
+
+    free(doctors);
+    free(slots);
+    free(conflictStart);
+    free(conflicts);
+
+    doctors       = NULL;
+    slots         = NULL;
+    conflictStart = NULL;
+    conflicts     = NULL;
+    doctorCount   = 0;
+    slotCount     = 0;
+}
+
+/*
+ * Formats a day number as YYYY-MM-DD.
+ */
+static void formatDate(int dayNumber, char dateStr[], size_t size)
+{
+    time_t midnight = dayNumberToTime(dayNumber);
+    strftime(dateStr, size, "%Y-%m-%d", localtime(&midnight));
+}
+
+/*
+ * Sets or clears one bit.
+ */
+static void setBit(uint64_t bits[], int bit, int value)
+{
+    uint64_t mask = (uint64_t) 1 << (bit % BITS_PER_WORD);
+
+    if(value)
+    {
+        bits[bit / BITS_PER_WORD] |= mask;
+    }
+    else
+    {
+        bits[bit / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+/*
+ * Returns 1 if a bit is set.
+ */
+static int testBit(const uint64_t bits[], int bit)
+{
+    return (bits[bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) & 1;
+}
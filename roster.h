@@ -0,0 +1,24 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the automatic roster generator. It fills the
+ *          unassigned shifts of a range of weeks from the doctor registry
+ *          while respecting a weekly shift limit, a minimum rest period
+ *          between shifts, the days off listed in unavailability.cfg and an
+ *          even spread of shifts across doctors.
+ */
+
+#ifndef ROSTER_H
+#define ROSTER_H
+
+/*
+ * Function: generateRoster
+ * ------------------------
+ * Prompts for the first week, the number of weeks, the weekly shift limit
+ * and the minimum rest in hours, then fills every open shift it can.
+ * Shifts that are already assigned are kept. The result is summarised
+ * and, if confirmed, saved to the schedule as a single batch.
+ */
+void generateRoster(void);
+
+#endif // ROSTER_H
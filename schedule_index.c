@@ -0,0 +1,449 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the bitset indexes over the calendar schedule.
+ *          Bit (day - firstDay) * shiftCount + shift stands for one slot, the
+ *          same order the store keeps its slots in, so a range of days is a
+ *          contiguous range of bits. covered has a bit set for every assigned
+ *          slot and each doctor has a bitset of the slots they hold; a
+ *          quarter of three daily shifts is only five 64-bit words.
+ *
+ *          Each doctor also has a Fenwick tree of shifts per day, so the
+ *          shifts in any range of days are two prefix sums, O(log days).
+ */
+
+#include "schedule_index.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "schedule_store.h"
+#include "utils.h"
+
+// Private constants
+#define BITS_PER_WORD 64
+
+static const int MINUTES_PER_DAY    = 24 * 60;
+static const int SECONDS_PER_MINUTE = 60;
+
+/*
+ * The slots held by one doctor. dayTree is a Fenwick tree (1-based) over
+ * the number of shifts the doctor works on each indexed day.
+ */
+typedef struct
+{
+    int       doctorId;
+    uint64_t *bits;
+    int      *dayTree;
+} DoctorBits;
+
+static uint64_t   *covered     = NULL;
+static DoctorBits *doctorBits  = NULL;
+static int         doctorCount = 0;
+static int         wordCount   = 0;
+static int         firstDay    = 0;
+static int         dayCount    = 0;
+static int         shiftCount  = 0;
+
+// Function prototypes for internal helper functions
+static DoctorBits *findDoctorBits(int doctorId, int create);
+static long        bitIndex(int dayNumber, int shiftIndex);
+static uint64_t    rangeMask(long word, long firstBit, long lastBit);
+static int         clampRange(int *first, int *last);
+static void        addWholeDays(int first, int last, ScheduleSlot found[], int maxFound, int *count);
+static void        addToDay(int dayTree[], int day, int delta);
+static int         shiftsUpToDay(const int dayTree[], int day);
+static int         lowestSetBit(uint64_t word);
+static void        setBit(uint64_t bits[], long bit, int value);
+static int         testBit(const uint64_t bits[], long bit);
+static void        freeScheduleIndex(void);
+
+/*
+ * Rebuilds the coverage and doctor bitsets from the stored slots.
+ */
+void rebuildScheduleIndex(void)
+{
+    freeScheduleIndex();
+
+    firstDay   = scheduleFirstDay();
+    dayCount   = scheduleDayCount();
+    shiftCount = scheduleShiftCount();
+    wordCount  = (int) (((long) dayCount * shiftCount + BITS_PER_WORD - 1) / BITS_PER_WORD);
+
+    covered = calloc(wordCount + 1, sizeof(uint64_t));
+    if(covered == NULL)
+    {
+        puts("Error: Not enough memory for the schedule index.");
+        return;
+    }
+
+    for(int day = 0; day < dayCount; day++)
+    {
+        for(int shiftIndex = 0; shiftIndex < shiftCount; shiftIndex++)
+        {
+            updateScheduleIndex(firstDay + day, shiftIndex, NO_DOCTOR_ASSIGNED,
+                                scheduleDoctorAt(firstDay + day, shiftIndex));
+        }
+    }
+}
+
+/*
+ * Clears the slot's bit for the old doctor and sets it for the new one.
+ */
+void updateScheduleIndex(int dayNumber, int shiftIndex, int oldDoctorId, int newDoctorId)
+{
+    long bit = bitIndex(dayNumber, shiftIndex);
+    if(bit < 0)
+    {
+        return;
+    }
+
+    DoctorBits *oldBits = findDoctorBits(oldDoctorId, 0);
+    DoctorBits *newBits = findDoctorBits(newDoctorId, 1);
+
+    if(oldBits != NULL && testBit(oldBits->bits, bit))
+    {
+        setBit(oldBits->bits, bit, 0);
+        addToDay(oldBits->dayTree, dayNumber - firstDay, -1);
+    }
+    if(newBits != NULL && !testBit(newBits->bits, bit))
+    {
+        setBit(newBits->bits, bit, 1);
+        addToDay(newBits->dayTree, dayNumber - firstDay, 1);
+    }
+
+    setBit(covered, bit, newDoctorId != NO_DOCTOR_ASSIGNED);
+}
+
+/*
+ * Counts the doctor's shifts in the range as the difference of two prefix sums.
+ */
+int countDoctorSlots(int doctorId, int first, int last)
+{
+    DoctorBits *entry = findDoctorBits(doctorId, 0);
+
+    if(entry == NULL || !clampRange(&first, &last))
+    {
+        return 0;
+    }
+
+    return shiftsUpToDay(entry->dayTree, last - firstDay) - shiftsUpToDay(entry->dayTree, first - firstDay - 1);
+}
+
+/*
+ * Walks the clear bits of the coverage bitset in the range. Days before or
+ * after the stored range have no assignments, so all of their slots count.
+ */
+int findUncoveredSlots(int first, int last, ScheduleSlot found[], int maxFound)
+{
+    int count       = 0;
+    int storedFirst = first;
+    int storedLast  = last;
+
+    if(!clampRange(&storedFirst, &storedLast))
+    {
+        addWholeDays(first, last, found, maxFound, &count);
+        return count;
+    }
+
+    addWholeDays(first, storedFirst - 1, found, maxFound, &count);
+
+    long firstBit = bitIndex(storedFirst, 0);
+    long lastBit  = bitIndex(storedLast, shiftCount - 1);
+
+    for(long word = firstBit / BITS_PER_WORD; word <= lastBit / BITS_PER_WORD; word++)
+    {
+        uint64_t gaps = ~covered[word] & rangeMask(word, firstBit, lastBit);
+
+        while(gaps != 0)
+        {
+            long bit = word * BITS_PER_WORD + lowestSetBit(gaps);
+
+            if(found != NULL && count < maxFound)
+            {
+                found[count].dayNumber  = firstDay + (int) (bit / shiftCount);
+                found[count].shiftIndex = (int) (bit % shiftCount);
+            }
+            count++;
+            gaps &= gaps - 1;
+        }
+    }
+
+    addWholeDays(storedLast + 1, last, found, maxFound, &count);
+    return count;
+}
+
+/*
+ * Tests the doctor's bits for every shift on the day before, the day itself
+ * and the day after whose hours overlap the requested shift.
+ */
+int isDoctorFree(int doctorId, int dayNumber, int shiftIndex)
+{
+    const ShiftDefinition *shift = scheduleShift(shiftIndex);
+    DoctorBits            *entry = findDoctorBits(doctorId, 0);
+
+    if(shift == NULL || entry == NULL)
+    {
+        return shift != NULL;
+    }
+
+    long start = (long) dayNumber * MINUTES_PER_DAY + shift->startMinute;
+    long end   = start + shift->lengthMinutes;
+
+    for(int day = dayNumber - 1; day <= dayNumber + 1; day++)
+    {
+        for(int other = 0; other < shiftCount; other++)
+        {
+            const ShiftDefinition *otherShift = scheduleShift(other);
+            long                   otherStart = (long) day * MINUTES_PER_DAY + otherShift->startMinute;
+            long                   otherEnd   = otherStart + otherShift->lengthMinutes;
+            long                   bit        = bitIndex(day, other);
+
+            if(bit >= 0 && otherStart < end && start < otherEnd && testBit(entry->bits, bit))
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Checks the shifts of the current and previous day against the minute of
+ * the day, since an evening shift can run into the next morning.
+ */
+int findOnDutySlots(time_t when, ScheduleSlot found[], int maxFound)
+{
+    int  today  = toDayNumber(when);
+    long minute = (long) (difftime(when, dayNumberToTime(today)) / SECONDS_PER_MINUTE);
+    int  count  = 0;
+
+    for(int day = today - 1; day <= today; day++)
+    {
+        long offset = (long) (today - day) * MINUTES_PER_DAY;
+
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount() && count < maxFound; shiftIndex++)
+        {
+            const ShiftDefinition *shift = scheduleShift(shiftIndex);
+
+            if(shift->startMinute <= minute + offset && minute + offset < shift->startMinute + shift->lengthMinutes)
+            {
+                found[count].dayNumber  = day;
+                found[count].shiftIndex = shiftIndex;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Returns a doctor's bitset, adding an empty one when create is set.
+ * Returns NULL for NO_DOCTOR_ASSIGNED or an unknown doctor.
+ */
+static DoctorBits *findDoctorBits(int doctorId, int create)
+{
+    if(doctorId == NO_DOCTOR_ASSIGNED)
+    {
+        return NULL;
+    }
+
+    for(int i = 0; i < doctorCount; i++)
+    {
+        if(doctorBits[i].doctorId == doctorId)
+        {
+            return &doctorBits[i];
+        }
+    }
+
+    if(!create || covered == NULL)
+    {
+        return NULL;
+    }
+
+    DoctorBits *newEntries = realloc(doctorBits, (doctorCount + 1) * sizeof(DoctorBits));
+    if(newEntries == NULL)
+    {
+        puts("Error: Not enough memory for the schedule index.");
+        return NULL;
+    }
+    doctorBits = newEntries;
+
+    DoctorBits *entry = &doctorBits[doctorCount];
+    entry->doctorId   = doctorId;
+    entry->bits       = calloc(wordCount + 1, sizeof(uint64_t));
+    entry->dayTree    = calloc(dayCount + 1, sizeof(int));
+
+    if(entry->bits == NULL || entry->dayTree == NULL)
+    {
+        puts("Error: Not enough memory for the schedule index.");
+        free(entry->bits);
+        free(entry->dayTree);
+        return NULL;
+    }
+
+    doctorCount++;
+    return entry;
+}
+
+/*
+ * Returns the bit of a slot, or -1 if the slot is outside the indexed range.
+ */
+static long bitIndex(int dayNumber, int shiftIndex)
+{
+    int day = dayNumber - firstDay;
+
+    if(covered == NULL || day < 0 || day >= dayCount || shiftIndex < 0 || shiftIndex >= shiftCount)
+    {
+        return -1;
+    }
+
+    return (long) day * shiftCount + shiftIndex;
+}
+
+/*
+ * Returns the bits of a word that lie between firstBit and lastBit.
+ */
+static uint64_t rangeMask(long word, long firstBit, long lastBit)
+{
+    uint64_t mask = ~(uint64_t) 0;
+    long     base = word * BITS_PER_WORD;
+
+    if(firstBit > base)
+    {
+        mask &= ~(uint64_t) 0 << (firstBit - base);
+    }
+    if(lastBit < base + BITS_PER_WORD - 1)
+    {
+        mask &= ~(uint64_t) 0 >> (BITS_PER_WORD - 1 - (lastBit - base));
+    }
+
+    return mask;
+}
+
+/*
+ * Narrows a range of days to the indexed days. Returns 0 if none remain.
+ */
+static int clampRange(int *first, int *last)
+{
+    if(*first < firstDay)
+    {
+        *first = firstDay;
+    }
+    if(*last > firstDay + dayCount - 1)
+    {
+        *last = firstDay + dayCount - 1;
+    }
+
+    return covered != NULL && *first <= *last;
+}
+
+/*
+ * Adds every slot of the days from first to last to found[].
+ */
+static void addWholeDays(int first, int last, ScheduleSlot found[], int maxFound, int *count)
+{
+    for(int dayNumber = first; dayNumber <= last; dayNumber++)
+    {
+        for(int shiftIndex = 0; shiftIndex < scheduleShiftCount(); shiftIndex++)
+        {
+            if(found != NULL && *count < maxFound)
+            {
+                found[*count].dayNumber  = dayNumber;
+                found[*count].shiftIndex = shiftIndex;
+            }
+            (*count)++;
+        }
+    }
+}
+
+/*
+ * Adds delta to the shift count of a day (0-based within the index).
+ */
+static void addToDay(int dayTree[], int day, int delta)
+{
+    for(int node = day + 1; node <= dayCount; node += node & -node)
+    {
+        dayTree[node] += delta;
+    }
+}
+
+/*
+ * Returns the shifts on days 0..day, or 0 when day is negative.
+ */
+static int shiftsUpToDay(const int dayTree[], int day)
+{
+    int total = 0;
+
+    for(int node = day + 1; node > 0; node -= node & -node)
+    {
+        total += dayTree[node];
+    }
+
+    return total;
+}
+
+/*
+ * Returns the position of the lowest set bit of a non-zero word.
+ */
+static int lowestSetBit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int position = 0;
+    while(!(word & 1))
+    {
+        word >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
+
+/*
+ * Sets or clears one bit.
+ */
+static void setBit(uint64_t bits[], long bit, int value)
+{
+    uint64_t mask = (uint64_t) 1 << (bit % BITS_PER_WORD);
+
+    if(value)
+    {
+        bits[bit / BITS_PER_WORD] |= mask;
+    }
+    else
+    {
+        bits[bit / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+/*
+ * Returns 1 if a bit is set.
+ */
+static int testBit(const uint64_t bits[], long bit)
+{
+    return (bits[bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) & 1;
+}
+
+/*
+ * Releases every bitset.
+ */
+static void freeScheduleIndex(void)
+{
+    for(int i = 0; i < doctorCount; i++)
+    {
+        free(doctorBits[i].bits);
+        free(doctorBits[i].dayTree);
+    }
+
+    free(doctorBits);
+    free(covered);
+
+    doctorBits  = NULL;
+    doctorCount = 0;
+    covered     = NULL;
+    wordCount   = 0;
+}
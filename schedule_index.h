@@ -0,0 +1,103 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the bitset indexes over the calendar schedule.
+ *          Every stored (day, shift) slot has one bit in a coverage bitset
+ *          and one bit in the bitset of the doctor assigned to it, so
+ *          coverage gaps and availability are answered with word-wide bit
+ *          operations instead of slot scans. Per-doctor prefix sums over
+ *          days give shift counts for any date range.
+ */
+
+#ifndef SCHEDULE_INDEX_H
+#define SCHEDULE_INDEX_H
+
+#include <time.h>
+
+/*
+ * A (day, shift) slot of the schedule.
+ */
+typedef struct
+{
+    int dayNumber;
+    int shiftIndex;
+} ScheduleSlot;
+
+/*
+ * Function: rebuildScheduleIndex
+ * ------------------------------
+ * Rebuilds every bitset from the schedule store. Called by the store
+ * whenever its range of days changes.
+ */
+void rebuildScheduleIndex(void);
+
+/*
+ * Function: updateScheduleIndex
+ * -----------------------------
+ * Moves one slot from one doctor's bitset to another's. Called by the store
+ * after each slot it writes.
+ *
+ * dayNumber: The calendar day of the slot
+ * shiftIndex: The shift within the day
+ * oldDoctorId: The doctor previously assigned, or NO_DOCTOR_ASSIGNED
+ * newDoctorId: The doctor now assigned, or NO_DOCTOR_ASSIGNED
+ */
+void updateScheduleIndex(int dayNumber, int shiftIndex, int oldDoctorId, int newDoctorId);
+
+/*
+ * Function: countDoctorSlots
+ * --------------------------
+ * Counts a doctor's shifts between two days in O(log days).
+ *
+ * doctorId: The doctor to count
+ * firstDay: The first calendar day, inclusive
+ * lastDay: The last calendar day, inclusive
+ *
+ * Returns: The number of shifts assigned to the doctor
+ */
+int countDoctorSlots(int doctorId, int firstDay, int lastDay);
+
+/*
+ * Function: findUncoveredSlots
+ * ----------------------------
+ * Lists the slots with no doctor assigned between two days, in time order.
+ * Days outside the stored range count as uncovered.
+ *
+ * firstDay: The first calendar day, inclusive
+ * lastDay: The last calendar day, inclusive
+ * found: Receives up to maxFound slots (may be NULL to only count them)
+ * maxFound: Capacity of found[]
+ *
+ * Returns: The total number of uncovered slots, which may exceed maxFound
+ */
+int findUncoveredSlots(int firstDay, int lastDay, ScheduleSlot found[], int maxFound);
+
+/*
+ * Function: isDoctorFree
+ * ----------------------
+ * Checks whether a doctor could work a slot: they hold neither that slot
+ * nor any shift whose hours overlap it.
+ *
+ * doctorId: The doctor to check
+ * dayNumber: The calendar day
+ * shiftIndex: The shift within the day
+ *
+ * Returns: 1 if the doctor is free, 0 otherwise
+ */
+int isDoctorFree(int doctorId, int dayNumber, int shiftIndex);
+
+/*
+ * Function: findOnDutySlots
+ * -------------------------
+ * Finds the shifts running at a moment, including a shift that started on
+ * the previous day and runs past midnight.
+ *
+ * when: The moment to look up
+ * found: Receives up to maxFound slots
+ * maxFound: Capacity of found[]
+ *
+ * Returns: The number of slots stored in found[]
+ */
+int findOnDutySlots(time_t when, ScheduleSlot found[], int maxFound);
+
+#endif // SCHEDULE_INDEX_H
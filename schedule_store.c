@@ -0,0 +1,948 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the calendar schedule store.
+ *          schedule.dat layout (version 1):
+ *              ScheduleHeader
+ *              ShiftDefinition[shiftCount]
+ *              SlotRecord[dayCount][shiftCount]
+ *          Day d of the file is calendar day firstDay + d. Each slot holds a
+ *          doctor ID and a checksum of (day, shift, doctor ID); an all-zero
+ *          slot is unassigned, and a slot whose checksum does not match was
+ *          torn by an interrupted write.
+ *
+ *          The slots are used straight from a read-only mapping of the file;
+ *          on Windows, or if mapping fails, they are read into a buffer
+ *          instead. A change is saved by writing just its 8-byte slot in
+ *          place. Every change, single or batched, is written to
+ *          schedule.journal first, so a write cut short is replayed in full
+ *          the next time the store is opened. Only the slots listed in a
+ *          journal can be torn, and replaying it rewrites them, so opening
+ *          the store never has to check the other slots.
+ */
+
+// pwrite, ftruncate, fsync and mmap are POSIX, not C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "schedule_store.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "doctor_data.h"
+#include "schedule_index.h"
+#include "utils.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Private constants
+#define MAX_SHIFTS 24
+#define CONFIG_LINE_LENGTH 128
+#define DEFAULT_SHIFT_COUNT 3
+#define LEGACY_DAYS 7
+#define LEGACY_TIMES 3
+#define INITIAL_BATCH_CAPACITY 64
+
+static const char     SCHEDULE_MAGIC[4] = { 'S', 'C', 'H', 'D' };
+static const char     JOURNAL_MAGIC[4]  = { 'S', 'J', 'N', 'L' };
+static const int      SCHEDULE_VERSION  = 1;
+static const int      DAYS_PER_WEEK     = 7;
+static const int      MINUTES_PER_HOUR  = 60;
+static const int      HOURS_PER_DAY     = 24;
+static const char    *SCHEDULE_FILE     = "schedule.dat";
+static const char    *SCHEDULE_TEMP     = "schedule.tmp";
+static const char    *JOURNAL_FILE      = "schedule.journal";
+static const char    *SHIFTS_FILE       = "shifts.cfg";
+
+static const ShiftDefinition DEFAULT_SHIFTS[DEFAULT_SHIFT_COUNT] = {
+    { "Morning", 6 * 60, 8 * 60 },
+    { "Afternoon", 14 * 60, 8 * 60 },
+    { "Evening", 22 * 60, 8 * 60 },
+};
+
+/*
+ * Header at the start of schedule.dat.
+ */
+typedef struct
+{
+    char magic[4];
+    int  version;
+    int  shiftCount;
+    int  firstDay;
+    int  dayCount;
+} ScheduleHeader;
+
+/*
+ * One (day, shift) slot of schedule.dat.
+ */
+typedef struct
+{
+    int32_t  doctorId;
+    uint32_t checksum;
+} SlotRecord;
+
+/*
+ * Header of schedule.journal. The checksum covers the entries that follow,
+ * so a journal cut short by a crash is recognised and ignored.
+ */
+typedef struct
+{
+    char     magic[4];
+    int32_t  count;
+    uint32_t checksum;
+} JournalHeader;
+
+/*
+ * One queued change, as kept in memory and in schedule.journal.
+ */
+typedef struct
+{
+    int32_t dayNumber;
+    int32_t shiftIndex;
+    int32_t doctorId;
+} JournalEntry;
+
+static ScheduleHeader    header;
+static ShiftDefinition   shifts[MAX_SHIFTS];
+static const SlotRecord *slots    = NULL;
+static void             *fileData = NULL;
+static size_t            fileSize = 0;
+static int               isMapped = 0;
+
+// Handle for positioned writes into schedule.dat
+#ifdef _WIN32
+static FILE *storeFile = NULL;
+#else
+static int storeFd = -1;
+#endif
+
+// Changes queued between scheduleBeginBatch and scheduleCommitBatch
+static JournalEntry *batch         = NULL;
+static int           batchCount    = 0;
+static int           batchCapacity = 0;
+
+// Function prototypes for internal helper functions
+static int        loadScheduleFile(void);
+static int        convertLegacyFile(void);
+static void       createEmptySchedule(void);
+static int        readShiftConfig(void);
+static long       slotOffset(void);
+static long       slotIndex(int dayNumber, int shiftIndex);
+static SlotRecord makeSlot(int dayNumber, int shiftIndex, int32_t doctorId);
+static int        isSlotValid(const SlotRecord *slot, int dayNumber, int shiftIndex);
+static int        writeScheduleFile(const ScheduleHeader *newHeader, const SlotRecord newSlots[]);
+static int        ensureDayRange(int firstNeeded, int lastNeeded);
+static int        rewriteWithRange(int firstDay, int dayCount);
+static int        extendForward(int dayCount);
+static int        writeSlot(int dayNumber, int shiftIndex, int32_t doctorId);
+static int        writeAt(long offset, const void *data, size_t size);
+static int        syncStore(void);
+static int        applyJournaled(const JournalEntry entries[], int count);
+static int        writeJournal(const JournalEntry entries[], int count);
+static void       replayJournal(void);
+static int        mapScheduleFile(void);
+static void       unmapScheduleFile(void);
+
+/*
+ * Loads schedule.dat, converting an older format or creating a new schedule
+ * as needed, then finishes any interrupted write.
+ */
+int openScheduleStore(void)
+{
+    int loaded = loadScheduleFile() || convertLegacyFile();
+
+    if(!loaded)
+    {
+        createEmptySchedule();
+    }
+
+    replayJournal();
+    return loaded;
+}
+
+/*
+ * Releases the mapping or buffer holding the schedule.
+ */
+void closeScheduleStore(void)
+{
+    unmapScheduleFile();
+}
+
+/*
+ * Returns the number of shifts in each day.
+ */
+int scheduleShiftCount(void)
+{
+    return header.shiftCount;
+}
+
+/*
+ * Returns the definition of a shift.
+ */
+const ShiftDefinition *scheduleShift(int shiftIndex)
+{
+    return (shiftIndex >= 0 && shiftIndex < header.shiftCount) ? &shifts[shiftIndex] : NULL;
+}
+
+/*
+ * Returns the day number of the first stored day.
+ */
+int scheduleFirstDay(void)
+{
+    return header.firstDay;
+}
+
+/*
+ * Returns the number of stored days.
+ */
+int scheduleDayCount(void)
+{
+    return header.dayCount;
+}
+
+/*
+ * Returns the doctor assigned to a slot, or NO_DOCTOR_ASSIGNED outside the
+ * stored range or when the slot fails its checksum.
+ */
+int scheduleDoctorAt(int dayNumber, int shiftIndex)
+{
+    long index = slotIndex(dayNumber, shiftIndex);
+
+    if(index < 0 || !isSlotValid(&slots[index], dayNumber, shiftIndex))
+    {
+        return NO_DOCTOR_ASSIGNED;
+    }
+
+    return slots[index].doctorId;
+}
+
+/*
+ * Journals and stores one slot with a positioned write, growing the range by
+ * whole weeks when the day falls outside it.
+ */
+int scheduleAssign(int dayNumber, int shiftIndex, int doctorId)
+{
+    JournalEntry entry = { dayNumber, shiftIndex, doctorId };
+
+    if(shiftIndex < 0 || shiftIndex >= header.shiftCount || !ensureDayRange(dayNumber, dayNumber))
+    {
+        return 0;
+    }
+
+    return applyJournaled(&entry, 1) == 1;
+}
+
+/*
+ * Clears every slot held by the doctor as a single batch.
+ */
+int scheduleClearDoctor(int doctorId)
+{
+    scheduleBeginBatch();
+
+    for(int day = 0; day < header.dayCount; day++)
+    {
+        for(int shiftIndex = 0; shiftIndex < header.shiftCount; shiftIndex++)
+        {
+            int dayNumber = header.firstDay + day;
+
+            if(scheduleDoctorAt(dayNumber, shiftIndex) == doctorId &&
+               !scheduleBatchAssign(dayNumber, shiftIndex, NO_DOCTOR_ASSIGNED))
+            {
+                scheduleCancelBatch();
+                return 0;
+            }
+        }
+    }
+
+    return scheduleCommitBatch();
+}
+
+/*
+ * Starts an empty batch.
+ */
+void scheduleBeginBatch(void)
+{
+    batchCount = 0;
+}
+
+/*
+ * Queues one change in the current batch.
+ */
+int scheduleBatchAssign(int dayNumber, int shiftIndex, int doctorId)
+{
+    if(shiftIndex < 0 || shiftIndex >= header.shiftCount)
+    {
+        return 0;
+    }
+
+    if(batchCount == batchCapacity)
+    {
+        int           newCapacity = batchCapacity == 0 ? INITIAL_BATCH_CAPACITY : batchCapacity * 2;
+        JournalEntry *newBatch    = realloc(batch, (size_t) newCapacity * sizeof(JournalEntry));
+
+        if(newBatch == NULL)
+        {
+            puts("Error: Not enough memory for the schedule changes.");
+            return 0;
+        }
+
+        batch         = newBatch;
+        batchCapacity = newCapacity;
+    }
+
+    batch[batchCount].dayNumber  = dayNumber;
+    batch[batchCount].shiftIndex = shiftIndex;
+    batch[batchCount].doctorId   = doctorId;
+    batchCount++;
+    return 1;
+}
+
+/*
+ * Grows the range once for the whole batch, then journals and writes it.
+ */
+int scheduleCommitBatch(void)
+{
+    if(batchCount == 0)
+    {
+        return 0;
+    }
+
+    int firstNeeded = batch[0].dayNumber;
+    int lastNeeded  = batch[0].dayNumber;
+
+    for(int i = 1; i < batchCount; i++)
+    {
+        if(batch[i].dayNumber < firstNeeded)
+        {
+            firstNeeded = batch[i].dayNumber;
+        }
+        if(batch[i].dayNumber > lastNeeded)
+        {
+            lastNeeded = batch[i].dayNumber;
+        }
+    }
+
+    int applied = ensureDayRange(firstNeeded, lastNeeded) ? applyJournaled(batch, batchCount) : 0;
+
+    scheduleCancelBatch();
+    return applied;
+}
+
+/*
+ * Drops any queued changes.
+ */
+void scheduleCancelBatch(void)
+{
+    batchCount = 0;
+}
+
+/*
+ * Opens schedule.dat if it is in the calendar format. Returns 0 if there is
+ * no such file.
+ */
+static int loadScheduleFile(void)
+{
+    FILE *file = fopen(SCHEDULE_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    ScheduleHeader fileHeader;
+    int valid = fread(&fileHeader, sizeof(fileHeader), 1, file) == 1 &&
+                memcmp(fileHeader.magic, SCHEDULE_MAGIC, sizeof(SCHEDULE_MAGIC)) == 0 &&
+                fileHeader.version == SCHEDULE_VERSION &&
+                fileHeader.shiftCount > 0 && fileHeader.shiftCount <= MAX_SHIFTS && fileHeader.dayCount >= 0 &&
+                fread(shifts, sizeof(ShiftDefinition), fileHeader.shiftCount, file) ==
+                        (size_t) fileHeader.shiftCount;
+
+    fclose(file);
+
+    if(!valid)
+    {
+        return 0;
+    }
+
+    header = fileHeader;
+    if(!mapScheduleFile())
+    {
+        return 0;
+    }
+
+    rebuildScheduleIndex();
+    return 1;
+}
+
+/*
+ * Converts the old schedule.dat (a 7 x 3 array of Doctor records) into the
+ * calendar format, placing its week at the current calendar week.
+ */
+static int convertLegacyFile(void)
+{
+    FILE *file = fopen(SCHEDULE_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    Doctor legacy[LEGACY_DAYS][LEGACY_TIMES];
+    int    read = fread(legacy, sizeof(Doctor), LEGACY_DAYS * LEGACY_TIMES, file) == LEGACY_DAYS * LEGACY_TIMES &&
+               fgetc(file) == EOF;
+
+    fclose(file);
+
+    if(!read)
+    {
+        puts("\nError reading from schedule.dat. Initializing with default settings.");
+        return 0;
+    }
+
+    ScheduleHeader newHeader;
+    int            today = toDayNumber(time(NULL));
+
+    memcpy(newHeader.magic, SCHEDULE_MAGIC, sizeof(SCHEDULE_MAGIC));
+    newHeader.version    = SCHEDULE_VERSION;
+    newHeader.shiftCount = readShiftConfig();
+    newHeader.firstDay   = today - dayOfWeek(today);
+    newHeader.dayCount   = LEGACY_DAYS;
+
+    SlotRecord newSlots[LEGACY_DAYS * MAX_SHIFTS];
+    memset(newSlots, 0, sizeof(newSlots));
+
+    for(int day = 0; day < LEGACY_DAYS; day++)
+    {
+        for(int time = 0; time < LEGACY_TIMES && time < newHeader.shiftCount; time++)
+        {
+            newSlots[day * newHeader.shiftCount + time] =
+                    makeSlot(newHeader.firstDay + day, time, legacy[day][time].id);
+        }
+    }
+
+    if(!writeScheduleFile(&newHeader, newSlots) || !loadScheduleFile())
+    {
+        return 0;
+    }
+
+    time_t weekStart = dayNumberToTime(newHeader.firstDay);
+    char   dateStr[20];
+
+    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", localtime(&weekStart));
+    printf("\nConverted schedule.dat to the calendar format (week of %s).\n", dateStr);
+    return 1;
+}
+
+/*
+ * Creates an empty schedule with the configured shifts.
+ */
+static void createEmptySchedule(void)
+{
+    ScheduleHeader newHeader;
+
+    memcpy(newHeader.magic, SCHEDULE_MAGIC, sizeof(SCHEDULE_MAGIC));
+    newHeader.version    = SCHEDULE_VERSION;
+    newHeader.shiftCount = readShiftConfig();
+    newHeader.firstDay   = 0;
+    newHeader.dayCount   = 0;
+
+    header = newHeader;
+
+    if(!writeScheduleFile(&newHeader, NULL) || !loadScheduleFile())
+    {
+        puts("\nUnable to create schedule.dat.");
+    }
+}
+
+/*
+ * Reads "name,HH:MM,hours" lines from shifts.cfg into shifts[].
+ * Returns the number of shifts, falling back to the default three.
+ */
+static int readShiftConfig(void)
+{
+    FILE *file  = fopen(SHIFTS_FILE, "r");
+    int   count = 0;
+
+    if(file != NULL)
+    {
+        char line[CONFIG_LINE_LENGTH];
+
+        while(fgets(line, sizeof(line), file) != NULL && count < MAX_SHIFTS)
+        {
+            ShiftDefinition shift;
+            int             hour, minute, hours;
+
+            if(line[0] == '#' || line[0] == '\n')
+            {
+                continue;
+            }
+
+            if(sscanf(line, " %15[^,],%d:%d,%d", shift.name, &hour, &minute, &hours) != 4 || hour < 0 ||
+               hour >= HOURS_PER_DAY || minute < 0 || minute >= MINUTES_PER_HOUR || hours < 1 ||
+               hours > HOURS_PER_DAY)
+            {
+                printf("Warning: Ignoring invalid line in shifts.cfg: %s", line);
+                continue;
+            }
+
+            shift.startMinute   = hour * MINUTES_PER_HOUR + minute;
+            shift.lengthMinutes = hours * MINUTES_PER_HOUR;
+            shifts[count++]     = shift;
+        }
+
+        fclose(file);
+    }
+
+    if(count == 0)
+    {
+        memcpy(shifts, DEFAULT_SHIFTS, sizeof(DEFAULT_SHIFTS));
+        count = DEFAULT_SHIFT_COUNT;
+    }
+
+    return count;
+}
+
+/*
+ * Returns the byte offset of the first slot in schedule.dat.
+ */
+static long slotOffset(void)
+{
+    return (long) sizeof(ScheduleHeader) + (long) header.shiftCount * (long) sizeof(ShiftDefinition);
+}
+
+/*
+ * Returns the position of a slot in slots[], or -1 if it is not stored.
+ */
+static long slotIndex(int dayNumber, int shiftIndex)
+{
+    int day = dayNumber - header.firstDay;
+
+    if(slots == NULL || day < 0 || day >= header.dayCount || shiftIndex < 0 || shiftIndex >= header.shiftCount)
+    {
+        return -1;
+    }
+
+    return (long) day * header.shiftCount + shiftIndex;
+}
+
+/*
+ * Builds the stored form of a slot. The checksum covers the slot's position
+ * as well as the doctor, so a write landing in the wrong place is caught too.
+ * Unassigned slots are all zeros, like the days added when the file grows.
+ */
+static SlotRecord makeSlot(int dayNumber, int shiftIndex, int32_t doctorId)
+{
+    SlotRecord slot = { NO_DOCTOR_ASSIGNED, 0 };
+
+    if(doctorId != NO_DOCTOR_ASSIGNED)
+    {
+        int32_t values[3] = { dayNumber, shiftIndex, doctorId };
+
+        slot.doctorId = doctorId;
+        slot.checksum = hashBytes(FNV_OFFSET_BASIS, values, sizeof(values));
+    }
+
+    return slot;
+}
+
+/*
+ * Returns 1 if a slot is unassigned or its checksum matches.
+ */
+static int isSlotValid(const SlotRecord *slot, int dayNumber, int shiftIndex)
+{
+    SlotRecord expected = makeSlot(dayNumber, shiftIndex, slot->doctorId);
+    return slot->checksum == expected.checksum;
+}
+
+/*
+ * Writes a complete schedule (header, the current shifts[] and the slots) to
+ * a temporary file and swaps it in for schedule.dat. newSlots may be NULL
+ * for an empty schedule.
+ */
+static int writeScheduleFile(const ScheduleHeader *newHeader, const SlotRecord newSlots[])
+{
+    FILE *file = fopen(SCHEDULE_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating schedule.tmp");
+        return 0;
+    }
+
+    size_t slotCount = (size_t) newHeader->dayCount * newHeader->shiftCount;
+    int    written   = fwrite(newHeader, sizeof(*newHeader), 1, file) == 1 &&
+                  fwrite(shifts, sizeof(ShiftDefinition), newHeader->shiftCount, file) ==
+                          (size_t) newHeader->shiftCount &&
+                  (slotCount == 0 || fwrite(newSlots, sizeof(SlotRecord), slotCount, file) == slotCount) &&
+                  flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing schedule.tmp");
+        remove(SCHEDULE_TEMP);
+        return 0;
+    }
+
+    // The old file must be unmapped and closed before Windows lets it be replaced
+    unmapScheduleFile();
+
+    if(!replaceFile(SCHEDULE_TEMP, SCHEDULE_FILE))
+    {
+        perror("Error renaming schedule.tmp to schedule.dat");
+        remove(SCHEDULE_TEMP);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Makes sure every day from firstNeeded to lastNeeded is stored, growing by
+ * whole weeks. Later days are appended in place; earlier days need the file
+ * rewritten, since the slots are stored oldest first.
+ */
+static int ensureDayRange(int firstNeeded, int lastNeeded)
+{
+    int firstWeek = firstNeeded - dayOfWeek(firstNeeded);
+    int lastWeek  = lastNeeded - dayOfWeek(lastNeeded) + DAYS_PER_WEEK - 1;
+    int lastDay   = header.firstDay + header.dayCount - 1;
+
+    if(header.dayCount == 0)
+    {
+        return rewriteWithRange(firstWeek, lastWeek - firstWeek + 1);
+    }
+
+    if(firstNeeded < header.firstDay)
+    {
+        int newLast = lastNeeded > lastDay ? lastWeek : lastDay;
+        return rewriteWithRange(firstWeek, newLast - firstWeek + 1);
+    }
+
+    if(lastNeeded > lastDay)
+    {
+        return extendForward(lastWeek - header.firstDay + 1);
+    }
+
+    return 1;
+}
+
+/*
+ * Rewrites schedule.dat to cover a new range of days containing the current one.
+ */
+static int rewriteWithRange(int firstDay, int dayCount)
+{
+    SlotRecord *newSlots = calloc((size_t) dayCount * header.shiftCount + 1, sizeof(SlotRecord));
+    if(newSlots == NULL)
+    {
+        puts("Error: Not enough memory to save the schedule.");
+        return 0;
+    }
+
+    if(slots != NULL && header.dayCount > 0)
+    {
+        memcpy(&newSlots[(long) (header.firstDay - firstDay) * header.shiftCount], slots,
+               (size_t) header.dayCount * header.shiftCount * sizeof(SlotRecord));
+    }
+
+    ScheduleHeader newHeader = header;
+    newHeader.firstDay       = firstDay;
+    newHeader.dayCount       = dayCount;
+
+    int saved = writeScheduleFile(&newHeader, newSlots) && loadScheduleFile();
+    free(newSlots);
+    return saved;
+}
+
+/*
+ * Adds days at the end of schedule.dat without rewriting it. The file is
+ * lengthened with zero bytes (unassigned slots) and synced before the
+ * header's day count is updated and synced, so an interruption leaves the
+ * old range intact and a new day count never outlives the new length.
+ */
+static int extendForward(int dayCount)
+{
+#ifdef _WIN32
+    return rewriteWithRange(header.firstDay, dayCount);
+#else
+    off_t newSize = (off_t) slotOffset() + (off_t) dayCount * header.shiftCount * (off_t) sizeof(SlotRecord);
+
+    if(storeFd < 0 || ftruncate(storeFd, newSize) != 0 || !syncStore())
+    {
+        return rewriteWithRange(header.firstDay, dayCount);
+    }
+
+    if(!writeAt((long) offsetof(ScheduleHeader, dayCount), &dayCount, sizeof(dayCount)) || !syncStore())
+    {
+        perror("Error saving the new length of schedule.dat");
+        return 0;
+    }
+
+    header.dayCount = dayCount;
+    if(!mapScheduleFile())
+    {
+        return 0;
+    }
+
+    rebuildScheduleIndex();
+    return 1;
+#endif
+}
+
+/*
+ * Saves one slot in place and updates the bitset indexes.
+ */
+static int writeSlot(int dayNumber, int shiftIndex, int32_t doctorId)
+{
+    long index = slotIndex(dayNumber, shiftIndex);
+    if(index < 0)
+    {
+        return 0;
+    }
+
+    int        oldDoctorId = scheduleDoctorAt(dayNumber, shiftIndex);
+    SlotRecord slot        = makeSlot(dayNumber, shiftIndex, doctorId);
+
+    if(!writeAt(slotOffset() + index * (long) sizeof(SlotRecord), &slot, sizeof(slot)))
+    {
+        return 0;
+    }
+
+    updateScheduleIndex(dayNumber, shiftIndex, oldDoctorId, doctorId);
+    return 1;
+}
+
+/*
+ * Writes bytes at an offset of schedule.dat. A mapping sees the change
+ * through the page cache; a buffered copy is updated here.
+ */
+static int writeAt(long offset, const void *data, size_t size)
+{
+#ifdef _WIN32
+    int written = storeFile != NULL && fseek(storeFile, offset, SEEK_SET) == 0 &&
+                  fwrite(data, size, 1, storeFile) == 1 && fflush(storeFile) == 0;
+#else
+    int written = storeFd >= 0 && pwrite(storeFd, data, size, (off_t) offset) == (ssize_t) size;
+#endif
+
+    if(!written)
+    {
+        perror("Error writing schedule.dat");
+        return 0;
+    }
+
+    if(!isMapped && fileData != NULL && (size_t) offset + size <= fileSize)
+    {
+        memcpy((char *) fileData + offset, data, size);
+    }
+
+    return 1;
+}
+
+/*
+ * Flushes schedule.dat to disk.
+ */
+static int syncStore(void)
+{
+#ifdef _WIN32
+    return storeFile != NULL && fflush(storeFile) == 0 && _commit(_fileno(storeFile)) == 0;
+#else
+    return storeFd >= 0 && fsync(storeFd) == 0;
+#endif
+}
+
+/*
+ * Journals changes, writes each slot in place and removes the journal once
+ * the slots are on disk. Returns the number of slots written.
+ */
+static int applyJournaled(const JournalEntry entries[], int count)
+{
+    if(!writeJournal(entries, count))
+    {
+        return 0;
+    }
+
+    int applied = 0;
+    for(int i = 0; i < count; i++)
+    {
+        applied += writeSlot(entries[i].dayNumber, entries[i].shiftIndex, entries[i].doctorId);
+    }
+
+    // If anything failed the journal stays, and the changes are replayed on the next start
+    if(applied == count && syncStore())
+    {
+        remove(JOURNAL_FILE);
+    }
+
+    return applied;
+}
+
+/*
+ * Writes changes to schedule.journal and flushes it to disk.
+ */
+static int writeJournal(const JournalEntry entries[], int count)
+{
+    FILE *file = fopen(JOURNAL_FILE, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating schedule.journal");
+        return 0;
+    }
+
+    JournalHeader journalHeader;
+
+    memcpy(journalHeader.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    journalHeader.count    = count;
+    journalHeader.checksum = hashBytes(FNV_OFFSET_BASIS, entries, (size_t) count * sizeof(JournalEntry));
+
+    int written = fwrite(&journalHeader, sizeof(journalHeader), 1, file) == 1 &&
+                  fwrite(entries, sizeof(JournalEntry), count, file) == (size_t) count && flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing schedule.journal");
+        remove(JOURNAL_FILE);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Re-applies changes left behind by an interruption, which rewrites any of
+ * their slots that were torn. An incomplete journal means none of its slots
+ * were written yet, so it is simply discarded.
+ */
+static void replayJournal(void)
+{
+    FILE *file = fopen(JOURNAL_FILE, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    JournalHeader journalHeader;
+    JournalEntry  entry;
+    int valid = fread(&journalHeader, sizeof(journalHeader), 1, file) == 1 &&
+                memcmp(journalHeader.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0 && journalHeader.count > 0;
+
+    scheduleBeginBatch();
+    for(int i = 0; valid && i < journalHeader.count; i++)
+    {
+        valid = fread(&entry, sizeof(entry), 1, file) == 1 &&
+                scheduleBatchAssign(entry.dayNumber, entry.shiftIndex, entry.doctorId);
+    }
+
+    fclose(file);
+
+    if(valid &&
+       hashBytes(FNV_OFFSET_BASIS, batch, (size_t) batchCount * sizeof(JournalEntry)) == journalHeader.checksum)
+    {
+        printf("\nRecovered %d schedule changes from an interrupted save.\n", scheduleCommitBatch());
+    }
+    else
+    {
+        scheduleCancelBatch();
+        remove(JOURNAL_FILE);
+        puts("\nDiscarded an incomplete schedule journal.");
+    }
+}
+
+/*
+ * Opens the write handle and makes the slots of schedule.dat available
+ * through slots[], mapping the file where possible.
+ */
+static int mapScheduleFile(void)
+{
+    unmapScheduleFile();
+
+    long   offset   = slotOffset();
+    size_t expected = (size_t) offset + (size_t) header.dayCount * header.shiftCount * sizeof(SlotRecord);
+
+#ifdef _WIN32
+    storeFile = fopen(SCHEDULE_FILE, "r+b");
+#else
+    storeFd = open(SCHEDULE_FILE, O_RDWR);
+    if(storeFd >= 0)
+    {
+        struct stat info;
+
+        if(fstat(storeFd, &info) == 0 && (size_t) info.st_size >= expected)
+        {
+            void *map = mmap(NULL, expected, PROT_READ, MAP_SHARED, storeFd, 0);
+            if(map != MAP_FAILED)
+            {
+                fileData = map;
+                fileSize = expected;
+                isMapped = 1;
+                slots    = (const SlotRecord *) ((const char *) map + offset);
+                return 1;
+            }
+        }
+    }
+#endif
+
+    // No mapping available: read the file into a buffer
+    FILE *file = fopen(SCHEDULE_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    fileData = malloc(expected);
+    fileSize = expected;
+
+    int loaded = fileData != NULL && fread(fileData, 1, expected, file) == expected;
+    fclose(file);
+
+    if(!loaded)
+    {
+        puts("\nError reading from schedule.dat.");
+        unmapScheduleFile();
+        return 0;
+    }
+
+    slots = (const SlotRecord *) ((const char *) fileData + offset);
+    return 1;
+}
+
+/*
+ * Releases the current mapping or buffer and closes the write handle.
+ */
+static void unmapScheduleFile(void)
+{
+    if(isMapped)
+    {
+#ifndef _WIN32
+        munmap(fileData, fileSize);
+#endif
+    }
+    else
+    {
+        free(fileData);
+    }
+
+#ifdef _WIN32
+    if(storeFile != NULL)
+    {
+        fclose(storeFile);
+        storeFile = NULL;
+    }
+#else
+    if(storeFd >= 0)
+    {
+        close(storeFd);
+        storeFd = -1;
+    }
+#endif
+
+    fileData = NULL;
+    fileSize = 0;
+    isMapped = 0;
+    slots    = NULL;
+}
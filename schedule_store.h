@@ -0,0 +1,153 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the calendar schedule store. schedule.dat holds
+ *          the shift definitions followed by one checksummed doctor ID per
+ *          (day, shift) slot for a contiguous range of calendar days. The
+ *          file is memory-mapped where the platform allows it, so even a
+ *          year of schedules loads without reading or parsing every slot,
+ *          and each change rewrites only the slots it touches.
+ */
+
+#ifndef SCHEDULE_STORE_H
+#define SCHEDULE_STORE_H
+
+#define MAX_SHIFT_NAME_LENGTH 16
+#define NO_DOCTOR_ASSIGNED 0
+
+/*
+ * A shift that repeats every day, e.g. "Morning" from 06:00 for 8 hours.
+ */
+typedef struct
+{
+    char name[MAX_SHIFT_NAME_LENGTH];
+    int  startMinute;
+    int  lengthMinutes;
+} ShiftDefinition;
+
+/*
+ * Function: openScheduleStore
+ * ---------------------------
+ * Opens schedule.dat. A file in the old one-week format is converted,
+ * with its assignments placed in the current calendar week. If there is no
+ * file, an empty schedule is created using the shifts in shifts.cfg (or
+ * Morning, Afternoon and Evening if that file is missing). A change that
+ * was interrupted is then replayed from schedule.journal, which rewrites
+ * any slot it tore; a slot failing its checksum otherwise reads as
+ * unassigned.
+ *
+ * Returns: 1 if an existing schedule was loaded, 0 if a new one was created
+ */
+int openScheduleStore(void);
+
+/*
+ * Function: closeScheduleStore
+ * ----------------------------
+ * Releases the mapping or buffer holding the schedule.
+ */
+void closeScheduleStore(void);
+
+/*
+ * Function: scheduleShiftCount
+ * ----------------------------
+ * Returns: The number of shifts in each day
+ */
+int scheduleShiftCount(void);
+
+/*
+ * Function: scheduleShift
+ * -----------------------
+ * Returns: The definition of a shift, given its index within the day
+ */
+const ShiftDefinition *scheduleShift(int shiftIndex);
+
+/*
+ * Function: scheduleFirstDay
+ * --------------------------
+ * Returns: The day number of the first stored day
+ */
+int scheduleFirstDay(void);
+
+/*
+ * Function: scheduleDayCount
+ * --------------------------
+ * Returns: The number of stored days (0 for an empty schedule)
+ */
+int scheduleDayCount(void);
+
+/*
+ * Function: scheduleDoctorAt
+ * --------------------------
+ * dayNumber: The calendar day (see toDayNumber)
+ * shiftIndex: The shift within the day
+ *
+ * Returns: The assigned doctor ID, or NO_DOCTOR_ASSIGNED
+ */
+int scheduleDoctorAt(int dayNumber, int shiftIndex);
+
+/*
+ * Function: scheduleAssign
+ * ------------------------
+ * Stores a doctor ID (or NO_DOCTOR_ASSIGNED) in a slot, extending the
+ * stored range of days if needed, and writes that slot to schedule.dat
+ * through schedule.journal.
+ *
+ * dayNumber: The calendar day
+ * shiftIndex: The shift within the day
+ * doctorId: The doctor to assign
+ *
+ * Returns: 1 if the schedule was saved, 0 otherwise
+ */
+int scheduleAssign(int dayNumber, int shiftIndex, int doctorId);
+
+/*
+ * Function: scheduleClearDoctor
+ * -----------------------------
+ * Unassigns a doctor from every slot as a single batch.
+ *
+ * doctorId: The doctor to remove from the schedule
+ *
+ * Returns: The number of slots cleared
+ */
+int scheduleClearDoctor(int doctorId);
+
+/*
+ * Function: scheduleBeginBatch
+ * ----------------------------
+ * Starts a batch of changes to be saved together by scheduleCommitBatch.
+ */
+void scheduleBeginBatch(void);
+
+/*
+ * Function: scheduleBatchAssign
+ * -----------------------------
+ * Queues a change in the current batch. The schedule is not changed until
+ * the batch is committed.
+ *
+ * dayNumber: The calendar day
+ * shiftIndex: The shift within the day
+ * doctorId: The doctor to assign, or NO_DOCTOR_ASSIGNED
+ *
+ * Returns: 1 if the change was queued, 0 otherwise
+ */
+int scheduleBatchAssign(int dayNumber, int shiftIndex, int doctorId);
+
+/*
+ * Function: scheduleCommitBatch
+ * -----------------------------
+ * Saves the queued changes. The range of days is extended once for the
+ * whole batch, and the batch is written to schedule.journal before any slot
+ * so that an interrupted save is completed the next time the schedule opens.
+ *
+ * Returns: The number of slots written
+ */
+int scheduleCommitBatch(void);
+
+/*
+ * Function: scheduleCancelBatch
+ * -----------------------------
+ * Discards the queued changes.
+ */
+void scheduleCancelBatch(void);
+
+#endif // SCHEDULE_STORE_H
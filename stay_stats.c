@@ -0,0 +1,869 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the length-of-stay statistics.
+ *          A sketch is a log-linear histogram of stays in minutes: one
+ *          bucket per minute below an hour, then 32 buckets per doubling, so
+ *          any percentile read from it is within about 1.6% of the true
+ *          value. Only the non-empty buckets are stored, sorted by bucket,
+ *          so merging two sketches is a merge of two sorted lists.
+ *
+ *          Sketches are found through an open-addressing index keyed by
+ *          month, kind and room or diagnosis. stay_sketches.dat records how
+ *          many archive records the sketches cover; since the archive is
+ *          append-only, bringing them up to date reads only the records
+ *          after that point. Each discharge batch is added in memory as it
+ *          is archived and the file is rewritten every SAVE_INTERVAL records,
+ *          so a discharge does not pay for rewriting every sketch. A batch
+ *          that does not start where the sketches end, or a shorter archive
+ *          than they cover (after the data was reset), makes them catch up
+ *          from the archive or start again from the first record.
+ */
+
+#include "stay_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "patient_data.h"
+#include "patient_management.h"
+#include "report_format.h"
+#include "report_sink.h"
+#include "utils.h"
+
+// Private constants
+#define LINEAR_BUCKETS 64
+#define SUB_BUCKET_BITS 5
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+#define LINEAR_BITS 6
+#define MAX_STAY_BITS 26
+#define BUCKET_COUNT (LINEAR_BUCKETS + (MAX_STAY_BITS - LINEAR_BITS) * SUB_BUCKETS)
+#define MIN_INDEX_CAPACITY 256
+#define INITIAL_BUCKET_CAPACITY 4
+#define SAVE_INTERVAL 256
+#define ARCHIVE_CHUNK 256
+#define PROMPT_LENGTH 64
+
+#define KIND_ALL 1
+#define KIND_DIAGNOSIS 2
+#define KIND_ROOM 3
+
+#define GROUP_NONE 1
+#define GROUP_MONTH 2
+#define GROUP_DIAGNOSIS 3
+#define GROUP_ROOM 4
+
+static const char   SKETCH_MAGIC[4]   = { 'S', 'T', 'A', 'Y' };
+static const int    SKETCH_VERSION    = 1;
+static const int    EMPTY_SLOT        = -1;
+static const int    DEFAULT_MONTHS    = 12;
+static const double SECONDS_PER_MIN   = 60.0;
+static const double MINUTES_PER_DAY   = 24.0 * 60.0;
+static const char  *SKETCH_FILE       = "stay_sketches.dat";
+static const char  *SKETCH_TEMP       = "stay_sketches.tmp";
+static const char  *STAY_REPORT_FILE  = "stay_reports.txt";
+static const char  *SEPARATOR_LINE    = "---------------------------------------\n";
+
+/*
+ * The number of stays in one histogram bucket.
+ */
+typedef struct
+{
+    int index;
+    int count;
+} SketchBucket;
+
+/*
+ * The stays of one month, overall or for one diagnosis or room, with the
+ * non-empty buckets sorted by index.
+ */
+typedef struct
+{
+    int           month;
+    int           kind;
+    int           room;
+    char         *diagnosis;
+    long long     count;
+    double        staySeconds;
+    SketchBucket *buckets;
+    int           bucketCount;
+    int           bucketCapacity;
+} StaySketch;
+
+/*
+ * Header of stay_sketches.dat, followed by sketchCount sketches.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    long long coveredRecords;
+    int       sketchCount;
+} SketchFileHeader;
+
+/*
+ * Header of one stored sketch, followed by the diagnosis text and the
+ * buckets.
+ */
+typedef struct
+{
+    int       month;
+    int       kind;
+    int       room;
+    int       diagnosisLength;
+    long long count;
+    double    staySeconds;
+    int       bucketCount;
+} SketchHeader;
+
+static StaySketch *sketches       = NULL;
+static int         sketchCount    = 0;
+static int         sketchCapacity = 0;
+static int        *sketchIndex    = NULL;
+static int         indexCapacity  = 0;
+static long long   coveredRecords = 0;
+static long long   savedRecords   = 0;
+static int         sketchesLoaded = 0;
+
+// Group-by choice compareGroupKeys sorts by, set before sorting
+static int sortGrouping = GROUP_NONE;
+
+// Function prototypes for internal helper functions
+static void         loadSketches(void);
+static int          updateSketches(void);
+static int          saveSketches(void);
+static void         resetSketches(void);
+static int          addDischargedStay(DateCache *dates, const DischargedPatient *record);
+static int          addStay(int month, const Patient *patient, double staySeconds);
+static StaySketch  *findSketch(int month, int kind, int room, const char *diagnosis, int create);
+static int          growSketchIndex(void);
+static unsigned int hashSketchKey(int month, int kind, int room, const char *diagnosis);
+static int          addToSketch(StaySketch *sketch, int bucket, int count, double staySeconds);
+static int          bucketOf(double staySeconds);
+static double       bucketMinutes(int bucket);
+static double       percentileDays(const long long histogram[], long long count, double fraction);
+static int          promptGrouping(void);
+static int          compareGroupKeys(const void *a, const void *b);
+static void         printStayReport(ReportSink *sink, int fromMonth, int toMonth, int grouping);
+static void         printStayRow(ReportSink *sink, const char *key, const long long histogram[], long long count,
+                                 double staySeconds);
+
+/*
+ * Adds a batch of discharges to the sketches, saving them once
+ * SAVE_INTERVAL records have been added since the last save, or catches up
+ * from the archive if the batch does not follow the records they cover.
+ */
+int stayStatsRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count)
+{
+    if(!sketchesLoaded)
+    {
+        loadSketches();
+    }
+
+    if(firstArchiveRecord != coveredRecords)
+    {
+        return updateSketches();
+    }
+
+    DateCache dates;
+    initDateCache(&dates);
+
+    for(int i = 0; i < count; i++)
+    {
+        if(!addDischargedStay(&dates, &records[i]))
+        {
+            puts("Error: Not enough memory for the length-of-stay sketches.");
+            resetSketches();
+            return 0;
+        }
+    }
+
+    coveredRecords += count;
+    if(coveredRecords - savedRecords >= SAVE_INTERVAL)
+    {
+        return saveSketches();
+    }
+    return 1;
+}
+
+/*
+ * Brings the sketches up to date, then prompts for the report and prints
+ * it to the console and stay_reports.txt.
+ */
+void displayStayReport(void)
+{
+    if(!sketchesLoaded)
+    {
+        loadSketches();
+    }
+    if(!updateSketches())
+    {
+        return;
+    }
+
+    DateCache dates;
+    initDateCache(&dates);
+
+    int  thisMonth = cachedMonthNumber(&dates, time(NULL));
+    char monthText[MONTH_TEXT_LENGTH];
+    char prompt[PROMPT_LENGTH];
+
+    formatMonthNumber(thisMonth - DEFAULT_MONTHS + 1, monthText);
+    snprintf(prompt, sizeof(prompt), "From month (YYYY-MM, Enter for %s):\n", monthText);
+    int fromMonth = promptMonth(prompt, thisMonth - DEFAULT_MONTHS + 1);
+
+    formatMonthNumber(thisMonth, monthText);
+    snprintf(prompt, sizeof(prompt), "To month, inclusive (YYYY-MM, Enter for %s):\n", monthText);
+    int toMonth = promptMonth(prompt, thisMonth);
+
+    if(toMonth < fromMonth)
+    {
+        puts("The range ends before it starts.");
+        return;
+    }
+
+    int grouping = promptGrouping();
+
+    FILE *file = fopen(STAY_REPORT_FILE, "a");
+    if(file == NULL)
+    {
+        printf("Error opening file for writing!\n");
+        return;
+    }
+
+    fprintf(file, "\n");
+
+    ReportSink *sink = openReportSink(file, 1);
+    if(sink != NULL)
+    {
+        printStayReport(sink, fromMonth, toMonth, grouping);
+    }
+
+    if(!closeReportSink(sink) || fclose(file) != 0)
+    {
+        printf("Error writing %s\n", STAY_REPORT_FILE);
+        return;
+    }
+    printf("\nReport successfully written to %s\n", STAY_REPORT_FILE);
+}
+
+/*
+ * Reads stay_sketches.dat. A missing or unreadable file leaves no sketches,
+ * so they are rebuilt from the whole archive.
+ */
+static void loadSketches(void)
+{
+    sketchesLoaded = 1;
+
+    FILE *file = fopen(SKETCH_FILE, "rb");
+    if(file == NULL)
+    {
+        return;
+    }
+
+    SketchFileHeader header;
+    int              valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, SKETCH_MAGIC, sizeof(SKETCH_MAGIC)) == 0 && header.version == SKETCH_VERSION;
+
+    for(int i = 0; valid && i < header.sketchCount; i++)
+    {
+        SketchHeader stored;
+        char         diagnosis[MAX_DIAGNOSIS_LENGTH + 1] = "";
+
+        valid = fread(&stored, sizeof(stored), 1, file) == 1 && stored.diagnosisLength >= 0 &&
+                stored.diagnosisLength <= MAX_DIAGNOSIS_LENGTH &&
+                fread(diagnosis, 1, stored.diagnosisLength, file) == (size_t) stored.diagnosisLength;
+        diagnosis[valid ? stored.diagnosisLength : 0] = '\0';
+
+        StaySketch *sketch = valid ? findSketch(stored.month, stored.kind, stored.room,
+                                                stored.kind == KIND_DIAGNOSIS ? diagnosis : NULL, 1)
+                                   : NULL;
+        valid = sketch != NULL;
+
+        for(int b = 0; valid && b < stored.bucketCount; b++)
+        {
+            SketchBucket bucket;
+            valid = fread(&bucket, sizeof(bucket), 1, file) == 1 && bucket.index >= 0 &&
+                    bucket.index < BUCKET_COUNT && addToSketch(sketch, bucket.index, bucket.count, 0);
+        }
+
+        if(valid)
+        {
+            sketch->count       = stored.count;
+            sketch->staySeconds = stored.staySeconds;
+        }
+    }
+
+    fclose(file);
+
+    if(!valid)
+    {
+        puts("Error reading stay_sketches.dat. The length-of-stay sketches will be rebuilt.");
+        resetSketches();
+        return;
+    }
+    coveredRecords = header.coveredRecords;
+    savedRecords   = header.coveredRecords;
+}
+
+/*
+ * Adds the stays archived since the sketches were saved and saves them
+ * again if any were added. Returns 0 if the sketches could not be updated.
+ */
+static int updateSketches(void)
+{
+    FILE *file = fopen("discharged_patients.dat", "rb");
+    if(file == NULL)
+    {
+        resetSketches();
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long long recordCount = ftell(file) / (long long) sizeof(DischargedPatient);
+
+    if(recordCount < coveredRecords)
+    {
+        resetSketches();
+    }
+    if(recordCount == coveredRecords)
+    {
+        fclose(file);
+        return 1;
+    }
+
+    DischargedPatient *chunk = malloc(ARCHIVE_CHUNK * sizeof(DischargedPatient));
+    DateCache          dates;
+    int                ok = chunk != NULL && fseek(file, (long) (coveredRecords * sizeof(DischargedPatient)), SEEK_SET) == 0;
+    size_t             read;
+
+    initDateCache(&dates);
+
+    while(ok && (read = fread(chunk, sizeof(DischargedPatient), ARCHIVE_CHUNK, file)) > 0)
+    {
+        for(size_t i = 0; ok && i < read; i++)
+        {
+            ok = addDischargedStay(&dates, &chunk[i]);
+        }
+        coveredRecords += ok ? (long long) read : 0;
+    }
+
+    free(chunk);
+    fclose(file);
+
+    if(!ok)
+    {
+        puts("Error: Not enough memory for the length-of-stay sketches.");
+        resetSketches();
+        return 0;
+    }
+
+    saveSketches();
+    return 1;
+}
+
+/*
+ * Writes every sketch to stay_sketches.tmp and renames it over
+ * stay_sketches.dat.
+ */
+static int saveSketches(void)
+{
+    FILE *file = fopen(SKETCH_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating stay_sketches.tmp");
+        return 0;
+    }
+
+    SketchFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SKETCH_MAGIC, sizeof(SKETCH_MAGIC));
+    header.version        = SKETCH_VERSION;
+    header.coveredRecords = coveredRecords;
+    header.sketchCount    = sketchCount;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int i = 0; written && i < sketchCount; i++)
+    {
+        const StaySketch *sketch = &sketches[i];
+        SketchHeader      stored;
+
+        memset(&stored, 0, sizeof(stored));
+        stored.month           = sketch->month;
+        stored.kind            = sketch->kind;
+        stored.room            = sketch->room;
+        stored.diagnosisLength = sketch->diagnosis == NULL ? 0 : (int) strlen(sketch->diagnosis);
+        stored.count           = sketch->count;
+        stored.staySeconds     = sketch->staySeconds;
+        stored.bucketCount     = sketch->bucketCount;
+
+        written = fwrite(&stored, sizeof(stored), 1, file) == 1 &&
+                  fwrite(sketch->diagnosis == NULL ? "" : sketch->diagnosis, 1, stored.diagnosisLength, file) ==
+                          (size_t) stored.diagnosisLength &&
+                  fwrite(sketch->buckets, sizeof(SketchBucket), sketch->bucketCount, file) ==
+                          (size_t) sketch->bucketCount;
+    }
+
+    written = written && flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing stay_sketches.tmp");
+        remove(SKETCH_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(SKETCH_TEMP, SKETCH_FILE))
+    {
+        perror("Error renaming stay_sketches.tmp to stay_sketches.dat");
+        remove(SKETCH_TEMP);
+        return 0;
+    }
+
+    savedRecords = coveredRecords;
+    return 1;
+}
+
+/*
+ * Frees every sketch so they are rebuilt from the first archive record.
+ */
+static void resetSketches(void)
+{
+    for(int i = 0; i < sketchCount; i++)
+    {
+        free(sketches[i].diagnosis);
+        free(sketches[i].buckets);
+    }
+
+    free(sketches);
+    free(sketchIndex);
+    sketches       = NULL;
+    sketchCount    = 0;
+    sketchCapacity = 0;
+    sketchIndex    = NULL;
+    indexCapacity  = 0;
+    coveredRecords = 0;
+    savedRecords   = 0;
+}
+
+/*
+ * Adds an archived discharge's stay to the sketches of its discharge month.
+ */
+static int addDischargedStay(DateCache *dates, const DischargedPatient *record)
+{
+    double staySeconds = difftime(record->dischargeDate, record->patient.admissionDate);
+    staySeconds        = staySeconds < 0 ? 0 : staySeconds;
+    return addStay(cachedMonthNumber(dates, record->dischargeDate), &record->patient, staySeconds);
+}
+
+/*
+ * Adds one completed stay to its month's overall, diagnosis and room
+ * sketches.
+ */
+static int addStay(int month, const Patient *patient, double staySeconds)
+{
+    char diagnosis[MAX_DIAGNOSIS_LENGTH + 1];
+    int  bucket = bucketOf(staySeconds);
+
+    normaliseText(patient->diagnosis, diagnosis, sizeof(diagnosis));
+
+    StaySketch *all = findSketch(month, KIND_ALL, 0, NULL, 1);
+    if(all == NULL || !addToSketch(all, bucket, 1, staySeconds))
+    {
+        return 0;
+    }
+
+    StaySketch *byDiagnosis = findSketch(month, KIND_DIAGNOSIS, 0, diagnosis, 1);
+    if(byDiagnosis == NULL || !addToSketch(byDiagnosis, bucket, 1, staySeconds))
+    {
+        return 0;
+    }
+
+    StaySketch *byRoom = findSketch(month, KIND_ROOM, patient->roomNumber, NULL, 1);
+    return byRoom != NULL && addToSketch(byRoom, bucket, 1, staySeconds);
+}
+
+/*
+ * Returns the sketch with a key, adding an empty one when create is set.
+ * Returns NULL if there is none or memory ran out.
+ */
+static StaySketch *findSketch(int month, int kind, int room, const char *diagnosis, int create)
+{
+    if(create && (sketchCount + 1) * 2 > indexCapacity && !growSketchIndex())
+    {
+        return NULL;
+    }
+    if(sketchIndex == NULL)
+    {
+        return NULL;
+    }
+
+    int mask = indexCapacity - 1;
+    int slot = hashSketchKey(month, kind, room, diagnosis) & mask;
+
+    while(sketchIndex[slot] != EMPTY_SLOT)
+    {
+        StaySketch *sketch = &sketches[sketchIndex[slot]];
+
+        if(sketch->month == month && sketch->kind == kind && sketch->room == room &&
+           (diagnosis == NULL || strcmp(sketch->diagnosis, diagnosis) == 0))
+        {
+            return sketch;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if(!create)
+    {
+        return NULL;
+    }
+
+    if(sketchCount == sketchCapacity)
+    {
+        int         newCapacity = sketchCapacity == 0 ? MIN_INDEX_CAPACITY : sketchCapacity * 2;
+        StaySketch *grown       = realloc(sketches, newCapacity * sizeof(StaySketch));
+
+        if(grown == NULL)
+        {
+            return NULL;
+        }
+        sketches       = grown;
+        sketchCapacity = newCapacity;
+    }
+
+    StaySketch *sketch = &sketches[sketchCount];
+    memset(sketch, 0, sizeof(StaySketch));
+    sketch->month = month;
+    sketch->kind  = kind;
+    sketch->room  = room;
+
+    if(diagnosis != NULL)
+    {
+        sketch->diagnosis = malloc(strlen(diagnosis) + 1);
+        if(sketch->diagnosis == NULL)
+        {
+            return NULL;
+        }
+        strcpy(sketch->diagnosis, diagnosis);
+    }
+
+    sketchIndex[slot] = sketchCount++;
+    return sketch;
+}
+
+/*
+ * Doubles the sketch index and reinserts every sketch.
+ */
+static int growSketchIndex(void)
+{
+    int  newCapacity = indexCapacity == 0 ? MIN_INDEX_CAPACITY : indexCapacity * 2;
+    int *newIndex    = malloc(newCapacity * sizeof(int));
+
+    if(newIndex == NULL)
+    {
+        return 0;
+    }
+
+    for(int slot = 0; slot < newCapacity; slot++)
+    {
+        newIndex[slot] = EMPTY_SLOT;
+    }
+
+    for(int i = 0; i < sketchCount; i++)
+    {
+        const StaySketch *sketch = &sketches[i];
+        int               slot   = hashSketchKey(sketch->month, sketch->kind, sketch->room, sketch->diagnosis) &
+                       (newCapacity - 1);
+
+        while(newIndex[slot] != EMPTY_SLOT)
+        {
+            slot = (slot + 1) & (newCapacity - 1);
+        }
+        newIndex[slot] = i;
+    }
+
+    free(sketchIndex);
+    sketchIndex   = newIndex;
+    indexCapacity = newCapacity;
+    return 1;
+}
+
+/*
+ * FNV-1a over the month, kind, room and diagnosis text.
+ */
+static unsigned int hashSketchKey(int month, int kind, int room, const char *diagnosis)
+{
+    const int    values[] = { month, kind, room };
+    unsigned int hash     = hashBytes(FNV_OFFSET_BASIS, values, sizeof(values));
+
+    return diagnosis == NULL ? hash : hashString(hash, diagnosis);
+}
+
+/*
+ * Adds stays to one bucket of a sketch, inserting the bucket in order if
+ * it is new.
+ */
+static int addToSketch(StaySketch *sketch, int bucket, int count, double staySeconds)
+{
+    int low  = 0;
+    int high = sketch->bucketCount;
+
+    while(low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if(sketch->buckets[middle].index < bucket)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if(low == sketch->bucketCount || sketch->buckets[low].index != bucket)
+    {
+        if(sketch->bucketCount == sketch->bucketCapacity)
+        {
+            int           newCapacity = sketch->bucketCapacity == 0 ? INITIAL_BUCKET_CAPACITY
+                                                                    : sketch->bucketCapacity * 2;
+            SketchBucket *grown       = realloc(sketch->buckets, newCapacity * sizeof(SketchBucket));
+
+            if(grown == NULL)
+            {
+                return 0;
+            }
+            sketch->buckets        = grown;
+            sketch->bucketCapacity = newCapacity;
+        }
+
+        memmove(&sketch->buckets[low + 1], &sketch->buckets[low],
+                (sketch->bucketCount - low) * sizeof(SketchBucket));
+        sketch->buckets[low] = (SketchBucket) { bucket, 0 };
+        sketch->bucketCount++;
+    }
+
+    sketch->buckets[low].count += count;
+    sketch->count += count;
+    sketch->staySeconds += staySeconds;
+    return 1;
+}
+
+/*
+ * Maps a stay to its bucket: whole minutes below LINEAR_BUCKETS, then
+ * SUB_BUCKETS buckets per doubling.
+ */
+static int bucketOf(double staySeconds)
+{
+    long minutes = staySeconds <= 0 ? 0 : (long) (staySeconds / SECONDS_PER_MIN);
+
+    if(minutes >= (1L << MAX_STAY_BITS))
+    {
+        return BUCKET_COUNT - 1;
+    }
+    if(minutes < LINEAR_BUCKETS)
+    {
+        return (int) minutes;
+    }
+
+    int exponent = LINEAR_BITS;
+    while((minutes >> (exponent + 1)) != 0)
+    {
+        exponent++;
+    }
+
+    int subBucket = (int) (minutes >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (exponent - LINEAR_BITS) * SUB_BUCKETS + subBucket;
+}
+
+/*
+ * Returns the middle of a bucket's range of minutes.
+ */
+static double bucketMinutes(int bucket)
+{
+    if(bucket < LINEAR_BUCKETS)
+    {
+        return bucket + 0.5;
+    }
+
+    int    exponent  = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + LINEAR_BITS;
+    int    subBucket = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+    double width     = (double) (1L << (exponent - SUB_BUCKET_BITS));
+
+    return (SUB_BUCKETS + subBucket) * width + width / 2;
+}
+
+/*
+ * Walks a merged histogram to the bucket holding the given fraction of
+ * the stays and returns its middle in days.
+ */
+static double percentileDays(const long long histogram[], long long count, double fraction)
+{
+    long long rank = (long long) (fraction * count);
+    long long seen = 0;
+
+    if(rank >= count)
+    {
+        rank = count - 1;
+    }
+
+    for(int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        seen += histogram[bucket];
+        if(seen > rank)
+        {
+            return bucketMinutes(bucket) / MINUTES_PER_DAY;
+        }
+    }
+    return bucketMinutes(BUCKET_COUNT - 1) / MINUTES_PER_DAY;
+}
+
+/*
+ * Asks how the stays should be grouped.
+ */
+static int promptGrouping(void)
+{
+    int grouping;
+
+    while(1)
+    {
+        printf("Group by:\n1: Nothing (the whole range)\n2: Month\n3: Diagnosis\n4: Room\nEnter choice: ");
+        int read = scanf("%d", &grouping);
+        clearInputBuffer();
+
+        if(read == SUCCESSFUL_READ && grouping >= GROUP_NONE && grouping <= GROUP_ROOM)
+        {
+            return grouping;
+        }
+        printf("Please enter a number between %d and %d.\n", GROUP_NONE, GROUP_ROOM);
+    }
+}
+
+/*
+ * Orders sketches by the chosen group key for qsort.
+ */
+static int compareGroupKeys(const void *a, const void *b)
+{
+    const StaySketch *first  = *(const StaySketch *const *) a;
+    const StaySketch *second = *(const StaySketch *const *) b;
+
+    switch(sortGrouping)
+    {
+        case GROUP_MONTH:
+            return (first->month > second->month) - (first->month < second->month);
+        case GROUP_DIAGNOSIS:
+            return strcmp(first->diagnosis, second->diagnosis);
+        case GROUP_ROOM:
+            return (first->room > second->room) - (first->room < second->room);
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Picks the range's sketches of the kind the grouping needs, sorts them so
+ * each group's sketches are adjacent and merges each run into one
+ * histogram for its row.
+ */
+static void printStayReport(ReportSink *sink, int fromMonth, int toMonth, int grouping)
+{
+    int                kind     = grouping == GROUP_DIAGNOSIS ? KIND_DIAGNOSIS
+                                  : grouping == GROUP_ROOM    ? KIND_ROOM
+                                                              : KIND_ALL;
+    const char        *keyNames[] = { "", "Range", "Month", "Diagnosis", "Room" };
+    const StaySketch **selected   = malloc((sketchCount + 1) * sizeof(StaySketch *));
+    long long         *histogram  = calloc(BUCKET_COUNT, sizeof(long long));
+    int                count      = 0;
+
+    if(selected == NULL || histogram == NULL)
+    {
+        puts("Error: Not enough memory for the length-of-stay report.");
+        free(selected);
+        free(histogram);
+        return;
+    }
+
+    for(int i = 0; i < sketchCount; i++)
+    {
+        if(sketches[i].kind == kind && sketches[i].month >= fromMonth && sketches[i].month <= toMonth)
+        {
+            selected[count++] = &sketches[i];
+        }
+    }
+
+    sortGrouping = grouping;
+    qsort(selected, count, sizeof(StaySketch *), compareGroupKeys);
+
+    char fromText[MONTH_TEXT_LENGTH];
+    char toText[MONTH_TEXT_LENGTH];
+
+    formatMonthNumber(fromMonth, fromText);
+    formatMonthNumber(toMonth, toText);
+    sinkPrintf(sink, "   Length of Stay Report - %s to %s\n", fromText, toText);
+    sinkPrintf(sink, "=======================================\n");
+    sinkPrintf(sink, "Stays in days, by discharge month. Percentiles are within about 2%%.\n");
+    sinkPrintf(sink, "%-24s| %-8s| %-8s| %-8s| %-8s| %s\n", keyNames[grouping], "Stays", "Mean", "Median", "90th",
+               "99th");
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+
+    if(count == 0)
+    {
+        sinkPrintf(sink, "| No discharges in this range |\n");
+    }
+
+    for(int first = 0; first < count;)
+    {
+        int       last        = first;
+        long long stays       = 0;
+        double    staySeconds = 0;
+
+        memset(histogram, 0, BUCKET_COUNT * sizeof(long long));
+        while(last < count && compareGroupKeys(&selected[first], &selected[last]) == 0)
+        {
+            for(int b = 0; b < selected[last]->bucketCount; b++)
+            {
+                histogram[selected[last]->buckets[b].index] += selected[last]->buckets[b].count;
+            }
+            stays += selected[last]->count;
+            staySeconds += selected[last]->staySeconds;
+            last++;
+        }
+
+        char key[MAX_DIAGNOSIS_LENGTH + 1];
+        switch(grouping)
+        {
+            case GROUP_MONTH:
+                formatMonthNumber(selected[first]->month, key);
+                break;
+            case GROUP_DIAGNOSIS:
+                snprintf(key, sizeof(key), "%s", selected[first]->diagnosis);
+                break;
+            case GROUP_ROOM:
+                snprintf(key, sizeof(key), "%d", selected[first]->room);
+                break;
+            default:
+                snprintf(key, sizeof(key), "All discharges");
+                break;
+        }
+
+        printStayRow(sink, key, histogram, stays, staySeconds);
+        first = last;
+    }
+
+    sinkPrintf(sink, "%s", SEPARATOR_LINE);
+    free(selected);
+    free(histogram);
+}
+
+/*
+ * Prints one group's count, mean and percentiles.
+ */
+static void printStayRow(ReportSink *sink, const char *key, const long long histogram[], long long count,
+                         double staySeconds)
+{
+    sinkPrintf(sink, "%-24.24s| %-8lld| %-8.2f| %-8.2f| %-8.2f| %.2f\n", key, count,
+               staySeconds / count / SECONDS_PER_MIN / MINUTES_PER_DAY, percentileDays(histogram, count, 0.5),
+               percentileDays(histogram, count, 0.9), percentileDays(histogram, count, 0.99));
+}
@@ -0,0 +1,42 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the length-of-stay statistics. Every completed
+ *          stay is added to a histogram sketch for its discharge month,
+ *          overall and for its diagnosis and room. Sketches are mergeable,
+ *          so the mean and percentiles of any run of months come from
+ *          merging that run's sketches rather than rescanning the archive.
+ *          The sketches are kept in stay_sketches.dat and updated as each
+ *          discharge is archived.
+ */
+
+#ifndef STAY_STATS_H
+#define STAY_STATS_H
+
+#include "patient_management.h"
+
+/*
+ * Function: stayStatsRecordDischarges
+ * -----------------------------------
+ * Adds newly archived discharges to their month's sketches. The sketches
+ * are saved to stay_sketches.dat once enough records have been added; newer
+ * records are read back from the end of the archive when they are loaded.
+ *
+ * records: The discharge records, in the order they were archived
+ * firstArchiveRecord: Position of records[0] in discharged_patients.dat
+ * count: Number of records
+ *
+ * Returns: 1 if the sketches are up to date, 0 otherwise
+ */
+int stayStatsRecordDischarges(const DischargedPatient records[], long firstArchiveRecord, int count);
+
+/*
+ * Function: displayStayReport
+ * ---------------------------
+ * Prompts for a range of months and a grouping, then shows the count, mean,
+ * median, 90th and 99th percentile length of stay of each group and appends
+ * the report to stay_reports.txt.
+ */
+void displayStayReport(void);
+
+#endif // STAY_STATS_H
@@ -0,0 +1,134 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the shared treap operations. Every change
+ *          is made by rotations, and each rotation recomputes the augmented
+ *          value of the two nodes it moves, lower one first.
+ */
+
+#include "treap.h"
+#include <stddef.h>
+
+// Function prototypes for internal helper functions
+static TreapLink *rotateLeft(TreapLink *node, TreapUpdate update);
+static TreapLink *rotateRight(TreapLink *node, TreapUpdate update);
+
+/*
+ * One xorshift step.
+ */
+unsigned int treapNextPriority(unsigned int *state)
+{
+    unsigned int value = *state;
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    *state = value;
+    return value;
+}
+
+/*
+ * Inserts by order, rotating the node up while its priority is higher than
+ * its parent's.
+ */
+TreapLink *treapInsert(TreapLink *root, TreapLink *node, TreapCompare compare, TreapUpdate update)
+{
+    if(root == NULL)
+    {
+        node->left  = NULL;
+        node->right = NULL;
+        update(node);
+        return node;
+    }
+
+    if(compare(node, root) < 0)
+    {
+        root->left = treapInsert(root->left, node, compare, update);
+        if(root->left->priority > root->priority)
+        {
+            return rotateRight(root, update);
+        }
+    }
+    else
+    {
+        root->right = treapInsert(root->right, node, compare, update);
+        if(root->right->priority > root->priority)
+        {
+            return rotateLeft(root, update);
+        }
+    }
+
+    update(root);
+    return root;
+}
+
+/*
+ * Finds the node by order, then rotates it down towards its higher-priority
+ * child until one side is empty and the other child takes its place.
+ */
+TreapLink *treapRemove(TreapLink *root, const TreapLink *node, TreapCompare compare, TreapUpdate update)
+{
+    if(root == NULL)
+    {
+        return NULL;
+    }
+
+    if(root != node)
+    {
+        if(compare(node, root) < 0)
+        {
+            root->left = treapRemove(root->left, node, compare, update);
+        }
+        else
+        {
+            root->right = treapRemove(root->right, node, compare, update);
+        }
+        update(root);
+        return root;
+    }
+
+    if(root->left == NULL || root->right == NULL)
+    {
+        return root->left != NULL ? root->left : root->right;
+    }
+
+    TreapLink *newRoot;
+    if(root->left->priority > root->right->priority)
+    {
+        newRoot        = rotateRight(root, update);
+        newRoot->right = treapRemove(root, node, compare, update);
+    }
+    else
+    {
+        newRoot       = rotateLeft(root, update);
+        newRoot->left = treapRemove(root, node, compare, update);
+    }
+
+    update(newRoot);
+    return newRoot;
+}
+
+/*
+ * Rotates a node's right child above it. Returns the new subtree root.
+ */
+static TreapLink *rotateLeft(TreapLink *node, TreapUpdate update)
+{
+    TreapLink *newRoot = node->right;
+    node->right        = newRoot->left;
+    newRoot->left      = node;
+    update(node);
+    update(newRoot);
+    return newRoot;
+}
+
+/*
+ * Rotates a node's left child above it. Returns the new subtree root.
+ */
+static TreapLink *rotateRight(TreapLink *node, TreapUpdate update)
+{
+    TreapLink *newRoot = node->left;
+    node->left         = newRoot->right;
+    newRoot->right     = node;
+    update(node);
+    update(newRoot);
+    return newRoot;
+}
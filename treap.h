@@ -0,0 +1,80 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the treap shared by the sorted indexes. A treap
+ *          is a binary search tree that also keeps a random priority per
+ *          node in heap order, which keeps it balanced in expectation.
+ *          The links are embedded as the first member of the owner's node,
+ *          so each index keeps its own key, augmented value and searches,
+ *          while insertion, removal and the rotations live here.
+ */
+
+#ifndef TREAP_H
+#define TREAP_H
+
+/*
+ * The links of one treap node. Embed it as the first member of a node
+ * struct, so a pointer to the node and to its links can be cast to each other.
+ */
+typedef struct TreapLink
+{
+    struct TreapLink *left;
+    struct TreapLink *right;
+    unsigned int      priority;
+} TreapLink;
+
+/*
+ * Orders two nodes: negative if a sorts before b, positive if after, and
+ * 0 only for the same entry.
+ */
+typedef int (*TreapCompare)(const TreapLink *a, const TreapLink *b);
+
+/*
+ * Recomputes a node's augmented value (a subtree size, a latest end time)
+ * from the node and its children after the links under it changed.
+ */
+typedef void (*TreapUpdate)(TreapLink *node);
+
+/*
+ * Function: treapNextPriority
+ * ---------------------------
+ * Produces the next priority with a xorshift generator, so a treap does not
+ * disturb the program's rand() sequence.
+ *
+ * state: The generator state, which must start non-zero
+ *
+ * Returns: The next priority
+ */
+unsigned int treapNextPriority(unsigned int *state);
+
+/*
+ * Function: treapInsert
+ * ---------------------
+ * Inserts a node whose priority is set, rotating it up while its priority
+ * is higher than its parent's. Equal entries go to the right.
+ *
+ * root: The root of the treap (may be NULL)
+ * node: The node to insert
+ * compare: Orders the nodes
+ * update: Recomputes a node's augmented value
+ *
+ * Returns: The new root
+ */
+TreapLink *treapInsert(TreapLink *root, TreapLink *node, TreapCompare compare, TreapUpdate update);
+
+/*
+ * Function: treapRemove
+ * ---------------------
+ * Unlinks a node, rotating it down until it has at most one child. The
+ * node itself is not freed.
+ *
+ * root: The root of the treap
+ * node: The node to unlink, which must be in the treap
+ * compare: Orders the nodes
+ * update: Recomputes a node's augmented value
+ *
+ * Returns: The new root
+ */
+TreapLink *treapRemove(TreapLink *root, const TreapLink *node, TreapCompare compare, TreapUpdate update);
+
+#endif // TREAP_H
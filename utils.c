@@ -4,9 +4,36 @@
  * Purpose: Utility functions for general use across the hospital management system.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "utils.h"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Private constants
+static const int INVALID_LIST  = -1;
+static const int EPOCH_YEAR    = 1970;
+static const int TM_BASE_YEAR  = 1900;
+static const int DAYS_PER_ERA  = 146097;
+static const int YEARS_PER_ERA = 400;
+static const int MAX_MONTH     = 12;
+static const int MAX_HOUR      = 23;
+static const int MAX_MINUTE    = 59;
+static const int DAYS_PER_WEEK = 7;
+static const int EPOCH_WEEKDAY = 3; // January 1, 1970 was a Thursday
+
+#define DATE_INPUT_LENGTH 64
+
 /*
  * Function: clearInputBuffer
  * --------------------------
@@ -17,3 +44,374 @@ void clearInputBuffer()
 {
     while (getchar() != '\n'); // Consume characters until a newline is found
 }
+
+/*
+ * Function: parseIntegerList
+ * --------------------------
+ * Parses whole numbers separated by spaces and/or commas, rejecting any other text,
+ * numbers outside the range of an int, and numbers run together like "1-2".
+ */
+int parseIntegerList(const char *text, int values[], int maxValues)
+{
+    int count = 0;
+
+    while(*text != '\0')
+    {
+        if(isspace((unsigned char) *text) || *text == ',')
+        {
+            text++;
+            continue;
+        }
+
+        char *end;
+        long  value;
+
+        errno = 0;
+        value = strtol(text, &end, 10);
+
+        if(end == text || count == maxValues || errno == ERANGE || value > INT_MAX || value < INT_MIN ||
+           (*end != '\0' && *end != ',' && !isspace((unsigned char) *end)))
+        {
+            return INVALID_LIST;
+        }
+
+        values[count++] = (int) value;
+        text            = end;
+    }
+
+    return count;
+}
+
+/*
+ * Function: toDayNumber
+ * ---------------------
+ * Converts a timestamp to whole local calendar days since January 1, 1970,
+ * using the proleptic Gregorian calendar so no table lookups are needed.
+ */
+int toDayNumber(time_t timestamp)
+{
+    struct tm *local = localtime(&timestamp);
+
+    int year  = local->tm_year + TM_BASE_YEAR;
+    int month = local->tm_mon + 1;
+    int day   = local->tm_mday;
+
+    // Count years from March so the leap day falls at the end of the year
+    year -= month <= 2;
+
+    int era       = (year >= 0 ? year : year - (YEARS_PER_ERA - 1)) / YEARS_PER_ERA;
+    int yearOfEra = year - era * YEARS_PER_ERA;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra  = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+    return era * DAYS_PER_ERA + dayOfEra - 719468;
+}
+
+/*
+ * Function: dayNumberToTime
+ * -------------------------
+ * Converts a day number back to the local midnight that starts it.
+ */
+time_t dayNumberToTime(int dayNumber)
+{
+    struct tm date = { 0 };
+
+    date.tm_year  = EPOCH_YEAR - TM_BASE_YEAR;
+    date.tm_mon   = 0;
+    date.tm_mday  = 1 + dayNumber; // mktime normalizes the overflowing day
+    date.tm_isdst = -1;
+
+    return mktime(&date);
+}
+
+/*
+ * Function: dayOfWeek
+ * -------------------
+ * Returns the weekday of a day number, counting Monday as 0.
+ */
+int dayOfWeek(int dayNumber)
+{
+    int weekday = (dayNumber + EPOCH_WEEKDAY) % DAYS_PER_WEEK;
+    return weekday < 0 ? weekday + DAYS_PER_WEEK : weekday;
+}
+
+/*
+ * Function: parseDateTime
+ * -----------------------
+ * Parses "YYYY-MM-DD" or "YYYY-MM-DD HH:MM" as a local time. Dates that do
+ * not exist (such as February 30) are rejected rather than normalized.
+ */
+int parseDateTime(const char *text, time_t *result)
+{
+    int  year, month, day;
+    int  hour   = 0;
+    int  minute = 0;
+    char trailing;
+
+    int fields = sscanf(text, " %d-%d-%d %d:%d %c", &year, &month, &day, &hour, &minute, &trailing);
+
+    if(fields != 3 && fields != 5)
+    {
+        return 0;
+    }
+
+    if(month < 1 || month > MAX_MONTH || day < 1 || hour < 0 || hour > MAX_HOUR ||
+       minute < 0 || minute > MAX_MINUTE)
+    {
+        return 0;
+    }
+
+    struct tm date = { 0 };
+    date.tm_year   = year - TM_BASE_YEAR;
+    date.tm_mon    = month - 1;
+    date.tm_mday   = day;
+    date.tm_hour   = hour;
+    date.tm_min    = minute;
+    date.tm_isdst  = -1;
+
+    time_t timestamp = mktime(&date);
+
+    // mktime rolls invalid days into the next month; reject those
+    if(timestamp == (time_t) -1 || date.tm_mday != day || date.tm_mon != month - 1)
+    {
+        return 0;
+    }
+
+    *result = timestamp;
+    return 1;
+}
+
+/*
+ * Function: promptDateTime
+ * ------------------------
+ * Reads lines until a valid date is entered; an empty line selects the default.
+ */
+time_t promptDateTime(const char *prompt, time_t defaultTime)
+{
+    char   line[DATE_INPUT_LENGTH];
+    time_t result;
+
+    while(1)
+    {
+        printf("%s", prompt);
+
+        if(fgets(line, sizeof(line), stdin) == NULL)
+        {
+            return defaultTime;
+        }
+
+        if(strchr(line, '\n') == NULL)
+        {
+            clearInputBuffer();
+        }
+
+        if(line[strspn(line, " \t\n")] == '\0')
+        {
+            return defaultTime;
+        }
+
+        if(parseDateTime(line, &result))
+        {
+            return result;
+        }
+
+        printf("Invalid date. Please use YYYY-MM-DD or YYYY-MM-DD HH:MM.\n");
+    }
+}
+
+/*
+ * Function: promptMonth
+ * ---------------------
+ * Reads lines until a valid month is entered; an empty line selects the default.
+ */
+int promptMonth(const char *prompt, int defaultMonth)
+{
+    char line[DATE_INPUT_LENGTH];
+    int  year;
+    int  month;
+
+    while(1)
+    {
+        printf("%s", prompt);
+
+        if(fgets(line, sizeof(line), stdin) == NULL)
+        {
+            return defaultMonth;
+        }
+
+        if(strchr(line, '\n') == NULL)
+        {
+            clearInputBuffer();
+        }
+
+        if(line[strspn(line, " \t\n")] == '\0')
+        {
+            return defaultMonth;
+        }
+
+        if(sscanf(line, "%d-%d", &year, &month) == 2 && year > 0 && month >= 1 && month <= MAX_MONTH)
+        {
+            return year * MAX_MONTH + month - 1;
+        }
+
+        printf("Invalid month. Please use YYYY-MM.\n");
+    }
+}
+
+/*
+ * Function: promptNumber
+ * ----------------------
+ * Reads a whole number in [min, max], asking again until one is entered.
+ */
+int promptNumber(const char *prompt, int min, int max)
+{
+    int value;
+
+    while(1)
+    {
+        printf("%s", prompt);
+        if(scanf("%d", &value) != SUCCESSFUL_READ)
+        {
+            printf("Invalid input. Please enter a number.\n");
+            clearInputBuffer();
+            continue;
+        }
+        clearInputBuffer();
+
+        if(value >= min && value <= max)
+        {
+            return value;
+        }
+        printf("Please enter a number between %d and %d.\n", min, max);
+    }
+}
+
+/*
+ * Function: formatMonthNumber
+ * ---------------------------
+ * Splits the month number back into its year and month.
+ */
+void formatMonthNumber(int month, char text[])
+{
+    snprintf(text, MONTH_TEXT_LENGTH, "%d-%02d", month / MAX_MONTH, month % MAX_MONTH + 1);
+}
+
+/*
+ * Function: normaliseText
+ * -----------------------
+ * Copies the text lowercased, keeping one space between words.
+ */
+void normaliseText(const char *text, char normalised[], size_t size)
+{
+    size_t length = 0;
+
+    for(; *text != '\0' && length + 1 < size; text++)
+    {
+        if(isspace((unsigned char) *text))
+        {
+            if(length > 0 && normalised[length - 1] != ' ')
+            {
+                normalised[length++] = ' ';
+            }
+        }
+        else
+        {
+            normalised[length++] = (char) tolower((unsigned char) *text);
+        }
+    }
+
+    if(length > 0 && normalised[length - 1] == ' ')
+    {
+        length--;
+    }
+    normalised[length] = '\0';
+}
+
+/*
+ * Function: hashBytes
+ * -------------------
+ * One FNV-1a step per byte.
+ */
+uint32_t hashBytes(uint32_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/*
+ * Function: hashString
+ * --------------------
+ * One FNV-1a step per character.
+ */
+uint32_t hashString(uint32_t hash, const char *text)
+{
+    for(; *text != '\0'; text++)
+    {
+        hash = (hash ^ (unsigned char) *text) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/*
+ * Function: replaceFile
+ * ---------------------
+ * Renames source over target. POSIX rename replaces the target in one
+ * step; Windows will not rename over an existing file, so it is removed
+ * first there.
+ */
+int replaceFile(const char *source, const char *target)
+{
+#ifdef _WIN32
+    if(remove(target) != 0 && errno != ENOENT)
+    {
+        return 0;
+    }
+#endif
+    return rename(source, target) == 0;
+}
+
+/*
+ * Function: truncateFile
+ * ----------------------
+ * Cuts a file back to the given length.
+ */
+int truncateFile(const char *fileName, long length)
+{
+#ifdef _WIN32
+    FILE *file = fopen(fileName, "r+b");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    int truncated = _chsize(_fileno(file), length) == 0;
+    return fclose(file) == 0 && truncated;
+#else
+    return truncate(fileName, (off_t) length) == 0;
+#endif
+}
+
+/*
+ * Function: flushToDisk
+ * ---------------------
+ * Flushes a stream's buffer and asks the system to write it to disk.
+ */
+int flushToDisk(FILE *file)
+{
+    if(fflush(file) != 0)
+    {
+        return 0;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
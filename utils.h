@@ -14,6 +14,18 @@
 #define YES 'y'
 #define NO 'n'
 
+// Length of a "YYYY-MM" month string, including the terminator
+#define MONTH_TEXT_LENGTH 16
+
+// FNV-1a parameters, used with hashBytes and hashString
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
 /*
  * Function: clearInputBuffer
  * --------------------------
@@ -21,4 +33,191 @@
  */
 void clearInputBuffer(void);
 
+/*
+ * Function: parseIntegerList
+ * --------------------------
+ * Parses whole numbers separated by spaces and/or commas.
+ *
+ * text: The text to parse
+ * values: Output array for the parsed numbers
+ * maxValues: Capacity of values[]
+ *
+ * Returns: The number of values parsed, or -1 if the text contains
+ *          something other than separated numbers, a number that does not
+ *          fit in an int, or more than maxValues numbers
+ */
+int parseIntegerList(const char *text, int values[], int maxValues);
+
+/*
+ * Function: toDayNumber
+ * ---------------------
+ * Converts a timestamp to the number of whole local calendar days
+ * since January 1, 1970, so each date maps to one integer bucket.
+ *
+ * timestamp: The time to convert
+ *
+ * Returns: The local day number
+ */
+int toDayNumber(time_t timestamp);
+
+/*
+ * Function: dayNumberToTime
+ * -------------------------
+ * Converts a day number back to the local midnight that starts it.
+ *
+ * dayNumber: The day number to convert
+ *
+ * Returns: The timestamp of local midnight on that day
+ */
+time_t dayNumberToTime(int dayNumber);
+
+/*
+ * Function: dayOfWeek
+ * -------------------
+ * Finds the weekday of a day number.
+ *
+ * dayNumber: The day number (see toDayNumber)
+ *
+ * Returns: 0 for Monday through 6 for Sunday
+ */
+int dayOfWeek(int dayNumber);
+
+/*
+ * Function: parseDateTime
+ * -----------------------
+ * Parses a local date written as "YYYY-MM-DD" or "YYYY-MM-DD HH:MM".
+ *
+ * text: The text to parse
+ * result: Receives the timestamp (midnight when no time is given)
+ *
+ * Returns: 1 if the text is a valid date, 0 otherwise
+ */
+int parseDateTime(const char *text, time_t *result);
+
+/*
+ * Function: promptDateTime
+ * ------------------------
+ * Prints a prompt and reads lines until a valid date is entered.
+ * An empty line selects the given default.
+ *
+ * prompt: Text to display before reading
+ * defaultTime: Value used when the user just presses Enter
+ *
+ * Returns: The entered timestamp
+ */
+time_t promptDateTime(const char *prompt, time_t defaultTime);
+
+/*
+ * Function: promptMonth
+ * ---------------------
+ * Prints a prompt and reads lines until a month is entered as "YYYY-MM".
+ * An empty line selects the given default. Months are numbered
+ * year * 12 + month - 1, so consecutive months have consecutive numbers.
+ *
+ * prompt: Text to display before reading
+ * defaultMonth: Month number used when the user just presses Enter
+ *
+ * Returns: The entered month number
+ */
+int promptMonth(const char *prompt, int defaultMonth);
+
+/*
+ * Function: promptNumber
+ * ----------------------
+ * Prints a prompt and reads lines until a whole number in [min, max] is
+ * entered.
+ *
+ * prompt: Text to display before reading
+ * min: Smallest accepted value
+ * max: Largest accepted value
+ *
+ * Returns: The entered number
+ */
+int promptNumber(const char *prompt, int min, int max);
+
+/*
+ * Function: formatMonthNumber
+ * ---------------------------
+ * Writes a month number (see promptMonth) as "YYYY-MM".
+ *
+ * month: The month number
+ * text: Receives the text (at least MONTH_TEXT_LENGTH bytes)
+ */
+void formatMonthNumber(int month, char text[]);
+
+/*
+ * Function: normaliseText
+ * -----------------------
+ * Lowercases free text and collapses runs of whitespace to one space, with
+ * none at either end, so variants of the same diagnosis compare equal.
+ *
+ * text: The text to normalise
+ * normalised: Receives the result
+ * size: Size of normalised in bytes
+ */
+void normaliseText(const char *text, char normalised[], size_t size);
+
+/*
+ * Function: hashBytes
+ * -------------------
+ * Folds bytes into a 32-bit FNV-1a hash. Start from FNV_OFFSET_BASIS, or
+ * from an earlier result to hash several values as one.
+ *
+ * hash: The hash so far
+ * data: The bytes to fold in
+ * size: Number of bytes
+ *
+ * Returns: The updated hash
+ */
+uint32_t hashBytes(uint32_t hash, const void *data, size_t size);
+
+/*
+ * Function: hashString
+ * --------------------
+ * Folds the characters of a string, without its terminator, into a 32-bit
+ * FNV-1a hash (see hashBytes).
+ *
+ * hash: The hash so far
+ * text: The string to fold in
+ *
+ * Returns: The updated hash
+ */
+uint32_t hashString(uint32_t hash, const char *text);
+
+/*
+ * Function: replaceFile
+ * ---------------------
+ * Moves a completed temporary file over the file it replaces, so readers
+ * see either the old file or the new one.
+ *
+ * source: The temporary file
+ * target: The file to replace (need not exist)
+ *
+ * Returns: 1 on success, 0 on failure with errno set
+ */
+int replaceFile(const char *source, const char *target);
+
+/*
+ * Function: truncateFile
+ * ----------------------
+ * Cuts a file back to a length, dropping anything written after it.
+ *
+ * fileName: The file to truncate
+ * length: The new length in bytes
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int truncateFile(const char *fileName, long length);
+
+/*
+ * Function: flushToDisk
+ * ---------------------
+ * Flushes a stream and waits until its data reaches the disk.
+ *
+ * file: The stream to flush
+ *
+ * Returns: 1 on success, 0 on failure
+ */
+int flushToDisk(FILE *file);
+
 #endif // UTILS_H
@@ -0,0 +1,926 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file implements the admission waitlist.
+ *          Entries live in a slot array (waitlist number = slot + 1) and each
+ *          slot records which heap holds it and where, so an entry can be
+ *          reprioritised or removed without searching the heap.
+ *          waitlist.dat holds a small header followed by the waiting entries.
+ *          Each later change is appended to waitlist.log instead of rewriting
+ *          waitlist.dat; once the log holds more changes than there are
+ *          entries waiting, it is folded into a new waitlist.dat. Both files
+ *          carry a generation number, so a log that was already folded in is
+ *          ignored if a crash leaves it behind.
+ */
+
+#include "waitlist.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+// Private constants
+#define INITIAL_SLOT_CAPACITY 16
+#define WAIT_NUMBER_OFFSET 1
+#define MIN_COMPACT_CHANGES 64
+#define CHANGE_ADDED 1
+#define CHANGE_REMOVED 2
+#define CHANGE_PRIORITY 3
+
+static const char  WAITLIST_MAGIC[4]     = { 'W', 'L', 'S', 'T' };
+static const int   WAITLIST_VERSION      = 2;
+static const int   LEGACY_VERSION        = 1;
+static const char  WAITLIST_LOG_MAGIC[4] = { 'W', 'L', 'O', 'G' };
+static const char *WAITLIST_FILE         = "waitlist.dat";
+static const char *WAITLIST_TEMP         = "waitlist.tmp";
+static const char *WAITLIST_LOG          = "waitlist.log";
+
+/*
+ * Header at the start of waitlist.dat, followed by count WaitingPatient records.
+ * Version 1 files end the header before the generation, which is then 0.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    int       count;
+    long long nextSequence;
+    long long generation;
+} WaitlistHeader;
+
+/*
+ * Header at the start of waitlist.log. The log only applies to the
+ * waitlist.dat of the same generation.
+ */
+typedef struct
+{
+    char      magic[4];
+    int       version;
+    long long generation;
+} WaitlistLogHeader;
+
+/*
+ * One change in waitlist.log, followed by the whole WaitingPatient when an
+ * entry was added. The sequence identifies the entry, since waitlist
+ * numbers are reused.
+ */
+typedef struct
+{
+    int       kind;
+    int       waitNumber;
+    long long sequence;
+    int       priority;
+} WaitlistChange;
+
+/*
+ * One waitlist slot and its place in the heaps.
+ */
+typedef struct
+{
+    WaitingPatient patient;
+    int            heap;
+    int            position;
+    int            inUse;
+} WaitSlot;
+
+/*
+ * A binary min-heap of slot indexes, most urgent first.
+ */
+typedef struct
+{
+    int *items;
+    int  count;
+    int  capacity;
+} WaitHeap;
+
+static WaitSlot  *slots         = NULL;
+static int        slotCapacity  = 0;
+static int       *freeSlots     = NULL;
+static int        freeCount     = 0;
+static WaitHeap  *heaps         = NULL;
+static int        heapCount     = 0;
+static int        waitingCount  = 0;
+static long long  nextSequence  = 1;
+static long long  generation    = 0;
+static int        logChanges    = 0;
+
+// Function prototypes for internal helper functions
+static int  loadWaitlistFile(void);
+static int  replayWaitlistLog(void);
+static int  restoreEntry(WaitingPatient patient);
+static int  findEntry(int waitNumber, long long sequence);
+static int  saveWaitlistFile(long long fileGeneration);
+static int  appendChange(int kind, const WaitingPatient *patient);
+static void compactWaitlist(void);
+static void setPriority(int slot, int priority);
+static void dropEntry(int slot);
+static int  claimSlot(int preferredSlot);
+static void releaseSlot(int slot);
+static int  growSlots(int minimumCapacity);
+static int  heapForWard(const char wardName[]);
+static int  isMoreUrgent(int leftSlot, int rightSlot);
+static int  heapPush(int heapIndex, int slot);
+static void heapRemove(int slot);
+static void siftUp(WaitHeap *heap, int position);
+static void siftDown(WaitHeap *heap, int position);
+static void placeAt(WaitHeap *heap, int position, int slot);
+static int  compareWaitOrder(const void *a, const void *b);
+static int  promptWaitNumber(void);
+
+/*
+ * Creates one heap per ward plus the any-ward heap and loads waitlist.dat.
+ */
+void initializeWaitlist(void)
+{
+    heapCount = facilityWardCount() + 1;
+    heaps     = calloc(heapCount, sizeof(WaitHeap));
+
+    if(heaps == NULL || !growSlots(INITIAL_SLOT_CAPACITY))
+    {
+        puts("Error: Not enough memory for the waitlist.");
+        heapCount = 0;
+        return;
+    }
+
+    int loaded = loadWaitlistFile();
+
+    // Fold any changes from the last session into a fresh waitlist.dat
+    if(replayWaitlistLog())
+    {
+        compactWaitlist();
+        loaded = 1;
+    }
+
+    if(loaded && waitingCount > 0)
+    {
+        printf("Waitlist loaded: %d patients waiting.\n", waitingCount);
+    }
+}
+
+/*
+ * Prompts for a triage priority and queues the patient.
+ */
+int waitlistPatient(const char name[], int age, const char diagnosis[], int wardIndex)
+{
+    if(heapCount == 0)
+    {
+        puts("The waitlist is not available.");
+        return NO_WAITLIST_ENTRY;
+    }
+
+    int priority = promptNumber("Enter triage priority (1 = most urgent, 5 = routine):\n", MIN_WAIT_PRIORITY,
+                                MAX_WAIT_PRIORITY);
+    int slot     = claimSlot(NO_WAITLIST_ENTRY);
+
+    if(slot == NO_WAITLIST_ENTRY)
+    {
+        puts("Error: Not enough memory to add the patient to the waitlist.");
+        return NO_WAITLIST_ENTRY;
+    }
+
+    WaitingPatient *patient = &slots[slot].patient;
+
+    memset(patient, 0, sizeof(*patient));
+    patient->waitNumber = slot + WAIT_NUMBER_OFFSET;
+    strncpy(patient->name, name, MAX_PATIENT_NAME_LENGTH - 1);
+    patient->age = age;
+    strncpy(patient->diagnosis, diagnosis, MAX_DIAGNOSIS_LENGTH - 1);
+    patient->priority = priority;
+    strncpy(patient->wardName, wardIndex == NO_WARD ? "" : facilityWardName(wardIndex), MAX_WARD_NAME_LENGTH - 1);
+    patient->sequence  = nextSequence++;
+    patient->arrivedAt = time(NULL);
+
+    if(!heapPush(wardIndex == NO_WARD ? heapCount - 1 : wardIndex, slot))
+    {
+        releaseSlot(slot);
+        puts("Error: Not enough memory to add the patient to the waitlist.");
+        return NO_WAITLIST_ENTRY;
+    }
+
+    appendChange(CHANGE_ADDED, patient);
+    printf("%s added to the waitlist as number %d (%d waiting).\n", patient->name, patient->waitNumber,
+           waitingCount);
+    return patient->waitNumber;
+}
+
+/*
+ * Finds the most urgent patient eligible for the room's ward, leaving them
+ * on the list.
+ */
+int waitlistPeekForRoom(int roomNumber, WaitingPatient *patient)
+{
+    int wardIndex = facilityRoomWard(roomNumber);
+    if(wardIndex == NO_WARD || heapCount == 0)
+    {
+        return 0;
+    }
+
+    const WaitHeap *wardHeap = &heaps[wardIndex];
+    const WaitHeap *anyHeap  = &heaps[heapCount - 1];
+    int             chosen   = NO_WAITLIST_ENTRY;
+
+    if(wardHeap->count > 0)
+    {
+        chosen = wardHeap->items[0];
+    }
+    if(anyHeap->count > 0 && (chosen == NO_WAITLIST_ENTRY || isMoreUrgent(anyHeap->items[0], chosen)))
+    {
+        chosen = anyHeap->items[0];
+    }
+
+    if(chosen == NO_WAITLIST_ENTRY)
+    {
+        return 0;
+    }
+
+    *patient = slots[chosen].patient;
+    return 1;
+}
+
+/*
+ * Removes an entry by waitlist number and sequence and logs the removal.
+ */
+int waitlistRemoveEntry(const WaitingPatient *patient)
+{
+    int slot = findEntry(patient->waitNumber, patient->sequence);
+    if(slot == NO_WAITLIST_ENTRY)
+    {
+        return 0;
+    }
+
+    dropEntry(slot);
+    return 1;
+}
+
+/*
+ * Returns the number of patients waiting.
+ */
+int waitlistSize(void)
+{
+    return waitingCount;
+}
+
+/*
+ * Prints the waiting patients, most urgent first.
+ */
+void displayWaitlist(void)
+{
+    if(waitingCount == 0)
+    {
+        puts("Nobody is on the waitlist.");
+        return;
+    }
+
+    int *order = malloc(waitingCount * sizeof(int));
+    if(order == NULL)
+    {
+        puts("Error: Not enough memory to display the waitlist.");
+        return;
+    }
+
+    int count = 0;
+    for(int slot = 0; slot < slotCapacity; slot++)
+    {
+        if(slots[slot].inUse)
+        {
+            order[count++] = slot;
+        }
+    }
+
+    qsort(order, count, sizeof(int), compareWaitOrder);
+
+    printf("\n--- Admission Waitlist ---\n");
+    printf("No.  | Priority | Ward                 | Waiting Since    | Name\n");
+    printf("-----|----------|----------------------|------------------|---------------------\n");
+
+    for(int i = 0; i < count; i++)
+    {
+        const WaitingPatient *patient = &slots[order[i]].patient;
+        char                  since[20];
+
+        strftime(since, sizeof(since), "%Y-%m-%d %H:%M", localtime(&patient->arrivedAt));
+        printf("%-4d | %-8d | %-20s | %-16s | %s\n", patient->waitNumber, patient->priority,
+               patient->wardName[0] == '\0' ? "Any" : patient->wardName, since, patient->name);
+    }
+
+    printf("-------------------------\n");
+    printf("Patients waiting: %d\n", count);
+    free(order);
+}
+
+/*
+ * Prompts for a waitlist number and moves the entry to its new priority.
+ */
+void changeWaitlistPriority(void)
+{
+    int slot = promptWaitNumber();
+    if(slot == NO_WAITLIST_ENTRY)
+    {
+        return;
+    }
+
+    WaitingPatient *patient  = &slots[slot].patient;
+    int             previous = patient->priority;
+
+    setPriority(slot, promptNumber("Enter new triage priority (1 = most urgent, 5 = routine):\n",
+                                   MIN_WAIT_PRIORITY, MAX_WAIT_PRIORITY));
+
+    appendChange(CHANGE_PRIORITY, patient);
+    printf("Priority of %s changed from %d to %d.\n", patient->name, previous, patient->priority);
+}
+
+/*
+ * Prompts for a waitlist number and drops the entry.
+ */
+void removeFromWaitlist(void)
+{
+    int slot = promptWaitNumber();
+    if(slot == NO_WAITLIST_ENTRY)
+    {
+        return;
+    }
+
+    printf("%s removed from the waitlist.\n", slots[slot].patient.name);
+    dropEntry(slot);
+}
+
+/*
+ * Reads waitlist.dat and rebuilds the heaps. Returns 0 if there is no valid file.
+ */
+static int loadWaitlistFile(void)
+{
+    FILE *file = fopen(WAITLIST_FILE, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    // Version 1 headers stop before the generation
+    WaitlistHeader header;
+    size_t         legacySize = offsetof(WaitlistHeader, generation);
+
+    header.generation = 0;
+    if(fread(&header, legacySize, 1, file) != 1 ||
+       memcmp(header.magic, WAITLIST_MAGIC, sizeof(WAITLIST_MAGIC)) != 0 ||
+       (header.version != WAITLIST_VERSION && header.version != LEGACY_VERSION) || header.count < 0 ||
+       (header.version == WAITLIST_VERSION &&
+        fread(&header.generation, sizeof(header.generation), 1, file) != 1))
+    {
+        puts("Error reading waitlist.dat. Starting with an empty waitlist.");
+        fclose(file);
+        return 0;
+    }
+
+    nextSequence = header.nextSequence;
+    generation   = header.generation;
+
+    WaitingPatient patient;
+    for(int i = 0; i < header.count && fread(&patient, sizeof(patient), 1, file) == 1; i++)
+    {
+        if(!restoreEntry(patient))
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/*
+ * Applies the changes in waitlist.log made since waitlist.dat was written.
+ * A torn last change is cut off. Returns 1 if the log held any changes.
+ */
+static int replayWaitlistLog(void)
+{
+    FILE *file = fopen(WAITLIST_LOG, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    WaitlistLogHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, WAITLIST_LOG_MAGIC, sizeof(WAITLIST_LOG_MAGIC)) != 0 ||
+       header.version != WAITLIST_VERSION || header.generation != generation)
+    {
+        // Already folded into waitlist.dat, or never finished; the next change starts a new log
+        fclose(file);
+        return 0;
+    }
+
+    long           goodLength = ftell(file);
+    WaitlistChange change;
+    WaitingPatient patient;
+
+    while(fread(&change, sizeof(change), 1, file) == 1)
+    {
+        if(change.kind == CHANGE_ADDED)
+        {
+            if(fread(&patient, sizeof(patient), 1, file) != 1)
+            {
+                break;
+            }
+            if(findEntry(patient.waitNumber, patient.sequence) == NO_WAITLIST_ENTRY)
+            {
+                restoreEntry(patient);
+            }
+        }
+        else
+        {
+            int slot = findEntry(change.waitNumber, change.sequence);
+
+            if(slot != NO_WAITLIST_ENTRY && change.kind == CHANGE_REMOVED)
+            {
+                heapRemove(slot);
+                releaseSlot(slot);
+            }
+            else if(slot != NO_WAITLIST_ENTRY && change.kind == CHANGE_PRIORITY)
+            {
+                setPriority(slot, change.priority);
+            }
+        }
+
+        goodLength = ftell(file);
+        logChanges++;
+    }
+
+    int torn = !feof(file) || ftell(file) != goodLength;
+    fclose(file);
+
+    if(torn && !truncateFile(WAITLIST_LOG, goodLength))
+    {
+        perror("Error cutting a torn change off waitlist.log");
+    }
+
+    return logChanges > 0;
+}
+
+/*
+ * Puts a saved entry back on its heap, keeping its waitlist number when the
+ * slot is free. Returns 0 if memory runs out.
+ */
+static int restoreEntry(WaitingPatient patient)
+{
+    int slot = claimSlot(patient.waitNumber - WAIT_NUMBER_OFFSET);
+    if(slot == NO_WAITLIST_ENTRY)
+    {
+        puts("Error: Not enough memory to load the waitlist.");
+        return 0;
+    }
+
+    int heapIndex = heapForWard(patient.wardName);
+    if(heapIndex == heapCount - 1 && patient.wardName[0] != '\0')
+    {
+        printf("Warning: Ward '%s' no longer exists; %s now waits for any ward.\n", patient.wardName,
+               patient.name);
+        patient.wardName[0] = '\0';
+    }
+
+    patient.waitNumber  = slot + WAIT_NUMBER_OFFSET;
+    slots[slot].patient = patient;
+
+    if(patient.sequence >= nextSequence)
+    {
+        nextSequence = patient.sequence + 1;
+    }
+
+    if(!heapPush(heapIndex, slot))
+    {
+        releaseSlot(slot);
+        puts("Error: Not enough memory to load the waitlist.");
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Returns the slot holding an entry, or NO_WAITLIST_ENTRY. The waitlist
+ * number is tried first; the sequence confirms it is still the same entry.
+ */
+static int findEntry(int waitNumber, long long sequence)
+{
+    int slot = waitNumber - WAIT_NUMBER_OFFSET;
+
+    if(slot >= 0 && slot < slotCapacity && slots[slot].inUse && slots[slot].patient.sequence == sequence)
+    {
+        return slot;
+    }
+
+    // Only reached if the entry was given another number when it was loaded
+    for(slot = 0; slot < slotCapacity; slot++)
+    {
+        if(slots[slot].inUse && slots[slot].patient.sequence == sequence)
+        {
+            return slot;
+        }
+    }
+
+    return NO_WAITLIST_ENTRY;
+}
+
+/*
+ * Writes the waitlist to a temporary file and swaps it in for waitlist.dat.
+ */
+static int saveWaitlistFile(long long fileGeneration)
+{
+    FILE *file = fopen(WAITLIST_TEMP, "wb");
+    if(file == NULL)
+    {
+        perror("Error creating waitlist.tmp");
+        return 0;
+    }
+
+    WaitlistHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, WAITLIST_MAGIC, sizeof(WAITLIST_MAGIC));
+    header.version      = WAITLIST_VERSION;
+    header.count        = waitingCount;
+    header.nextSequence = nextSequence;
+    header.generation   = fileGeneration;
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for(int slot = 0; slot < slotCapacity && written; slot++)
+    {
+        if(slots[slot].inUse)
+        {
+            written = fwrite(&slots[slot].patient, sizeof(WaitingPatient), 1, file) == 1;
+        }
+    }
+
+    if(written)
+    {
+        written = flushToDisk(file);
+    }
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing waitlist.tmp");
+        remove(WAITLIST_TEMP);
+        return 0;
+    }
+
+    if(!replaceFile(WAITLIST_TEMP, WAITLIST_FILE))
+    {
+        perror("Error renaming waitlist.tmp to waitlist.dat");
+        remove(WAITLIST_TEMP);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Appends one change to waitlist.log, starting a new log after a
+ * compaction, and compacts once the log outgrows the waitlist.
+ */
+static int appendChange(int kind, const WaitingPatient *patient)
+{
+    FILE *file = fopen(WAITLIST_LOG, logChanges == 0 ? "wb" : "ab");
+    if(file == NULL)
+    {
+        perror("Error opening waitlist.log");
+        return 0;
+    }
+
+    int written = 1;
+
+    if(logChanges == 0)
+    {
+        WaitlistLogHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, WAITLIST_LOG_MAGIC, sizeof(WAITLIST_LOG_MAGIC));
+        header.version    = WAITLIST_VERSION;
+        header.generation = generation;
+        written           = fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+
+    WaitlistChange change;
+    memset(&change, 0, sizeof(change));
+    change.kind       = kind;
+    change.waitNumber = patient->waitNumber;
+    change.sequence   = patient->sequence;
+    change.priority   = patient->priority;
+
+    written = written && fwrite(&change, sizeof(change), 1, file) == 1;
+    if(kind == CHANGE_ADDED)
+    {
+        written = written && fwrite(patient, sizeof(*patient), 1, file) == 1;
+    }
+    written = written && flushToDisk(file);
+
+    if(fclose(file) != 0 || !written)
+    {
+        perror("Error writing waitlist.log");
+        return 0;
+    }
+
+    logChanges++;
+    if(logChanges >= MIN_COMPACT_CHANGES && logChanges > waitingCount)
+    {
+        compactWaitlist();
+    }
+    return 1;
+}
+
+/*
+ * Writes the whole waitlist as the next generation of waitlist.dat, which
+ * retires the current log. On failure the log simply keeps growing.
+ */
+static void compactWaitlist(void)
+{
+    if(!saveWaitlistFile(generation + 1))
+    {
+        return;
+    }
+
+    generation++;
+    logChanges = 0;
+    remove(WAITLIST_LOG);
+}
+
+/*
+ * Gives an entry a new priority and moves it to its place in its heap.
+ */
+static void setPriority(int slot, int priority)
+{
+    int previous = slots[slot].patient.priority;
+
+    slots[slot].patient.priority = priority;
+
+    WaitHeap *heap = &heaps[slots[slot].heap];
+    if(priority < previous)
+    {
+        siftUp(heap, slots[slot].position);
+    }
+    else
+    {
+        siftDown(heap, slots[slot].position);
+    }
+}
+
+/*
+ * Takes an entry off its heap, frees its slot and logs the removal.
+ */
+static void dropEntry(int slot)
+{
+    heapRemove(slot);
+    releaseSlot(slot);
+    appendChange(CHANGE_REMOVED, &slots[slot].patient);
+}
+
+/*
+ * Takes a free slot, preferring the given one so saved waitlist numbers
+ * survive a restart. Returns NO_WAITLIST_ENTRY if memory runs out.
+ */
+static int claimSlot(int preferredSlot)
+{
+    if(preferredSlot >= 0 && (preferredSlot < slotCapacity || growSlots(preferredSlot + 1)) &&
+       !slots[preferredSlot].inUse)
+    {
+        // Take it out of the free stack
+        for(int i = 0; i < freeCount; i++)
+        {
+            if(freeSlots[i] == preferredSlot)
+            {
+                freeSlots[i] = freeSlots[--freeCount];
+                break;
+            }
+        }
+
+        slots[preferredSlot].inUse = 1;
+        waitingCount++;
+        return preferredSlot;
+    }
+
+    if(freeCount == 0 && !growSlots(slotCapacity * 2))
+    {
+        return NO_WAITLIST_ENTRY;
+    }
+
+    int slot          = freeSlots[--freeCount];
+    slots[slot].inUse = 1;
+    waitingCount++;
+    return slot;
+}
+
+/*
+ * Returns a slot to the free stack.
+ */
+static void releaseSlot(int slot)
+{
+    slots[slot].inUse      = 0;
+    freeSlots[freeCount++] = slot;
+    waitingCount--;
+}
+
+/*
+ * Grows the slot array, pushing the new slots highest first so the
+ * lowest waitlist numbers are handed out first.
+ */
+static int growSlots(int minimumCapacity)
+{
+    int newCapacity = slotCapacity == 0 ? INITIAL_SLOT_CAPACITY : slotCapacity;
+    while(newCapacity < minimumCapacity)
+    {
+        newCapacity *= 2;
+    }
+
+    if(newCapacity == slotCapacity && slots != NULL)
+    {
+        return 1;
+    }
+
+    WaitSlot *grownSlots = realloc(slots, newCapacity * sizeof(WaitSlot));
+    if(grownSlots == NULL)
+    {
+        return 0;
+    }
+    slots = grownSlots;
+
+    int *grownFree = realloc(freeSlots, newCapacity * sizeof(int));
+    if(grownFree == NULL)
+    {
+        return 0;
+    }
+    freeSlots = grownFree;
+
+    for(int slot = newCapacity - 1; slot >= slotCapacity; slot--)
+    {
+        slots[slot].inUse      = 0;
+        freeSlots[freeCount++] = slot;
+    }
+
+    slotCapacity = newCapacity;
+    return 1;
+}
+
+/*
+ * Returns the heap for a ward name; an empty or unknown name maps to the any-ward heap.
+ */
+static int heapForWard(const char wardName[])
+{
+    int wardIndex = wardName[0] == '\0' ? NO_WARD : facilityFindWard(wardName);
+    return wardIndex == NO_WARD ? heapCount - 1 : wardIndex;
+}
+
+/*
+ * Orders entries by priority, then by arrival.
+ */
+static int isMoreUrgent(int leftSlot, int rightSlot)
+{
+    const WaitingPatient *left  = &slots[leftSlot].patient;
+    const WaitingPatient *right = &slots[rightSlot].patient;
+
+    if(left->priority != right->priority)
+    {
+        return left->priority < right->priority;
+    }
+    return left->sequence < right->sequence;
+}
+
+/*
+ * Adds a slot to a heap.
+ */
+static int heapPush(int heapIndex, int slot)
+{
+    WaitHeap *heap = &heaps[heapIndex];
+
+    if(heap->count == heap->capacity)
+    {
+        int  newCapacity = heap->capacity == 0 ? INITIAL_SLOT_CAPACITY : heap->capacity * 2;
+        int *grown       = realloc(heap->items, newCapacity * sizeof(int));
+
+        if(grown == NULL)
+        {
+            return 0;
+        }
+
+        heap->items    = grown;
+        heap->capacity = newCapacity;
+    }
+
+    slots[slot].heap = heapIndex;
+    placeAt(heap, heap->count++, slot);
+    siftUp(heap, heap->count - 1);
+    return 1;
+}
+
+/*
+ * Removes a slot from whichever heap holds it.
+ */
+static void heapRemove(int slot)
+{
+    WaitHeap *heap     = &heaps[slots[slot].heap];
+    int       position = slots[slot].position;
+    int       last     = heap->items[--heap->count];
+
+    if(position < heap->count)
+    {
+        placeAt(heap, position, last);
+        siftUp(heap, position);
+        siftDown(heap, slots[last].position);
+    }
+}
+
+/*
+ * Moves an entry towards the root while it is more urgent than its parent.
+ */
+static void siftUp(WaitHeap *heap, int position)
+{
+    int slot = heap->items[position];
+
+    while(position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if(!isMoreUrgent(slot, heap->items[parent]))
+        {
+            break;
+        }
+
+        placeAt(heap, position, heap->items[parent]);
+        position = parent;
+    }
+
+    placeAt(heap, position, slot);
+}
+
+/*
+ * Moves an entry towards the leaves while a child is more urgent.
+ */
+static void siftDown(WaitHeap *heap, int position)
+{
+    int slot = heap->items[position];
+
+    while(2 * position + 1 < heap->count)
+    {
+        int child = 2 * position + 1;
+        if(child + 1 < heap->count && isMoreUrgent(heap->items[child + 1], heap->items[child]))
+        {
+            child++;
+        }
+
+        if(!isMoreUrgent(heap->items[child], slot))
+        {
+            break;
+        }
+
+        placeAt(heap, position, heap->items[child]);
+        position = child;
+    }
+
+    placeAt(heap, position, slot);
+}
+
+/*
+ * Stores a slot at a heap position and records the position in the slot.
+ */
+static void placeAt(WaitHeap *heap, int position, int slot)
+{
+    heap->items[position] = slot;
+    slots[slot].position  = position;
+}
+
+/*
+ * Orders slot indexes for the waitlist display.
+ */
+static int compareWaitOrder(const void *a, const void *b)
+{
+    int left  = *(const int *) a;
+    int right = *(const int *) b;
+
+    if(isMoreUrgent(left, right))
+    {
+        return -1;
+    }
+    return isMoreUrgent(right, left) ? 1 : 0;
+}
+
+/*
+ * Prompts for a waitlist number and returns its slot, or NO_WAITLIST_ENTRY.
+ */
+static int promptWaitNumber(void)
+{
+    int waitNumber;
+
+    printf("Enter waitlist number:\n");
+    if(scanf("%d", &waitNumber) != SUCCESSFUL_READ)
+    {
+        clearInputBuffer();
+        puts("Invalid input.");
+        return NO_WAITLIST_ENTRY;
+    }
+    clearInputBuffer();
+
+    int slot = waitNumber - WAIT_NUMBER_OFFSET;
+    if(slot < 0 || slot >= slotCapacity || !slots[slot].inUse)
+    {
+        printf("No patient with waitlist number %d.\n", waitNumber);
+        return NO_WAITLIST_ENTRY;
+    }
+
+    return slot;
+}
@@ -0,0 +1,117 @@
+/*
+ * Author: Arsh M, Nathan O
+ * Date: Oct 18, 2026
+ * Purpose: This file defines the admission waitlist. Patients who cannot be
+ *          given a bed wait in a priority queue, optionally restricted to one
+ *          ward. Each ward has its own indexed binary heap (plus one heap for
+ *          patients who accept any ward), ordered by triage priority and then
+ *          arrival, so adding, removing and reprioritising are O(log n).
+ */
+
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <time.h>
+#include "facility.h"
+#include "patient_data.h"
+
+// Triage priorities, most urgent first
+#define MIN_WAIT_PRIORITY 1
+#define MAX_WAIT_PRIORITY 5
+
+#define NO_WAITLIST_ENTRY (-1)
+
+/*
+ * A patient waiting for a bed. The waitlist number identifies the entry
+ * while it is on the list and may be reused once it leaves.
+ */
+typedef struct
+{
+    int       waitNumber;
+    char      name[MAX_PATIENT_NAME_LENGTH];
+    int       age;
+    char      diagnosis[MAX_DIAGNOSIS_LENGTH];
+    int       priority;
+    char      wardName[MAX_WARD_NAME_LENGTH];
+    long long sequence;
+    time_t    arrivedAt;
+} WaitingPatient;
+
+/*
+ * Function: initializeWaitlist
+ * ----------------------------
+ * Loads the waitlist from waitlist.dat and applies the changes logged in
+ * waitlist.log since it was written. Must run after initializeFacility.
+ * Entries for wards that no longer exist are moved to the any-ward queue.
+ */
+void initializeWaitlist(void);
+
+/*
+ * Function: waitlistPatient
+ * -------------------------
+ * Prompts for a triage priority and adds the patient to the waitlist.
+ *
+ * name: The patient's name
+ * age: The patient's age
+ * diagnosis: The patient's diagnosis
+ * wardIndex: The ward the patient must be placed in, or NO_WARD for any ward
+ *
+ * Returns: The waitlist number, or NO_WAITLIST_ENTRY if the patient could not be added
+ */
+int waitlistPatient(const char name[], int age, const char diagnosis[], int wardIndex);
+
+/*
+ * Function: waitlistPeekForRoom
+ * -----------------------------
+ * Finds the most urgent patient who may be placed in the given room:
+ * the better of the head of the room's ward queue and the head of the
+ * any-ward queue. The patient stays on the list until waitlistRemoveEntry
+ * is called, which should only happen once their admission is saved.
+ *
+ * roomNumber: The room with a free bed
+ * patient: Receives a copy of the entry
+ *
+ * Returns: 1 if a patient was found, 0 if nobody is waiting for that room
+ */
+int waitlistPeekForRoom(int roomNumber, WaitingPatient *patient);
+
+/*
+ * Function: waitlistRemoveEntry
+ * -----------------------------
+ * Removes an entry returned by waitlistPeekForRoom and saves the removal.
+ *
+ * patient: The entry to remove
+ *
+ * Returns: 1 if it was removed, 0 if it is no longer on the list
+ */
+int waitlistRemoveEntry(const WaitingPatient *patient);
+
+/*
+ * Function: waitlistSize
+ * ----------------------
+ * Returns: The number of patients waiting
+ */
+int waitlistSize(void);
+
+/*
+ * Function: displayWaitlist
+ * -------------------------
+ * Prints every waiting patient in the order they would be admitted.
+ */
+void displayWaitlist(void);
+
+/*
+ * Function: changeWaitlistPriority
+ * --------------------------------
+ * Prompts for a waitlist number and a new triage priority.
+ */
+void changeWaitlistPriority(void);
+
+/*
+ * Function: removeFromWaitlist
+ * ----------------------------
+ * Prompts for a waitlist number and removes that patient from the list.
+ */
+void removeFromWaitlist(void);
+
+#endif // WAITLIST_H